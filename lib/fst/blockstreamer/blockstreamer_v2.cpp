@@ -20,6 +20,9 @@
 #include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <stdexcept>
+#include <exception>
+#include <vector>
 
 // Framework libraries
 #include <compression/compression.h>
@@ -28,6 +31,7 @@
 #include <interface/openmphelper.h>
 
 #include "blockstreamer_v2.h"
+#include "positionalreader.h"
 #include <memory>
 
 #define BATCH_SIZE_WRITE 25
@@ -50,9 +54,17 @@
 using namespace std;
 
 
-// Method for writing column data of any type to a ofstream.
-void fdsStreamUncompressed_v2(ofstream& myfile, char* vec, unsigned long long vecLength, int elementSize, int blockSizeElems,
-  FixedRatioCompressor* fixedRatioCompressor, std::string annotation, bool hasAnnotation)
+// Size of a buffer that can hold a single compressed block of 'blockSize' bytes. Block sizes are a multiple of
+// MAX_SIZE_COMPRESS_BLOCK (or smaller), so the bound is a multiple of MAX_COMPRESSBOUND and keeps 16-byte alignment.
+inline unsigned long long BlockCompressBound(unsigned long long blockSize)
+{
+  return MAX_COMPRESSBOUND * max(1ULL, (blockSize + MAX_SIZE_COMPRESS_BLOCK - 1) / MAX_SIZE_COMPRESS_BLOCK);
+}
+
+
+// Method for writing column data of any type to an output stream.
+void fdsStreamUncompressed_v2(ostream& myfile, char* vec, unsigned long long vecLength, int elementSize, int blockSizeElems,
+  FixedRatioCompressor* fixedRatioCompressor, std::string annotation, bool hasAnnotation, ColumnStatistics* columnStatistics)
 {
   const unsigned int annotationLength = annotation.length();
   int nrOfBlocks = 1 + (vecLength - 1) / blockSizeElems; // number of compressed / uncompressed blocks
@@ -79,6 +91,8 @@ void fdsStreamUncompressed_v2(ofstream& myfile, char* vec, unsigned long long ve
   // nothing to write
   if (vecLength == 0) return;
 
+  if (columnStatistics != nullptr) columnStatistics->Allocate(vecLength, blockSizeElems);
+
   // No fixed ratio compressor specified
   if (fixedRatioCompressor == nullptr)
   {
@@ -125,6 +139,18 @@ void fdsStreamUncompressed_v2(ofstream& myfile, char* vec, unsigned long long ve
         // the memcpy activates cache buffering
         std::memcpy(compBuf, &vec[batch * totSize], writeSize);
 
+        if (columnStatistics != nullptr)
+        {
+          const unsigned long long batchElems = writeSize / elementSize;
+
+          for (unsigned long long blockStart = 0; blockStart < batchElems; blockStart += blockSizeElems)
+          {
+            const unsigned int blockElems = static_cast<unsigned int>(min(batchElems - blockStart, static_cast<unsigned long long>(blockSizeElems)));
+            columnStatistics->CalculateBlock(&compBuf[blockStart * elementSize], static_cast<unsigned long long>(batch) * batchSize +
+              blockStart / blockSizeElems, blockElems);
+          }
+        }
+
 #pragma omp ordered
         {
           myfile.write(compBuf, writeSize);
@@ -153,6 +179,7 @@ void fdsStreamUncompressed_v2(ofstream& myfile, char* vec, unsigned long long ve
 
     CompAlgo compAlgo;
     fixedRatioCompressor->Compress(&compBuf[COL_META_SIZE], compressBufSizeRemain, vec, remainBlock, compAlgo);
+    if (columnStatistics != nullptr) columnStatistics->CalculateBlock(vec, 0, remain);
     compress[1] = static_cast<unsigned int>(compAlgo); // set fixed-ratio compression algorithm
     myfile.write(compBuf, compressBufSizeRemain + COL_META_SIZE);
 
@@ -171,6 +198,7 @@ void fdsStreamUncompressed_v2(ofstream& myfile, char* vec, unsigned long long ve
 
   CompAlgo compAlgo;
   fixedRatioCompressor->Compress(&compBuf[COL_META_SIZE], compressBufSize, vec, blockSize, compAlgo);
+  if (columnStatistics != nullptr) columnStatistics->CalculateBlock(vec, 0, blockSizeElems);
   compress[1] = static_cast<unsigned int>(compAlgo); // set fixed-ratio compression algorithm
   myfile.write(compBuf, compressBufSize + COL_META_SIZE);
 
@@ -181,6 +209,7 @@ void fdsStreamUncompressed_v2(ofstream& myfile, char* vec, unsigned long long ve
   for (int block = 1; block != nrOfBlocks; ++block)
   {
     fixedRatioCompressor->Compress(compBuf, compressBufSize, &vec[blockPos], blockSize, compAlgo);
+    if (columnStatistics != nullptr) columnStatistics->CalculateBlock(&vec[blockPos], block, blockSizeElems);
     blockPos += blockSize;
     myfile.write(compBuf, compressBufSize);
   }
@@ -188,6 +217,7 @@ void fdsStreamUncompressed_v2(ofstream& myfile, char* vec, unsigned long long ve
   // Last block
 
   fixedRatioCompressor->Compress(compBuf, compressBufSizeRemain, &vec[blockPos], remainBlock, compAlgo);
+  if (columnStatistics != nullptr) columnStatistics->CalculateBlock(&vec[blockPos], nrOfBlocks, remain);
   myfile.write(compBuf, compressBufSizeRemain);
 }
 
@@ -199,8 +229,9 @@ void fdsStreamUncompressed_v2(ofstream& myfile, char* vec, unsigned long long ve
 
 
 // Method for writing column data of any type to a stream.
-void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long nrOfRows, int elementSize,
-  StreamCompressor* streamCompressor, int blockSizeElems, std::string annotation, bool hasAnnotation)
+void fdsStreamcompressed_v2(ostream& myfile, char* colVec, unsigned long long nrOfRows, int elementSize,
+  StreamCompressor* streamCompressor, int blockSizeElems, std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics)
 {
   unsigned int annotationLength = annotation.length();
   int nrOfBlocks = 1 + (nrOfRows - 1) / blockSizeElems; // number of compressed / uncompressed blocks
@@ -226,6 +257,8 @@ void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long n
   // nothing to write
   if (nrOfRows == 0) return;
 
+  if (columnStatistics != nullptr) columnStatistics->Allocate(nrOfRows, blockSizeElems);
+
   unsigned long long curPos = myfile.tellp();
 
   // Blocks meta information
@@ -264,7 +297,8 @@ void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long n
   int batchSize = min(BATCH_SIZE_WRITE, nrOfBlocks / nrOfThreads); // keep thread buffer small
   batchSize = max(1, batchSize);
 
-  std::unique_ptr<char[]> threadBufferP(new char[nrOfThreads * MAX_COMPRESSBOUND * batchSize]);
+  const unsigned long long compressBound = BlockCompressBound(blockSize);
+  std::unique_ptr<char[]> threadBufferP(new char[nrOfThreads * compressBound * batchSize]);
   char* threadBuffer = threadBufferP.get();
 
   // TODO: possibly memset to zero to avoid valgrind warnings
@@ -273,6 +307,9 @@ void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long n
 
   if (nrOfBatches > 0)
   {
+    // each thread of the parallel region needs its own compressor statistics
+    streamCompressor->PrepareThreadStates(nrOfThreads);
+
     // Parallel region processes batches with batchSize complete blocks per batch
 
 #pragma omp parallel num_threads(nrOfThreads)
@@ -292,9 +329,10 @@ void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long n
         {
           int block = batch * batchSize + offset;
           CompAlgo compAlgo;
-          char* compBuf = &threadBuffer[threadNr * MAX_COMPRESSBOUND * batchSize + totSize];
+          char* compBuf = &threadBuffer[threadNr * compressBound * batchSize + totSize];
           unsigned long long vecOffset = static_cast<unsigned long long>(block) * static_cast<unsigned long long>(blockSize);
           compSize[offset] = static_cast<unsigned int>(streamCompressor->Compress(&colVec[vecOffset], blockSize, compBuf, compAlgo, block));
+          if (columnStatistics != nullptr) columnStatistics->CalculateBlock(&colVec[vecOffset], block, blockSizeElems);
           totSize += static_cast<unsigned long long>(compSize[offset]);
           blockAlgorithm[offset] = static_cast<unsigned int>(compAlgo);
           if (compSize[offset] > localMax) localMax = compSize[offset];
@@ -310,7 +348,7 @@ void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long n
             blockIndexPos += compSize[offset]; // compressed block length
           }
 
-          char* compBuf = &threadBuffer[threadNr * MAX_COMPRESSBOUND * batchSize];
+          char* compBuf = &threadBuffer[threadNr * compressBound * batchSize];
           if (localMax > maxCompressionSize) maxCompressionSize = localMax;
           myfile.write(compBuf, totSize);
         }
@@ -322,6 +360,9 @@ void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long n
   // Parallel region ends here
   //////////////////////////////////////////////////////////
 
+  // the remaining blocks start from the merged statistics of all threads
+  streamCompressor->MergeThreadStates();
+
   // 1 long file pointer and 1 short algorithmID per block
   {
     char* compBuf = threadBuffer;
@@ -338,6 +379,7 @@ void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long n
 
       unsigned long long vecOffset = static_cast<unsigned long long>(block) * static_cast<unsigned long long>(blockSize);
       compSize = static_cast<unsigned int>(streamCompressor->Compress(&colVec[vecOffset], blockSize, &compBuf[totSize], compAlgo, block));
+      if (columnStatistics != nullptr) columnStatistics->CalculateBlock(&colVec[vecOffset], block, blockSizeElems);
       totSize += compSize;
       blockAlgorithm = static_cast<unsigned int>(compAlgo);
       if (compSize > maxCompressionSize) maxCompressionSize = compSize;
@@ -349,6 +391,7 @@ void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long n
     // last (possibly) partial block
     unsigned long long vecOffset = static_cast<unsigned long long>(nrOfBlocks) * static_cast<unsigned long long>(blockSize);
     compSize = static_cast<unsigned int>(streamCompressor->Compress(&colVec[vecOffset], remain * elementSize, &compBuf[totSize], compAlgo, nrOfBlocks));
+    if (columnStatistics != nullptr) columnStatistics->CalculateBlock(&colVec[vecOffset], nrOfBlocks, remain);
     totSize += compSize;
 
     if (compSize > maxCompressionSize) maxCompressionSize = compSize;
@@ -376,7 +419,8 @@ void fdsStreamcompressed_v2(ofstream& myfile, char* colVec, unsigned long long n
 // Read data compressed with a fixed ratio compressor from a stream
 // Note that repSize is assumed to be a multiple of elementSize
 inline void fdsReadFixedCompStream_v2(istream& myfile, char* outVec, unsigned long long blockPos,
-  unsigned int* meta, unsigned long long startRow, int elementSize, unsigned long long vecLength)
+  unsigned int* meta, unsigned long long startRow, int elementSize, unsigned long long vecLength,
+  const IFstSource* positionalReader)
 {
   unsigned int compAlgo = meta[1]; // identifier of the fixed ratio compressor
   unsigned int repSize = fixedRatioSourceRepSize[static_cast<int>(compAlgo)]; // in bytes
@@ -395,10 +439,8 @@ inline void fdsReadFixedCompStream_v2(istream& myfile, char* outVec, unsigned lo
 
   Decompressor decompressor; // decompressor
 
-  if (startRep > 0)
-  {
-    myfile.seekg(blockPos + COL_META_SIZE + startRep * targetRepSize); // move to startRep
-  }
+  // file position of startRep
+  unsigned long long readPos = blockPos + COL_META_SIZE + static_cast<unsigned long long>(startRep) * targetRepSize;
 
   unsigned int startRowRep = startRep * repSizeElement;
   unsigned int startOffset = startRow - startRowRep; // rep-block offset in number of elements
@@ -411,7 +453,8 @@ inline void fdsReadFixedCompStream_v2(istream& myfile, char* outVec, unsigned lo
     char repBuf[MAX_TARGET_REP_SIZE]; // rep unit buffer for target
     char buf[MAX_SOURCE_REP_SIZE]; // rep unit buffer for source
 
-    myfile.read(repBuf, targetRepSize); // read single repetition block
+    ReadAt(myfile, positionalReader, repBuf, targetRepSize, readPos); // read single repetition block
+    readPos += targetRepSize;
     decompressor.Decompress(compAlgo, buf, repSize, repBuf, targetRepSize); // decompress repetition block
 
     if (startRep == endRep) // finished
@@ -446,7 +489,8 @@ inline void fdsReadFixedCompStream_v2(istream& myfile, char* outVec, unsigned lo
     // Decompress full blocks
     for (unsigned int block = 0; block < nrOfFullBlocks; ++block)
     {
-      myfile.read(repBuf, targetBlockSize);
+      ReadAt(myfile, positionalReader, repBuf, targetBlockSize, readPos);
+      readPos += targetBlockSize;
       decompressor.Decompress(compAlgo, &outP[activeBlockPos], blockSize, repBuf, targetBlockSize);
       activeBlockPos += blockSize;
     }
@@ -458,7 +502,8 @@ inline void fdsReadFixedCompStream_v2(istream& myfile, char* outVec, unsigned lo
     // Decompress full blocks
     for (unsigned int block = 0; block < nrOfFullBlocks; ++block)
     {
-      myfile.read(repBuf, targetBlockSize);
+      ReadAt(myfile, positionalReader, repBuf, targetBlockSize, readPos);
+      readPos += targetBlockSize;
       decompressor.Decompress(compAlgo, alignBuf, blockSize, repBuf, targetBlockSize);
       memcpy(&outP[activeBlockPos], alignBuf, blockSize); // move to unaligned output vector
       activeBlockPos += blockSize;
@@ -470,7 +515,7 @@ inline void fdsReadFixedCompStream_v2(istream& myfile, char* outVec, unsigned lo
   // Read last block
   unsigned int lastBlockSize = remainReps * repSize; // block size in bytes
   unsigned int lastTargetBlockSize = remainReps * targetRepSize; // block size in bytes
-  myfile.read(repBuf, lastTargetBlockSize);
+  ReadAt(myfile, positionalReader, repBuf, lastTargetBlockSize, readPos);
 
   // Decompress all but last repetition block fully
   if (lastBlockSize != repSize)
@@ -497,15 +542,16 @@ inline void fdsReadFixedCompStream_v2(istream& myfile, char* outVec, unsigned lo
 
 #define UNCOMPRESSED_BLOCKSIZE 262144  // reading in small block is more efficient (probably more efficient L3 caching)
 
-void ProcessBatch(char* outVec, char* blockIndex, unsigned long long blockSize, Decompressor decompressor, unsigned long long outOffset, bool isAlligned,
-  unsigned long long blockStart, unsigned long long blockEnd, unsigned long long*& bStart, unsigned long long*& bEnd, char* threadBuf)
+void ProcessBatch(char* outVec, const char* blockIndex, unsigned long long blockSize, Decompressor decompressor, unsigned long long outOffset,
+  bool isAlligned, unsigned long long blockStart, unsigned long long blockEnd, const unsigned long long*& bStart,
+  const unsigned long long*& bEnd, char* threadBuf, char* allignBuf)
 {
   unsigned long long totSize = 0;
   for (unsigned long long blockCount = blockStart; blockCount < blockEnd; blockCount++)
   {
     // File offsets and algorithm
-    bStart = reinterpret_cast<unsigned long long*>(&blockIndex[8 * blockCount]);
-    bEnd = reinterpret_cast<unsigned long long*>(&blockIndex[8 + 8 * blockCount]);
+    bStart = reinterpret_cast<const unsigned long long*>(&blockIndex[8 * blockCount]);
+    bEnd = reinterpret_cast<const unsigned long long*>(&blockIndex[8 + 8 * blockCount]);
     unsigned short threadAlgo = static_cast<unsigned short>(((*bStart) >> 48) & 0xffff);
     unsigned long long curCompBlockSize = (*bEnd & BLOCK_POS_MASK) - (*bStart & BLOCK_POS_MASK);
 
@@ -519,7 +565,6 @@ void ProcessBatch(char* outVec, char* blockIndex, unsigned long long blockSize,
     }
     else // misaligned output vector, memcpy to avoid inefficient decompression
     {
-      char allignBuf[MAX_SIZE_COMPRESS_BLOCK];
       decompressor.Decompress(threadAlgo, allignBuf, blockSize, &threadBuf[totSize], curCompBlockSize);
       memcpy(&outVec[outOffset + (blockCount - 1) * blockSize], allignBuf, blockSize); // copy to misaligned pointer
     }
@@ -528,13 +573,12 @@ void ProcessBatch(char* outVec, char* blockIndex, unsigned long long blockSize,
   }
 }
 
-void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size, int elementSize, std::string& annotation, int maxbatchSize, bool& hasAnnotation)
+// Read the annotation of a column and return its length in bytes
+inline unsigned int ReadColumnAnnotation(istream& myfile, const IFstSource* positionalReader, unsigned long long blockPos,
+  std::string& annotation, bool& hasAnnotation)
 {
-  myfile.seekg(blockPos);
-
   unsigned int annotationLength;
-  myfile.read(reinterpret_cast<char*>(&annotationLength), 4);
+  ReadAt(myfile, positionalReader, reinterpret_cast<char*>(&annotationLength), 4, blockPos);
 
   hasAnnotation = (annotationLength & (1 << 31)) != 0;
 
@@ -547,51 +591,103 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
     {
       std::unique_ptr<char[]> annotationBufP(new char[annotationLength]);
       char* annotationBuf = annotationBufP.get();
-      myfile.read(annotationBuf, annotationLength);
+      ReadAt(myfile, positionalReader, annotationBuf, annotationLength, blockPos + 4);
 
       annotation += std::string(annotationBuf, annotationLength);
     }
   }
 
-  // there is no data to read
-  if (length == 0) return;
+  return annotationLength;
+}
 
-  blockPos += 4 + annotationLength;
 
-  // Read header
+void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos, unsigned long long startRow,
+  unsigned long long length, unsigned long long size, int elementSize, std::string& annotation, int maxbatchSize, bool& hasAnnotation,
+  const IFstSource* positionalReader, ColumnMetaCache* metaCache)
+{
+  const ColumnMeta_v2* meta = nullptr;
   unsigned int compress[2];
-  myfile.read(reinterpret_cast<char*>(compress), COL_META_SIZE);
+
+  if (metaCache != nullptr)
+  {
+    meta = &metaCache->Column(myfile, blockPos, size, elementSize, positionalReader);
+
+    annotation += meta->annotation;
+    hasAnnotation = meta->hasAnnotation;
+
+    // there is no data to read
+    if (length == 0) return;
+
+    blockPos = meta->dataPos;
+    compress[0] = meta->compress[0];
+    compress[1] = meta->compress[1];
+  }
+  else
+  {
+    const unsigned int annotationLength = ReadColumnAnnotation(myfile, positionalReader, blockPos, annotation, hasAnnotation);
+
+    // there is no data to read
+    if (length == 0) return;
+
+    blockPos += 4 + annotationLength;
+
+    // Read header
+    ReadAt(myfile, positionalReader, reinterpret_cast<char*>(compress), COL_META_SIZE, blockPos);
+  }
 
   // Data is uncompressed or uses a fixed-ratio compressor (logical)
   if (compress[0] == 0)
   {
     if (compress[1] == 0) // uncompressed data
     {
-      // Jump to startRow position
-      if (startRow > 0) myfile.seekg(blockPos + elementSize * startRow + COL_META_SIZE);
+      // startRow position
+      uint64_t readPos = blockPos + elementSize * startRow + COL_META_SIZE;
 
       uint64_t totBytes = static_cast<uint64_t>(length) * elementSize;
 
-      uint64_t nrOfBlocks = (totBytes - 1) / UNCOMPRESSED_BLOCKSIZE; // all but last block
+      long long nrOfBlocks = (totBytes - 1) / UNCOMPRESSED_BLOCKSIZE; // all but last block
       uint64_t remainingBytes = totBytes - nrOfBlocks * UNCOMPRESSED_BLOCKSIZE; // last block
-      uint64_t curBlockPos = 0;
 
-      // TODO: use multi-threaded logic here
-
-      for (uint64_t block = 0; block != nrOfBlocks; ++block)
+      if (positionalReader == nullptr)
       {
-        // Read data
-        myfile.read(&outVec[curBlockPos], UNCOMPRESSED_BLOCKSIZE);
-        curBlockPos += UNCOMPRESSED_BLOCKSIZE;
+        for (long long block = 0; block != nrOfBlocks; ++block)
+        {
+          ReadAt(myfile, positionalReader, &outVec[block * UNCOMPRESSED_BLOCKSIZE], UNCOMPRESSED_BLOCKSIZE,
+            readPos + block * UNCOMPRESSED_BLOCKSIZE);
+        }
       }
-      myfile.read(&outVec[curBlockPos], remainingBytes);
+      else
+      {
+        // positional reads have no shared file position, so blocks can be read concurrently
+        const int nrOfThreads = static_cast<int>(max(1LL, min(static_cast<long long>(GetFstThreads()), nrOfBlocks)));
+        bool readError = false;
+
+#pragma omp parallel for num_threads(nrOfThreads) schedule(static)
+        for (long long block = 0; block < nrOfBlocks; ++block)
+        {
+          if (!positionalReader->Read(&outVec[block * UNCOMPRESSED_BLOCKSIZE], UNCOMPRESSED_BLOCKSIZE,
+            readPos + block * UNCOMPRESSED_BLOCKSIZE))
+          {
+#pragma omp critical
+            readError = true;
+          }
+        }
+
+        if (readError)
+        {
+          throw(runtime_error(FSTERROR_READ_FAILED));
+        }
+      }
+
+      ReadAt(myfile, positionalReader, &outVec[nrOfBlocks * UNCOMPRESSED_BLOCKSIZE], remainingBytes,
+        readPos + nrOfBlocks * UNCOMPRESSED_BLOCKSIZE);
 
       return;
     }
 
     // Stream uses a fixed-ratio compressor
 
-    fdsReadFixedCompStream_v2(myfile, outVec, blockPos, compress, startRow, elementSize, length);
+    fdsReadFixedCompStream_v2(myfile, outVec, blockPos, compress, startRow, elementSize, length, positionalReader);
 
     return;
   }
@@ -601,6 +697,12 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
   // unsigned int* maxCompSize = (unsigned int*) &compress[0];  // 4 algorithms in index
   unsigned int blockSizeElements = compress[1]; // number of elements per block
 
+  // the block size is recorded by the writer (see FstStore::SetBlockSize)
+  if (blockSizeElements == 0 || static_cast<unsigned long long>(blockSizeElements) * elementSize > MAX_BLOCK_SIZE)
+  {
+    throw(runtime_error(FSTERROR_READ_FAILED));
+  }
+
   // Number of compressed data blocks, the last block can be smaller than blockSizeElements
   unsigned long long nrOfBlocks = 1 + (size - 1) / blockSizeElements;
 
@@ -609,23 +711,28 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
   unsigned long long endBlock = (startRow + length - 1) / blockSizeElements;
   int startOffset = startRow % blockSizeElements;
 
-  if (startBlock > 0)
+  // Block index (position pointer and algorithm for each block) starting at the startBlock meta info
+  std::unique_ptr<char[]> blockIndexP;
+  const char* blockIndex; // 1 long file pointer using 2 highest bytes for algorithm
+
+  if (meta != nullptr)
   {
-    myfile.seekg(blockPos + COL_META_SIZE + 8 * startBlock); // move to startBlock meta info
+    blockIndex = reinterpret_cast<const char*>(&meta->blockIndex[startBlock]);
+  }
+  else
+  {
+    blockIndexP.reset(new char[(2 + endBlock - startBlock) * 8]);
+    ReadAt(myfile, positionalReader, blockIndexP.get(), (2 + endBlock - startBlock) * 8, blockPos + COL_META_SIZE + 8 * startBlock);
+    blockIndex = blockIndexP.get();
   }
-
-  // Read block index (position pointer and algorithm for each block)
-  std::unique_ptr<char[]> blockIndexP(new char[(2 + endBlock - startBlock) * 8]);
-  char* blockIndex = blockIndexP.get(); // 1 long file pointer using 2 highest bytes for algorithm
-
-  myfile.read(blockIndex, (2 + endBlock - startBlock) * 8);
 
   int blockSize = elementSize * blockSizeElements;
+  const unsigned long long compressBound = BlockCompressBound(blockSize);
 
   Decompressor decompressor;
 
-  unsigned long long* blockPStart = reinterpret_cast<unsigned long long*>(&blockIndex[0]);
-  unsigned long long* blockPEnd = reinterpret_cast<unsigned long long*>(&blockIndex[8]);
+  const unsigned long long* blockPStart = reinterpret_cast<const unsigned long long*>(&blockIndex[0]);
+  const unsigned long long* blockPEnd = reinterpret_cast<const unsigned long long*>(&blockIndex[8]);
 
   unsigned short algo = static_cast<unsigned short>(((*blockPStart) >> 48) & 0xffff);
   unsigned long long blockPosStart = (*blockPStart) & BLOCK_POS_MASK;
@@ -637,13 +744,15 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
   // Process single block and return
   if (startBlock == endBlock) // Read single block and subset result
   {
-    char compBuf[MAX_COMPRESSBOUND]; // maximum size needed in worst case scenario compression
-    char tmpBuf[MAX_SIZE_COMPRESS_BLOCK]; // temporary buffer
+    std::unique_ptr<char[]> compBufP(new char[compressBound]); // maximum size needed in worst case scenario compression
+    std::unique_ptr<char[]> tmpBufP(new char[blockSize]); // temporary buffer
+    char* compBuf = compBufP.get();
+    char* tmpBuf = tmpBufP.get();
 
     if (algo == 0) // no compression on this block
     {
-      myfile.seekg(blockPos + blockPosStart + elementSize * startOffset); // move to block data position
-      myfile.read(static_cast<char*>(outVec), static_cast<uint64_t>(length) * elementSize);
+      ReadAt(myfile, positionalReader, static_cast<char*>(outVec), static_cast<uint64_t>(length) * elementSize,
+        blockPos + blockPosStart + elementSize * startOffset);
 
       return;
     }
@@ -655,8 +764,7 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
       curSize = 1 + (size + blockSizeElements - 1) % blockSizeElements; // smaller last block size
     }
 
-    myfile.seekg(blockPos + blockPosStart); // move to block data position, not always necessary!
-    myfile.read(compBuf, compSize);
+    ReadAt(myfile, positionalReader, compBuf, compSize, blockPos + blockPosStart);
 
     if (length == curSize)
     {
@@ -678,16 +786,16 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
 
   if (algo == 0) // no compression
   {
-    myfile.seekg(blockPos + blockPosStart + elementSize * startOffset); // move to block data position
-    myfile.read(outVec, elementSize * subBlockSize); // read first block data
+    ReadAt(myfile, positionalReader, outVec, elementSize * subBlockSize, blockPos + blockPosStart + elementSize * startOffset);
   }
   else
   {
-    char compBuf[MAX_COMPRESSBOUND]; // maximum size needed in worst case scenario compression
-    char tmpBuf[MAX_SIZE_COMPRESS_BLOCK]; // temporary buffer
+    std::unique_ptr<char[]> compBufP(new char[compressBound]); // maximum size needed in worst case scenario compression
+    std::unique_ptr<char[]> tmpBufP(new char[blockSize]); // temporary buffer
+    char* compBuf = compBufP.get();
+    char* tmpBuf = tmpBufP.get();
 
-    myfile.seekg(blockPos + blockPosStart); // move to block data position
-    myfile.read(compBuf, compSize);
+    ReadAt(myfile, positionalReader, compBuf, compSize, blockPos + blockPosStart);
 
     if (startOffset == 0) // full block
     {
@@ -717,53 +825,62 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
   batchSize = max(1, batchSize);
 
   // TODO: localize threadBuffer in small area
-  std::unique_ptr<char[]> threadBufferP(new char[nrOfThreads * MAX_COMPRESSBOUND * batchSize]);
+  std::unique_ptr<char[]> threadBufferP(new char[nrOfThreads * compressBound * batchSize]);
   char* threadBuffer = threadBufferP.get();
 
+  // decompression buffer for each thread, only required for a misaligned output vector
+  std::unique_ptr<char[]> allignBufferP(isAlligned ? nullptr : new char[nrOfThreads * blockSize]);
+  char* allignBuffer = allignBufferP.get();
+
   long long nrOfBatches = (maxBlock + batchSize - 1) / batchSize; // number of batches (last one may be smaller)
-  long long blockCount = 0;
+  bool readError = false;
 
   //////////////////////////////////////////////////////////
   // Parallel logic starts here
   //////////////////////////////////////////////////////////
 
-#pragma omp parallel num_threads(nrOfThreads) shared(isAlligned,nrOfBatches,batchSize,blockCount)
+#pragma omp parallel num_threads(nrOfThreads) shared(isAlligned,nrOfBatches,batchSize,readError)
   {
 #pragma omp for schedule(static, 1)
     for (long long blockJob = 0; blockJob < nrOfBatches; blockJob++) // a blockJob is a single unit of work
     {
       int threadNr = OMP_GET_THREAD_NUM; // use memory buffer specific for this thread
 
-      unsigned long long blockStart;
-      unsigned long long blockEnd;
-      unsigned long long *bStart, *bEnd;
-      char* threadBuf = &threadBuffer[threadNr * MAX_COMPRESSBOUND * batchSize]; // MAX_COMPRESSBOUND is adjusted to 16-byte allignment
-      int curBatchSize = batchSize;
-
-#pragma omp critical
-      {
-        blockStart = 1 + blockCount * batchSize;
-        bStart = reinterpret_cast<unsigned long long*>(&blockIndex[8 * blockStart]);
+      char* threadBuf = &threadBuffer[threadNr * compressBound * batchSize]; // compressBound is adjusted to 16-byte allignment
+      char* allignBuf = isAlligned ? nullptr : &allignBuffer[threadNr * blockSize];
 
-        // last batch might have a smaller size
-        if (blockCount == (nrOfBatches - 1))
-        {
-          curBatchSize = batchSize - (nrOfBatches * batchSize % maxBlock);
-        }
+      // last batch might have a smaller size
+      unsigned long long blockStart = 1 + blockJob * batchSize;
+      unsigned long long blockEnd = min(blockStart + batchSize, maxBlock + 1);
 
-        blockEnd = blockStart + curBatchSize;
+      // determine total length of compressed blocks in batch
+      const unsigned long long* bStart = reinterpret_cast<const unsigned long long*>(&blockIndex[8 * blockStart]);
+      const unsigned long long* bEnd = reinterpret_cast<const unsigned long long*>(&blockIndex[8 * blockEnd]);
+      unsigned long long curCompSize = (*bEnd & BLOCK_POS_MASK) - (*bStart & BLOCK_POS_MASK);
+      unsigned long long batchPos = blockPos + (*bStart & BLOCK_POS_MASK);
 
-        // determine total length of compressed blocks in batch
-        blockCount++;
-        bEnd = reinterpret_cast<unsigned long long*>(&blockIndex[8 * blockEnd]);
-        unsigned long long curCompSize = (*bEnd & BLOCK_POS_MASK) - (*bStart & BLOCK_POS_MASK);
+      // always cache in threadBuf first (non zero copy for uncompressed blocks)
+      if (positionalReader != nullptr)
+      {
+        // no shared file position, each thread fetches its own batch
+        if (!positionalReader->Read(threadBuf, curCompSize, batchPos))
+        {
+#pragma omp critical
+          readError = true;
 
-        myfile.read(threadBuf, curCompSize); // always cache in threadBuf first (non zero copy for uncompressed blocks)
+          continue;
+        }
+      }
+      else
+      {
+#pragma omp critical
+        ReadAt(myfile, positionalReader, threadBuf, curCompSize, batchPos);
       }
 
       // Decompress all blocks into output vector
 
-      ProcessBatch(outVec, blockIndex, blockSize, decompressor, outOffset, isAlligned, blockStart, blockEnd, bStart, bEnd, threadBuf);
+      ProcessBatch(outVec, blockIndex, blockSize, decompressor, outOffset, isAlligned, blockStart, blockEnd, bStart, bEnd, threadBuf,
+        allignBuf);
     }
   }
 
@@ -771,6 +888,11 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
   // Parallel logic ends here
   //////////////////////////////////////////////////////////
 
+  if (readError)
+  {
+    throw(runtime_error(FSTERROR_READ_FAILED));
+  }
+
   outOffset += maxBlock * blockSize;
   maxBlock++;
 
@@ -784,8 +906,8 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
   // Process last block
 
   // Update meta pointers
-  blockPStart = reinterpret_cast<unsigned long long*>(&blockIndex[8 * maxBlock]);
-  blockPEnd = reinterpret_cast<unsigned long long*>(&blockIndex[8 + 8 * maxBlock]);
+  blockPStart = reinterpret_cast<const unsigned long long*>(&blockIndex[8 * maxBlock]);
+  blockPEnd = reinterpret_cast<const unsigned long long*>(&blockIndex[8 + 8 * maxBlock]);
 
   algo = static_cast<unsigned short>(((*blockPStart) >> 48) & 0xffff);
   blockPosStart = (*blockPStart) & BLOCK_POS_MASK;
@@ -796,14 +918,16 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
 
   if (algo == 0) // no compression
   {
-    myfile.read(&outVec[outOffset], elementSize * remain); // read remaining elements from block
+    ReadAt(myfile, positionalReader, &outVec[outOffset], elementSize * remain, blockPos + blockPosStart); // read remaining elements from block
   }
   else
   {
-    char compBuf[MAX_COMPRESSBOUND]; // maximum size needed in worst case scenario compression
-    char tmpBuf[MAX_SIZE_COMPRESS_BLOCK]; // temporary buffer
+    std::unique_ptr<char[]> compBufP(new char[compressBound]); // maximum size needed in worst case scenario compression
+    std::unique_ptr<char[]> tmpBufP(new char[blockSize]); // temporary buffer
+    char* compBuf = compBufP.get();
+    char* tmpBuf = tmpBufP.get();
 
-    myfile.read(compBuf, compSize);
+    ReadAt(myfile, positionalReader, compBuf, compSize, blockPos + blockPosStart);
 
     if (endBlock == (nrOfBlocks - 1)) // test for last block
     {
@@ -830,3 +954,329 @@ void fdsReadColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos
   }
 }
 
+
+
+// Copy the elements of 'rows' from a block of column data that starts at row 'firstRow'
+template<typename T>
+inline void ScatterElements(char* outVec, const char* blockData, const unsigned long long* rows, unsigned long long nrOfRows,
+  unsigned long long firstRow)
+{
+  T* outP = reinterpret_cast<T*>(outVec);
+  const T* blockP = reinterpret_cast<const T*>(blockData);
+
+  for (unsigned long long pos = 0; pos < nrOfRows; ++pos)
+  {
+    outP[pos] = blockP[rows[pos] - firstRow];
+  }
+}
+
+
+inline void ScatterElements(char* outVec, const char* blockData, const unsigned long long* rows, unsigned long long nrOfRows,
+  unsigned long long firstRow, int elementSize)
+{
+  switch (elementSize)
+  {
+    case 1:
+      ScatterElements<char>(outVec, blockData, rows, nrOfRows, firstRow);
+      break;
+
+    case 4:
+      ScatterElements<int>(outVec, blockData, rows, nrOfRows, firstRow);
+      break;
+
+    default:
+      ScatterElements<long long>(outVec, blockData, rows, nrOfRows, firstRow);
+      break;
+  }
+}
+
+
+void fdsGatherColumn_v2(istream& myfile, char* outVec, unsigned long long blockPos, const unsigned long long* rows,
+  unsigned long long nrOfRows, unsigned long long size, int elementSize, std::string& annotation, bool& hasAnnotation,
+  const IFstSource* positionalReader)
+{
+  const unsigned int annotationLength = ReadColumnAnnotation(myfile, positionalReader, blockPos, annotation, hasAnnotation);
+
+  // there is no data to read
+  if (nrOfRows == 0) return;
+
+  blockPos += 4 + annotationLength;
+
+  // Read header
+  unsigned int compress[2];
+  ReadAt(myfile, positionalReader, reinterpret_cast<char*>(compress), COL_META_SIZE, blockPos);
+
+  // Uncompressed and fixed-ratio data is gathered in parts of MAX_SIZE_COMPRESS_BLOCK bytes, compressed data per block
+  const bool isCompressed = compress[0] != 0;
+  const unsigned long long blockSizeElements = isCompressed ? compress[1] : MAX_SIZE_COMPRESS_BLOCK / elementSize;
+  const unsigned long long blockSize = blockSizeElements * elementSize;
+
+  // the block size is recorded by the writer (see FstStore::SetBlockSize)
+  if (blockSizeElements == 0 || blockSize > MAX_BLOCK_SIZE)
+  {
+    throw(runtime_error(FSTERROR_READ_FAILED));
+  }
+
+  // Rows [blockStart[group], blockStart[group + 1]) are located in the same block
+  vector<unsigned long long> blockStart;
+
+  for (unsigned long long pos = 0; pos < nrOfRows; ++pos)
+  {
+    if (pos == 0 || rows[pos] / blockSizeElements != rows[pos - 1] / blockSizeElements) blockStart.push_back(pos);
+  }
+
+  blockStart.push_back(nrOfRows);
+
+  const long long nrOfGroups = static_cast<long long>(blockStart.size()) - 1;
+
+  // Block index entries of all blocks from the first to the last selected block (plus one)
+  const unsigned long long firstBlock = rows[0] / blockSizeElements;
+  const unsigned long long lastBlock = rows[nrOfRows - 1] / blockSizeElements;
+  const unsigned long long nrOfBlocks = 1 + (size - 1) / blockSizeElements;
+
+  std::unique_ptr<unsigned long long[]> blockIndexP;
+  unsigned long long* blockIndex = nullptr;
+
+  if (isCompressed)
+  {
+    blockIndexP = std::unique_ptr<unsigned long long[]>(new unsigned long long[2 + lastBlock - firstBlock]);
+    blockIndex = blockIndexP.get();
+
+    ReadAt(myfile, positionalReader, reinterpret_cast<char*>(blockIndex), (2 + lastBlock - firstBlock) * 8,
+      blockPos + COL_META_SIZE + 8 * firstBlock);
+  }
+
+  // without a positional reader, all reads use the (single) stream
+  const int nrOfThreads = positionalReader == nullptr ? 1 :
+    static_cast<int>(max(1LL, min(static_cast<long long>(GetFstThreads()), nrOfGroups)));
+
+  // element range or decompressed block and compressed block buffers for each thread
+  const unsigned long long compressBound = isCompressed ? BlockCompressBound(blockSize) : 0;
+  std::unique_ptr<char[]> threadBufferP(new char[nrOfThreads * (blockSize + compressBound)]);
+  char* threadBuffer = threadBufferP.get();
+
+  Decompressor decompressor;
+  std::exception_ptr firstError;  // rethrown after the parallel region
+
+#pragma omp parallel for num_threads(nrOfThreads) schedule(dynamic, 1)
+  for (long long group = 0; group < nrOfGroups; ++group)
+  {
+    try
+    {
+      const unsigned long long* groupRows = &rows[blockStart[group]];
+      const unsigned long long groupLength = blockStart[group + 1] - blockStart[group];
+      char* groupOut = &outVec[blockStart[group] * elementSize];
+
+      const unsigned long long firstRow = groupRows[0];
+      const unsigned long long rangeLength = groupRows[groupLength - 1] + 1 - firstRow;
+
+      char* tmpBuf = &threadBuffer[OMP_GET_THREAD_NUM * (blockSize + compressBound)];  // element range or decompressed block
+
+      if (!isCompressed)
+      {
+        if (compress[1] == 0)  // uncompressed data
+        {
+          ReadAt(myfile, positionalReader, tmpBuf, rangeLength * elementSize, blockPos + COL_META_SIZE + firstRow * elementSize);
+        }
+        else  // fixed-ratio compressor
+        {
+          fdsReadFixedCompStream_v2(myfile, tmpBuf, blockPos, compress, firstRow, elementSize, rangeLength, positionalReader);
+        }
+
+        ScatterElements(groupOut, tmpBuf, groupRows, groupLength, firstRow, elementSize);
+        continue;
+      }
+
+      const unsigned long long block = firstRow / blockSizeElements;
+      const unsigned long long blockFirstRow = block * blockSizeElements;
+
+      const unsigned long long blockPStart = blockIndex[block - firstBlock];
+      const unsigned long long blockPEnd = blockIndex[1 + block - firstBlock];
+      const unsigned short algo = static_cast<unsigned short>((blockPStart >> 48) & 0xffff);
+      const unsigned long long blockPosStart = blockPStart & BLOCK_POS_MASK;
+      const unsigned long long compSize = (blockPEnd & BLOCK_POS_MASK) - blockPosStart;
+
+      if (algo == 0)  // no compression on this block, only read the selected range
+      {
+        ReadAt(myfile, positionalReader, tmpBuf, rangeLength * elementSize,
+          blockPos + blockPosStart + elementSize * (firstRow - blockFirstRow));
+
+        ScatterElements(groupOut, tmpBuf, groupRows, groupLength, firstRow, elementSize);
+        continue;
+      }
+
+      // last block can have less elements
+      const unsigned long long curSize = block == nrOfBlocks - 1 ? size - blockFirstRow : blockSizeElements;
+
+      char* compBuf = &tmpBuf[blockSize];
+      ReadAt(myfile, positionalReader, compBuf, compSize, blockPos + blockPosStart);
+      decompressor.Decompress(algo, tmpBuf, elementSize * curSize, compBuf, compSize);
+
+      ScatterElements(groupOut, tmpBuf, groupRows, groupLength, blockFirstRow, elementSize);
+    }
+    catch (...)
+    {
+#pragma omp critical
+      {
+        if (!firstError) firstError = std::current_exception();
+      }
+    }
+  }
+
+  if (firstError) std::rethrow_exception(firstError);
+}
+
+bool fdsReadBlockIndex_v2(istream& myfile, unsigned long long blockPos, unsigned long long size, int elementSize,
+  vector<unsigned long long>& blockIndex, unsigned long long& blockSizeElems, unsigned long long& dataPos,
+  const IFstSource* positionalReader)
+{
+  std::string annotation;
+  bool hasAnnotation;
+  const unsigned int annotationLength = ReadColumnAnnotation(myfile, positionalReader, blockPos, annotation, hasAnnotation);
+
+  if (size == 0) return false;
+
+  dataPos = blockPos + 4 + annotationLength;
+
+  unsigned int compress[2];
+  ReadAt(myfile, positionalReader, reinterpret_cast<char*>(compress), COL_META_SIZE, dataPos);
+
+  // uncompressed data or a fixed-ratio compressor
+  if (compress[0] == 0) return false;
+
+  blockSizeElems = compress[1];
+
+  // the block size is recorded by the writer (see FstStore::SetBlockSize)
+  if (blockSizeElems == 0 || blockSizeElems * elementSize > MAX_BLOCK_SIZE)
+  {
+    throw(runtime_error(FSTERROR_READ_FAILED));
+  }
+
+  const unsigned long long nrOfBlocks = 1 + (size - 1) / blockSizeElems;
+
+  blockIndex.resize(nrOfBlocks + 1);
+  ReadAt(myfile, positionalReader, reinterpret_cast<char*>(blockIndex.data()), (nrOfBlocks + 1) * 8,
+    dataPos + COL_META_SIZE);
+
+  return true;
+}
+
+
+const ColumnMeta_v2& ColumnMetaCache::Column(istream& myfile, unsigned long long blockPos, unsigned long long size,
+  int elementSize, const IFstSource* positionalReader)
+{
+  {
+    std::lock_guard<std::mutex> lock(cacheLock);
+
+    const auto column = columns.find(blockPos);
+    if (column != columns.end()) return *column->second;
+  }
+
+  // read outside the lock, concurrent reads of the same column keep the first result
+  std::unique_ptr<ColumnMeta_v2> meta(new ColumnMeta_v2());
+  const unsigned int annotationLength = ReadColumnAnnotation(myfile, positionalReader, blockPos, meta->annotation,
+    meta->hasAnnotation);
+
+  meta->dataPos = blockPos + 4 + annotationLength;
+
+  if (size > 0)
+  {
+    ReadAt(myfile, positionalReader, reinterpret_cast<char*>(meta->compress), COL_META_SIZE, meta->dataPos);
+
+    // uncompressed data and fixed-ratio compressors have no block index
+    if (meta->compress[0] != 0)
+    {
+      const unsigned long long blockSizeElems = meta->compress[1];
+
+      if (blockSizeElems == 0 || blockSizeElems * elementSize > MAX_BLOCK_SIZE)
+      {
+        throw(runtime_error(FSTERROR_READ_FAILED));
+      }
+
+      const unsigned long long nrOfBlocks = 1 + (size - 1) / blockSizeElems;
+
+      meta->blockIndex.resize(nrOfBlocks + 1);
+      ReadAt(myfile, positionalReader, reinterpret_cast<char*>(meta->blockIndex.data()), (nrOfBlocks + 1) * 8,
+        meta->dataPos + COL_META_SIZE);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(cacheLock);
+
+  return *columns.emplace(blockPos, std::move(meta)).first->second;
+}
+
+
+void ColumnMetaCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(cacheLock);
+
+  columns.clear();
+}
+
+
+unsigned long long fdsReadCompressedBlock_v2(istream& myfile, const vector<unsigned long long>& blockIndex,
+  unsigned long long dataPos, unsigned long long block, vector<char>& compBuf, const IFstSource* positionalReader)
+{
+  const unsigned long long blockPosStart = blockIndex[block] & BLOCK_POS_MASK;
+  const unsigned long long blockPosEnd = blockIndex[block + 1] & BLOCK_POS_MASK;
+
+  if (blockPosEnd < blockPosStart)
+  {
+    throw(runtime_error(FSTERROR_READ_FAILED));
+  }
+
+  const unsigned long long compSize = blockPosEnd - blockPosStart;
+
+  if (compBuf.size() < compSize) compBuf.resize(compSize);
+  ReadAt(myfile, positionalReader, compBuf.data(), compSize, dataPos + blockPosStart);
+
+  return compSize;
+}
+
+
+char* fdsColumnView_v2(char* fileData, unsigned long long fileSize, unsigned long long blockPos, unsigned long long startRow,
+  unsigned long long length, int elementSize, std::string& annotation, bool& hasAnnotation)
+{
+  if (blockPos + 4 > fileSize) return nullptr;
+
+  unsigned int annotationLength;
+  memcpy(&annotationLength, &fileData[blockPos], 4);
+
+  const bool columnHasAnnotation = (annotationLength & (1 << 31)) != 0;
+  annotationLength = annotationLength & 0x7fffffff;  // highest bit is toogle bit for availability
+
+  const unsigned long long metaPos = blockPos + 4 + annotationLength;
+  if (metaPos + COL_META_SIZE > fileSize) return nullptr;
+
+  unsigned int compress[2];
+  memcpy(compress, &fileData[metaPos], COL_META_SIZE);
+
+  // only uncompressed data can be used without a copy
+  if (compress[0] != 0 || compress[1] != 0) return nullptr;
+
+  const unsigned long long dataPos = metaPos + COL_META_SIZE + startRow * elementSize;
+  if (dataPos + length * elementSize > fileSize) return nullptr;
+
+  char* view = &fileData[dataPos];
+
+  // element pointers must be aligned, the mapping itself is page aligned
+  if (reinterpret_cast<uintptr_t>(view) % elementSize != 0) return nullptr;
+
+  hasAnnotation = columnHasAnnotation;
+
+  if (hasAnnotation)
+  {
+    annotation += std::string(&fileData[blockPos + 4], annotationLength);
+  }
+
+  return view;
+}
+
+
+unsigned int fdsUncompressedPadding_v2(unsigned long long columnPos, unsigned long long annotationLength, int alignment)
+{
+  const unsigned long long dataPos = columnPos + 4 + annotationLength + COL_META_SIZE;
+
+  return static_cast<unsigned int>((alignment - dataPos % alignment) % alignment);
+}
@@ -19,21 +19,105 @@
 #define BLOCKSTORE_H
 
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <compression/compressor.h>
+#include <blockstreamer/positionalreader.h>
+#include <statistics/columnstatistics.h>
 
-// Method for writing column data of any type to a ofstream.
-void fdsStreamUncompressed_v2(std::ofstream& myfile, char* vec, unsigned long long vecLength, int elementSize, int blockSizeElems,
-                              FixedRatioCompressor* fixedRatioCompressor, std::string annotation, bool hasAnnotation);
+// Method for writing column data of any type to an output stream. If column statistics are given, the statistics of
+// each block are calculated while the block is copied or compressed.
+void fdsStreamUncompressed_v2(std::ostream& myfile, char* vec, unsigned long long vecLength, int elementSize, int blockSizeElems,
+                              FixedRatioCompressor* fixedRatioCompressor, std::string annotation, bool hasAnnotation,
+                              ColumnStatistics* columnStatistics = nullptr);
 
 
-// Method for writing column data of any type to a stream.
-void fdsStreamcompressed_v2(std::ofstream& myfile, char* colVec, unsigned long long nrOfRows, int elementSize,
-                            StreamCompressor* streamCompressor, int blockSizeElems, std::string annotation, bool hasAnnotation);
+// Method for writing column data of any type to a stream. If column statistics are given, the statistics of
+// each block are calculated by the thread that compresses the block.
+void fdsStreamcompressed_v2(std::ostream& myfile, char* colVec, unsigned long long nrOfRows, int elementSize,
+                            StreamCompressor* streamCompressor, int blockSizeElems, std::string annotation, bool hasAnnotation,
+                            ColumnStatistics* columnStatistics = nullptr);
 
 
+// Annotation, header and block index of a column, as read by fdsReadColumn_v2.
+struct ColumnMeta_v2
+{
+  std::string annotation;
+  bool hasAnnotation = false;
+  unsigned long long dataPos = 0;              // position of the column header (behind the annotation)
+  unsigned int compress[2] = { 0, 0 };         // column header
+  std::vector<unsigned long long> blockIndex;  // complete block index of a compressed column, empty otherwise
+};
+
+
+// Metadata of the columns that were read before, for readers that read many row ranges of the same columns (see
+// FstBatchReader). The metadata of a column is read once, on first use. Can be used by multiple threads.
+class ColumnMetaCache
+{
+  std::mutex cacheLock;
+  std::unordered_map<unsigned long long, std::unique_ptr<ColumnMeta_v2>> columns;  // keyed on column position
+
+public:
+  // Metadata of the column at 'blockPos' with 'size' elements of 'elementSize' bytes.
+  const ColumnMeta_v2& Column(std::istream& myfile, unsigned long long blockPos, unsigned long long size, int elementSize,
+                              const IFstSource* positionalReader);
+
+  void Clear();
+};
+
+
+// Method for reading column data of any type. When a positional reader is given, all data is read through that reader
+// and threads fetch their compressed batches concurrently, otherwise batches are read sequentially from the stream.
+// With a metadata cache, the column header and block index are taken from (or added to) the cache.
 void fdsReadColumn_v2(std::istream& myfile, char* outVec, unsigned long long blockPos, unsigned long long startRow, unsigned long long length,
-                      unsigned long long size, int elementSize, std::string& annotation, int maxbatchSize, bool& hasAnnotation);
+                      unsigned long long size, int elementSize, std::string& annotation, int maxbatchSize, bool& hasAnnotation,
+                      const IFstSource* positionalReader = nullptr, ColumnMetaCache* metaCache = nullptr);
+
+
+// Method for reading a selection of rows of column data of any type. Parameter 'rows' contains 'nrOfRows' sorted (zero based)
+// row numbers, element 'pos' of 'outVec' receives the value of row 'rows[pos]'. Only blocks that contain selected rows are
+// decompressed. With a positional reader, blocks are read and decompressed in parallel.
+void fdsGatherColumn_v2(std::istream& myfile, char* outVec, unsigned long long blockPos, const unsigned long long* rows,
+                        unsigned long long nrOfRows, unsigned long long size, int elementSize, std::string& annotation,
+                        bool& hasAnnotation, const IFstSource* positionalReader = nullptr);
+
+
+// Read the block index of a compressed column: an entry for each block plus an end entry, with the algorithm of the
+// block in the upper 16 bits and its position (relative to 'dataPos') in the lower 48 bits. Returns false when the
+// column is uncompressed or uses a fixed-ratio compressor, such columns have no block index.
+bool fdsReadBlockIndex_v2(std::istream& myfile, unsigned long long blockPos, unsigned long long size, int elementSize,
+                          std::vector<unsigned long long>& blockIndex, unsigned long long& blockSizeElems,
+                          unsigned long long& dataPos, const IFstSource* positionalReader = nullptr);
+
+
+// Algorithm of a block in a block index read with fdsReadBlockIndex_v2.
+inline unsigned short fdsBlockAlgorithm_v2(const std::vector<unsigned long long>& blockIndex, unsigned long long block)
+{
+  return static_cast<unsigned short>(blockIndex[block] >> 48);
+}
+
+
+// Read the compressed data of a single block into 'compBuf' and return its size in bytes. Parameters 'blockIndex' and
+// 'dataPos' are the result of fdsReadBlockIndex_v2.
+unsigned long long fdsReadCompressedBlock_v2(std::istream& myfile, const std::vector<unsigned long long>& blockIndex,
+                                             unsigned long long dataPos, unsigned long long block,
+                                             std::vector<char>& compBuf, const IFstSource* positionalReader = nullptr);
+
+
+// Locate the data of an uncompressed column in a memory-mapped file. Returns a pointer to element 'startRow' or nullptr
+// when the column data is compressed or the element pointer would be misaligned, the column should be read normally then.
+// The annotation is only set when a pointer is returned.
+char* fdsColumnView_v2(char* fileData, unsigned long long fileSize, unsigned long long blockPos, unsigned long long startRow,
+                       unsigned long long length, int elementSize, std::string& annotation, bool& hasAnnotation);
+
+
+// Number of padding bytes required before an uncompressed column starting at 'columnPos' to align its data
+// to a multiple of 'alignment' bytes in the file.
+unsigned int fdsUncompressedPadding_v2(unsigned long long columnPos, unsigned long long annotationLength, int alignment);
 
 
 #endif // BLOCKSTORE_H
@@ -0,0 +1,101 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+#include "memorymappedfile.h"
+
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string &fileName)
+{
+  HANDLE fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (fileHandle == INVALID_HANDLE_VALUE) return;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+  {
+    CloseHandle(fileHandle);
+    return;
+  }
+
+  // copy-on-write mapping, the view (not the handles) keeps the mapping alive
+  HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(fileHandle);
+
+  if (mappingHandle == nullptr) return;
+
+  void* view = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+  CloseHandle(mappingHandle);
+
+  if (view == nullptr) return;
+
+  data = static_cast<char*>(view);
+  size = static_cast<unsigned long long>(fileSize.QuadPart);
+}
+
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+  if (data != nullptr) UnmapViewOfFile(data);
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string &fileName)
+{
+  int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+
+  if (fileDescriptor < 0) return;
+
+  struct stat fileStat;
+  if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+  {
+    close(fileDescriptor);
+    return;
+  }
+
+  // private mapping: writes to the mapped pages are copy-on-write and never reach the file
+  void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+  close(fileDescriptor);  // the mapping remains valid
+
+  if (view == MAP_FAILED) return;
+
+  data = static_cast<char*>(view);
+  size = static_cast<unsigned long long>(fileStat.st_size);
+}
+
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+  if (data != nullptr) munmap(data, static_cast<size_t>(size));
+}
+
+#endif
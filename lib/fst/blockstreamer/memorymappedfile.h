@@ -0,0 +1,64 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef MEMORY_MAPPED_FILE_H
+#define MEMORY_MAPPED_FILE_H
+
+#include <string>
+
+
+/**
+ * \brief Copy-on-write memory mapping of a complete file. Pages are shared with the page cache (and other
+ * processes mapping the same file) until they are modified, modifications are never written back to the file.
+ * The mapping is released when the object is destroyed, so column views into the mapping should hold a
+ * (shared) reference to it.
+ */
+class MemoryMappedFile
+{
+  char* data = nullptr;
+  unsigned long long size = 0;
+
+public:
+  /**
+   * \brief Map a file into memory.
+   * \param fileName path of the file to map. Use IsOpen() to check for success.
+   */
+  explicit MemoryMappedFile(const std::string &fileName);
+
+  ~MemoryMappedFile();
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  /**
+   * \brief Check if the file was mapped successfully.
+   */
+  bool IsOpen() const { return data != nullptr; }
+
+  /**
+   * \brief Start of the mapped file.
+   */
+  char* Data() const { return data; }
+
+  /**
+   * \brief Size of the mapped file in bytes.
+   */
+  unsigned long long Size() const { return size; }
+};
+
+
+#endif  // MEMORY_MAPPED_FILE_H
@@ -0,0 +1,94 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <cstring>
+#include <algorithm>
+
+#include "memorystream.h"
+
+
+using namespace std;
+
+
+bool MemorySource::Read(char* buf, unsigned long long size, unsigned long long pos) const
+{
+  if (pos > image->Size() || size > image->Size() - pos) return false;
+
+  memcpy(buf, image->Data() + pos, size);
+
+  return true;
+}
+
+
+MemorySink::MemorySink(std::shared_ptr<FstMemoryImage> image, const bool truncate) : image(std::move(image))
+{
+  if (this->image && truncate) this->image->Buffer().clear();
+}
+
+
+MemorySink::int_type MemorySink::overflow(int_type c)
+{
+  if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+
+  const char value = traits_type::to_char_type(c);
+  xsputn(&value, 1);
+
+  return c;
+}
+
+
+std::streamsize MemorySink::xsputn(const char* s, std::streamsize n)
+{
+  if (n <= 0) return 0;  // empty writes can have a null source
+
+  vector<char> &buffer = image->Buffer();
+  const unsigned long long end = pos + static_cast<unsigned long long>(n);
+
+  // grow geometrically, data can be written beyond the current end (gaps are zero filled)
+  if (end > buffer.size())
+  {
+    if (end > buffer.capacity()) buffer.reserve(max(end, 2 * static_cast<unsigned long long>(buffer.capacity())));
+    buffer.resize(end);
+  }
+
+  memcpy(&buffer[pos], s, static_cast<size_t>(n));
+  pos = end;
+
+  return n;
+}
+
+
+MemorySink::pos_type MemorySink::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+  if ((which & std::ios_base::out) == 0) return pos_type(off_type(-1));
+
+  long long newPos = off;
+  if (dir == std::ios_base::cur) newPos += static_cast<long long>(pos);
+  if (dir == std::ios_base::end) newPos += static_cast<long long>(image->Size());
+
+  if (newPos < 0) return pos_type(off_type(-1));
+
+  pos = static_cast<unsigned long long>(newPos);
+
+  return pos_type(static_cast<off_type>(pos));
+}
+
+
+MemorySink::pos_type MemorySink::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+  return seekoff(off_type(pos), std::ios_base::beg, which);
+}
@@ -0,0 +1,80 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef MEMORY_STREAM_H
+#define MEMORY_STREAM_H
+
+#include <memory>
+#include <streambuf>
+
+#include <interface/ifstsource.h>
+#include <interface/ifstsink.h>
+#include <interface/fstmemoryimage.h>
+
+
+/**
+ * \brief Memory implementation of IFstSource, reads are copies from the memory image.
+ */
+class MemorySource : public IFstSource
+{
+  std::shared_ptr<FstMemoryImage> image;
+
+public:
+  explicit MemorySource(std::shared_ptr<FstMemoryImage> image) : image(std::move(image)) { }
+
+  bool IsOpen() const override { return image != nullptr; }
+
+  unsigned long long Size() const override { return image->Size(); }
+
+  bool Read(char* buf, unsigned long long size, unsigned long long pos) const override;
+};
+
+
+/**
+ * \brief Memory implementation of IFstSink. Written data is stored in the memory image, which grows as needed.
+ */
+class MemorySink : public std::streambuf, public IFstSink
+{
+  std::shared_ptr<FstMemoryImage> image;
+  unsigned long long pos = 0;  // current write position
+
+protected:
+  int_type overflow(int_type c) override;
+
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+public:
+  /**
+   * \brief Open a memory image for writing.
+   * \param image memory image to write to.
+   * \param truncate if true, the existing content of the image is discarded.
+   */
+  MemorySink(std::shared_ptr<FstMemoryImage> image, bool truncate);
+
+  bool IsOpen() const override { return image != nullptr; }
+
+  std::streambuf* StreamBuffer() override { return this; }
+
+  bool Close() override { return true; }
+};
+
+
+#endif  // MEMORY_STREAM_H
@@ -0,0 +1,321 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <cerrno>
+#endif
+
+#include <interface/fstdefines.h>
+
+#include "pipelinedwriter.h"
+
+
+using namespace std;
+
+
+// maximum number of bytes written in a single system call
+#define MAX_WRITE_REQUEST 1073741824
+
+
+#ifdef _WIN32
+
+PipelinedWriter::PipelinedWriter(const std::string &fileName, bool truncate)
+{
+  fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+    truncate ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (fileHandle == INVALID_HANDLE_VALUE) return;
+
+  LARGE_INTEGER fileSize;
+  if (!truncate && GetFileSizeEx(fileHandle, &fileSize))
+  {
+    fileEnd = static_cast<unsigned long long>(fileSize.QuadPart);
+  }
+
+  buffer = std::unique_ptr<char[]>(new char[WRITE_BUFFER_SIZE]);
+  setp(buffer.get(), buffer.get() + WRITE_BUFFER_SIZE);
+
+  writerThread = std::thread(&PipelinedWriter::WriterLoop, this);
+}
+
+
+bool PipelinedWriter::IsOpen() const
+{
+  return fileHandle != INVALID_HANDLE_VALUE;
+}
+
+
+bool PipelinedWriter::WriteAt(const char* data, unsigned long long size, unsigned long long pos) const
+{
+  while (size > 0)
+  {
+    DWORD request = static_cast<DWORD>(size < MAX_WRITE_REQUEST ? size : MAX_WRITE_REQUEST);
+    DWORD nrOfBytesWritten = 0;
+
+    // the offset is specified per call, the file pointer of the handle is not used
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(pos & 0xffffffff);
+    overlapped.OffsetHigh = static_cast<DWORD>(pos >> 32);
+
+    if (!WriteFile(fileHandle, data, request, &nrOfBytesWritten, &overlapped) || nrOfBytesWritten == 0) return false;
+
+    data += nrOfBytesWritten;
+    pos += nrOfBytesWritten;
+    size -= nrOfBytesWritten;
+  }
+
+  return true;
+}
+
+#else
+
+PipelinedWriter::PipelinedWriter(const std::string &fileName, bool truncate)
+{
+  fileDescriptor = open(fileName.c_str(), truncate ? (O_WRONLY | O_CREAT | O_TRUNC) : O_WRONLY, 0666);
+
+  if (fileDescriptor < 0) return;
+
+  if (!truncate)
+  {
+    off_t fileSize = lseek(fileDescriptor, 0, SEEK_END);
+    if (fileSize > 0) fileEnd = static_cast<unsigned long long>(fileSize);
+  }
+
+  buffer = std::unique_ptr<char[]>(new char[WRITE_BUFFER_SIZE]);
+  setp(buffer.get(), buffer.get() + WRITE_BUFFER_SIZE);
+
+  writerThread = std::thread(&PipelinedWriter::WriterLoop, this);
+}
+
+
+bool PipelinedWriter::IsOpen() const
+{
+  return fileDescriptor >= 0;
+}
+
+
+bool PipelinedWriter::WriteAt(const char* data, unsigned long long size, unsigned long long pos) const
+{
+  while (size > 0)
+  {
+    size_t request = static_cast<size_t>(size < MAX_WRITE_REQUEST ? size : MAX_WRITE_REQUEST);
+    ssize_t nrOfBytesWritten = pwrite(fileDescriptor, data, request, static_cast<off_t>(pos));
+
+    if (nrOfBytesWritten < 0)
+    {
+      if (errno == EINTR) continue;  // interrupted before any data was written
+      return false;
+    }
+
+    if (nrOfBytesWritten == 0) return false;
+
+    data += nrOfBytesWritten;
+    pos += nrOfBytesWritten;
+    size -= nrOfBytesWritten;
+  }
+
+  return true;
+}
+
+#endif
+
+
+PipelinedWriter::~PipelinedWriter()
+{
+  Close();
+}
+
+
+bool PipelinedWriter::Close()
+{
+  if (!writerThread.joinable()) return !writeError;
+
+  FlushBuffer();
+
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    closing = true;
+  }
+
+  queueChanged.notify_all();
+  writerThread.join();
+
+#ifdef _WIN32
+  CloseHandle(fileHandle);
+  fileHandle = INVALID_HANDLE_VALUE;
+#else
+  if (close(fileDescriptor) != 0) writeError = true;
+  fileDescriptor = -1;
+#endif
+
+  return !writeError;
+}
+
+
+void PipelinedWriter::WriterLoop()
+{
+  std::unique_lock<std::mutex> lock(queueMutex);
+
+  while (true)
+  {
+    queueChanged.wait(lock, [this] { return closing || !queue.empty(); });
+
+    // all data was written
+    if (queue.empty()) return;
+
+    WriteJob job = std::move(queue.front());
+    queue.pop_front();
+
+    // after an error, remaining data is discarded
+    const bool skip = writeError;
+
+    lock.unlock();
+    const bool success = skip || WriteAt(job.data.get(), job.size, job.pos);
+    job.data.reset();  // release the written buffer outside the lock
+    lock.lock();
+
+    if (!success) writeError = true;
+
+    queuedBytes -= job.size;
+    queueChanged.notify_all();
+  }
+}
+
+
+void PipelinedWriter::Enqueue(std::unique_ptr<char[]> data, unsigned long long size, unsigned long long pos)
+{
+  {
+    std::unique_lock<std::mutex> lock(queueMutex);
+
+    // wait for room in the queue, a single job is always accepted
+    queueChanged.wait(lock, [this, size] { return queuedBytes == 0 || queuedBytes + size <= WRITE_QUEUE_SIZE || writeError; });
+
+    queue.push_back(WriteJob { std::move(data), size, pos });
+    queuedBytes += size;
+  }
+
+  queueChanged.notify_all();
+
+  bufferPos = pos + size;
+  fileEnd = std::max(fileEnd, bufferPos);
+}
+
+
+bool PipelinedWriter::FlushBuffer()
+{
+  const unsigned long long size = static_cast<unsigned long long>(pptr() - pbase());
+
+  if (size > 0)
+  {
+    // the filled buffer is handed to the writer thread
+    std::unique_ptr<char[]> data = std::move(buffer);
+    buffer = std::unique_ptr<char[]>(new char[WRITE_BUFFER_SIZE]);
+    setp(buffer.get(), buffer.get() + WRITE_BUFFER_SIZE);
+
+    Enqueue(std::move(data), size, bufferPos);
+  }
+
+  std::lock_guard<std::mutex> lock(queueMutex);
+  return !writeError;
+}
+
+
+PipelinedWriter::int_type PipelinedWriter::overflow(int_type c)
+{
+  if (!FlushBuffer()) return traits_type::eof();
+
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+
+  return traits_type::not_eof(c);
+}
+
+
+std::streamsize PipelinedWriter::xsputn(const char* s, std::streamsize n)
+{
+  if (n <= 0) return 0;  // empty writes can have a null source
+
+  if (n <= epptr() - pptr())
+  {
+    memcpy(pptr(), s, static_cast<size_t>(n));
+    pbump(static_cast<int>(n));
+    return n;
+  }
+
+  if (!FlushBuffer()) return 0;
+
+  if (n < WRITE_BUFFER_SIZE)
+  {
+    memcpy(pptr(), s, static_cast<size_t>(n));
+    pbump(static_cast<int>(n));
+    return n;
+  }
+
+  // large writes are queued directly
+  std::unique_ptr<char[]> data(new char[static_cast<size_t>(n)]);
+  memcpy(data.get(), s, static_cast<size_t>(n));
+  Enqueue(std::move(data), static_cast<unsigned long long>(n), bufferPos);
+
+  return n;
+}
+
+
+int PipelinedWriter::sync()
+{
+  return FlushBuffer() ? 0 : -1;
+}
+
+
+PipelinedWriter::pos_type PipelinedWriter::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+  if ((which & std::ios_base::out) == 0) return pos_type(off_type(-1));
+
+  // current position (tellp) doesn't require a flush
+  if (dir == std::ios_base::cur && off == 0)
+  {
+    return pos_type(static_cast<off_type>(bufferPos + (pptr() - pbase())));
+  }
+
+  if (!FlushBuffer()) return pos_type(off_type(-1));
+
+  unsigned long long newPos = static_cast<unsigned long long>(off);
+  if (dir == std::ios_base::cur) newPos = bufferPos + off;
+  if (dir == std::ios_base::end) newPos = fileEnd + off;
+
+  bufferPos = newPos;
+
+  return pos_type(static_cast<off_type>(newPos));
+}
+
+
+PipelinedWriter::pos_type PipelinedWriter::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+  return seekoff(off_type(pos), std::ios_base::beg, which);
+}
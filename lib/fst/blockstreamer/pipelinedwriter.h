@@ -0,0 +1,119 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef PIPELINED_WRITER_H
+#define PIPELINED_WRITER_H
+
+#include <streambuf>
+#include <string>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <interface/ifstsink.h>
+
+
+/**
+ * \brief Stream buffer that hands all written data to a dedicated writer thread. Data is collected in buffers of
+ * WRITE_BUFFER_SIZE bytes that are queued together with their file position, so compression of the next data can
+ * proceed while earlier data is written to disk. At most WRITE_QUEUE_SIZE bytes are queued, the producer waits if
+ * the queue is full.
+ *
+ * Seeking is supported for patching previously written data (such as a block index), the patch is queued like any
+ * other write. This is the file implementation of IFstSink, use with a std::ostream:
+ *
+ *   PipelinedWriter writer(fileName, true);
+ *   std::ostream myfile(&writer);
+ */
+class PipelinedWriter : public std::streambuf, public IFstSink
+{
+  struct WriteJob
+  {
+    std::unique_ptr<char[]> data;
+    unsigned long long size;
+    unsigned long long pos;
+  };
+
+#ifdef _WIN32
+  void* fileHandle;
+#else
+  int fileDescriptor;
+#endif
+
+  std::unique_ptr<char[]> buffer;  // active buffer
+  unsigned long long bufferPos = 0;  // file position of the start of the active buffer
+  unsigned long long fileEnd = 0;  // end of the file including queued data
+
+  std::deque<WriteJob> queue;
+  unsigned long long queuedBytes = 0;
+  bool closing = false;
+  bool writeError = false;
+
+  std::mutex queueMutex;
+  std::condition_variable queueChanged;
+  std::thread writerThread;
+
+  void Enqueue(std::unique_ptr<char[]> data, unsigned long long size, unsigned long long pos);
+
+  bool FlushBuffer();
+
+  bool WriteAt(const char* data, unsigned long long size, unsigned long long pos) const;
+
+  void WriterLoop();
+
+protected:
+  int_type overflow(int_type c) override;
+
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+  int sync() override;
+
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+public:
+  /**
+   * \brief Open a file for pipelined writing.
+   * \param fileName path of the file to write. Use IsOpen() to check for success.
+   * \param truncate if true, the file is created or truncated. Otherwise the existing file is opened for update.
+   */
+  PipelinedWriter(const std::string &fileName, bool truncate);
+
+  ~PipelinedWriter();
+
+  PipelinedWriter(const PipelinedWriter&) = delete;
+  PipelinedWriter& operator=(const PipelinedWriter&) = delete;
+
+  /**
+   * \brief Check if the file was opened successfully.
+   */
+  bool IsOpen() const override;
+
+  std::streambuf* StreamBuffer() override { return this; }
+
+  /**
+   * \brief Write all queued data, stop the writer thread and close the file.
+   * \return false if any of the write operations failed.
+   */
+  bool Close() override;
+};
+
+
+#endif  // PIPELINED_WRITER_H
@@ -0,0 +1,186 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <stdexcept>
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/stat.h>
+  #include <cerrno>
+#endif
+
+#include <interface/fstdefines.h>
+
+#include "positionalreader.h"
+
+
+using namespace std;
+
+
+// maximum number of bytes requested in a single system call
+#define MAX_READ_REQUEST 1073741824
+
+
+#ifdef _WIN32
+
+PositionalReader::PositionalReader(const std::string &fileName)
+{
+  // reads on a synchronous handle are serialized, an overlapped handle allows concurrent reads from all threads
+  fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+}
+
+
+PositionalReader::~PositionalReader()
+{
+  if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+}
+
+
+bool PositionalReader::IsOpen() const
+{
+  return fileHandle != INVALID_HANDLE_VALUE;
+}
+
+
+unsigned long long PositionalReader::Size() const
+{
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(fileHandle, &fileSize)) return 0;
+
+  return static_cast<unsigned long long>(fileSize.QuadPart);
+}
+
+
+bool PositionalReader::Read(char* buf, unsigned long long size, unsigned long long pos) const
+{
+  // each call waits on its own event, so a thread is only signaled for the completion of its own reads
+  HANDLE readEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+  if (readEvent == nullptr) return false;
+
+  bool success = true;
+
+  while (size > 0)
+  {
+    DWORD request = static_cast<DWORD>(size < MAX_READ_REQUEST ? size : MAX_READ_REQUEST);
+    DWORD nrOfBytesRead = 0;
+
+    // the offset is specified per call, the file pointer of the handle is not used
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(pos & 0xffffffff);
+    overlapped.OffsetHigh = static_cast<DWORD>(pos >> 32);
+    overlapped.hEvent = readEvent;
+
+    if (!ReadFile(fileHandle, buf, request, nullptr, &overlapped) && GetLastError() != ERROR_IO_PENDING)
+    {
+      success = false;
+      break;
+    }
+
+    // wait for completion, reads beyond the end of the file fail with ERROR_HANDLE_EOF
+    if (!GetOverlappedResult(fileHandle, &overlapped, &nrOfBytesRead, TRUE) || nrOfBytesRead == 0)
+    {
+      success = false;
+      break;
+    }
+
+    buf += nrOfBytesRead;
+    pos += nrOfBytesRead;
+    size -= nrOfBytesRead;
+  }
+
+  CloseHandle(readEvent);
+
+  return success;
+}
+
+#else
+
+PositionalReader::PositionalReader(const std::string &fileName)
+{
+  fileDescriptor = open(fileName.c_str(), O_RDONLY);
+}
+
+
+PositionalReader::~PositionalReader()
+{
+  if (fileDescriptor >= 0) close(fileDescriptor);
+}
+
+
+bool PositionalReader::IsOpen() const
+{
+  return fileDescriptor >= 0;
+}
+
+
+unsigned long long PositionalReader::Size() const
+{
+  struct stat fileStat;
+  if (fstat(fileDescriptor, &fileStat) != 0) return 0;
+
+  return static_cast<unsigned long long>(fileStat.st_size);
+}
+
+
+bool PositionalReader::Read(char* buf, unsigned long long size, unsigned long long pos) const
+{
+  while (size > 0)
+  {
+    size_t request = static_cast<size_t>(size < MAX_READ_REQUEST ? size : MAX_READ_REQUEST);
+    ssize_t nrOfBytesRead = pread(fileDescriptor, buf, request, static_cast<off_t>(pos));
+
+    if (nrOfBytesRead < 0)
+    {
+      if (errno == EINTR) continue;  // interrupted before any data was read
+      return false;
+    }
+
+    if (nrOfBytesRead == 0) return false;  // unexpected end of file
+
+    buf += nrOfBytesRead;
+    pos += nrOfBytesRead;
+    size -= nrOfBytesRead;
+  }
+
+  return true;
+}
+
+#endif
+
+
+void ReadAt(istream &myfile, const IFstSource* positionalReader, char* buf, unsigned long long size,
+  unsigned long long pos)
+{
+  if (positionalReader == nullptr)
+  {
+    myfile.seekg(pos);
+    myfile.read(buf, size);
+    return;
+  }
+
+  if (!positionalReader->Read(buf, size, pos))
+  {
+    throw(runtime_error(FSTERROR_READ_FAILED));
+  }
+}
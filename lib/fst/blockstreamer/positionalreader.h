@@ -0,0 +1,86 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef POSITIONAL_READER_H
+#define POSITIONAL_READER_H
+
+#include <istream>
+#include <string>
+
+#include <interface/ifstsource.h>
+
+
+/**
+ * \brief Read-only file handle that reads data at an absolute file offset. In contrast to a std::istream,
+ * the reader has no shared file position, so multiple threads can read from the same instance without locking
+ * (pread on POSIX systems and overlapped ReadFile calls on Windows). This is the file implementation of IFstSource.
+ */
+class PositionalReader : public IFstSource
+{
+#ifdef _WIN32
+  void* fileHandle;
+#else
+  int fileDescriptor;
+#endif
+
+public:
+  /**
+   * \brief Open a file for positional reading.
+   * \param fileName path of the file to open. Use IsOpen() to check for success.
+   */
+  explicit PositionalReader(const std::string &fileName);
+
+  ~PositionalReader();
+
+  PositionalReader(const PositionalReader&) = delete;
+  PositionalReader& operator=(const PositionalReader&) = delete;
+
+  /**
+   * \brief Check if the file was opened successfully.
+   */
+  bool IsOpen() const override;
+
+  /**
+   * \brief Size of the file in bytes.
+   */
+  unsigned long long Size() const override;
+
+  /**
+   * \brief Read a range of bytes from the file. This method is thread-safe.
+   * \param buf buffer to read the data into, must have room for at least 'size' bytes.
+   * \param size number of bytes to read.
+   * \param pos file offset of the first byte to read.
+   * \return true if all requested bytes were read, false otherwise.
+   */
+  bool Read(char* buf, unsigned long long size, unsigned long long pos) const override;
+};
+
+
+/**
+ * \brief Read a range of bytes from the source if available, or from the stream otherwise.
+ * Stream reads move the stream position, so they are not thread-safe.
+ * \param myfile stream used when no source is available.
+ * \param positionalReader source (such as a PositionalReader) or nullptr.
+ * \param buf buffer to read the data into.
+ * \param size number of bytes to read.
+ * \param pos file offset of the first byte to read.
+ */
+void ReadAt(std::istream &myfile, const IFstSource* positionalReader, char* buf, unsigned long long size,
+  unsigned long long pos);
+
+
+#endif  // POSITIONAL_READER_H
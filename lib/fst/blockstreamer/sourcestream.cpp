@@ -0,0 +1,131 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <cstring>
+#include <algorithm>
+
+#include <interface/fstdefines.h>
+
+#include "sourcestream.h"
+
+
+using namespace std;
+
+
+SourceStreamBuffer::SourceStreamBuffer(const IFstSource* source) : source(source)
+{
+}
+
+
+void SourceStreamBuffer::Allocate()
+{
+  if (buffer) return;
+
+  sourceSize = source->Size();
+  buffer = std::unique_ptr<char[]>(new char[SOURCE_BUFFER_SIZE]);
+  setg(buffer.get(), buffer.get(), buffer.get());
+}
+
+
+SourceStreamBuffer::int_type SourceStreamBuffer::underflow()
+{
+  if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+
+  Allocate();
+
+  const unsigned long long pos = bufferPos + (gptr() - eback());
+  if (pos >= sourceSize) return traits_type::eof();
+
+  const unsigned long long size = min(static_cast<unsigned long long>(SOURCE_BUFFER_SIZE), sourceSize - pos);
+  if (!source->Read(buffer.get(), size, pos)) return traits_type::eof();
+
+  bufferPos = pos;
+  setg(buffer.get(), buffer.get(), buffer.get() + size);
+
+  return traits_type::to_int_type(*gptr());
+}
+
+
+std::streamsize SourceStreamBuffer::xsgetn(char* s, std::streamsize n)
+{
+  Allocate();
+
+  // data available in the buffer
+  std::streamsize nrOfBytes = min(n, static_cast<std::streamsize>(egptr() - gptr()));
+  memcpy(s, gptr(), static_cast<size_t>(nrOfBytes));
+  gbump(static_cast<int>(nrOfBytes));
+
+  if (nrOfBytes == n) return n;
+
+  const unsigned long long pos = bufferPos + (gptr() - eback());
+  const std::streamsize remaining = n - nrOfBytes;
+
+  // large reads bypass the buffer
+  if (remaining >= SOURCE_BUFFER_SIZE)
+  {
+    const unsigned long long size = min(static_cast<unsigned long long>(remaining), sourceSize - min(pos, sourceSize));
+    if (size == 0 || !source->Read(s + nrOfBytes, size, pos)) return nrOfBytes;
+
+    bufferPos = pos + size;
+    setg(buffer.get(), buffer.get(), buffer.get());
+
+    return nrOfBytes + static_cast<std::streamsize>(size);
+  }
+
+  if (traits_type::eq_int_type(underflow(), traits_type::eof())) return nrOfBytes;
+
+  return nrOfBytes + xsgetn(s + nrOfBytes, remaining);
+}
+
+
+SourceStreamBuffer::pos_type SourceStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir,
+  std::ios_base::openmode which)
+{
+  if ((which & std::ios_base::in) == 0) return pos_type(off_type(-1));
+
+  Allocate();
+
+  long long newPos = off;
+  if (dir == std::ios_base::cur) newPos += static_cast<long long>(bufferPos + (gptr() - eback()));
+  if (dir == std::ios_base::end) newPos += static_cast<long long>(sourceSize);
+
+  if (newPos < 0) return pos_type(off_type(-1));
+
+  return seekpos(pos_type(static_cast<off_type>(newPos)), which);
+}
+
+
+SourceStreamBuffer::pos_type SourceStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+  if ((which & std::ios_base::in) == 0 || off_type(pos) < 0) return pos_type(off_type(-1));
+
+  Allocate();
+
+  const unsigned long long newPos = static_cast<unsigned long long>(off_type(pos));
+
+  // keep the buffer if the new position is within it
+  if (newPos >= bufferPos && newPos <= bufferPos + (egptr() - eback()))
+  {
+    setg(eback(), eback() + (newPos - bufferPos), egptr());
+    return pos;
+  }
+
+  bufferPos = newPos;
+  setg(buffer.get(), buffer.get(), buffer.get());
+
+  return pos;
+}
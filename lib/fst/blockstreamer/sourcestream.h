@@ -0,0 +1,71 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef SOURCE_STREAM_H
+#define SOURCE_STREAM_H
+
+#include <istream>
+#include <memory>
+#include <streambuf>
+
+#include <interface/ifstsource.h>
+
+
+/**
+ * \brief Buffered, seekable stream buffer that reads from an IFstSource. Used for sequential reads of metadata, such
+ * as the table header and column names, from any source. The buffer is allocated on the first read, so a stream
+ * that is only passed along with its (positional) source is cheap to create.
+ */
+class SourceStreamBuffer : public std::streambuf
+{
+  const IFstSource* source;
+  unsigned long long sourceSize = 0;
+  std::unique_ptr<char[]> buffer;    // allocated on first use, together with sourceSize
+  unsigned long long bufferPos = 0;  // source offset of the start of the buffer
+
+  void Allocate();
+
+protected:
+  int_type underflow() override;
+
+  std::streamsize xsgetn(char* s, std::streamsize n) override;
+
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+public:
+  explicit SourceStreamBuffer(const IFstSource* source);
+};
+
+
+/**
+ * \brief Input stream that reads from an IFstSource, the source should outlive the stream.
+ */
+class SourceStream : public std::istream
+{
+  SourceStreamBuffer streamBuffer;
+
+public:
+  explicit SourceStream(const IFstSource* source) : std::istream(nullptr), streamBuffer(source)
+  {
+    rdbuf(&streamBuffer);
+  }
+};
+
+
+#endif  // SOURCE_STREAM_H
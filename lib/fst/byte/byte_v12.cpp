@@ -24,11 +24,9 @@
 using namespace std;
 
 
-void fdsWriteByteVec_v12(ofstream& myfile, char* byteVector, unsigned long long nrOfRows, unsigned int compression,
-	std::string annotation, bool hasAnnotation)
+void fdsWriteByteVec_v12(ostream& myfile, char* byteVector, unsigned long long nrOfRows, unsigned int compression,
+	std::string annotation, bool hasAnnotation, unsigned int blockSize)
 {
-  int blockSize = BLOCKSIZE_BYTE; // block size in bytes
-
   if (compression == 0)
   {
     return fdsStreamUncompressed_v2(myfile, byteVector, nrOfRows, 1, BLOCKSIZE_BYTE, nullptr, annotation, hasAnnotation);
@@ -41,7 +39,7 @@ void fdsWriteByteVec_v12(ofstream& myfile, char* byteVector, unsigned long long
     StreamCompressor* streamCompressor = new StreamLinearCompressor(compress1, 2.0f * compression);
 
     streamCompressor->CompressBufferSize(blockSize);
-    fdsStreamcompressed_v2(myfile, byteVector, nrOfRows, 1, streamCompressor, BLOCKSIZE_BYTE, annotation, hasAnnotation);
+    fdsStreamcompressed_v2(myfile, byteVector, nrOfRows, 1, streamCompressor, blockSize, annotation, hasAnnotation);
 
     delete compress1;
     delete streamCompressor;
@@ -52,7 +50,7 @@ void fdsWriteByteVec_v12(ofstream& myfile, char* byteVector, unsigned long long
   Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD, 0);
   StreamCompressor* streamCompressor = new StreamCompositeCompressor(compress1, compress2, 2.0F * (compression - 50));
   streamCompressor->CompressBufferSize(blockSize);
-  fdsStreamcompressed_v2(myfile, byteVector, nrOfRows, 1, streamCompressor, BLOCKSIZE_BYTE, annotation, hasAnnotation);
+  fdsStreamcompressed_v2(myfile, byteVector, nrOfRows, 1, streamCompressor, blockSize, annotation, hasAnnotation);
 
   delete compress1;
   delete compress2;
@@ -63,10 +61,11 @@ void fdsWriteByteVec_v12(ofstream& myfile, char* byteVector, unsigned long long
 
 
 void fdsReadByteVec_v12(istream& myfile, char* byteVec, unsigned long long blockPos, unsigned long long startRow, unsigned long long length,
-                        unsigned long long size)
+                        unsigned long long size, const IFstSource* positionalReader, ColumnMetaCache* metaCache)
 {
   std::string annotation;
   bool hasAnnotation;
 
-  return fdsReadColumn_v2(myfile, byteVec, blockPos, startRow, length, size, 1, annotation, BATCH_SIZE_READ_BYTE, hasAnnotation);
+  return fdsReadColumn_v2(myfile, byteVec, blockPos, startRow, length, size, 1, annotation, BATCH_SIZE_READ_BYTE, hasAnnotation,
+    positionalReader, metaCache);
 }
@@ -21,10 +21,18 @@
 
 #include <fstream>
 
-void fdsWriteByteVec_v12(std::ofstream& myfile, char* byteVector, unsigned long long nrOfRows, unsigned int compression,
-                         std::string annotation, bool hasAnnotation);
+#include <interface/fstdefines.h>
+
+
+class IFstSource;
+class ColumnMetaCache;
+
+
+void fdsWriteByteVec_v12(std::ostream& myfile, char* byteVector, unsigned long long nrOfRows, unsigned int compression,
+                         std::string annotation, bool hasAnnotation, unsigned int blockSize = BLOCKSIZE);
 
 void fdsReadByteVec_v12(std::istream& myfile, char* byteVector, unsigned long long blockPos, unsigned long long startRow,
-                        unsigned long long length, unsigned long long size);
+                        unsigned long long length, unsigned long long size, const IFstSource* positionalReader = nullptr,
+                        ColumnMetaCache* metaCache = nullptr);
 
 #endif // BYTE_V12_H
@@ -42,7 +42,7 @@
 // #include <compression/compressor.h>
 
 
-inline uint64_t store_byte_block_v13(std::ofstream& fst_file, const char** elements, uint64_t* sizes, uint64_t length)
+inline uint64_t store_byte_block_v13(std::ostream& fst_file, const char** elements, uint64_t* sizes, uint64_t length)
 {
   // fits on the stack (8 * BLOCK_SIZE_BYTE_BLOCK) 
   //const std::unique_ptr<char*[]> elements(new char* [BLOCK_SIZE_BYTE_BLOCK]);  // array of pointer on the stack
@@ -85,7 +85,7 @@ inline uint64_t store_byte_block_v13(std::ofstream& fst_file, const char** eleme
  * \param nr_of_rows of the column vector
  * \param compression compression setting, value between 0 and 100
 */
-void fdsWriteByteBlockVec_v13(std::ofstream& fst_file, IByteBlockColumn* byte_block_writer,
+void fdsWriteByteBlockVec_v13(std::ostream& fst_file, IByteBlockColumn* byte_block_writer,
   uint64_t nr_of_rows, uint32_t compression)
 {
   // nothing to write
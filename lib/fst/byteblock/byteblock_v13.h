@@ -68,7 +68,7 @@ public:
   }
 };
 
-void fdsWriteByteBlockVec_v13(std::ofstream& fst_file, IByteBlockColumn* byte_block_writer,
+void fdsWriteByteBlockVec_v13(std::ostream& fst_file, IByteBlockColumn* byte_block_writer,
   uint64_t nr_of_rows, uint32_t compression);
 
 void read_byte_block_vec_v13(std::istream& fst_file, IByteBlockColumn* byte_block, uint64_t block_pos, uint64_t start_row,
@@ -19,10 +19,15 @@
 #include "interface/istringwriter.h"
 #include "interface/fstdefines.h"
 #include <compression/compressor.h>
+#include <compression/zstddictionary.h>
+#include <blockstreamer/positionalreader.h>
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 #include <cstring>  // memset
+#include <string>
+#include <vector>
 
 
 // #include <boost/unordered_map.hpp>
@@ -30,7 +35,7 @@
 using namespace std;
 
 
-inline unsigned int StoreCharBlock_v6(ofstream& myfile, IStringWriter* blockRunner, unsigned long long startCount, unsigned long long endCount)
+inline unsigned int StoreCharBlock_v6(ostream& myfile, IStringWriter* blockRunner, unsigned long long startCount, unsigned long long endCount)
 {
   blockRunner->SetBuffersFromVec(startCount, endCount);
 
@@ -48,9 +53,9 @@ inline unsigned int StoreCharBlock_v6(ofstream& myfile, IStringWriter* blockRunn
 }
 
 
-inline unsigned int storeCharBlockCompressed_v6(ofstream& myfile, IStringWriter* blockRunner, unsigned int startCount,
+inline unsigned int storeCharBlockCompressed_v6(ostream& myfile, IStringWriter* blockRunner, unsigned int startCount,
   unsigned int endCount, StreamCompressor* intCompressor, StreamCompressor* charCompressor, unsigned short int& algoInt,
-  unsigned short int& algoChar, int& intBufSize, int blockNr)
+  unsigned short int& algoChar, int& intBufSize, int blockNr, ZstdDictionary* dictionary)
 {
   // Determine string lengths
   unsigned int nrOfElements = endCount - startCount; // the string at position endCount is not included
@@ -79,14 +84,35 @@ inline unsigned int storeCharBlockCompressed_v6(ofstream& myfile, IStringWriter*
 
   unsigned int totSize = blockRunner->bufSize;
 
-  int compBufSize = charCompressor->CompressBufferSize(totSize);
+  int compBufSize = dictionary == nullptr ? charCompressor->CompressBufferSize(totSize) :
+    static_cast<int>(ZSTD_compressBound(totSize));
 
   std::unique_ptr<char[]> compBufP(new char[compBufSize]);
   char* compBuf = compBufP.get();
 
   // Compress buffer
-  int resSize = charCompressor->Compress(blockRunner->activeBuf, totSize, compBuf, compAlgorithm, blockNr);
-  myfile.write(compBuf, resSize);
+  int resSize;
+
+  if (dictionary == nullptr)
+  {
+    resSize = charCompressor->Compress(blockRunner->activeBuf, totSize, compBuf, compAlgorithm, blockNr);
+    myfile.write(compBuf, resSize);
+  }
+  else
+  {
+    resSize = static_cast<int>(dictionary->Compress(compBuf, compBufSize, blockRunner->activeBuf, totSize));
+    compAlgorithm = ZSTD;
+
+    // blocks that can't be compressed are stored uncompressed
+    if (resSize == 0 || resSize >= static_cast<int>(totSize))
+    {
+      resSize = static_cast<int>(totSize);
+      compBuf = blockRunner->activeBuf;
+      compAlgorithm = UNCOMPRESS;
+    }
+
+    myfile.write(compBuf, resSize);
+  }
 
   algoChar = static_cast<unsigned short int>(compAlgorithm); // store selected algorithm
 
@@ -94,7 +120,44 @@ inline unsigned int storeCharBlockCompressed_v6(ofstream& myfile, IStringWriter*
 }
 
 
-void fdsWriteCharVec_v6(ofstream& myfile, IStringWriter* stringWriter, int compression, StringEncoding stringEncoding)
+// Train a dictionary from the first part of the character data of blocks sampled evenly over the vector. The start of
+// a block benefits most from a dictionary, as the compressor has no history there.
+inline void TrainCharDictionary(IStringWriter* stringWriter, unsigned long long nrOfBlocks, unsigned long long vecLength,
+  vector<char> &dict)
+{
+  const unsigned long long totNrOfBlocks = nrOfBlocks + 1;
+  const unsigned long long nrOfSamples = min(totNrOfBlocks,
+    static_cast<unsigned long long>(CHAR_DICT_TRAIN_SIZE / CHAR_DICT_SAMPLE));
+  const unsigned long long maxBlockSample = CHAR_DICT_TRAIN_SIZE / nrOfSamples;  // maximum bytes sampled per block
+
+  vector<char> samples;
+  vector<size_t> sampleSizes;
+
+  for (unsigned long long sample = 0; sample < nrOfSamples; ++sample)
+  {
+    const unsigned long long block = (sample * totNrOfBlocks) / nrOfSamples;
+
+    stringWriter->SetBuffersFromVec(block * BLOCKSIZE_CHAR, min((block + 1) * BLOCKSIZE_CHAR, vecLength));
+
+    const unsigned long long sampleSize = min(static_cast<unsigned long long>(stringWriter->bufSize), maxBlockSample);
+    samples.insert(samples.end(), stringWriter->activeBuf, stringWriter->activeBuf + sampleSize);
+
+    for (unsigned long long pos = 0; pos < sampleSize; pos += CHAR_DICT_SAMPLE)
+    {
+      sampleSizes.push_back(static_cast<size_t>(min(sampleSize - pos, static_cast<unsigned long long>(CHAR_DICT_SAMPLE))));
+    }
+  }
+
+  // the dictionary should be much smaller than the training data
+  const size_t capacity = min(samples.size() / 16, static_cast<size_t>(CHAR_DICT_SIZE));
+  if (capacity < 1024) return;
+
+  ZstdDictionary::Train(samples, sampleSizes, capacity, dict);
+}
+
+
+void fdsWriteCharVec_v6(ostream& myfile, IStringWriter* stringWriter, int compression, StringEncoding stringEncoding,
+  bool useDictionary)
 {
   uint64_t vecLength = stringWriter->vecLength; // expected to be larger than zero
 
@@ -155,17 +218,30 @@ void fdsWriteCharVec_v6(ofstream& myfile, IStringWriter* stringWriter, int compr
   // clear memory for safety
   memset(meta, 0, metaSize);
 
+  // The character data of all blocks is compressed with a single dictionary
+  vector<char> dict;
+  std::unique_ptr<ZstdDictionary> dictionary;
+
+  if (useDictionary && nrOfBlocks + 1 >= CHAR_DICT_MIN_BLOCKS)
+  {
+    TrainCharDictionary(stringWriter, nrOfBlocks, vecLength, dict);
+
+    // ZSTD levels 1 to 9
+    if (!dict.empty()) dictionary.reset(new ZstdDictionary(dict.data(), dict.size(), 1 + compression / 12));
+  }
+
   // Set column header
   uint32_t* isCompressed = reinterpret_cast<uint32_t*>(meta);
   uint32_t* blockSizeChar = reinterpret_cast<uint32_t*>(&meta[4]);
   *blockSizeChar = BLOCKSIZE_CHAR;
-  *isCompressed = (stringEncoding << 1) | 1; // set compression flag
+  *isCompressed = (static_cast<uint32_t>(dict.size()) << 8) | (stringEncoding << 1) | 1; // set compression flag
 
   myfile.write(meta, metaSize); // write block offset and algorithm index
+  myfile.write(dict.data(), dict.size());  // dictionary precedes the first block
 
   char* blockP = &meta[CHAR_HEADER_SIZE];
 
-  unsigned long long fullSize = metaSize;
+  unsigned long long fullSize = metaSize + dict.size();
 
   // Compressors
   Compressor* compressInt;
@@ -208,7 +284,8 @@ void fdsWriteCharVec_v6(ofstream& myfile, IStringWriter* stringWriter, int compr
 
     stringWriter->SetBuffersFromVec(block * BLOCKSIZE_CHAR, (block + 1) * BLOCKSIZE_CHAR);
     unsigned long long totSize = storeCharBlockCompressed_v6(myfile, stringWriter, block * BLOCKSIZE_CHAR,
-      (block + 1) * BLOCKSIZE_CHAR, streamCompressInt, streamCompressChar, *algoInt, *algoChar, *intBufSize, block);
+      (block + 1) * BLOCKSIZE_CHAR, streamCompressInt, streamCompressChar, *algoInt, *algoChar, *intBufSize, block,
+      dictionary.get());
 
     fullSize += totSize;
     *blockPos = fullSize;
@@ -222,7 +299,7 @@ void fdsWriteCharVec_v6(ofstream& myfile, IStringWriter* stringWriter, int compr
 
   stringWriter->SetBuffersFromVec(nrOfBlocks * BLOCKSIZE_CHAR, vecLength);
   unsigned long long totSize = storeCharBlockCompressed_v6(myfile, stringWriter, nrOfBlocks * BLOCKSIZE_CHAR,
-    vecLength, streamCompressInt, streamCompressChar, *algoInt, *algoChar, *intBufSize, nrOfBlocks);
+    vecLength, streamCompressInt, streamCompressChar, *algoInt, *algoChar, *intBufSize, nrOfBlocks, dictionary.get());
 
   fullSize += totSize;
   *blockPos = fullSize;
@@ -240,98 +317,163 @@ void fdsWriteCharVec_v6(ofstream& myfile, IStringWriter* stringWriter, int compr
 }
 
 
-inline void ReadDataBlock_v6(istream& myfile, IStringColumn* blockReader, unsigned long long blockSize, unsigned long long nrOfElements,
-                             unsigned long long startElem, unsigned long long endElem, unsigned long long vecOffset)
+// Copy the selected elements of a data block to the result vector. The elements are collected in a block with the same
+// layout (cumulative string lengths, NA bits and character data), so they can be converted with a single BufferToVec call.
+inline void GatherBlockToVec(IStringColumn* blockReader, unsigned long long nrOfElements, const unsigned int* sizeMeta,
+  const char* buf, const unsigned long long* selection, unsigned long long nrOfSelected, unsigned long long vecOffset)
 {
-  unsigned long long nrOfNAInts = 1 + nrOfElements / 32; // last bit is NA flag
-  unsigned long long totElements = nrOfElements + nrOfNAInts;
+  const unsigned int* bitsNA = &sizeMeta[nrOfElements];
+  const bool hasNA = (bitsNA[nrOfElements / 32] & (1 << (nrOfElements % 32))) != 0;
 
-  std::unique_ptr<unsigned int[]> sizeMetaP(new unsigned int[totElements]);
-  unsigned int* sizeMeta = sizeMetaP.get();
+  const unsigned long long nrOfSelectedNAInts = 1 + nrOfSelected / 32;
+  std::unique_ptr<unsigned int[]> selectedMetaP(new unsigned int[nrOfSelected + nrOfSelectedNAInts]());
+  unsigned int* selectedMeta = selectedMetaP.get();
+  unsigned int* selectedNA = &selectedMeta[nrOfSelected];
 
-  myfile.read(reinterpret_cast<char*>(sizeMeta), totElements * 4); // read cumulative string lengths and NA bits
+  string selectedBuf;
 
-  unsigned int charDataSize = blockSize - totElements * 4;
+  for (unsigned long long pos = 0; pos < nrOfSelected; ++pos)
+  {
+    const unsigned long long elem = selection[pos];
+    const unsigned int strStart = elem == 0 ? 0 : sizeMeta[elem - 1];
 
-  std::unique_ptr<char[]> bufP(new char[charDataSize]);
-  char* buf = bufP.get();
+    selectedBuf.append(&buf[strStart], sizeMeta[elem] - strStart);
+    selectedMeta[pos] = static_cast<unsigned int>(selectedBuf.size());
+
+    if (hasNA && (bitsNA[elem / 32] & (1 << (elem % 32))) != 0)
+    {
+      selectedNA[pos / 32] |= 1 << (pos % 32);
+      selectedNA[nrOfSelected / 32] |= 1 << (nrOfSelected % 32);  // NA flag
+    }
+  }
+
+  blockReader->BufferToVec(nrOfSelected, 0, nrOfSelected - 1, vecOffset, selectedMeta, &selectedBuf[0]);
+}
 
-  myfile.read(buf, charDataSize); // read string lengths
+
+// Copy elements [startElem, endElem] of a data block to the result vector, or the elements in 'selection' if given
+inline void BlockToVec(IStringColumn* blockReader, unsigned long long nrOfElements, unsigned long long startElem,
+  unsigned long long endElem, unsigned long long vecOffset, unsigned int* sizeMeta, char* buf,
+  const unsigned long long* selection, unsigned long long nrOfSelected)
+{
+  if (selection != nullptr)
+  {
+    GatherBlockToVec(blockReader, nrOfElements, sizeMeta, buf, selection, nrOfSelected, vecOffset);
+    return;
+  }
 
   blockReader->BufferToVec(nrOfElements, startElem, endElem, vecOffset, sizeMeta, buf);
 }
 
 
-inline void ReadDataBlockCompressed_v6(istream& myfile, IStringColumn* blockReader, unsigned long long blockSize, unsigned long long nrOfElements,
-  unsigned long long startElem, unsigned long long endElem, unsigned long long vecOffset,
-  unsigned int intBlockSize, Decompressor& decompressor, unsigned short int& algoInt, unsigned short int& algoChar)
+// Read a complete uncompressed data block at file position 'readPos'. If a selection of (block relative) elements
+// is given, only those elements are copied to the result and 'startElem' and 'endElem' are not used.
+inline void ReadDataBlock_v6(istream& myfile, const IFstSource* positionalReader, IStringColumn* blockReader,
+  unsigned long long readPos, unsigned long long blockSize, unsigned long long nrOfElements, unsigned long long startElem,
+  unsigned long long endElem, unsigned long long vecOffset, const unsigned long long* selection = nullptr,
+  unsigned long long nrOfSelected = 0)
 {
-  unsigned long long nrOfNAInts = 1 + nrOfElements / 32; // NA metadata including overall NA bit
+  unsigned long long nrOfNAInts = 1 + nrOfElements / 32; // last bit is NA flag
   unsigned long long totElements = nrOfElements + nrOfNAInts;
 
-  std::unique_ptr<unsigned int[]> sizeMetaP(new unsigned int[totElements]);
-  unsigned int* sizeMeta = sizeMetaP.get();
+  // cumulative string lengths and NA bits followed by the character data
+  std::unique_ptr<char[]> blockBufP(new char[blockSize]);
+  char* blockBuf = blockBufP.get();
 
-  // Read and uncompress str sizes data
-  if (algoInt == 0) // uncompressed
-  {
-    myfile.read(reinterpret_cast<char*>(sizeMeta), totElements * 4); // read cumulative string lengths
-  }
-  else
-  {
-    unsigned int intBufSize = intBlockSize;
+  ReadAt(myfile, positionalReader, blockBuf, blockSize, readPos);
+
+  unsigned int* sizeMeta = reinterpret_cast<unsigned int*>(blockBuf);
+  char* buf = &blockBuf[totElements * 4];
 
-    std::unique_ptr<char[]> strSizeBufP(new char[intBufSize]);
-    char* strSizeBuf = strSizeBufP.get();
+  BlockToVec(blockReader, nrOfElements, startElem, endElem, vecOffset, sizeMeta, buf, selection, nrOfSelected);
+}
 
-    myfile.read(strSizeBuf, intBufSize);
-    myfile.read(reinterpret_cast<char*>(&sizeMeta[nrOfElements]), nrOfNAInts * 4); // read cumulative string lengths
 
-    // Decompress size but not NA metadata (which is currently uncompressed)
+// Read a complete compressed data block at file position 'readPos', see ReadDataBlock_v6 for the element selection
+inline void ReadDataBlockCompressed_v6(istream& myfile, const IFstSource* positionalReader, IStringColumn* blockReader,
+  unsigned long long readPos, unsigned long long blockSize, unsigned long long nrOfElements, unsigned long long startElem,
+  unsigned long long endElem, unsigned long long vecOffset, unsigned int intBlockSize, Decompressor& decompressor,
+  unsigned short int& algoInt, unsigned short int& algoChar, ZstdDictionary* dictionary,
+  const unsigned long long* selection = nullptr, unsigned long long nrOfSelected = 0)
+{
+  unsigned long long nrOfNAInts = 1 + nrOfElements / 32; // NA metadata including overall NA bit
+  unsigned long long totElements = nrOfElements + nrOfNAInts;
 
-    decompressor.Decompress(algoInt, reinterpret_cast<char*>(sizeMeta), nrOfElements * 4, strSizeBuf, intBlockSize);
+  // (compressed) string sizes, NA bits and (compressed) character data in a single read
+  std::unique_ptr<char[]> blockBufP(new char[blockSize]);
+  char* blockBuf = blockBufP.get();
+
+  ReadAt(myfile, positionalReader, blockBuf, blockSize, readPos);
+
+  std::unique_ptr<unsigned int[]> sizeMetaP;
+  unsigned int* sizeMeta = reinterpret_cast<unsigned int*>(blockBuf);  // cumulative string lengths
+
+  // Uncompress str sizes data
+  if (algoInt != 0)
+  {
+    sizeMetaP = std::unique_ptr<unsigned int[]>(new unsigned int[totElements]);
+    sizeMeta = sizeMetaP.get();
+
+    // NA metadata is currently uncompressed
+    memcpy(&sizeMeta[nrOfElements], &blockBuf[intBlockSize], nrOfNAInts * 4);
+    decompressor.Decompress(algoInt, reinterpret_cast<char*>(sizeMeta), nrOfElements * 4, blockBuf, intBlockSize);
   }
 
   unsigned int charDataSizeUncompressed = sizeMeta[nrOfElements - 1];
 
-  // Read and uncompress string vector data, use stack if possible here !!!!!
+  // Uncompress string vector data
   unsigned int charDataSize = blockSize - intBlockSize - nrOfNAInts * 4;
+  char* charData = &blockBuf[intBlockSize + nrOfNAInts * 4];
+
+  if (algoChar == 0)
+  {
+    BlockToVec(blockReader, nrOfElements, startElem, endElem, vecOffset, sizeMeta, charData, selection, nrOfSelected);
+    return;
+  }
 
   std::unique_ptr<char[]> bufP(new char[charDataSizeUncompressed]);
   char* buf = bufP.get();
 
-  if (algoChar == 0)
+  // all compressed blocks of a column with a dictionary use that dictionary
+  if (dictionary != nullptr)
   {
-    myfile.read(buf, charDataSize); // read string lengths
+    dictionary->Decompress(buf, charDataSizeUncompressed, charData, charDataSize);
   }
   else
   {
-    std::unique_ptr<char[]> bufCompressedP(new char[charDataSize]);
-    char* bufCompressed = bufCompressedP.get();
-
-    myfile.read(bufCompressed, charDataSize); // read string lengths
-    decompressor.Decompress(algoChar, buf, charDataSizeUncompressed, bufCompressed, charDataSize);
+    decompressor.Decompress(algoChar, buf, charDataSizeUncompressed, charData, charDataSize);
   }
 
-  blockReader->BufferToVec(nrOfElements, startElem, endElem, vecOffset, sizeMeta, buf);
+  BlockToVec(blockReader, nrOfElements, startElem, endElem, vecOffset, sizeMeta, buf, selection, nrOfSelected);
+}
+
+
+// Read the dictionary of a compressed character vector, if any
+inline std::unique_ptr<ZstdDictionary> ReadCharDictionary(istream& myfile, const IFstSource* positionalReader,
+  unsigned long long dictPos, unsigned long long dictSize)
+{
+  if (dictSize == 0) return std::unique_ptr<ZstdDictionary>();
+
+  std::unique_ptr<char[]> dictP(new char[dictSize]);
+  ReadAt(myfile, positionalReader, dictP.get(), dictSize, dictPos);
+
+  return std::unique_ptr<ZstdDictionary>(new ZstdDictionary(dictP.get(), dictSize));
 }
 
 
 void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long vecLength, unsigned long long size)
+  unsigned long long vecLength, unsigned long long size, unsigned long long vecOffset, const IFstSource* positionalReader)
 {
   // nothing to read
   if (vecLength == 0) return;
 
-  // Jump to startRow size
-  myfile.seekg(blockPos);
-
   // Read algorithm type and block size
   unsigned int meta[2];
-  myfile.read(reinterpret_cast<char*>(meta), CHAR_HEADER_SIZE);
+  ReadAt(myfile, positionalReader, reinterpret_cast<char*>(meta), CHAR_HEADER_SIZE, blockPos);
 
   unsigned int compression = meta[0] & 1; // maximum 8 encodings
   StringEncoding stringEncoding = static_cast<StringEncoding>(meta[0] >> 1 & 7); // at maximum 8 encodings
+  unsigned long long dictSize = meta[0] >> 8;  // size of the dictionary stored after the block index
 
   unsigned long long blockSizeChar = static_cast<unsigned long long>(meta[1]);
   unsigned long long totNrOfBlocks = (size - 1) / blockSizeChar; // total number of blocks minus 1
@@ -353,19 +495,17 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
 
     if (startBlock > 0) // include previous block offset
     {
-      myfile.seekg(blockPos + CHAR_HEADER_SIZE + (startBlock - 1) * 8); // jump to correct block index
-      myfile.read(reinterpret_cast<char*>(blockOffset), (1 + nrOfBlocks) * 8);
+      ReadAt(myfile, positionalReader, reinterpret_cast<char*>(blockOffset), (1 + nrOfBlocks) * 8,
+        blockPos + CHAR_HEADER_SIZE + (startBlock - 1) * 8);
     }
     else
     {
       blockOffset[0] = CHAR_HEADER_SIZE + (totNrOfBlocks + 1) * 8;
-      myfile.read(reinterpret_cast<char*>(&blockOffset[1]), nrOfBlocks * 8);
+      ReadAt(myfile, positionalReader, reinterpret_cast<char*>(&blockOffset[1]), nrOfBlocks * 8, blockPos + CHAR_HEADER_SIZE);
     }
 
-
-    // Navigate to first selected data block
+    // First selected data block
     unsigned long long offset = blockOffset[0];
-    myfile.seekg(blockPos + offset);
 
     unsigned long long endElem = blockSizeChar - 1;
     unsigned long long nrOfElements = blockSizeChar;
@@ -382,7 +522,8 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
     // Read first block with offset
     unsigned long long blockSize = blockOffset[1] - offset; // size of data block
 
-    ReadDataBlock_v6(myfile, blockReader, blockSize, nrOfElements, startOffset, endElem, 0);
+    ReadDataBlock_v6(myfile, positionalReader, blockReader, blockPos + offset, blockSize, nrOfElements, startOffset, endElem,
+      vecOffset);
 
     if (startBlock == endBlock) // subset start and end of block
     {
@@ -390,7 +531,7 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
     }
 
     offset = blockOffset[1];
-    unsigned long long vecPos = blockSizeChar - startOffset;
+    unsigned long long vecPos = vecOffset + blockSizeChar - startOffset;
 
     if (endBlock == totNrOfBlocks)
     {
@@ -402,14 +543,16 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
     {
       unsigned long long newPos = blockOffset[block + 1];
 
-      ReadDataBlock_v6(myfile, blockReader, newPos - offset, blockSizeChar, 0, blockSizeChar - 1, vecPos);
+      ReadDataBlock_v6(myfile, positionalReader, blockReader, blockPos + offset, newPos - offset, blockSizeChar, 0,
+        blockSizeChar - 1, vecPos);
 
       vecPos += blockSizeChar;
       offset = newPos;
     }
 
     unsigned long long newPos = blockOffset[nrOfBlocks + 1];
-    ReadDataBlock_v6(myfile, blockReader, newPos - offset, nrOfElements, 0, endOffset, vecPos);
+    ReadDataBlock_v6(myfile, positionalReader, blockReader, blockPos + offset, newPos - offset, nrOfElements, 0, endOffset,
+      vecPos);
 
     return;
   }
@@ -423,18 +566,22 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
   std::unique_ptr<char[]> blockInfoP = std::unique_ptr<char[]>(new char[bufLength + CHAR_INDEX_SIZE]);
   char* blockInfo = blockInfoP.get();
 
+  const unsigned long long indexEnd = CHAR_HEADER_SIZE + (totNrOfBlocks + 1) * CHAR_INDEX_SIZE;
+
   if (startBlock > 0) // include previous block offset
   {
-    myfile.seekg(blockPos + CHAR_HEADER_SIZE + (startBlock - 1) * CHAR_INDEX_SIZE); // jump to correct block index
-    myfile.read(blockInfo, (nrOfBlocks + 1) * CHAR_INDEX_SIZE);
+    ReadAt(myfile, positionalReader, blockInfo, (nrOfBlocks + 1) * CHAR_INDEX_SIZE,
+      blockPos + CHAR_HEADER_SIZE + (startBlock - 1) * CHAR_INDEX_SIZE);
   }
   else
   {
     unsigned long long* firstBlock = reinterpret_cast<unsigned long long*>(blockInfo);
-    *firstBlock = CHAR_HEADER_SIZE + (totNrOfBlocks + 1) * CHAR_INDEX_SIZE; // offset of first data block
-    myfile.read(&blockInfo[CHAR_INDEX_SIZE], nrOfBlocks * CHAR_INDEX_SIZE);
+    *firstBlock = indexEnd + dictSize; // offset of first data block
+    ReadAt(myfile, positionalReader, &blockInfo[CHAR_INDEX_SIZE], nrOfBlocks * CHAR_INDEX_SIZE, blockPos + CHAR_HEADER_SIZE);
   }
 
+  std::unique_ptr<ZstdDictionary> dictionary = ReadCharDictionary(myfile, positionalReader, blockPos + indexEnd, dictSize);
+
   // Get block meta data
   unsigned long long* offset = reinterpret_cast<unsigned long long*>(blockInfo);
   char* blockP = &blockInfo[CHAR_INDEX_SIZE];
@@ -443,10 +590,6 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
   unsigned short int* algoChar = reinterpret_cast<unsigned short int*>(blockP + 10);
   int* intBufSize = reinterpret_cast<int*>(blockP + 12);
 
-  // move to first data block
-
-  myfile.seekg(blockPos + *offset);
-
   unsigned long long endElem = blockSizeChar - 1;
   unsigned long long nrOfElements = blockSizeChar;
 
@@ -464,8 +607,8 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
   // Read first block with offset
   unsigned long long blockSize = *curBlockPos - *offset; // size of data block
 
-  ReadDataBlockCompressed_v6(myfile, blockReader, blockSize, nrOfElements, startOffset, endElem, 0, *intBufSize,
-    decompressor, *algoInt, *algoChar);
+  ReadDataBlockCompressed_v6(myfile, positionalReader, blockReader, blockPos + *offset, blockSize, nrOfElements, startOffset,
+    endElem, vecOffset, *intBufSize, decompressor, *algoInt, *algoChar, dictionary.get());
 
 
   if (startBlock == endBlock) // subset start and end of block
@@ -477,7 +620,7 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
 
   offset = curBlockPos;
 
-  unsigned long long vecPos = blockSizeChar - startOffset;
+  unsigned long long vecPos = vecOffset + blockSizeChar - startOffset;
 
   if (endBlock == totNrOfBlocks)
   {
@@ -493,8 +636,8 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
     algoChar = reinterpret_cast<unsigned short int*>(blockP + 10);
     intBufSize = reinterpret_cast<int*>(blockP + 12);
 
-    ReadDataBlockCompressed_v6(myfile, blockReader, *curBlockPos - *offset, blockSizeChar, 0, blockSizeChar - 1, vecPos, *intBufSize,
-      decompressor, *algoInt, *algoChar);
+    ReadDataBlockCompressed_v6(myfile, positionalReader, blockReader, blockPos + *offset, *curBlockPos - *offset, blockSizeChar,
+      0, blockSizeChar - 1, vecPos, *intBufSize, decompressor, *algoInt, *algoChar, dictionary.get());
 
     vecPos += blockSizeChar;
     offset = curBlockPos;
@@ -506,6 +649,92 @@ void fdsReadCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned lon
   algoChar = reinterpret_cast<unsigned short int*>(blockP + 10);
   intBufSize = reinterpret_cast<int*>(blockP + 12);
 
-  ReadDataBlockCompressed_v6(myfile, blockReader, *curBlockPos - *offset, nrOfElements, 0, endOffset, vecPos, *intBufSize,
-    decompressor, *algoInt, *algoChar);
+  ReadDataBlockCompressed_v6(myfile, positionalReader, blockReader, blockPos + *offset, *curBlockPos - *offset, nrOfElements, 0,
+    endOffset, vecPos, *intBufSize, decompressor, *algoInt, *algoChar, dictionary.get());
+}
+
+
+void fdsGatherCharVec_v6(istream& myfile, IStringColumn* blockReader, unsigned long long blockPos, const unsigned long long* rows,
+  unsigned long long nrOfRows, unsigned long long size, unsigned long long vecOffset, const IFstSource* positionalReader)
+{
+  // nothing to read
+  if (nrOfRows == 0) return;
+
+  // Read algorithm type and block size
+  unsigned int meta[2];
+  ReadAt(myfile, positionalReader, reinterpret_cast<char*>(meta), CHAR_HEADER_SIZE, blockPos);
+
+  unsigned int compression = meta[0] & 1; // maximum 8 encodings
+  StringEncoding stringEncoding = static_cast<StringEncoding>(meta[0] >> 1 & 7); // at maximum 8 encodings
+  unsigned long long dictSize = meta[0] >> 8;  // size of the dictionary stored after the block index
+
+  unsigned long long blockSizeChar = static_cast<unsigned long long>(meta[1]);
+  unsigned long long totNrOfBlocks = (size - 1) / blockSizeChar; // total number of blocks minus 1
+  unsigned long long startBlock = rows[0] / blockSizeChar;
+  unsigned long long endBlock = rows[nrOfRows - 1] / blockSizeChar;
+  unsigned long long nrOfBlocks = 1 + endBlock - startBlock; // blocks spanned by the selection
+
+  blockReader->SetEncoding(stringEncoding);
+
+  // Block index entries contain the end offset of each block, followed by compression meta data for compressed vectors
+  const unsigned long long indexSize = compression == 0 ? 8 : CHAR_INDEX_SIZE;
+
+  std::unique_ptr<char[]> blockInfoP(new char[(nrOfBlocks + 1) * indexSize]);
+  char* blockInfo = blockInfoP.get();
+
+  if (startBlock > 0) // include previous block offset
+  {
+    ReadAt(myfile, positionalReader, blockInfo, (nrOfBlocks + 1) * indexSize, blockPos + CHAR_HEADER_SIZE + (startBlock - 1) * indexSize);
+  }
+  else
+  {
+    *reinterpret_cast<unsigned long long*>(blockInfo) = CHAR_HEADER_SIZE + (totNrOfBlocks + 1) * indexSize + dictSize;
+    ReadAt(myfile, positionalReader, &blockInfo[indexSize], nrOfBlocks * indexSize, blockPos + CHAR_HEADER_SIZE);
+  }
+
+  std::unique_ptr<ZstdDictionary> dictionary = ReadCharDictionary(myfile, positionalReader,
+    blockPos + CHAR_HEADER_SIZE + (totNrOfBlocks + 1) * indexSize, dictSize);
+
+  Decompressor decompressor; // uncompresses all available algorithms
+  vector<unsigned long long> selection;  // selected elements of a single block
+
+  // Only blocks that contain selected rows are read
+  unsigned long long pos = 0;
+
+  while (pos < nrOfRows)
+  {
+    const unsigned long long block = rows[pos] / blockSizeChar;
+    const unsigned long long blockStart = block * blockSizeChar;
+    const unsigned long long selectionOffset = pos;
+
+    selection.clear();
+
+    for (; pos < nrOfRows && rows[pos] < blockStart + blockSizeChar; ++pos)
+    {
+      selection.push_back(rows[pos] - blockStart);
+    }
+
+    // last block can have less elements
+    const unsigned long long nrOfElements = block == totNrOfBlocks ? size - totNrOfBlocks * blockSizeChar : blockSizeChar;
+
+    char* blockP = &blockInfo[(1 + block - startBlock) * indexSize];
+    const unsigned long long offset = *reinterpret_cast<unsigned long long*>(&blockInfo[(block - startBlock) * indexSize]);
+    const unsigned long long blockSize = *reinterpret_cast<unsigned long long*>(blockP) - offset;
+
+    if (compression == 0)
+    {
+      ReadDataBlock_v6(myfile, positionalReader, blockReader, blockPos + offset, blockSize, nrOfElements, 0, 0,
+        vecOffset + selectionOffset, selection.data(), selection.size());
+
+      continue;
+    }
+
+    unsigned short int algoInt = *reinterpret_cast<unsigned short int*>(blockP + 8);
+    unsigned short int algoChar = *reinterpret_cast<unsigned short int*>(blockP + 10);
+    const int intBufSize = *reinterpret_cast<int*>(blockP + 12);
+
+    ReadDataBlockCompressed_v6(myfile, positionalReader, blockReader, blockPos + offset, blockSize, nrOfElements, 0, 0,
+      vecOffset + selectionOffset, intBufSize, decompressor, algoInt, algoChar, dictionary.get(), selection.data(),
+      selection.size());
+  }
 }
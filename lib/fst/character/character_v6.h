@@ -24,13 +24,28 @@
 
 #include "interface/istringwriter.h"
 #include "interface/ifstcolumn.h"
+#include "blockstreamer/positionalreader.h"
 
 
-void fdsWriteCharVec_v6(std::ofstream &myfile, IStringWriter* blockRunner, int compression, StringEncoding stringEncoding);
+// The first 4 bytes of the column header hold the compression flag (bit 0), the string encoding (bits 1 - 3) and the
+// size of the dictionary that is stored after the block index (bits 8 - 31, zero without a dictionary). Parameter
+// 'useDictionary' compresses the character data of all blocks with a ZSTD dictionary trained from sampled blocks
+// (only for compressed vectors with at least CHAR_DICT_MIN_BLOCKS blocks).
+void fdsWriteCharVec_v6(std::ostream &myfile, IStringWriter* blockRunner, int compression, StringEncoding stringEncoding,
+  bool useDictionary = false);
 
 
+// Parameter 'vecOffset' is the position in the result vector where the first element is stored.
 void fdsReadCharVec_v6(std::istream &myfile, IStringColumn* blockReader, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long vecLength, unsigned long long size);
+  unsigned long long vecLength, unsigned long long size, unsigned long long vecOffset = 0,
+  const IFstSource* positionalReader = nullptr);
+
+
+// Read the 'nrOfRows' sorted (zero based) rows in 'rows' and store them starting at position 'vecOffset' of the
+// result vector. Only the character blocks that contain selected rows are read.
+void fdsGatherCharVec_v6(std::istream &myfile, IStringColumn* blockReader, unsigned long long blockPos, const unsigned long long* rows,
+  unsigned long long nrOfRows, unsigned long long size, unsigned long long vecOffset = 0,
+  const IFstSource* positionalReader = nullptr);
 
 
 #endif  // CHARACTER_V6_H
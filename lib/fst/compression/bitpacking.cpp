@@ -0,0 +1,703 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include <compression/bitpacking.h>
+#include <compression/simdtargets.h>
+
+
+// Packed values are processed as unsigned numbers, so all arithmetic is modular and NA values (the minimum integer)
+// need no special treatment.
+
+template<typename U>
+inline U WidthMask(const int width)
+{
+  return width == static_cast<int>(8 * sizeof(U)) ? ~static_cast<U>(0) : (static_cast<U>(1) << width) - 1;
+}
+
+
+template<typename U>
+inline U ZigZag(const U delta)
+{
+  const int bits = 8 * sizeof(U);
+  return (delta << 1) ^ (0 - (delta >> (bits - 1)));
+}
+
+
+template<typename U>
+inline U UnZigZag(const U value)
+{
+  return (value >> 1) ^ (0 - (value & 1));
+}
+
+
+template<typename U>
+inline int BitWidth(U value)
+{
+  int width = 0;
+
+  while (value != 0)
+  {
+    ++width;
+    value >>= 1;
+  }
+
+  return width;
+}
+
+
+// Value k of 'lane' in a frame of 'LANES' interleaved words
+
+template<typename U>
+inline U UnpackValue(const U* packed, const int width, const U mask, const int k, const int lane)
+{
+  const int bits = 8 * sizeof(U);
+  const int lanes = 32 / sizeof(U);
+
+  const int bit = k * width;
+  const int word = bit / bits;
+  const int shift = bit % bits;
+
+  U value = packed[word * lanes + lane] >> shift;
+  if (shift + width > bits) value |= packed[(word + 1) * lanes + lane] << (bits - shift);
+
+  return value & mask;
+}
+
+
+template<typename T, typename U>
+void UnpackForScalar(const U* packed, T* out, const int width, const T base)
+{
+  const int lanes = 32 / sizeof(U);
+  const U mask = WidthMask<U>(width);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / lanes; k++)
+  {
+    for (int lane = 0; lane < lanes; lane++)
+    {
+      out[k * lanes + lane] = static_cast<T>(static_cast<U>(base) + UnpackValue(packed, width, mask, k, lane));
+    }
+  }
+}
+
+
+template<typename T, typename U>
+T UnpackDeltaScalar(const U* packed, T* out, const int width, const T base)
+{
+  const int lanes = 32 / sizeof(U);
+  const U mask = WidthMask<U>(width);
+  U value = static_cast<U>(base);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / lanes; k++)
+  {
+    for (int lane = 0; lane < lanes; lane++)
+    {
+      value += UnZigZag(UnpackValue(packed, width, mask, k, lane));
+      out[k * lanes + lane] = static_cast<T>(value);
+    }
+  }
+
+  return static_cast<T>(value);
+}
+
+
+void UnpackForIntScalar(const unsigned int* packed, int* out, int width, int base)
+{
+  UnpackForScalar(packed, out, width, base);
+}
+
+
+int UnpackDeltaIntScalar(const unsigned int* packed, int* out, int width, int base)
+{
+  return UnpackDeltaScalar(packed, out, width, base);
+}
+
+
+void UnpackForInt64Scalar(const unsigned long long* packed, long long* out, int width, long long base)
+{
+  UnpackForScalar(packed, out, width, base);
+}
+
+
+long long UnpackDeltaInt64Scalar(const unsigned long long* packed, long long* out, int width, long long base)
+{
+  return UnpackDeltaScalar(packed, out, width, base);
+}
+
+
+#ifdef FST_SIMD_X86
+
+// The vectorized kernels unpack value k of all lanes at once. Shift counts are uniform for all lanes, so no
+// variable shifts are required.
+
+// 32 bit values, 8 lanes (two halves of 4 lanes for SSE2)
+
+FST_TARGET_SSE2 inline __m128i UnpackSse2(const unsigned int* packed, const int k, const int width, const int half,
+  const __m128i mask)
+{
+  const int bit = k * width;
+  const int word = bit / 32;
+  const int shift = bit % 32;
+
+  __m128i values = _mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + 8 * word + 4 * half)),
+    _mm_cvtsi32_si128(shift));
+
+  if (shift + width > 32)
+  {
+    const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + 8 * (word + 1) + 4 * half));
+    values = _mm_or_si128(values, _mm_sll_epi32(next, _mm_cvtsi32_si128(32 - shift)));
+  }
+
+  return _mm_and_si128(values, mask);
+}
+
+
+FST_TARGET_SSE2 void UnpackForIntSse2(const unsigned int* packed, int* out, int width, int base)
+{
+  const __m128i mask = _mm_set1_epi32(static_cast<int>(WidthMask<unsigned int>(width)));
+  const __m128i baseVec = _mm_set1_epi32(base);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / 8; k++)
+  {
+    for (int half = 0; half < 2; half++)
+    {
+      const __m128i values = _mm_add_epi32(UnpackSse2(packed, k, width, half, mask), baseVec);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8 * k + 4 * half), values);
+    }
+  }
+}
+
+
+FST_TARGET_SSE2 int UnpackDeltaIntSse2(const unsigned int* packed, int* out, int width, int base)
+{
+  const __m128i mask = _mm_set1_epi32(static_cast<int>(WidthMask<unsigned int>(width)));
+  const __m128i one = _mm_set1_epi32(1);
+  __m128i carry = _mm_set1_epi32(base);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / 8; k++)
+  {
+    for (int half = 0; half < 2; half++)
+    {
+      const __m128i values = UnpackSse2(packed, k, width, half, mask);
+
+      __m128i deltas = _mm_xor_si128(_mm_srli_epi32(values, 1), _mm_sub_epi32(_mm_setzero_si128(),
+        _mm_and_si128(values, one)));
+
+      // inclusive prefix sum
+      deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 4));
+      deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 8));
+      deltas = _mm_add_epi32(deltas, carry);
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8 * k + 4 * half), deltas);
+      carry = _mm_shuffle_epi32(deltas, 0xFF);
+    }
+  }
+
+  return out[PACK_FRAME_SIZE - 1];
+}
+
+
+FST_TARGET_AVX2 inline __m256i UnpackAvx2(const unsigned int* packed, const int k, const int width, const __m256i mask)
+{
+  const int bit = k * width;
+  const int word = bit / 32;
+  const int shift = bit % 32;
+
+  __m256i values = _mm256_srl_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(packed + 8 * word)),
+    _mm_cvtsi32_si128(shift));
+
+  if (shift + width > 32)
+  {
+    const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(packed + 8 * (word + 1)));
+    values = _mm256_or_si256(values, _mm256_sll_epi32(next, _mm_cvtsi32_si128(32 - shift)));
+  }
+
+  return _mm256_and_si256(values, mask);
+}
+
+
+FST_TARGET_AVX2 void UnpackForIntAvx2(const unsigned int* packed, int* out, int width, int base)
+{
+  const __m256i mask = _mm256_set1_epi32(static_cast<int>(WidthMask<unsigned int>(width)));
+  const __m256i baseVec = _mm256_set1_epi32(base);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / 8; k++)
+  {
+    const __m256i values = _mm256_add_epi32(UnpackAvx2(packed, k, width, mask), baseVec);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8 * k), values);
+  }
+}
+
+
+FST_TARGET_AVX2 int UnpackDeltaIntAvx2(const unsigned int* packed, int* out, int width, int base)
+{
+  const __m256i mask = _mm256_set1_epi32(static_cast<int>(WidthMask<unsigned int>(width)));
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i lastOfLow = _mm256_set1_epi32(3);
+  const __m256i last = _mm256_set1_epi32(7);
+  __m256i carry = _mm256_set1_epi32(base);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / 8; k++)
+  {
+    const __m256i values = UnpackAvx2(packed, k, width, mask);
+
+    __m256i deltas = _mm256_xor_si256(_mm256_srli_epi32(values, 1), _mm256_sub_epi32(_mm256_setzero_si256(),
+      _mm256_and_si256(values, one)));
+
+    // inclusive prefix sum within both 128 bit halves, then add the total of the low half to the high half
+    deltas = _mm256_add_epi32(deltas, _mm256_slli_si256(deltas, 4));
+    deltas = _mm256_add_epi32(deltas, _mm256_slli_si256(deltas, 8));
+    deltas = _mm256_add_epi32(deltas, _mm256_blend_epi32(_mm256_setzero_si256(),
+      _mm256_permutevar8x32_epi32(deltas, lastOfLow), 0xF0));
+    deltas = _mm256_add_epi32(deltas, carry);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8 * k), deltas);
+    carry = _mm256_permutevar8x32_epi32(deltas, last);
+  }
+
+  return out[PACK_FRAME_SIZE - 1];
+}
+
+
+// 64 bit values, 4 lanes (two halves of 2 lanes for SSE2)
+
+FST_TARGET_SSE2 inline __m128i UnpackSse2(const unsigned long long* packed, const int k, const int width,
+  const int half, const __m128i mask)
+{
+  const int bit = k * width;
+  const int word = bit / 64;
+  const int shift = bit % 64;
+
+  __m128i values = _mm_srl_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + 4 * word + 2 * half)),
+    _mm_cvtsi32_si128(shift));
+
+  if (shift + width > 64)
+  {
+    const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + 4 * (word + 1) + 2 * half));
+    values = _mm_or_si128(values, _mm_sll_epi64(next, _mm_cvtsi32_si128(64 - shift)));
+  }
+
+  return _mm_and_si128(values, mask);
+}
+
+
+FST_TARGET_SSE2 void UnpackForInt64Sse2(const unsigned long long* packed, long long* out, int width, long long base)
+{
+  const __m128i mask = _mm_set1_epi64x(static_cast<long long>(WidthMask<unsigned long long>(width)));
+  const __m128i baseVec = _mm_set1_epi64x(base);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / 4; k++)
+  {
+    for (int half = 0; half < 2; half++)
+    {
+      const __m128i values = _mm_add_epi64(UnpackSse2(packed, k, width, half, mask), baseVec);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * k + 2 * half), values);
+    }
+  }
+}
+
+
+FST_TARGET_SSE2 long long UnpackDeltaInt64Sse2(const unsigned long long* packed, long long* out, int width,
+  long long base)
+{
+  const __m128i mask = _mm_set1_epi64x(static_cast<long long>(WidthMask<unsigned long long>(width)));
+  const __m128i one = _mm_set1_epi64x(1);
+  __m128i carry = _mm_set1_epi64x(base);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / 4; k++)
+  {
+    for (int half = 0; half < 2; half++)
+    {
+      const __m128i values = UnpackSse2(packed, k, width, half, mask);
+
+      __m128i deltas = _mm_xor_si128(_mm_srli_epi64(values, 1), _mm_sub_epi64(_mm_setzero_si128(),
+        _mm_and_si128(values, one)));
+
+      deltas = _mm_add_epi64(deltas, _mm_slli_si128(deltas, 8));
+      deltas = _mm_add_epi64(deltas, carry);
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * k + 2 * half), deltas);
+      carry = _mm_unpackhi_epi64(deltas, deltas);
+    }
+  }
+
+  return out[PACK_FRAME_SIZE - 1];
+}
+
+
+FST_TARGET_AVX2 inline __m256i UnpackAvx2(const unsigned long long* packed, const int k, const int width,
+  const __m256i mask)
+{
+  const int bit = k * width;
+  const int word = bit / 64;
+  const int shift = bit % 64;
+
+  __m256i values = _mm256_srl_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(packed + 4 * word)),
+    _mm_cvtsi32_si128(shift));
+
+  if (shift + width > 64)
+  {
+    const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(packed + 4 * (word + 1)));
+    values = _mm256_or_si256(values, _mm256_sll_epi64(next, _mm_cvtsi32_si128(64 - shift)));
+  }
+
+  return _mm256_and_si256(values, mask);
+}
+
+
+FST_TARGET_AVX2 void UnpackForInt64Avx2(const unsigned long long* packed, long long* out, int width, long long base)
+{
+  const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(WidthMask<unsigned long long>(width)));
+  const __m256i baseVec = _mm256_set1_epi64x(base);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / 4; k++)
+  {
+    const __m256i values = _mm256_add_epi64(UnpackAvx2(packed, k, width, mask), baseVec);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4 * k), values);
+  }
+}
+
+
+FST_TARGET_AVX2 long long UnpackDeltaInt64Avx2(const unsigned long long* packed, long long* out, int width,
+  long long base)
+{
+  const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(WidthMask<unsigned long long>(width)));
+  const __m256i one = _mm256_set1_epi64x(1);
+  __m256i carry = _mm256_set1_epi64x(base);
+
+  for (int k = 0; k < PACK_FRAME_SIZE / 4; k++)
+  {
+    const __m256i values = UnpackAvx2(packed, k, width, mask);
+
+    __m256i deltas = _mm256_xor_si256(_mm256_srli_epi64(values, 1), _mm256_sub_epi64(_mm256_setzero_si256(),
+      _mm256_and_si256(values, one)));
+
+    // inclusive prefix sum within both 128 bit halves, then add the total of the low half to the high half
+    deltas = _mm256_add_epi64(deltas, _mm256_slli_si256(deltas, 8));
+    deltas = _mm256_add_epi64(deltas, _mm256_blend_epi32(_mm256_setzero_si256(),
+      _mm256_permute4x64_epi64(deltas, 0x55), 0xF0));
+    deltas = _mm256_add_epi64(deltas, carry);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4 * k), deltas);
+    carry = _mm256_permute4x64_epi64(deltas, 0xFF);
+  }
+
+  return out[PACK_FRAME_SIZE - 1];
+}
+
+#endif  // FST_SIMD_X86
+
+
+const PackingKernels* GetPackingKernels(ShuffleKernel kernel)
+{
+  static const PackingKernels scalarKernels { UnpackForIntScalar, UnpackDeltaIntScalar, UnpackForInt64Scalar,
+    UnpackDeltaInt64Scalar };
+
+  if (kernel == ShuffleKernel::SCALAR) return &scalarKernels;
+
+#ifdef FST_SIMD_X86
+  static const PackingKernels sse2Kernels { UnpackForIntSse2, UnpackDeltaIntSse2, UnpackForInt64Sse2,
+    UnpackDeltaInt64Sse2 };
+  static const PackingKernels avx2Kernels { UnpackForIntAvx2, UnpackDeltaIntAvx2, UnpackForInt64Avx2,
+    UnpackDeltaInt64Avx2 };
+
+  // instruction set support is detected by the shuffle kernels
+  if (GetShuffleKernels(kernel) == nullptr) return nullptr;
+
+  return kernel == ShuffleKernel::SSE2 ? &sse2Kernels : &avx2Kernels;
+#else
+  return nullptr;
+#endif
+}
+
+
+const PackingKernels &ActivePackingKernels()
+{
+  static const PackingKernels* activeKernels = GetPackingKernels(ActiveShuffleKernel());
+  return *activeKernels;
+}
+
+
+// Base value and bit widths of the FOR and delta encodings
+
+template<typename T, typename U>
+void PackedWidths(const T* src, const unsigned int nrOfInts, int &deltaWidth, int &forWidth, T &minValue)
+{
+  if (nrOfInts == 0)
+  {
+    deltaWidth = 0;
+    forWidth = 0;
+    minValue = 0;
+    return;
+  }
+
+  T maxValue = src[0];
+  U deltaBits = 0;
+  minValue = src[0];
+
+  for (unsigned int pos = 1; pos < nrOfInts; pos++)
+  {
+    const T value = src[pos];
+    deltaBits |= ZigZag(static_cast<U>(static_cast<U>(value) - static_cast<U>(src[pos - 1])));
+
+    if (value < minValue) minValue = value;
+    if (value > maxValue) maxValue = value;
+  }
+
+  deltaWidth = BitWidth(deltaBits);
+  forWidth = BitWidth(static_cast<U>(static_cast<U>(maxValue) - static_cast<U>(minValue)));
+}
+
+
+inline unsigned int PackedSize(const unsigned int nrOfInts, const int width, const unsigned int headerSize)
+{
+  const unsigned int nrOfFrames = (nrOfInts + PACK_FRAME_SIZE - 1) / PACK_FRAME_SIZE;
+  return headerSize + nrOfFrames * (PACK_FRAME_SIZE / 8) * width;
+}
+
+
+void PackedSizesInt(const int* src, unsigned int nrOfInts, unsigned int &deltaSize, unsigned int &forSize)
+{
+  int deltaWidth, forWidth;
+  int minValue;
+
+  PackedWidths<int, unsigned int>(src, nrOfInts, deltaWidth, forWidth, minValue);
+
+  deltaSize = PackedSize(nrOfInts, deltaWidth, PACK_HEADER_INT);
+  forSize = PackedSize(nrOfInts, forWidth, PACK_HEADER_INT);
+}
+
+
+void PackedSizesInt64(const long long* src, unsigned int nrOfInts, unsigned int &deltaSize, unsigned int &forSize)
+{
+  int deltaWidth, forWidth;
+  long long minValue;
+
+  PackedWidths<long long, unsigned long long>(src, nrOfInts, deltaWidth, forWidth, minValue);
+
+  deltaSize = PackedSize(nrOfInts, deltaWidth, PACK_HEADER_INT64);
+  forSize = PackedSize(nrOfInts, forWidth, PACK_HEADER_INT64);
+}
+
+
+unsigned int PackedSizeBound(unsigned int blockSize, unsigned int elementSize)
+{
+  return PackedSize((blockSize + elementSize - 1) / elementSize, 8 * elementSize, 2 * elementSize);
+}
+
+
+// Packed data starts at an arbitrary offset of the block buffer, so words are read and written with memcpy
+
+template<typename U>
+inline void OrWord(char* word, const U bits)
+{
+  U value;
+  memcpy(&value, word, sizeof(U));
+  value |= bits;
+  memcpy(word, &value, sizeof(U));
+}
+
+
+template<typename T, typename U, bool DELTA>
+unsigned int PackCompress(char* dst, const unsigned int dstCapacity, const char* src, const unsigned int srcSize)
+{
+  const int bits = 8 * sizeof(U);
+  const int lanes = 32 / sizeof(U);
+  const unsigned int headerSize = 2 * sizeof(T);
+  const unsigned int nrOfInts = srcSize / sizeof(T);
+  const T* values = reinterpret_cast<const T*>(src);
+
+  int deltaWidth, forWidth;
+  T minValue;
+  PackedWidths<T, U>(values, nrOfInts, deltaWidth, forWidth, minValue);
+
+  const int width = DELTA ? deltaWidth : forWidth;
+  const T base = DELTA ? (nrOfInts == 0 ? 0 : values[0]) : minValue;
+  const unsigned int packedSize = PackedSize(nrOfInts, width, headerSize);
+
+  if (packedSize > dstCapacity) return 0;
+
+  // header
+  memset(dst, 0, packedSize);
+  memcpy(dst, &base, sizeof(T));
+  dst[sizeof(T)] = static_cast<char>(width);
+
+  if (width == 0) return packedSize;
+
+  char* packed = dst + headerSize;
+  U previous = static_cast<U>(base);
+
+  for (unsigned int pos = 0; pos < nrOfInts; pos++)
+  {
+    U value = static_cast<U>(values[pos]);
+
+    if (DELTA)
+    {
+      const U delta = ZigZag(static_cast<U>(value - previous));
+      previous = value;
+      value = delta;
+    }
+    else
+    {
+      value -= static_cast<U>(base);
+    }
+
+    const unsigned int frame = pos / PACK_FRAME_SIZE;
+    const int lane = pos % lanes;
+    const int k = (pos % PACK_FRAME_SIZE) / lanes;
+    const int bit = k * width;
+    const int shift = bit % bits;
+
+    char* word = packed + sizeof(U) * (static_cast<size_t>(frame) * lanes * width + (bit / bits) * lanes + lane);
+    OrWord(word, value << shift);
+    if (shift + width > bits) OrWord(word + sizeof(U) * lanes, value >> (bits - shift));
+  }
+
+  return packedSize;
+}
+
+
+inline int UnpackFrame(const PackingKernels &kernels, const bool delta, const unsigned int* packed, int* out,
+  const int width, const int base)
+{
+  if (delta) return kernels.unpackDeltaInt(packed, out, width, base);
+
+  kernels.unpackForInt(packed, out, width, base);
+  return base;
+}
+
+
+inline long long UnpackFrame(const PackingKernels &kernels, const bool delta, const unsigned long long* packed,
+  long long* out, const int width, const long long base)
+{
+  if (delta) return kernels.unpackDeltaInt64(packed, out, width, base);
+
+  kernels.unpackForInt64(packed, out, width, base);
+  return base;
+}
+
+
+// The kernels read the packed words of a frame as U, a frame at a misaligned offset is copied to 'scratch' first
+template<typename U>
+inline const U* AlignedFrame(const char* frame, const size_t frameBytes, U* scratch)
+{
+  if (reinterpret_cast<uintptr_t>(frame) % sizeof(U) == 0) return reinterpret_cast<const U*>(frame);
+
+  memcpy(scratch, frame, frameBytes);
+  return scratch;
+}
+
+
+template<typename T, typename U, bool DELTA>
+unsigned int PackDecompress(char* dst, const unsigned int dstCapacity, const char* src,
+  const unsigned int compressedSize)
+{
+  const int bits = 8 * sizeof(U);
+  const unsigned int headerSize = 2 * sizeof(T);
+  const unsigned int nrOfInts = dstCapacity / sizeof(T);
+
+  if (compressedSize < headerSize) return 1;
+
+  T base;
+  memcpy(&base, src, sizeof(T));
+  const int width = static_cast<unsigned char>(src[sizeof(T)]);
+
+  if (width > bits || compressedSize != PackedSize(nrOfInts, width, headerSize)) return 1;
+
+  T* out = reinterpret_cast<T*>(dst);
+
+  if (width == 0)  // constant (FOR) or repeated (delta) value
+  {
+    for (unsigned int pos = 0; pos < nrOfInts; pos++) out[pos] = base;
+    return 0;
+  }
+
+  const PackingKernels &kernels = ActivePackingKernels();
+  const char* packed = src + headerSize;
+  const size_t frameBytes = static_cast<size_t>(width) * 32;  // width words of 32 bytes (all lanes)
+  const unsigned int nrOfFrames = nrOfInts / PACK_FRAME_SIZE;
+  U scratch[PACK_FRAME_SIZE];  // a frame has at most PACK_FRAME_SIZE words
+  T carry = base;
+
+  for (unsigned int frame = 0; frame < nrOfFrames; frame++)
+  {
+    carry = UnpackFrame(kernels, DELTA, AlignedFrame(packed + frame * frameBytes, frameBytes, scratch),
+      out + frame * PACK_FRAME_SIZE, width, carry);
+  }
+
+  // padded last frame
+  const unsigned int remain = nrOfInts % PACK_FRAME_SIZE;
+  if (remain != 0)
+  {
+    T lastFrame[PACK_FRAME_SIZE];
+    UnpackFrame(kernels, DELTA, AlignedFrame(packed + nrOfFrames * frameBytes, frameBytes, scratch), lastFrame,
+      width, carry);
+    memcpy(out + nrOfFrames * PACK_FRAME_SIZE, lastFrame, remain * sizeof(T));
+  }
+
+  return 0;
+}
+
+
+unsigned int DELTA_INT_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int)
+{
+  return PackCompress<int, unsigned int, true>(dst, dstCapacity, src, srcSize);
+}
+
+
+unsigned int DELTA_INT_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
+{
+  return PackDecompress<int, unsigned int, true>(dst, dstCapacity, src, compressedSize);
+}
+
+
+unsigned int FOR_INT_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int)
+{
+  return PackCompress<int, unsigned int, false>(dst, dstCapacity, src, srcSize);
+}
+
+
+unsigned int FOR_INT_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
+{
+  return PackDecompress<int, unsigned int, false>(dst, dstCapacity, src, compressedSize);
+}
+
+
+unsigned int DELTA_INT64_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int)
+{
+  return PackCompress<long long, unsigned long long, true>(dst, dstCapacity, src, srcSize);
+}
+
+
+unsigned int DELTA_INT64_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
+{
+  return PackDecompress<long long, unsigned long long, true>(dst, dstCapacity, src, compressedSize);
+}
+
+
+unsigned int FOR_INT64_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int)
+{
+  return PackCompress<long long, unsigned long long, false>(dst, dstCapacity, src, srcSize);
+}
+
+
+unsigned int FOR_INT64_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
+{
+  return PackDecompress<long long, unsigned long long, false>(dst, dstCapacity, src, compressedSize);
+}
@@ -0,0 +1,113 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef BIT_PACKING_H
+#define BIT_PACKING_H
+
+#include <compression/shufflekernels.h>
+
+
+// Integer codecs for sorted keys and timestamps. Each value is converted to an unsigned value that is stored with the
+// minimum number of bits required for all values in the block:
+//
+// frame-of-reference (FOR): value - minimum value of the block
+// delta: zig-zag encoded difference with the previous value (the first value is stored in the header)
+//
+// Values are packed in frames of 256 values. Within a frame, value i is stored in lane (i % LANES) of a set of
+// interleaved 32 bit (or 64 bit) words, with LANES equal to 8 (or 4). That layout allows for a decoder that unpacks
+// a full vector register of consecutive values with a single shift and mask. The last frame is padded with zeros.
+
+#define PACK_FRAME_SIZE    256  // number of values in a frame
+#define PACK_HEADER_INT    8    // int32 base value, uint8 bit width and padding
+#define PACK_HEADER_INT64  16   // int64 base value, uint8 bit width and padding
+
+
+/**
+ * \brief Set of bit-unpacking methods for a single instruction set. Each method decodes a full frame of packed data
+ * with bit width 'width' (1 - 32 or 1 - 64) into PACK_FRAME_SIZE values.
+ *
+ * \param base minimum value of the block for FOR decoding, last value of the previous frame for delta decoding.
+ * \return last value of the frame, only for the delta decoders.
+ */
+struct PackingKernels
+{
+  void (*unpackForInt)(const unsigned int* packed, int* out, int width, int base);
+  int (*unpackDeltaInt)(const unsigned int* packed, int* out, int width, int base);
+  void (*unpackForInt64)(const unsigned long long* packed, long long* out, int width, long long base);
+  long long (*unpackDeltaInt64)(const unsigned long long* packed, long long* out, int width, long long base);
+};
+
+
+/**
+ * \brief Unpack kernels for a specific instruction set.
+ * \param kernel requested instruction set.
+ * \return the kernels or nullptr if the instruction set is not supported by the CPU or the build.
+ */
+const PackingKernels* GetPackingKernels(ShuffleKernel kernel);
+
+
+/**
+ * \brief Unpack kernels for the instruction set that is selected for the byte shuffle (see ActiveShuffleKernel).
+ */
+const PackingKernels &ActivePackingKernels();
+
+
+/**
+ * \brief Calculate the size of an integer vector after delta and FOR bit-packing, without packing the data.
+ * \param src integer vector.
+ * \param nrOfInts number of elements in 'src'.
+ * \param deltaSize size of the delta packed data (including header).
+ * \param forSize size of the FOR packed data (including header).
+ */
+void PackedSizesInt(const int* src, unsigned int nrOfInts, unsigned int &deltaSize, unsigned int &forSize);
+
+
+/**
+ * \brief Calculate the size of an int64 vector after delta and FOR bit-packing, without packing the data.
+ */
+void PackedSizesInt64(const long long* src, unsigned int nrOfInts, unsigned int &deltaSize, unsigned int &forSize);
+
+
+/**
+ * \brief Maximum size of packed data for a block of 'blockSize' bytes.
+ * \param elementSize 4 for integer and 8 for int64 data.
+ */
+unsigned int PackedSizeBound(unsigned int blockSize, unsigned int elementSize);
+
+
+// Codecs with the interface of CompAlgorithm and DecompAlgorithm (see compression.h). The compressors return zero when
+// the packed data does not fit in 'dstCapacity' and the decompressors return a nonzero value for corrupted data.
+
+unsigned int DELTA_INT_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int compressionLevel);
+
+unsigned int DELTA_INT_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize);
+
+unsigned int FOR_INT_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int compressionLevel);
+
+unsigned int FOR_INT_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize);
+
+unsigned int DELTA_INT64_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize,
+  int compressionLevel);
+
+unsigned int DELTA_INT64_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize);
+
+unsigned int FOR_INT64_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int compressionLevel);
+
+unsigned int FOR_INT64_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize);
+
+
+#endif  // BIT_PACKING_H
@@ -24,27 +24,79 @@
 #include <fstream>
 
 #include <compression/compression.h>
+#include <compression/compressioncontext.h>
+#include <compression/shufflekernels.h>
 #include <interface/fstdefines.h>
 
 // #include <unordered_map>
 // #include <boost/unordered_map.hpp>
 
-#include <zstd.h>
-
-#define LZ4_DISABLE_DEPRECATE_WARNINGS  // required for Clang++6.0 compiler error
-#include <lz4.h>
 
 
 using namespace std;
 
 
+// One-shot (de)compression with the reusable contexts of the calling thread
+
+inline size_t ZstdCompress(void* dst, size_t dstCapacity, const void* src, size_t srcSize, int compressionLevel)
+{
+  return ZSTD_compressCCtx(CompressionContext::ForThread().ZstdCompression(), dst, dstCapacity, src, srcSize,
+    compressionLevel);
+}
+
+inline size_t ZstdDecompress(void* dst, size_t dstCapacity, const void* src, size_t compressedSize)
+{
+  return ZSTD_decompressDCtx(CompressionContext::ForThread().ZstdDecompression(), dst, dstCapacity, src, compressedSize);
+}
+
+inline int Lz4Compress(const char* src, char* dst, int srcSize, int dstCapacity, int acceleration)
+{
+  return LZ4_compress_fast_extState(CompressionContext::ForThread().Lz4State(), src, dst, srcSize, dstCapacity,
+    acceleration);
+}
+
+inline unsigned int Lz4HighCompressLevel(const char* src, char* dst, unsigned int srcSize, unsigned int dstCapacity,
+  int compressionLevel)
+{
+  // compression level 0 - 100 maps to LZ4HC_CLEVEL_MIN - LZ4HC_CLEVEL_MAX
+  const int level = LZ4HC_CLEVEL_MIN + (compressionLevel * (LZ4HC_CLEVEL_MAX - LZ4HC_CLEVEL_MIN)) / 100;
+
+  return static_cast<unsigned int>(LZ4_compress_HC_extStateHC(CompressionContext::ForThread().Lz4HighState(), src, dst,
+    static_cast<int>(srcSize), static_cast<int>(dstCapacity), level));
+}
+
+
 size_t MAX_compressBound(size_t srcSize)
 {
 	return max(ZSTD_compressBound(srcSize), LZ4_COMPRESSBOUND(srcSize));
 }
 
-// The size of outVec is expected to be 2 times nrOfDoubles
 void ShuffleReal(double* inVec, double* outVec, int nrOfDoubles)
+{
+  ActiveShuffleKernels().shuffleReal(inVec, outVec, nrOfDoubles);
+}
+
+
+void DeshuffleReal(double* inVec, double* outVec, int nrOfDoubles)
+{
+  ActiveShuffleKernels().deshuffleReal(inVec, outVec, nrOfDoubles);
+}
+
+
+void ShuffleInt2(int* inVec, int* outVec, int nrOfInts)
+{
+  ActiveShuffleKernels().shuffleInt2(inVec, outVec, nrOfInts);
+}
+
+
+void DeshuffleInt2(int* inVec, int* outVec, int nrOfInts)
+{
+  ActiveShuffleKernels().deshuffleInt2(inVec, outVec, nrOfInts);
+}
+
+
+// The size of outVec is expected to be 2 times nrOfDoubles
+void ShuffleRealScalar(double* inVec, double* outVec, int nrOfDoubles)
 {
   int blockLength = nrOfDoubles / 8;
 
@@ -207,7 +259,7 @@ void ShuffleReal(double* inVec, double* outVec, int nrOfDoubles)
 }
 
 
-void DeshuffleReal(double* inVec, double* outVec, int nrOfDoubles)
+void DeshuffleRealScalar(double* inVec, double* outVec, int nrOfDoubles)
 {
   int blockLength = nrOfDoubles / 8;
 
@@ -378,7 +430,7 @@ void DeshuffleReal(double* inVec, double* outVec, int nrOfDoubles)
 
 
 // The size of outVec must be equal to nrOfInts
-void ShuffleInt2(int* inVec, int* outVec, int nrOfInts)
+void ShuffleInt2Scalar(int* inVec, int* outVec, int nrOfInts)
 {
   // Determine block length in number of longs
   int blockLength = nrOfInts / 8;
@@ -453,7 +505,7 @@ void ShuffleInt2(int* inVec, int* outVec, int nrOfInts)
 }
 
 
-void DeshuffleInt2(int* inVec, int* outVec, int nrOfInts)
+void DeshuffleInt2Scalar(int* inVec, int* outVec, int nrOfInts)
 {
   int blockLength = nrOfInts / 8;
 
@@ -926,7 +978,7 @@ unsigned int NoDecompression(char* dst, unsigned int dstCapacity, const char* sr
 
 unsigned int LZ4_C(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, int compressionLevel)
 {
-  return LZ4_compress_fast(src, dst, srcSize, dstCapacity, 101 - compressionLevel);  // no acceleration
+  return Lz4Compress(src, dst, srcSize, dstCapacity, 101 - compressionLevel);  // no acceleration
 }
 
 unsigned int LZ4_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
@@ -939,11 +991,10 @@ unsigned int LZ4_INT_TO_BYTE_C(char* dst, unsigned int dstCapacity, const char*
   int nrOfLongs = 1 + (srcSize - 1) / 32;  // srcSize is processed in blocks of 32 bytes
 
   // Compress buffer
-  char buf[MAX_SIZE_COMPRESS_BLOCK_QUARTER];
-  // char buf[nrOfLongs * 8];
+  char* buf = CompressionContext::ForThread().Buffer(nrOfLongs * 8);
 
   CompactIntToByte(buf, src, srcSize / 4);
-  return LZ4_compress_fast(buf, dst, nrOfLongs * 8, dstCapacity, 101 - compressionLevel);  // no acceleration at compress == 100
+  return Lz4Compress(buf, dst, nrOfLongs * 8, dstCapacity, 101 - compressionLevel);  // no acceleration at compress == 100
 }
 
 unsigned int LZ4_INT_TO_BYTE_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
@@ -952,7 +1003,7 @@ unsigned int LZ4_INT_TO_BYTE_D(char* dst, unsigned int dstCapacity, const char*
   int nrOfDstInts = dstCapacity / 4;
 
   // Compress buffer
-  char buf[MAX_SIZE_COMPRESS_BLOCK_QUARTER];
+  char* buf = CompressionContext::ForThread().Buffer(nrOfLongs * 8);
 
   // Decompress
   unsigned int errorCode = static_cast<unsigned int>(LZ4_decompress_fast(src, (char*) buf, nrOfLongs * 8)) != compressedSize;
@@ -967,11 +1018,11 @@ unsigned int ZSTD_INT_TO_BYTE_C(char* dst, unsigned int dstCapacity, const char*
   int nrOfLongs = 1 + (srcSize - 1) / 32;  // srcSize is processed in blocks of 32 bytes
 
   // Compress buffer
-  char buf[MAX_SIZE_COMPRESS_BLOCK_QUARTER];
+  char* buf = CompressionContext::ForThread().Buffer(nrOfLongs * 8);
 
   CompactIntToByte(buf, src, srcSize / 4);
 
-  return static_cast<unsigned int>(ZSTD_compress(dst, dstCapacity, static_cast<char*>(buf), 8 * nrOfLongs,
+  return static_cast<unsigned int>(ZstdCompress(dst, dstCapacity, static_cast<char*>(buf), 8 * nrOfLongs,
       (compressionLevel * ZSTD_maxCLevel()) / 100));
 }
 
@@ -981,11 +1032,10 @@ unsigned int ZSTD_INT_TO_BYTE_D(char* dst, unsigned int dstCapacity, const char*
   int nrOfDstInts = dstCapacity / 4;
 
   // Compress buffer
-  // char buf[nrOfLongs * 8];
-  char buf[MAX_SIZE_COMPRESS_BLOCK_QUARTER];
+  char* buf = CompressionContext::ForThread().Buffer(nrOfLongs * 8);
 
   // Decompress
-  unsigned int errorCode = static_cast<unsigned int>(ZSTD_decompress((char*) buf, 8 * nrOfLongs, src, compressedSize) != 8 * nrOfLongs);
+  unsigned int errorCode = static_cast<unsigned int>(ZstdDecompress((char*) buf, 8 * nrOfLongs, src, compressedSize) != 8 * nrOfLongs);
   DecompactByteToInt(buf, dst, nrOfDstInts);  // one integer per byte
 
   return errorCode;
@@ -996,10 +1046,10 @@ unsigned int LZ4_INT_TO_SHORT_SHUF2_C(char* dst, unsigned int dstCapacity, const
   int nrOfLongs = 1 + (srcSize - 1) / 16;  // srcSize is processed in blocks of 16 bytes
 
   // Compress buffer
-  char buf[MAX_SIZE_COMPRESS_BLOCK_HALF];
+  char* buf = CompressionContext::ForThread().Buffer(nrOfLongs * 8);
 
   CompactIntToShort(buf, src, srcSize / 4);  // expecting a integer vector here
-  return LZ4_compress_fast(buf, dst, nrOfLongs * 8, dstCapacity, 100 - compressionLevel);  // no acceleration at compress == 100
+  return Lz4Compress(buf, dst, nrOfLongs * 8, dstCapacity, 100 - compressionLevel);  // no acceleration at compress == 100
 }
 
 unsigned int LZ4_INT_TO_SHORT_SHUF2_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
@@ -1008,7 +1058,7 @@ unsigned int LZ4_INT_TO_SHORT_SHUF2_D(char* dst, unsigned int dstCapacity, const
   int nrOfDstInts = dstCapacity / 4;
 
   // Compress buffer
-  char buf[MAX_SIZE_COMPRESS_BLOCK_HALF];
+  char* buf = CompressionContext::ForThread().Buffer(nrOfLongs * 8);
 
   // Decompress
   const unsigned int errorCode = static_cast<unsigned int>(LZ4_decompress_fast(src, static_cast<char*>(buf), nrOfLongs * 8)) != compressedSize;
@@ -1022,11 +1072,11 @@ unsigned int ZSTD_INT_TO_SHORT_SHUF2_C(char* dst, unsigned int dstCapacity, cons
   int nrOfLongs = 1 + (srcSize - 1) / 16;  // srcSize is processed in blocks of 16 bytes
 
   // Compress buffer
-  char buf[MAX_SIZE_COMPRESS_BLOCK_HALF];
+  char* buf = CompressionContext::ForThread().Buffer(nrOfLongs * 8);
 
   CompactIntToShort(buf, src, srcSize / 4);  // expecting a integer vector here
 
-  return static_cast<unsigned int>(ZSTD_compress(dst, dstCapacity, static_cast<char*>(buf), nrOfLongs * 8,
+  return static_cast<unsigned int>(ZstdCompress(dst, dstCapacity, static_cast<char*>(buf), nrOfLongs * 8,
       (compressionLevel * ZSTD_maxCLevel()) / 100));
 }
 
@@ -1036,10 +1086,10 @@ unsigned int ZSTD_INT_TO_SHORT_SHUF2_D(char* dst, unsigned int dstCapacity, cons
   const unsigned int nrOfDstInts = dstCapacity / 4;
 
   // Compress buffer
-  char buf[MAX_SIZE_COMPRESS_BLOCK_HALF];
+  char* buf = CompressionContext::ForThread().Buffer(nrOfLongs * 8);
 
   // Decompress
-  const unsigned int errorCode = ZSTD_decompress(static_cast<char*>(buf), nrOfLongs * 8, src, compressedSize) != nrOfLongs * 8;
+  const unsigned int errorCode = ZstdDecompress(static_cast<char*>(buf), nrOfLongs * 8, src, compressedSize) != nrOfLongs * 8;
 
   DecompactShortToInt(buf, dst, nrOfDstInts);  // one integer per byte
 
@@ -1113,11 +1163,10 @@ unsigned int LZ4_LOGIC64_C(char* dst, unsigned int dstCapacity, const char* src,
   int nrOfLongs = 1 + (nrOfLogicals - 1) / 32;
 
   // Compress buffer
-  // unsigned long long buf[nrOfLongs];
-  unsigned long long buf[MAX_SIZE_COMPRESS_BLOCK_128];
+  unsigned long long* buf = reinterpret_cast<unsigned long long*>(CompressionContext::ForThread().Buffer(nrOfLongs * 8));
 
   LogicCompr64(src, buf, nrOfLogicals);
-  return LZ4_compress_fast((char*) buf, dst, nrOfLongs * 8, dstCapacity, 100 - compressionLevel);  // no acceleration at compress == 100
+  return Lz4Compress((char*) buf, dst, nrOfLongs * 8, dstCapacity, 100 - compressionLevel);  // no acceleration at compress == 100
 }
 
 unsigned int LZ4_LOGIC64_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
@@ -1126,8 +1175,7 @@ unsigned int LZ4_LOGIC64_D(char* dst, unsigned int dstCapacity, const char* src,
   int nrOfLongs = 1 + (nrOfLogicals - 1) / 32;
 
   // Compress buffer
-  // unsigned long long buf[nrOfLongs];
-  unsigned long long buf[MAX_SIZE_COMPRESS_BLOCK_128];
+  unsigned long long* buf = reinterpret_cast<unsigned long long*>(CompressionContext::ForThread().Buffer(nrOfLongs * 8));
 
   // Decompress
   unsigned int errorCode = static_cast<unsigned int>(LZ4_decompress_fast(src, (char*) buf, 8 * nrOfLongs)) != compressedSize;
@@ -1148,12 +1196,11 @@ unsigned int ZSTD_LOGIC64_C(char* dst, unsigned int dstCapacity, const char* src
   int nrOfLongs = 1 + (nrOfLogicals - 1) / 32;
 
   // Compress buffer
-  // unsigned long long buf[nrOfLongs];
-  unsigned long long buf[MAX_SIZE_COMPRESS_BLOCK_128];
+  unsigned long long* buf = reinterpret_cast<unsigned long long*>(CompressionContext::ForThread().Buffer(nrOfLongs * 8));
 
   LogicCompr64(src, buf, nrOfLogicals);
 
-  return static_cast<unsigned int>(ZSTD_compress(dst, dstCapacity, (char*)buf, nrOfLongs * 8,
+  return static_cast<unsigned int>(ZstdCompress(dst, dstCapacity, (char*)buf, nrOfLongs * 8,
       (compressionLevel * ZSTD_maxCLevel()) / 100));
 }
 
@@ -1162,12 +1209,11 @@ unsigned int ZSTD_LOGIC64_D(char* dst, unsigned int dstCapacity, const char* src
   int nrOfLogicals = dstCapacity / 4;
   unsigned int nrOfLongs = 1 + (nrOfLogicals - 1) / 32;
 
-    // Compress buffer
-  // unsigned long long buf[nrOfLongs];
-  unsigned long long buf[MAX_SIZE_COMPRESS_BLOCK_128];
+  // Compress buffer
+  unsigned long long* buf = reinterpret_cast<unsigned long long*>(CompressionContext::ForThread().Buffer(nrOfLongs * 8));
 
   // Decompress
-  unsigned int errorCode = static_cast<unsigned int>(ZSTD_decompress((char*) buf, 8 * nrOfLongs, src, compressedSize) != 8 * nrOfLongs);
+  unsigned int errorCode = static_cast<unsigned int>(ZstdDecompress((char*) buf, 8 * nrOfLongs, src, compressedSize) != 8 * nrOfLongs);
   LogicDecompr64(dst, (unsigned long long*) buf, nrOfLogicals, 0);
 
   return errorCode;
@@ -1182,17 +1228,17 @@ unsigned int LZ4_C_SHUF4(char* dst, unsigned int dstCapacity, const char* src,
 {
   int intSize = srcSize / 4;
 
-  unsigned long long shuffleBuf[MAX_SIZE_COMPRESS_BLOCK_8];
+  char* shuffleBuf = CompressionContext::ForThread().Buffer(srcSize);
 
   ShuffleInt2((int*) src, (int*) shuffleBuf, intSize);
-  return LZ4_compress_fast((char*) shuffleBuf, dst, srcSize, dstCapacity, 100 - compressionLevel);  // large acceleration
+  return Lz4Compress((char*) shuffleBuf, dst, srcSize, dstCapacity, 100 - compressionLevel);  // large acceleration
 }
 
 unsigned int LZ4_D_SHUF4(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
 {
   int intSize = dstCapacity / 4;
 
-  unsigned long long shuffleBuf[MAX_SIZE_COMPRESS_BLOCK_8];
+  char* shuffleBuf = CompressionContext::ForThread().Buffer(dstCapacity);
 
   unsigned int errorCode = static_cast<unsigned int>(LZ4_decompress_fast(src, (char*) shuffleBuf, dstCapacity)) != compressedSize;
   DeshuffleInt2((int*) shuffleBuf, (int*) dst, intSize);
@@ -1209,19 +1255,17 @@ unsigned int LZ4_C_SHUF8(char* dst, unsigned int dstCapacity, const char* src,
 {
   int doubleSize = srcSize / 8;
 
-  // double shuffleBuf[doubleSize];
-  double shuffleBuf[MAX_SIZE_COMPRESS_BLOCK_8];
+  double* shuffleBuf = reinterpret_cast<double*>(CompressionContext::ForThread().Buffer(srcSize));
 
   ShuffleReal((double*) src, shuffleBuf, doubleSize);
-  return LZ4_compress_fast(reinterpret_cast<char*>(shuffleBuf), dst, srcSize, dstCapacity, 100 - compressionLevel);  // large acceleration
+  return Lz4Compress(reinterpret_cast<char*>(shuffleBuf), dst, srcSize, dstCapacity, 100 - compressionLevel);  // large acceleration
 }
 
 unsigned int LZ4_D_SHUF8(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
 {
   int doubleSize = dstCapacity / 8;
 
-  // double shuffleBuf[doubleSize];
-  double shuffleBuf[MAX_SIZE_COMPRESS_BLOCK_8];
+  double* shuffleBuf = reinterpret_cast<double*>(CompressionContext::ForThread().Buffer(dstCapacity));
 
   unsigned int errorCode = static_cast<unsigned int>(LZ4_decompress_fast(src, (char*) shuffleBuf, dstCapacity)) != compressedSize;
   DeshuffleReal(shuffleBuf, (double*) dst, doubleSize);
@@ -1230,17 +1274,44 @@ unsigned int LZ4_D_SHUF8(char* dst, unsigned int dstCapacity, const char* src, u
 }
 
 
+// LZ4HC, LZ4HC_SHUF4 and LZ4HC_SHUF8
+
+unsigned int LZ4HC_C(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, int compressionLevel)
+{
+  return Lz4HighCompressLevel(src, dst, srcSize, dstCapacity, compressionLevel);
+}
+
+
+unsigned int LZ4HC_C_SHUF4(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize,
+  int compressionLevel)
+{
+  char* shuffleBuf = CompressionContext::ForThread().Buffer(srcSize);
+
+  ShuffleInt2((int*) src, (int*) shuffleBuf, srcSize / 4);
+  return Lz4HighCompressLevel(shuffleBuf, dst, srcSize, dstCapacity, compressionLevel);
+}
+
+
+unsigned int LZ4HC_C_SHUF8(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize,
+  int compressionLevel)
+{
+  double* shuffleBuf = reinterpret_cast<double*>(CompressionContext::ForThread().Buffer(srcSize));
+
+  ShuffleReal((double*) src, shuffleBuf, srcSize / 8);
+  return Lz4HighCompressLevel(reinterpret_cast<char*>(shuffleBuf), dst, srcSize, dstCapacity, compressionLevel);
+}
+
+
 // ZSTD_SHUF8
 
 unsigned int ZSTD_C_SHUF8(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, int compressionLevel)
 {
   int doubleSize = srcSize / 8;
 
-  // double shuffleBuf[doubleSize];
-  double shuffleBuf[MAX_SIZE_COMPRESS_BLOCK_8];
+  double* shuffleBuf = reinterpret_cast<double*>(CompressionContext::ForThread().Buffer(srcSize));
 
   ShuffleReal((double*) src, shuffleBuf, doubleSize);
-  return static_cast<unsigned int>(ZSTD_compress(dst, dstCapacity, (char*)shuffleBuf, srcSize,
+  return static_cast<unsigned int>(ZstdCompress(dst, dstCapacity, (char*)shuffleBuf, srcSize,
       (compressionLevel * ZSTD_maxCLevel()) / 100));
 }
 
@@ -1248,10 +1319,9 @@ unsigned int ZSTD_D_SHUF8(char* dst, unsigned int dstCapacity, const char* src,
 {
   int doubleSize = dstCapacity / 8;
 
-  // double shuffleBuf[doubleSize];
-  double shuffleBuf[MAX_SIZE_COMPRESS_BLOCK_8];
+  double* shuffleBuf = reinterpret_cast<double*>(CompressionContext::ForThread().Buffer(dstCapacity));
 
-  unsigned int errorCode = ZSTD_decompress((char*) shuffleBuf, dstCapacity, src, compressedSize) != dstCapacity;
+  unsigned int errorCode = ZstdDecompress((char*) shuffleBuf, dstCapacity, src, compressedSize) != dstCapacity;
   DeshuffleReal(shuffleBuf, (double*) dst, doubleSize);
 
   return errorCode;
@@ -1262,12 +1332,12 @@ unsigned int ZSTD_D_SHUF8(char* dst, unsigned int dstCapacity, const char* src,
 
 unsigned int ZSTD_C(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, int compressionLevel)
 {
-  return static_cast<unsigned int>(ZSTD_compress(dst, dstCapacity, src, srcSize, (compressionLevel * ZSTD_maxCLevel()) / 100));
+  return static_cast<unsigned int>(ZstdCompress(dst, dstCapacity, src, srcSize, (compressionLevel * ZSTD_maxCLevel()) / 100));
 }
 
 unsigned int ZSTD_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
 {
-  return ZSTD_decompress(dst, dstCapacity, src, compressedSize) != dstCapacity;
+  return ZstdDecompress(dst, dstCapacity, src, compressedSize) != dstCapacity;
 }
 
 
@@ -1277,12 +1347,11 @@ unsigned int ZSTD_C_SHUF4(char* dst, unsigned int dstCapacity, const char* src,
 {
   const int int_size = src_size / 4;
 
-  unsigned long long shuffleBuf[MAX_SIZE_COMPRESS_BLOCK_8];
-  // int shuffleBuf[MAX_SIZE_COMPRESS_BLOCK_QUARTER];
+  char* shuffleBuf = CompressionContext::ForThread().Buffer(src_size);
 
   ShuffleInt2((int*) src, reinterpret_cast<int*>(shuffleBuf), int_size);
 
-  return static_cast<unsigned int>(ZSTD_compress(dst, dstCapacity, reinterpret_cast<char*>(shuffleBuf), src_size,
+  return static_cast<unsigned int>(ZstdCompress(dst, dstCapacity, shuffleBuf, src_size,
       (compressionLevel * ZSTD_maxCLevel()) / 100));
 }
 
@@ -1290,9 +1359,9 @@ unsigned int ZSTD_D_SHUF4(char* dst, unsigned int dstCapacity, const char* src,
 {
   int intSize = dstCapacity / 4;
 
-  unsigned long long shuffleBuf[MAX_SIZE_COMPRESS_BLOCK_8];
+  char* shuffleBuf = CompressionContext::ForThread().Buffer(dstCapacity);
 
-  unsigned int errorCode = ZSTD_decompress((char*) shuffleBuf, dstCapacity, src, compressedSize) != dstCapacity;
+  unsigned int errorCode = ZstdDecompress((char*) shuffleBuf, dstCapacity, src, compressedSize) != dstCapacity;
   DeshuffleInt2((int*) shuffleBuf, (int*) dst, intSize);
 
   return errorCode;
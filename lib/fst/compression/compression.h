@@ -25,6 +25,7 @@ size_t MAX_compressBound(size_t srcSize);
 // #define LZ4_COMPRESSBOUND(isize)  ((unsigned)(isize) > (unsigned)LZ4_MAX_INPUT_SIZE ? 0 : (isize) + ((isize)/255) + 16)
 
 // The size of outVec is expected to be 2 times nrOfDoubles
+// The byte shuffle uses the fastest kernel available on the CPU (see shufflekernels.h)
 void ShuffleReal(double* inVec, double* outVec, int nrOfDoubles);
 
 
@@ -38,6 +39,19 @@ void ShuffleInt2(int* inVec, int* outVec, int nrOfInts);
 void DeshuffleInt2(int* inVec, int* outVec, int nrOfInts);
 
 
+// Scalar byte shuffle, these define the shuffled format
+void ShuffleRealScalar(double* inVec, double* outVec, int nrOfDoubles);
+
+
+void DeshuffleRealScalar(double* inVec, double* outVec, int nrOfDoubles);
+
+
+void ShuffleInt2Scalar(int* inVec, int* outVec, int nrOfInts);
+
+
+void DeshuffleInt2Scalar(int* inVec, int* outVec, int nrOfInts);
+
+
 // The first nrOfDiscard decompressed logicals are discarded. Parameter nrOfLogicals includes these discarded values,
 // so nrOfLogicals must be equal or larger than nrOfDiscard.
 void LogicDecompr64(char* logicalVec, const unsigned long long* compBuf, int nrOfLogicals, int nrOfDiscard);
@@ -172,6 +186,22 @@ unsigned int LZ4_C_SHUF8(char* dst, unsigned int dstCapacity, const char* src,
 unsigned int LZ4_D_SHUF8(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize);
 
 
+// High compression LZ4 (LZ4 HC), the resulting blocks are decompressed with LZ4_D, LZ4_D_SHUF4 and
+// LZ4_D_SHUF8 respectively
+
+unsigned int LZ4HC_C(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, int compressionLevel);
+
+
+// srcSize must be a multiple of 4
+unsigned int LZ4HC_C_SHUF4(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize,
+  int compressionLevel);
+
+
+// srcSize must be a multiple of 8
+unsigned int LZ4HC_C_SHUF8(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize,
+  int compressionLevel);
+
+
 // ZSTD_SHUF8
 
 unsigned int ZSTD_C_SHUF8(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, int compressionLevel);
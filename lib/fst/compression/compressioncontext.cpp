@@ -0,0 +1,94 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <stdexcept>
+
+#include <compression/compressioncontext.h>
+#include <interface/fstdefines.h>
+
+
+CompressionContext::~CompressionContext()
+{
+  ZSTD_freeCCtx(zstdCompression);
+  ZSTD_freeDCtx(zstdDecompression);
+  LZ4_freeStream(lz4State);
+  LZ4_freeStreamHC(lz4HighState);
+}
+
+
+CompressionContext &CompressionContext::ForThread()
+{
+  static thread_local CompressionContext context;
+  return context;
+}
+
+
+ZSTD_CCtx* CompressionContext::ZstdCompression()
+{
+  if (zstdCompression != nullptr) return zstdCompression;
+
+  zstdCompression = ZSTD_createCCtx();
+  if (zstdCompression == nullptr) throw(std::runtime_error(FSTERROR_COMPRESSION_CONTEXT));
+
+  return zstdCompression;
+}
+
+
+ZSTD_DCtx* CompressionContext::ZstdDecompression()
+{
+  if (zstdDecompression != nullptr) return zstdDecompression;
+
+  zstdDecompression = ZSTD_createDCtx();
+  if (zstdDecompression == nullptr) throw(std::runtime_error(FSTERROR_COMPRESSION_CONTEXT));
+
+  return zstdDecompression;
+}
+
+
+void* CompressionContext::Lz4State()
+{
+  if (lz4State != nullptr) return lz4State;
+
+  lz4State = LZ4_createStream();
+  if (lz4State == nullptr) throw(std::runtime_error(FSTERROR_COMPRESSION_CONTEXT));
+
+  return lz4State;
+}
+
+
+void* CompressionContext::Lz4HighState()
+{
+  if (lz4HighState != nullptr) return lz4HighState;
+
+  lz4HighState = LZ4_createStreamHC();
+  if (lz4HighState == nullptr) throw(std::runtime_error(FSTERROR_COMPRESSION_CONTEXT));
+
+  return lz4HighState;
+}
+
+
+char* CompressionContext::Buffer(const size_t size)
+{
+  if (size > bufferSize)
+  {
+    const size_t nrOfLongs = (size + 7) / 8;
+    buffer.reset(new unsigned long long[nrOfLongs]);
+    bufferSize = 8 * nrOfLongs;
+  }
+
+  return reinterpret_cast<char*>(buffer.get());
+}
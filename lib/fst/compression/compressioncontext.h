@@ -0,0 +1,91 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef COMPRESSION_CONTEXT_H
+#define COMPRESSION_CONTEXT_H
+
+#include <cstddef>
+#include <memory>
+
+#include <zstd.h>
+
+#define LZ4_DISABLE_DEPRECATE_WARNINGS  // required for Clang++6.0 compiler error
+#include <lz4.h>
+#include <lz4hc.h>
+
+
+/**
+ * \brief Compression and decompression state of a single thread. The one-shot ZSTD and LZ4 API's allocate and
+ * initialize a fresh context for each call, which is significant for blocks of only 16 KB. The contexts of this class
+ * are created on first use and reused for all subsequent blocks that are (de)compressed by the same thread, so the
+ * blockstreamer, the character columns and FstCompressor all share them.
+ *
+ * Each thread has its own instance (see ForThread), so the contexts are never accessed concurrently.
+ */
+class CompressionContext
+{
+  ZSTD_CCtx* zstdCompression = nullptr;
+  ZSTD_DCtx* zstdDecompression = nullptr;
+  LZ4_stream_t* lz4State = nullptr;
+  LZ4_streamHC_t* lz4HighState = nullptr;
+
+  std::unique_ptr<unsigned long long[]> buffer;  // 8-byte aligned scratch buffer
+  size_t bufferSize = 0;
+
+  CompressionContext() { }
+
+public:
+  ~CompressionContext();
+
+  CompressionContext(const CompressionContext &) = delete;
+  CompressionContext &operator=(const CompressionContext &) = delete;
+
+  /**
+   * \brief The context of the calling thread, destroyed when the thread exits.
+   */
+  static CompressionContext &ForThread();
+
+  /**
+   * \brief ZSTD compression context, allocated on first use.
+   */
+  ZSTD_CCtx* ZstdCompression();
+
+  /**
+   * \brief ZSTD decompression context, allocated on first use.
+   */
+  ZSTD_DCtx* ZstdDecompression();
+
+  /**
+   * \brief State for LZ4_compress_fast_extState, allocated on first use.
+   */
+  void* Lz4State();
+
+  /**
+   * \brief State for LZ4_compress_HC_extStateHC, allocated on first use.
+   */
+  void* Lz4HighState();
+
+  /**
+   * \brief Scratch buffer of at least 'size' bytes for shuffled or compacted block data, aligned at 8 bytes. The
+   * buffer grows with the largest block size used by the thread. The content is only valid until the next call.
+   * \param size minimum number of bytes required.
+   */
+  char* Buffer(size_t size);
+};
+
+
+#endif  // COMPRESSION_CONTEXT_H
@@ -16,11 +16,19 @@
 */
 
 #include <algorithm>
+#include <stdexcept>
 #include <fstream>
 #include <cstring>
 
 #include <compression/compressor.h>
 #include <compression/compression.h>
+#include <compression/bitpacking.h>
+#include <compression/compressioncontext.h>
+#include <compression/decimalcodec.h>
+#include <compression/runlength.h>
+#include <compression/xorcodec.h>
+#include <interface/fstdefines.h>
+#include <interface/openmphelper.h>
 
 #define LZ4_DISABLE_DEPRECATE_WARNINGS  // required for Clang++6.0 compiler error
 #include <lz4.h>
@@ -46,7 +54,15 @@ CompAlgorithm compAlgorithms[NR_OF_ALGORITHMS] = {  // all current and historic
   INT_TO_BYTE_C,
   INT_TO_SHORT_C,
   ZSTD_INT_TO_BYTE_C,
-  ZSTD_INT_TO_SHORT_SHUF2_C
+  ZSTD_INT_TO_SHORT_SHUF2_C,
+  DELTA_INT_C,
+  FOR_INT_C,
+  DELTA_INT64_C,
+  FOR_INT64_C,
+  XOR_DOUBLE_C,
+  RLE_INT_C,
+  RLE_INT64_C,
+  DECIMAL_DOUBLE_C
 };
 
 
@@ -66,7 +82,15 @@ DecompAlgorithm decompAlgorithms[NR_OF_ALGORITHMS] = {  // all current and histo
   INT_TO_BYTE_D,
   INT_TO_SHORT_D,
   ZSTD_INT_TO_BYTE_D,
-  ZSTD_INT_TO_SHORT_SHUF2_D
+  ZSTD_INT_TO_SHORT_SHUF2_D,
+  DELTA_INT_D,
+  FOR_INT_D,
+  DELTA_INT64_D,
+  FOR_INT64_D,
+  XOR_DOUBLE_D,
+  RLE_INT_D,
+  RLE_INT64_D,
+  DECIMAL_DOUBLE_D
 };
 
 
@@ -86,7 +110,15 @@ CompAlgoType algorithmType[NR_OF_ALGORITHMS] = {  // type of algorithm
   CompAlgoType::INT_TO_BYTE_TYPE,
   CompAlgoType::INT_TO_SHORT_TYPE,
   CompAlgoType::ZSTD_INT_TO_BYTE_TYPE,
-  CompAlgoType::ZSTD_INT_TO_SHORT_TYPE
+  CompAlgoType::ZSTD_INT_TO_SHORT_TYPE,
+  CompAlgoType::BITPACK_INT_TYPE,
+  CompAlgoType::BITPACK_INT_TYPE,
+  CompAlgoType::BITPACK_INT64_TYPE,
+  CompAlgoType::BITPACK_INT64_TYPE,
+  CompAlgoType::XOR_DOUBLE_TYPE,
+  CompAlgoType::RLE_INT_TYPE,
+  CompAlgoType::RLE_INT64_TYPE,
+  CompAlgoType::DECIMAL_DOUBLE_TYPE
 };
 
 
@@ -107,6 +139,14 @@ unsigned int fixedRatioSourceRepSize[NR_OF_ALGORITHMS] = {  // all current and h
   32,
   16,
   0,
+  0,
+  0,
+  0,
+  0,
+  0,
+  0,
+  0,
+  0,
   0
 };
 
@@ -128,6 +168,14 @@ unsigned int fixedRatioTargetRepSize[NR_OF_ALGORITHMS] = {  // all current and h
   8,
   8,
   0,
+  0,
+  0,
+  0,
+  0,
+  0,
+  0,
+  0,
+  0,
   0
 };
 
@@ -222,6 +270,30 @@ inline int MaxCompressSize(int blockSize, CompAlgoType algoType)
       compBufSize = 8 * nrOfLongs;
       break;
     }
+
+    case CompAlgoType::BITPACK_INT_TYPE:
+      compBufSize = static_cast<int>(PackedSizeBound(blockSize, 4));
+      break;
+
+    case CompAlgoType::BITPACK_INT64_TYPE:
+      compBufSize = static_cast<int>(PackedSizeBound(blockSize, 8));
+      break;
+
+    case CompAlgoType::XOR_DOUBLE_TYPE:
+      compBufSize = static_cast<int>(XorSizeBound(blockSize));
+      break;
+
+    case CompAlgoType::RLE_INT_TYPE:
+      compBufSize = RLE_HEADER_SIZE + 2 * ((blockSize + 3) / 4) * 4;  // a run for each value
+      break;
+
+    case CompAlgoType::RLE_INT64_TYPE:
+      compBufSize = RLE_HEADER_SIZE + ((blockSize + 7) / 8) * 12;  // a run for each value
+      break;
+
+    case CompAlgoType::DECIMAL_DOUBLE_TYPE:
+      compBufSize = static_cast<int>(DecimalSizeBound(blockSize));
+      break;
   }
 
   return compBufSize;
@@ -230,6 +302,9 @@ inline int MaxCompressSize(int blockSize, CompAlgoType algoType)
 
 int Decompressor::Decompress(unsigned int algo, char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
 {
+  // algorithms from a newer fst format
+  if (algo >= NR_OF_ALGORITHMS) throw(std::runtime_error(FSTERROR_COMP_STREAM));
+
   DecompAlgorithm decompAlgorithm = decompAlgorithms[algo];
   return decompAlgorithm(dst, dstCapacity, src, compressedSize);
 }
@@ -277,14 +352,180 @@ int SingleCompressor::Compress(char* dst, unsigned int dstCapacity, const char*
 }
 
 
-DualCompressor::DualCompressor(CompAlgo algo1, CompAlgo algo2, int compressionLevel1, int compressionLevel2)
+Lz4HighCompressor::Lz4HighCompressor(CompAlgo algo1, int compressionLevel)
 {
-  lastCount = 0;
-  a1Count = 0.0;
-  a1Ratio = 50;
-  lastSize1 = 0;
-  lastSize2 = 0;
+  switch (algo1)
+  {
+    case CompAlgo::LZ4:
+      a1 = LZ4HC_C;
+      break;
+
+    case CompAlgo::LZ4_SHUF4:
+      a1 = LZ4HC_C_SHUF4;
+      break;
+
+    case CompAlgo::LZ4_SHUF8:
+      a1 = LZ4HC_C_SHUF8;
+      break;
+
+    default:
+      throw(std::runtime_error(FSTERROR_LZ4_HIGH_ALGORITHM));
+  }
 
+  this->algo1 = algo1;
+  this->compLevel = compressionLevel;
+}
+
+int Lz4HighCompressor::CompressBufferSize(int maxBlockSize)
+{
+  return MaxCompressSize(maxBlockSize, algorithmType[static_cast<int>(algo1)]);
+}
+
+int Lz4HighCompressor::Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize,
+  CompAlgo &compAlgorithm)
+{
+  compAlgorithm = algo1;
+  return a1(dst, dstCapacity, src, srcSize, compLevel);
+}
+
+
+IntegerPackCompressor::IntegerPackCompressor(Compressor* compressor, bool isInt64)
+{
+  compress = compressor;
+  int64 = isInt64;
+}
+
+int IntegerPackCompressor::CompressBufferSize(int maxBlockSize)
+{
+  const int packedSize = MaxCompressSize(maxBlockSize, int64 ? CompAlgoType::BITPACK_INT64_TYPE :
+    CompAlgoType::BITPACK_INT_TYPE);
+
+  return max(compress->CompressBufferSize(maxBlockSize), packedSize);
+}
+
+int IntegerPackCompressor::Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize,
+  CompAlgo &compAlgorithm)
+{
+  const unsigned int rleSize = int64 ? RunLengthSizeInt64(reinterpret_cast<const long long*>(src), srcSize / 8) :
+    RunLengthSizeInt(reinterpret_cast<const int*>(src), srcSize / 4);
+
+  // blocks with few runs are stored as runs without trying the other codecs (runs are also used by predicates)
+  if (rleSize <= srcSize / RLE_DIRECT_RATIO)
+  {
+    compAlgorithm = int64 ? CompAlgo::RLE_INT64 : CompAlgo::RLE_INT;
+    return compAlgorithms[compAlgorithm](dst, dstCapacity, src, srcSize, 0);
+  }
+
+  unsigned int deltaSize, forSize;
+
+  if (int64)
+  {
+    PackedSizesInt64(reinterpret_cast<const long long*>(src), srcSize / 8, deltaSize, forSize);
+  }
+  else
+  {
+    PackedSizesInt(reinterpret_cast<const int*>(src), srcSize / 4, deltaSize, forSize);
+  }
+
+  const int compSize = compress->Compress(dst, dstCapacity, src, srcSize, compAlgorithm);
+
+  const bool useDelta = deltaSize < forSize;
+  const unsigned int packedSize = useDelta ? deltaSize : forSize;
+
+  if (min(packedSize, rleSize) >= static_cast<unsigned int>(compSize)) return compSize;
+
+  if (rleSize <= packedSize)
+  {
+    compAlgorithm = int64 ? CompAlgo::RLE_INT64 : CompAlgo::RLE_INT;
+  }
+  else if (int64)
+  {
+    compAlgorithm = useDelta ? CompAlgo::DELTA_INT64 : CompAlgo::FOR_INT64;
+  }
+  else
+  {
+    compAlgorithm = useDelta ? CompAlgo::DELTA_INT : CompAlgo::FOR_INT;
+  }
+
+  return compAlgorithms[compAlgorithm](dst, dstCapacity, src, srcSize, 0);
+}
+
+
+XorDoubleCompressor::XorDoubleCompressor(Compressor* compressor)
+{
+  compress = compressor;
+}
+
+int XorDoubleCompressor::CompressBufferSize(int maxBlockSize)
+{
+  return compress->CompressBufferSize(maxBlockSize);  // XOR encoding is only used when smaller
+}
+
+int XorDoubleCompressor::Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize,
+  CompAlgo &compAlgorithm)
+{
+  const int compSize = compress->Compress(dst, dstCapacity, src, srcSize, compAlgorithm);
+  if (compSize <= 1) return compSize;
+
+  // the scratch buffer is free after the wrapped compressor is done
+  char* xorBuf = CompressionContext::ForThread().Buffer(compSize);
+  const unsigned int xorSize = XOR_DOUBLE_C(xorBuf, compSize - 1, src, srcSize, 0);
+
+  if (xorSize == 0) return compSize;
+
+  memcpy(dst, xorBuf, xorSize);
+  compAlgorithm = CompAlgo::XOR_DOUBLE;
+
+  return static_cast<int>(xorSize);
+}
+
+
+DecimalDoubleCompressor::DecimalDoubleCompressor(Compressor* compressor, int nrOfDecimals)
+{
+  compress = compressor;
+  decimals = nrOfDecimals;
+}
+
+int DecimalDoubleCompressor::CompressBufferSize(int maxBlockSize)
+{
+  return max(compress->CompressBufferSize(maxBlockSize), MaxCompressSize(maxBlockSize,
+    CompAlgoType::DECIMAL_DOUBLE_TYPE));
+}
+
+int DecimalDoubleCompressor::Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize,
+  CompAlgo &compAlgorithm)
+{
+  const unsigned int decimalSize = DecimalSize(reinterpret_cast<const double*>(src), srcSize / 8, decimals);
+
+  if (decimalSize == 0 || decimalSize > srcSize / DECIMAL_DIRECT_RATIO)
+  {
+    const int compSize = compress->Compress(dst, dstCapacity, src, srcSize, compAlgorithm);
+
+    if (decimalSize == 0 || decimalSize >= static_cast<unsigned int>(compSize)) return compSize;
+  }
+
+  compAlgorithm = CompAlgo::DECIMAL_DOUBLE;
+
+  return static_cast<int>(DecimalEncode(dst, dstCapacity, src, srcSize, decimals));
+}
+
+
+// Start a DualCompressor state from the given statistics
+inline void ResetDualCompressorState(DualCompressorState &state, const int a1Ratio, const int lastSize1,
+  const int lastSize2)
+{
+  state.lastCount = 0;
+  state.a1Count = 0.0;
+  state.a1Ratio = a1Ratio;
+  state.lastSize1 = lastSize1;
+  state.lastSize2 = lastSize2;
+  state.nrOfBlocks = 0;
+}
+
+
+DualCompressor::DualCompressor(CompAlgo algo1, CompAlgo algo2, int compressionLevel1, int compressionLevel2,
+  int nrOfThreads)
+{
   this->algo1 = algo1;
   this->algo2 = algo2;
   this->compLevel1 = compressionLevel1;
@@ -292,6 +533,32 @@ DualCompressor::DualCompressor(CompAlgo algo1, CompAlgo algo2, int compressionLe
 
   a1 = compAlgorithms[static_cast<int>(algo1)];
   a2 = compAlgorithms[static_cast<int>(algo2)];
+
+  nrOfStates = nrOfThreads > 0 ? nrOfThreads : GetFstThreads();
+  threadStates = std::unique_ptr<DualCompressorState[]>(new DualCompressorState[nrOfStates]);
+
+  for (int threadNr = 0; threadNr < nrOfStates; threadNr++)
+  {
+    ResetDualCompressorState(threadStates[threadNr], 50, 0, 0);
+  }
+
+  ResetDualCompressorState(sharedState, 50, 0, 0);
+}
+
+void DualCompressor::PrepareThreadStates(int nrOfThreads)
+{
+  if (nrOfThreads <= nrOfStates) return;
+
+  std::unique_ptr<DualCompressorState[]> states(new DualCompressorState[nrOfThreads]);
+
+  // outside a parallel region all states are equal to the first state
+  for (int threadNr = 0; threadNr < nrOfThreads; threadNr++)
+  {
+    states[threadNr] = threadStates[threadNr < nrOfStates ? threadNr : 0];
+  }
+
+  threadStates = std::move(states);
+  nrOfStates = nrOfThreads;
 }
 
 int DualCompressor::CompressBufferSize(int maxBlockSize)
@@ -303,67 +570,93 @@ int DualCompressor::CompressBufferSize(int maxBlockSize)
 
 int DualCompressor::Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, CompAlgo &compAlgorithm)
 {
-	int lastCountLocal;
-	float a1CountLocal;
-	int a1RatioLocal;
-	int lastSize1Local;
-	int lastSize2Local;
+  // the statistics of the current thread are not shared, PrepareThreadStates provides a state for each thread
+  const int threadNr = CurrentFstThread();
 
-	#pragma omp critical
-	{
-		lastCountLocal = lastCount;
-		a1CountLocal = a1Count;
-		a1RatioLocal = a1Ratio;
-		lastSize1Local = lastSize1;
-		lastSize2Local = lastSize2;
-	}
+  if (threadNr >= 0 && threadNr < nrOfStates)
+  {
+    return CompressBlock(threadStates[threadNr], dst, dstCapacity, src, srcSize, compAlgorithm);
+  }
 
-  a1CountLocal += (a1RatioLocal / 100.0F);  // check for use of algorithm 1
+  // a thread outside the prepared parallel region
+  std::lock_guard<std::mutex> lock(sharedStateLock);
 
-  if (a1CountLocal > lastCountLocal)
+  return CompressBlock(sharedState, dst, dstCapacity, src, srcSize, compAlgorithm);
+}
+
+int DualCompressor::CompressBlock(DualCompressorState &state, char* dst, unsigned int dstCapacity, const char* src,
+  unsigned int srcSize, CompAlgo &compAlgorithm)
+{
+  ++state.nrOfBlocks;
+
+  state.a1Count += (state.a1Ratio / 100.0F);  // check for use of algorithm 1
+
+  if (state.a1Count > state.lastCount)
   {
-    ++lastCountLocal;
+    ++state.lastCount;
     compAlgorithm = algo1;
-    lastSize1Local = a1(dst, dstCapacity, src,  srcSize, compLevel1);
+    state.lastSize1 = a1(dst, dstCapacity, src,  srcSize, compLevel1);
+  }
+  else
+  {
+    compAlgorithm = algo2;
+    state.lastSize2 = a2(dst, dstCapacity, src,  srcSize, compLevel2);
+  }
+
+  if (state.lastSize2 > state.lastSize1)
+  {
+    state.a1Ratio = min(95, state.a1Ratio + 5);
+  }
+  else
+  {
+    state.a1Ratio = max(5, state.a1Ratio - 5);
+  }
 
-    if (lastSize2Local > lastSize1Local)
+  return compAlgorithm == algo1 ? state.lastSize1 : state.lastSize2;
+}
+
+void DualCompressor::MergeThreadStates()
+{
+  int ratioSum = 0, nrOfRatios = 0;
+  long long size1Sum = 0, size2Sum = 0;
+  int nrOfSize1 = 0, nrOfSize2 = 0;
+
+  // the merged state only depends on the thread states, not on the order in which the threads finished
+  for (int threadNr = 0; threadNr <= nrOfStates; threadNr++)
+  {
+    const DualCompressorState &state = threadNr < nrOfStates ? threadStates[threadNr] : sharedState;
+
+    // threads without blocks still have the previous merged statistics
+    if (state.nrOfBlocks == 0) continue;
+
+    ratioSum += state.a1Ratio;
+    ++nrOfRatios;
+
+    if (state.lastSize1 > 0)
     {
-      a1RatioLocal = min(95, a1RatioLocal + 5);
+      size1Sum += state.lastSize1;
+      ++nrOfSize1;
     }
-    else
+
+    if (state.lastSize2 > 0)
     {
-      a1RatioLocal = max(5, a1RatioLocal - 5);
+      size2Sum += state.lastSize2;
+      ++nrOfSize2;
     }
-
-	#pragma omp critical (criticalcompression)
-	{
-		lastCount = lastCountLocal;
-		a1Ratio = a1RatioLocal;
-		lastSize1 = lastSize1Local;
-	}
-
-    return lastSize1Local;
   }
 
-  compAlgorithm = algo2;
-  lastSize2Local = a2(dst, dstCapacity, src,  srcSize, compLevel2);
+  if (nrOfRatios == 0) return;  // no blocks were compressed
 
-  if (lastSize2Local > lastSize1Local)
-  {
-    a1RatioLocal = min(95, a1RatioLocal + 5);
-  }
-  else
+  const int a1Ratio = (ratioSum + nrOfRatios / 2) / nrOfRatios;
+  const int lastSize1 = nrOfSize1 == 0 ? 0 : static_cast<int>(size1Sum / nrOfSize1);
+  const int lastSize2 = nrOfSize2 == 0 ? 0 : static_cast<int>(size2Sum / nrOfSize2);
+
+  for (int threadNr = 0; threadNr < nrOfStates; threadNr++)
   {
-    a1RatioLocal = max(5, a1RatioLocal - 5);
+    ResetDualCompressorState(threadStates[threadNr], a1Ratio, lastSize1, lastSize2);
   }
 
-	#pragma omp critical (criticalcompression)
-	{
-		a1Ratio = a1RatioLocal;
-		lastSize2 = lastSize2Local;
-	}
-
-  return lastSize2Local;
+  ResetDualCompressorState(sharedState, a1Ratio, lastSize1, lastSize2);
 }
 
 
@@ -468,3 +761,65 @@ int StreamCompositeCompressor::Compress(char* src,  unsigned int srcSize, char*
 
   return compSize;
 }
+
+
+StreamAdaptiveCompressor::StreamAdaptiveCompressor(Compressor *compressor1, Compressor *compressor2,
+  float compressionLevel)
+{
+  compress1 = compressor1;
+  compress2 = compressor2;
+  compBufSize = 0;
+
+  const float level = min(max(compressionLevel, 0.0F), 100.0F);
+  strongRatio = ADAPTIVE_STRONG_RATIO - (ADAPTIVE_STRONG_RATIO - ADAPTIVE_MIN_RATIO) * level / 100.0F;
+}
+
+int StreamAdaptiveCompressor::CompressBufferSize()
+{
+  return compBufSize;  // return buffer size for the compression algorithm
+}
+
+int StreamAdaptiveCompressor::CompressBufferSize(unsigned int srcSize)
+{
+  // uncompressed blocks are copied to the compression buffer
+  compBufSize = max(max(compress1->CompressBufferSize(srcSize), compress2->CompressBufferSize(srcSize)),
+    static_cast<int>(srcSize));
+
+  return compBufSize;
+}
+
+float StreamAdaptiveCompressor::SampleRatio(const char* src, unsigned int srcSize) const
+{
+  // the sample starts at a multiple of 16 bytes to keep the element boundaries of the shuffle compressors
+  const unsigned int sampleSize = min(srcSize, static_cast<unsigned int>(ADAPTIVE_SAMPLE_SIZE)) & ~15U;
+  if (sampleSize == 0) return 0.0F;
+
+  const unsigned int sampleStart = ((srcSize - sampleSize) / 2) & ~15U;
+
+  char sampleBuf[2 * ADAPTIVE_SAMPLE_SIZE];
+  CompAlgo sampleAlgorithm;
+
+  const int sampleCompSize = compress1->Compress(sampleBuf, sizeof(sampleBuf), &src[sampleStart], sampleSize,
+    sampleAlgorithm);
+
+  if (sampleCompSize <= 0) return 0.0F;  // the sample does not fit the buffer
+
+  return static_cast<float>(sampleSize) / sampleCompSize;
+}
+
+int StreamAdaptiveCompressor::Compress(char* src,  unsigned int srcSize, char* compBuf, CompAlgo &compAlgorithm, int)
+{
+  const float ratio = SampleRatio(src, srcSize);
+
+  if (ratio < ADAPTIVE_MIN_RATIO)
+  {
+    compAlgorithm = CompAlgo::UNCOMPRESS;
+    memcpy(compBuf, src, srcSize);
+
+    return srcSize;
+  }
+
+  Compressor* compress = ratio >= strongRatio ? compress2 : compress1;
+
+  return compress->Compress(compBuf, compBufSize, src, srcSize, compAlgorithm);
+}
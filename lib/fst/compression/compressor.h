@@ -21,10 +21,18 @@
 #include <compression/compression.h>
 #include <interface/fstdefines.h>
 
+#include <memory>
+#include <mutex>
 
-#define NR_OF_ALGORITHMS 16
+
+#define NR_OF_ALGORITHMS 24
 #define MAX_TARGET_REP_SIZE 8
 #define MAX_SOURCE_REP_SIZE 128
+#define RLE_DIRECT_RATIO 32  // blocks with a run-length encoding of at most 1 / 32 of their size are stored as runs
+#define ADAPTIVE_SAMPLE_SIZE 2048    // bytes of a block that are compressed to estimate its compressibility
+#define ADAPTIVE_MIN_RATIO 1.1F      // blocks with a lower sample compression ratio are stored uncompressed
+#define ADAPTIVE_STRONG_RATIO 4.0F   // blocks with a higher sample compression ratio always use the strong compressor
+#define DECIMAL_DIRECT_RATIO 4  // blocks with a decimal encoding of at most 1 / 4 of their size use it directly
 
 // Compression algorithm types. Used for determining the maximum compression buffer size.
 enum CompAlgoType
@@ -40,7 +48,13 @@ enum CompAlgoType
   INT_TO_BYTE_TYPE,
   INT_TO_SHORT_TYPE,
   ZSTD_INT_TO_BYTE_TYPE,
-  ZSTD_INT_TO_SHORT_TYPE
+  ZSTD_INT_TO_SHORT_TYPE,
+  BITPACK_INT_TYPE,
+  BITPACK_INT64_TYPE,
+  XOR_DOUBLE_TYPE,
+  RLE_INT_TYPE,
+  RLE_INT64_TYPE,
+  DECIMAL_DOUBLE_TYPE
 };
 
 
@@ -61,7 +75,15 @@ enum CompAlgo
   INT_TO_BYTE,
   INT_TO_SHORT,
   ZSTD_INT_TO_BYTE,
-  ZSTD_INT_TO_SHORT_SHUF2
+  ZSTD_INT_TO_SHORT_SHUF2,
+  DELTA_INT,
+  FOR_INT,
+  DELTA_INT64,
+  FOR_INT64,
+  XOR_DOUBLE,
+  RLE_INT,
+  RLE_INT64,
+  DECIMAL_DOUBLE
 };
 
 
@@ -92,6 +114,13 @@ public:
   virtual int Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, CompAlgo &compAlgorithm) = 0;
   virtual int CompressBufferSize(int maxBlockSize) = 0;
 
+  // Make sure that nrOfThreads threads can use the compressor concurrently, call before a parallel compression.
+  virtual void PrepareThreadStates(int /* nrOfThreads */) {}
+
+  // Merge the statistics that were collected by the threads after a parallel compression. Compressors that adapt to
+  // the compressed data override this method, wrapping compressors forward it.
+  virtual void MergeThreadStates() {}
+
   virtual ~Compressor() {}
 };
 
@@ -174,18 +203,184 @@ public:
 };
 
 
-class DualCompressor : public Compressor
+/**
+ A compressor that uses the high compression LZ4 encoder (LZ4 HC) for the LZ4, LZ4_SHUF4 or LZ4_SHUF8
+ algorithm. The blocks are stored with the same algorithm identifiers as the fast LZ4 encoder, so files remain readable
+ by all fst versions and decompression is just as fast, but encoding is much slower. Intended for data that is written
+ once and read many times.
+*/
+class Lz4HighCompressor : public Compressor
 {
 private:
-  CompAlgorithm a1, a2;
-  CompAlgo algo1, algo2;
-  int compLevel1, compLevel2;
+  CompAlgorithm a1;
+  CompAlgo algo1;
+  int compLevel;
+
+public:
+
+  /**
+   Constructor for a high compression LZ4 compressor.
+
+   @param algo1 LZ4, LZ4_SHUF4 or LZ4_SHUF8.
+   @param compressionLevel Level of compression (0 - 100), mapped to LZ4 HC levels 3 - 12.
+   */
+  Lz4HighCompressor(CompAlgo algo1, int compressionLevel);
+
+  int CompressBufferSize(int maxBlockSize);
+
+  int Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, CompAlgo &compAlgorithm);
+};
+
+
+/**
+ A compressor for integer or int64 vectors that stores a block with delta or frame-of-reference bit-packing or with
+ run-length encoding when that results in a smaller block than the wrapped compressor. The packed and run-length
+ encoded sizes are calculated from the values, so the data is only encoded when it is selected. Blocks with few runs
+ (see RLE_DIRECT_RATIO) are run-length encoded without trying the wrapped compressor.
+*/
+class IntegerPackCompressor : public Compressor
+{
+private:
+  Compressor* compress;
+  bool int64;
+
+public:
+
+  /**
+   Constructor for a bit-packing compressor.
+
+   @param compressor Compressor used for blocks that do not benefit from bit-packing or run-length encoding (the
+          IntegerPackCompressor takes ownership).
+   @param isInt64 True for 64 bit integer vectors, false for 32 bit integer vectors.
+   */
+  IntegerPackCompressor(Compressor* compressor, bool isInt64);
+
+  ~IntegerPackCompressor() { delete compress; }
 
+  IntegerPackCompressor(const IntegerPackCompressor &) = delete;
+  IntegerPackCompressor &operator=(const IntegerPackCompressor &) = delete;
+
+  int CompressBufferSize(int maxBlockSize);
+
+  void PrepareThreadStates(int nrOfThreads) { compress->PrepareThreadStates(nrOfThreads); }
+
+  void MergeThreadStates() { compress->MergeThreadStates(); }
+
+  int Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, CompAlgo &compAlgorithm);
+};
+
+
+/**
+ A compressor for double vectors that stores a block with the XOR codec (XOR_DOUBLE) when that results in a smaller
+ block than the wrapped compressor. XOR encoding is stopped as soon as it exceeds the size of the wrapped compressor's
+ output.
+*/
+class XorDoubleCompressor : public Compressor
+{
+private:
+  Compressor* compress;
+
+public:
+
+  /**
+   Constructor for a XOR compressor.
+
+   @param compressor Compressor used for blocks that do not benefit from XOR encoding (the XorDoubleCompressor takes
+          ownership).
+   */
+  XorDoubleCompressor(Compressor* compressor);
+
+  ~XorDoubleCompressor() { delete compress; }
+
+  XorDoubleCompressor(const XorDoubleCompressor &) = delete;
+  XorDoubleCompressor &operator=(const XorDoubleCompressor &) = delete;
+
+  int CompressBufferSize(int maxBlockSize);
+
+  void PrepareThreadStates(int nrOfThreads) { compress->PrepareThreadStates(nrOfThreads); }
+
+  void MergeThreadStates() { compress->MergeThreadStates(); }
+
+  int Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, CompAlgo &compAlgorithm);
+};
+
+
+/**
+ A compressor for double vectors that stores a block as scaled integers (DECIMAL_DOUBLE) when all values have a limited
+ number of decimals. Blocks with a decimal encoding of at most 1 / DECIMAL_DIRECT_RATIO of their size are encoded
+ without trying the wrapped compressor, because they also decode faster. Other blocks use the smallest result.
+*/
+class DecimalDoubleCompressor : public Compressor
+{
+private:
+  Compressor* compress;
+  int decimals;
+
+public:
+
+  /**
+   Constructor for a decimal compressor.
+
+   @param compressor Compressor used for blocks that can't be stored as scaled integers or that are smaller with the
+          wrapped compressor (the DecimalDoubleCompressor takes ownership).
+   @param nrOfDecimals Number of decimals of the values or DECIMAL_DETECT to detect it for each block.
+   */
+  DecimalDoubleCompressor(Compressor* compressor, int nrOfDecimals);
+
+  ~DecimalDoubleCompressor() { delete compress; }
+
+  DecimalDoubleCompressor(const DecimalDoubleCompressor &) = delete;
+  DecimalDoubleCompressor &operator=(const DecimalDoubleCompressor &) = delete;
+
+  int CompressBufferSize(int maxBlockSize);
+
+  void PrepareThreadStates(int nrOfThreads) { compress->PrepareThreadStates(nrOfThreads); }
+
+  void MergeThreadStates() { compress->MergeThreadStates(); }
+
+  int Compress(char* dst, unsigned int dstCapacity, const char* src,  unsigned int srcSize, CompAlgo &compAlgorithm);
+};
+
+
+// Running statistics of a DualCompressor. Each thread updates its own copy, the padding keeps the statistics of
+// different threads in separate cache lines.
+struct DualCompressorState
+{
   int lastCount;
   float a1Count;
   int a1Ratio;
   int lastSize1;
   int lastSize2;
+  int nrOfBlocks;  // blocks compressed since the last merge
+  char padding[104];
+};
+
+
+/**
+ A compressor with two competing algorithms. The share of blocks that is compressed with the first algorithm is
+ increased when its last block was smaller than the last block of the second algorithm, and decreased otherwise.
+ Each thread keeps its own statistics, so compressing a block never takes a lock. With a static schedule the blocks
+ that a thread compresses are fixed, so the output only depends on the number of threads. PrepareThreadStates
+ provides a state for each thread of the parallel region and the statistics of the threads are merged (in thread
+ order) with MergeThreadStates after a parallel compression. Threads that don't have a state share a single state that is
+protected by a lock.
+*/
+class DualCompressor : public Compressor
+{
+private:
+  CompAlgorithm a1, a2;
+  CompAlgo algo1, algo2;
+  int compLevel1, compLevel2;
+
+  int nrOfStates;
+  std::unique_ptr<DualCompressorState[]> threadStates;  // one for each thread
+
+  // state of threads outside the parallel region prepared with PrepareThreadStates
+  DualCompressorState sharedState;
+  std::mutex sharedStateLock;
+
+  int CompressBlock(DualCompressorState &state, char* dst, unsigned int dstCapacity, const char* src,
+    unsigned int srcSize, CompAlgo &compAlgorithm);
 
 public:
 
@@ -194,11 +389,30 @@ public:
 
    @param algo1 First compression algorithm.
    @param algo2 Second compression algorithm.
+   @param nrOfThreads Initial number of threads that use the compressor concurrently (GetFstThreads() if zero).
    */
-  DualCompressor(CompAlgo algo1, CompAlgo algo2, int compressionLevel1, int compressionLevel2);
+  DualCompressor(CompAlgo algo1, CompAlgo algo2, int compressionLevel1, int compressionLevel2, int nrOfThreads = 0);
 
   int CompressBufferSize(int maxBlockSize);
 
+  /**
+  Add states for a parallel region with nrOfThreads threads. The new states start from the statistics of the first
+  state, which are shared by all states after construction or a merge.
+  */
+  void PrepareThreadStates(int nrOfThreads);
+
+  /**
+  Merge the statistics of all threads and start each thread from the merged statistics. The share of the first
+  algorithm becomes the average share of the threads that compressed a block and the last block sizes the average of
+  the threads that compressed a block with that algorithm.
+  */
+  void MergeThreadStates();
+
+  /**
+  Percentage of the blocks that is compressed with the first algorithm (after merging the thread states).
+  */
+  int Algorithm1Ratio() const { return threadStates[0].a1Ratio; }
+
   /**
   Compress src into dst using compressionLevel (0 - 100)
 
@@ -221,6 +435,14 @@ public:
 
   virtual int CompressBufferSize() = 0;
 
+  // Prepare the compressors for a parallel compression with nrOfThreads threads (see
+  // Compressor::PrepareThreadStates).
+  virtual void PrepareThreadStates(int nrOfThreads) = 0;
+
+  // Merge the thread statistics of the compressors after all blocks have been compressed (see
+  // Compressor::MergeThreadStates).
+  virtual void MergeThreadStates() = 0;
+
   virtual ~StreamCompressor() {};
 };
 
@@ -245,6 +467,10 @@ public:
   int CompressBufferSize(unsigned int srcSize);
 
   int Compress(char* src, unsigned int srcSize, char* compBuf, CompAlgo &compAlgorithm, int blockNr);
+
+  void PrepareThreadStates(int nrOfThreads) { compress->PrepareThreadStates(nrOfThreads); }
+
+  void MergeThreadStates() { compress->MergeThreadStates(); }
 };
 
 
@@ -283,6 +509,10 @@ public:
     @param compAlgorithm Algorithm that was used for compression.
   */
   int Compress(char* src, unsigned int srcSize, char* compBuf, CompAlgo &compAlgorithm, int blockNr);
+
+  void PrepareThreadStates(int nrOfThreads) { compress->PrepareThreadStates(nrOfThreads); }
+
+  void MergeThreadStates() { compress->MergeThreadStates(); }
 };
 
 
@@ -328,6 +558,68 @@ public:
     @param compAlgorithm Algorithm that was used for compression.
   */
   int Compress(char* src,  unsigned int srcSize, char* compBuf, CompAlgo &compAlgorithm, int blockNr);
+
+  void PrepareThreadStates(int nrOfThreads)
+  {
+    compress1->PrepareThreadStates(nrOfThreads);
+    compress2->PrepareThreadStates(nrOfThreads);
+  }
+
+  void MergeThreadStates()
+  {
+    compress1->MergeThreadStates();
+    compress2->MergeThreadStates();
+  }
+};
+
+
+/**
+ A compressor that selects the codec of each block from an estimate of the block's compressibility. A slice of
+ ADAPTIVE_SAMPLE_SIZE bytes from the middle of the block is compressed with the fast compressor and the resulting
+ ratio decides: blocks that hardly compress are stored uncompressed, redundant blocks are compressed with the strong
+ compressor and the remaining blocks with the fast compressor. Unlike the DualCompressor, the selection has no shared
+ state, so blocks are compressed by concurrent threads without synchronization and the result doesn't depend on the
+ order in which blocks are compressed.
+*/
+class StreamAdaptiveCompressor : public StreamCompressor
+{
+private:
+  Compressor* compress1;
+  Compressor* compress2;
+  float strongRatio;  // minimum sample compression ratio for the strong compressor
+  int compBufSize;
+
+  float SampleRatio(const char* src, unsigned int srcSize) const;
+
+public:
+
+/**
+   Constructor for a StreamAdaptiveCompressor
+
+   @param compressor1 Fast compressor, also used to compress the sample (for example a LZ4 variant).
+   @param compressor2 Strong compressor (for example a ZSTD variant).
+   @param compressionLevel Value 0 - 100 indicating the compression level. Higher levels use the strong compressor for
+          less redundant blocks, down to all blocks that are not stored uncompressed at level 100.
+*/
+  StreamAdaptiveCompressor(Compressor *compressor1, Compressor *compressor2, float compressionLevel);
+
+  int CompressBufferSize();
+
+  int CompressBufferSize(unsigned int srcSize);
+
+  int Compress(char* src,  unsigned int srcSize, char* compBuf, CompAlgo &compAlgorithm, int blockNr);
+
+  void PrepareThreadStates(int nrOfThreads)
+  {
+    compress1->PrepareThreadStates(nrOfThreads);
+    compress2->PrepareThreadStates(nrOfThreads);
+  }
+
+  void MergeThreadStates()
+  {
+    compress1->MergeThreadStates();
+    compress2->MergeThreadStates();
+  }
 };
 
 
@@ -0,0 +1,266 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <compression/bitpacking.h>
+#include <compression/compressioncontext.h>
+#include <compression/decimalcodec.h>
+
+
+#define DECIMAL_MAX_INT 9007199254740992.0  // 2^53, larger integers are not exact as a double
+
+static const double powersOfTen[DECIMAL_MAX_SCALE + 1] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+
+// Scaled integer of 'value' if 'value' is the correctly rounded result of dividing that integer by 10^scale
+inline bool ScaledInteger(const double value, const int scale, long long &scaled)
+{
+  const double product = value * powersOfTen[scale];
+
+  if (!(std::fabs(product) < DECIMAL_MAX_INT)) return false;  // also false for NaN and infinite values
+
+  scaled = std::llround(product);
+  const double restored = static_cast<double>(scaled) / powersOfTen[scale];
+
+  return memcmp(&restored, &value, 8) == 0;  // bit for bit, so -0.0 is rejected
+}
+
+
+/**
+ * \brief Smallest scale that represents all values, starting at 'decimals' (or zero for DECIMAL_DETECT).
+ * \return the scale or -1 if the values can't be represented.
+ */
+int DecimalScale(const double* src, const unsigned int nrOfDoubles, const int decimals, unsigned int &nrOfNaN,
+  unsigned long long &nanBits)
+{
+  if (decimals > DECIMAL_MAX_SCALE) return -1;
+
+  int scale = decimals == DECIMAL_DETECT ? 0 : decimals;
+  nrOfNaN = 0;
+  nanBits = 0;
+
+  for (unsigned int pos = 0; pos < nrOfDoubles; pos++)
+  {
+    const double value = src[pos];
+
+    if (std::isnan(value))
+    {
+      unsigned long long bits;
+      memcpy(&bits, &value, 8);
+
+      if (nrOfNaN != 0 && bits != nanBits) return -1;
+
+      ++nrOfNaN;
+      nanBits = bits;
+      continue;
+    }
+
+    long long scaled;
+
+    // a value that is exact at a scale is also exact at a higher scale (within the range of DECIMAL_MAX_INT)
+    while (!ScaledInteger(value, scale, scaled))
+    {
+      if (decimals != DECIMAL_DETECT || scale == DECIMAL_MAX_SCALE) return -1;
+      ++scale;
+    }
+  }
+
+  return scale;
+}
+
+
+/**
+ * \brief Scale all values to integers, NaN values get the scaled value of the previous (or first) value.
+ * \return false if a value exceeds the range of DECIMAL_MAX_INT at 'scale'.
+ */
+bool ScaleDecimals(const double* src, const unsigned int nrOfDoubles, const int scale, long long* scaled)
+{
+  long long previous = 0;
+  unsigned int nrOfLeadingNaN = 0;
+
+  for (unsigned int pos = 0; pos < nrOfDoubles; pos++)
+  {
+    if (std::isnan(src[pos]))
+    {
+      if (pos == nrOfLeadingNaN) ++nrOfLeadingNaN;
+      scaled[pos] = previous;
+      continue;
+    }
+
+    if (!ScaledInteger(src[pos], scale, scaled[pos])) return false;
+    previous = scaled[pos];
+  }
+
+  if (nrOfLeadingNaN < nrOfDoubles)
+  {
+    for (unsigned int pos = 0; pos < nrOfLeadingNaN; pos++) scaled[pos] = scaled[nrOfLeadingNaN];
+  }
+
+  return true;
+}
+
+
+unsigned int DecimalSizeBound(unsigned int blockSize)
+{
+  return DECIMAL_HEADER_SIZE + PackedSizeBound(blockSize, 8) + 4 * ((blockSize + 7) / 8);
+}
+
+
+unsigned int DecimalSize(const double* src, unsigned int nrOfDoubles, int decimals)
+{
+  unsigned int nrOfNaN;
+  unsigned long long nanBits;
+
+  const int scale = DecimalScale(src, nrOfDoubles, decimals, nrOfNaN, nanBits);
+  if (scale < 0) return 0;
+
+  long long* scaled = reinterpret_cast<long long*>(CompressionContext::ForThread().Buffer(8 * nrOfDoubles));
+  if (!ScaleDecimals(src, nrOfDoubles, scale, scaled)) return 0;
+
+  unsigned int deltaSize, forSize;
+  PackedSizesInt64(scaled, nrOfDoubles, deltaSize, forSize);
+
+  return DECIMAL_HEADER_SIZE + std::min(deltaSize, forSize) + 4 * nrOfNaN;
+}
+
+
+unsigned int DecimalEncode(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int decimals)
+{
+  const unsigned int nrOfDoubles = srcSize / 8;
+  const double* values = reinterpret_cast<const double*>(src);
+
+  unsigned int nrOfNaN;
+  unsigned long long nanBits;
+
+  const int scale = DecimalScale(values, nrOfDoubles, decimals, nrOfNaN, nanBits);
+  if (scale < 0) return 0;
+
+  long long* scaled = reinterpret_cast<long long*>(CompressionContext::ForThread().Buffer(srcSize));
+  if (!ScaleDecimals(values, nrOfDoubles, scale, scaled)) return 0;
+
+  unsigned int deltaSize, forSize;
+  PackedSizesInt64(scaled, nrOfDoubles, deltaSize, forSize);
+
+  const bool useDelta = deltaSize < forSize;
+  const unsigned int packedSize = useDelta ? deltaSize : forSize;
+  const unsigned int encodedSize = DECIMAL_HEADER_SIZE + packedSize + 4 * nrOfNaN;
+
+  if (encodedSize > dstCapacity) return 0;
+
+  // header
+  memset(dst, 0, DECIMAL_HEADER_SIZE);
+  dst[0] = static_cast<char>(scale);
+  dst[1] = useDelta ? 0 : 1;
+  memcpy(&dst[4], &nrOfNaN, 4);
+  memcpy(&dst[8], &nanBits, 8);
+
+  const char* scaledData = reinterpret_cast<const char*>(scaled);
+
+  if (useDelta)
+  {
+    DELTA_INT64_C(&dst[DECIMAL_HEADER_SIZE], packedSize, scaledData, srcSize, 0);
+  }
+  else
+  {
+    FOR_INT64_C(&dst[DECIMAL_HEADER_SIZE], packedSize, scaledData, srcSize, 0);
+  }
+
+  // positions of the NaN values
+  char* nanPositions = &dst[DECIMAL_HEADER_SIZE + packedSize];
+
+  for (unsigned int pos = 0; nrOfNaN != 0 && pos < nrOfDoubles; pos++)
+  {
+    if (!std::isnan(values[pos])) continue;
+
+    memcpy(nanPositions, &pos, 4);
+    nanPositions += 4;
+  }
+
+  return encodedSize;
+}
+
+
+unsigned int DECIMAL_DOUBLE_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int)
+{
+  return DecimalEncode(dst, dstCapacity, src, srcSize, DECIMAL_DETECT);
+}
+
+
+unsigned int DECIMAL_DOUBLE_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
+{
+  if (compressedSize < DECIMAL_HEADER_SIZE) return 1;
+
+  const int scale = static_cast<unsigned char>(src[0]);
+  const int packing = static_cast<unsigned char>(src[1]);
+
+  unsigned int nrOfNaN;
+  memcpy(&nrOfNaN, &src[4], 4);
+
+  const unsigned int nrOfDoubles = dstCapacity / 8;
+
+  if (scale > DECIMAL_MAX_SCALE || packing > 1 || nrOfNaN > nrOfDoubles) return 1;
+  if (compressedSize < DECIMAL_HEADER_SIZE + 4 * nrOfNaN) return 1;
+
+  const unsigned int packedSize = compressedSize - DECIMAL_HEADER_SIZE - 4 * nrOfNaN;
+
+  // the scaled integers are unpacked in place
+  const unsigned int result = packing == 0 ?
+    DELTA_INT64_D(dst, dstCapacity, &src[DECIMAL_HEADER_SIZE], packedSize) :
+    FOR_INT64_D(dst, dstCapacity, &src[DECIMAL_HEADER_SIZE], packedSize);
+
+  if (result != 0) return result;
+
+  const double divisor = powersOfTen[scale];
+
+  long long scaled[PACK_FRAME_SIZE];
+  double values[PACK_FRAME_SIZE];
+
+  // convert a frame at a time, the conversion loop has no dependencies between values so it is vectorized
+  for (unsigned int frameStart = 0; frameStart < nrOfDoubles; frameStart += PACK_FRAME_SIZE)
+  {
+    const unsigned int count = std::min(static_cast<unsigned int>(PACK_FRAME_SIZE), nrOfDoubles - frameStart);
+    char* frame = &dst[8 * static_cast<size_t>(frameStart)];
+
+    memcpy(scaled, frame, 8 * count);
+
+    for (unsigned int pos = 0; pos < count; pos++)
+    {
+      values[pos] = static_cast<double>(scaled[pos]) / divisor;
+    }
+
+    memcpy(frame, values, 8 * count);
+  }
+
+  // NaN values
+  const char* nanPositions = &src[DECIMAL_HEADER_SIZE + packedSize];
+
+  for (unsigned int nanNr = 0; nanNr < nrOfNaN; nanNr++)
+  {
+    unsigned int pos;
+    memcpy(&pos, &nanPositions[4 * nanNr], 4);
+
+    if (pos >= nrOfDoubles) return 1;
+
+    memcpy(&dst[8 * static_cast<size_t>(pos)], &src[8], 8);
+  }
+
+  return 0;
+}
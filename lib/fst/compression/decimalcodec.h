@@ -0,0 +1,81 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#ifndef DECIMAL_CODEC_H
+#define DECIMAL_CODEC_H
+
+
+// Scaled-decimal codec for double vectors. Prices and quantities often have a few decimals, such values are the
+// integers 'n' for which n / 10^scale (correctly rounded) equals the original double. A block of such values is stored
+// as delta or frame-of-reference bit-packed int64 values (see bitpacking.h) with the scale in the header:
+//
+// [uint8 scale][uint8 packing (0: delta, 1: frame-of-reference)][2 bytes padding][uint32 nrOfNaN][uint64 NaN bits]
+// [packed int64 values][nrOfNaN x uint32 position]
+//
+// A single NaN bit pattern (for example the NA value) is allowed per block. NaN values are packed as the previous
+// value, so they don't widen the packed values, and their positions are stored after the packed values. Values are
+// only encoded when they are restored bit for bit, other blocks (including blocks with -0.0, infinite values or more
+// than DECIMAL_MAX_SCALE decimals) use a different codec.
+
+#define DECIMAL_MAX_SCALE    9   // maximum number of decimals
+#define DECIMAL_HEADER_SIZE  16
+#define DECIMAL_DETECT       -1  // detect the number of decimals from the data
+
+
+/**
+ * \brief Maximum size of decimal encoded data for a block of 'blockSize' bytes.
+ */
+unsigned int DecimalSizeBound(unsigned int blockSize);
+
+
+/**
+ * \brief Size of the decimal encoding of a double vector, calculated without encoding the data.
+ * \param src double values.
+ * \param nrOfDoubles number of values.
+ * \param decimals number of decimals or DECIMAL_DETECT for the smallest number of decimals that represents all values.
+ * \return size of the encoding or zero if the values can't be represented with the (maximum) number of decimals.
+ */
+unsigned int DecimalSize(const double* src, unsigned int nrOfDoubles, int decimals);
+
+
+/**
+ * \brief Encode a double vector as scaled integers.
+ * \param decimals number of decimals or DECIMAL_DETECT for the smallest number of decimals that represents all values.
+ * \return size of the encoded data or zero if the values can't be represented with the (maximum) number of decimals
+ * or the encoding does not fit in 'dstCapacity' bytes.
+ */
+unsigned int DecimalEncode(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int decimals);
+
+
+/**
+ * \brief Encode a double vector as scaled integers with the interface of CompAlgorithm (see compression.h). The number
+ * of decimals is detected from the data.
+ * \return size of the encoded data or zero if the values can't be encoded.
+ */
+unsigned int DECIMAL_DOUBLE_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize,
+  int compressionLevel);
+
+
+/**
+ * \brief Decode scaled integers into 'dstCapacity' bytes of doubles.
+ * \return zero on success, a nonzero value for corrupted data.
+ */
+unsigned int DECIMAL_DOUBLE_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize);
+
+
+#endif  // DECIMAL_CODEC_H
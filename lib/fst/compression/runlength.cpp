@@ -0,0 +1,207 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include <compression/runlength.h>
+
+
+using namespace std;
+
+
+// Number of runs of equal consecutive values
+template<typename T>
+inline unsigned int RunCount(const T* src, const unsigned int nrOfElements)
+{
+  if (nrOfElements == 0) return 0;
+
+  unsigned int nrOfRuns = 1;
+
+  for (unsigned int pos = 1; pos < nrOfElements; pos++)
+  {
+    nrOfRuns += src[pos] != src[pos - 1];
+  }
+
+  return nrOfRuns;
+}
+
+
+template<typename T>
+inline unsigned int RunLengthSize(const T* src, const unsigned int nrOfElements)
+{
+  return RLE_HEADER_SIZE + RunCount(src, nrOfElements) * static_cast<unsigned int>(4 + sizeof(T));
+}
+
+
+template<typename T>
+inline unsigned int RunLengthEncode(char* dst, const unsigned int dstCapacity, const char* src,
+  const unsigned int srcSize)
+{
+  const unsigned int nrOfElements = srcSize / sizeof(T);
+  const T* values = reinterpret_cast<const T*>(src);
+
+  // the runs are counted first to locate the values section
+  const unsigned int nrOfRuns = RunCount(values, nrOfElements);
+  const unsigned long long encodedSize = RLE_HEADER_SIZE + static_cast<unsigned long long>(nrOfRuns) * (4 + sizeof(T));
+
+  if (encodedSize > dstCapacity) return 0;
+
+  memcpy(dst, &nrOfRuns, 4);
+  char* lengthP = dst + RLE_HEADER_SIZE;
+  char* valueP = lengthP + 4 * static_cast<size_t>(nrOfRuns);
+
+  unsigned int runStart = 0;
+
+  for (unsigned int pos = 1; pos <= nrOfElements; pos++)
+  {
+    if (pos < nrOfElements && values[pos] == values[runStart]) continue;
+
+    const unsigned int runLength = pos - runStart;
+    memcpy(lengthP, &runLength, 4);
+    memcpy(valueP, &values[runStart], sizeof(T));
+
+    lengthP += 4;
+    valueP += sizeof(T);
+    runStart = pos;
+  }
+
+  return static_cast<unsigned int>(encodedSize);
+}
+
+
+// Validate the header and run lengths of encoded data, returns the number of runs or zero for corrupted data
+inline unsigned int RunLengthHeader(const char* src, const unsigned int compressedSize, const unsigned int valueSize,
+  const unsigned int nrOfElements)
+{
+  if (compressedSize < RLE_HEADER_SIZE) return 0;
+
+  unsigned int nrOfRuns;
+  memcpy(&nrOfRuns, src, 4);
+
+  if (nrOfRuns == 0 || nrOfRuns > nrOfElements) return 0;
+  if (compressedSize != RLE_HEADER_SIZE + static_cast<unsigned long long>(nrOfRuns) * (4 + valueSize)) return 0;
+
+  unsigned long long totLength = 0;
+  const char* lengthP = src + RLE_HEADER_SIZE;
+
+  for (unsigned int run = 0; run < nrOfRuns; run++)
+  {
+    unsigned int runLength;
+    memcpy(&runLength, lengthP + 4 * static_cast<size_t>(run), 4);
+
+    if (runLength == 0) return 0;
+    totLength += runLength;
+  }
+
+  return totLength == nrOfElements ? nrOfRuns : 0;
+}
+
+
+template<typename T>
+inline unsigned int RunLengthDecode(char* dst, const unsigned int dstCapacity, const char* src,
+  const unsigned int compressedSize)
+{
+  const unsigned int nrOfElements = dstCapacity / sizeof(T);
+  const unsigned int nrOfRuns = RunLengthHeader(src, compressedSize, sizeof(T), nrOfElements);
+
+  if (nrOfRuns == 0) return 1;
+
+  const char* lengthP = src + RLE_HEADER_SIZE;
+  const char* valueP = lengthP + 4 * static_cast<size_t>(nrOfRuns);
+  T* out = reinterpret_cast<T*>(dst);
+
+  for (unsigned int run = 0; run < nrOfRuns; run++)
+  {
+    unsigned int runLength;
+    T value;
+
+    memcpy(&runLength, lengthP + 4 * static_cast<size_t>(run), 4);
+    memcpy(&value, valueP + sizeof(T) * run, sizeof(T));
+
+    std::fill(out, out + runLength, value);
+    out += runLength;
+  }
+
+  return 0;
+}
+
+
+unsigned int RunLengthSizeInt(const int* src, unsigned int nrOfInts)
+{
+  return RunLengthSize(src, nrOfInts);
+}
+
+
+unsigned int RunLengthSizeInt64(const long long* src, unsigned int nrOfInts)
+{
+  return RunLengthSize(src, nrOfInts);
+}
+
+
+unsigned int RLE_INT_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int)
+{
+  return RunLengthEncode<int>(dst, dstCapacity, src, srcSize);
+}
+
+
+unsigned int RLE_INT_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
+{
+  return RunLengthDecode<int>(dst, dstCapacity, src, compressedSize);
+}
+
+
+unsigned int RLE_INT64_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int)
+{
+  return RunLengthEncode<long long>(dst, dstCapacity, src, srcSize);
+}
+
+
+unsigned int RLE_INT64_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
+{
+  return RunLengthDecode<long long>(dst, dstCapacity, src, compressedSize);
+}
+
+
+unsigned int RunLengthRuns(const char* src, unsigned int compressedSize, int elementSize, unsigned int nrOfElements,
+  vector<unsigned int> &runLengths, vector<long long> &runValues)
+{
+  const unsigned int nrOfRuns = RunLengthHeader(src, compressedSize, elementSize, nrOfElements);
+
+  if (nrOfRuns == 0) return 1;
+
+  runLengths.resize(nrOfRuns);
+  runValues.resize(nrOfRuns);
+
+  const char* valueP = src + RLE_HEADER_SIZE + 4 * static_cast<size_t>(nrOfRuns);
+  memcpy(runLengths.data(), src + RLE_HEADER_SIZE, 4 * static_cast<size_t>(nrOfRuns));
+
+  if (elementSize == 8)
+  {
+    memcpy(runValues.data(), valueP, 8 * static_cast<size_t>(nrOfRuns));
+    return 0;
+  }
+
+  for (unsigned int run = 0; run < nrOfRuns; run++)
+  {
+    int value;
+    memcpy(&value, valueP + 4 * static_cast<size_t>(run), 4);
+    runValues[run] = value;
+  }
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef RUN_LENGTH_H
+#define RUN_LENGTH_H
+
+#include <vector>
+
+
+// Run-length codec for integer (INT_32, FACTOR, BOOL_2) and int64 vectors. A block is stored as the number of runs,
+// followed by the length of each run and the value of each run:
+//
+// [uint32 nrOfRuns][nrOfRuns x uint32 run length][nrOfRuns x value]
+//
+// The runs can be used directly by predicate evaluation and counting, without expanding them to the block values.
+
+#define RLE_HEADER_SIZE 4
+
+
+/**
+ * \brief Size of the run-length encoding of an integer vector, calculated without encoding the data.
+ */
+unsigned int RunLengthSizeInt(const int* src, unsigned int nrOfInts);
+
+
+/**
+ * \brief Size of the run-length encoding of an int64 vector, calculated without encoding the data.
+ */
+unsigned int RunLengthSizeInt64(const long long* src, unsigned int nrOfInts);
+
+
+/**
+ * \brief Run-length encode an integer vector with the interface of CompAlgorithm (see compression.h).
+ * \return size of the encoded data or zero if it does not fit in 'dstCapacity' bytes.
+ */
+unsigned int RLE_INT_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int compressionLevel);
+
+
+/**
+ * \brief Decode run-length encoded integers into 'dstCapacity' bytes.
+ * \return zero on success, a nonzero value for corrupted data.
+ */
+unsigned int RLE_INT_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize);
+
+
+/**
+ * \brief Run-length encode an int64 vector with the interface of CompAlgorithm (see compression.h).
+ * \return size of the encoded data or zero if it does not fit in 'dstCapacity' bytes.
+ */
+unsigned int RLE_INT64_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize,
+  int compressionLevel);
+
+
+/**
+ * \brief Decode run-length encoded int64 values into 'dstCapacity' bytes.
+ * \return zero on success, a nonzero value for corrupted data.
+ */
+unsigned int RLE_INT64_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize);
+
+
+/**
+ * \brief Extract the runs of run-length encoded data without expanding them.
+ * \param src encoded data.
+ * \param compressedSize size of the encoded data.
+ * \param elementSize 4 for integer data (RLE_INT) or 8 for int64 data (RLE_INT64).
+ * \param nrOfElements number of elements in the block.
+ * \param runLengths length of each run (output).
+ * \param runValues value of each run (output), integer values are widened to 64 bits.
+ * \return zero on success, a nonzero value for corrupted data.
+ */
+unsigned int RunLengthRuns(const char* src, unsigned int compressedSize, int elementSize, unsigned int nrOfElements,
+  std::vector<unsigned int> &runLengths, std::vector<long long> &runValues);
+
+
+#endif  // RUN_LENGTH_H
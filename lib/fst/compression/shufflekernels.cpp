@@ -0,0 +1,535 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <cstddef>
+#include <cstring>
+
+#include <compression/compression.h>
+#include <compression/shufflekernels.h>
+#include <compression/simdtargets.h>
+
+
+
+
+// The scalar shuffle stores byte 'b' of all elements in pass 'nrOfBytes - 1 - b'. Within a pass, each group of 8
+// elements occupies 8 bytes in a permuted order. The methods below handle the groups that are not covered by the
+// vectorized loops and copy the remaining (nrOfElements % 8) elements unmodified, like the scalar implementation.
+
+// Position of element 'elem' of a group of 8 doubles within its pass
+inline int RealPosition(int elem)
+{
+  return 7 - elem;
+}
+
+
+// Position of element 'elem' of a group of 8 integers within its pass
+inline int IntPosition(int elem)
+{
+  return 4 * (elem & 1) + 3 - elem / 2;
+}
+
+
+void ShuffleRealGroups(const char* src, char* dst, int nrOfDoubles, int firstGroup)
+{
+  const int blockLength = nrOfDoubles / 8;
+  const size_t passSize = 8 * static_cast<size_t>(blockLength);
+
+  for (int group = firstGroup; group < blockLength; group++)
+  {
+    for (int elem = 0; elem < 8; elem++)
+    {
+      for (int byte = 0; byte < 8; byte++)
+      {
+        dst[(7 - byte) * passSize + 8 * group + RealPosition(elem)] = src[64 * group + 8 * elem + byte];
+      }
+    }
+  }
+
+  memcpy(dst + 64 * blockLength, src + 64 * blockLength, 8 * (nrOfDoubles % 8));
+}
+
+
+void DeshuffleRealGroups(const char* src, char* dst, int nrOfDoubles, int firstGroup)
+{
+  const int blockLength = nrOfDoubles / 8;
+  const size_t passSize = 8 * static_cast<size_t>(blockLength);
+
+  for (int group = firstGroup; group < blockLength; group++)
+  {
+    for (int elem = 0; elem < 8; elem++)
+    {
+      for (int byte = 0; byte < 8; byte++)
+      {
+        dst[64 * group + 8 * elem + byte] = src[(7 - byte) * passSize + 8 * group + RealPosition(elem)];
+      }
+    }
+  }
+
+  memcpy(dst + 64 * blockLength, src + 64 * blockLength, 8 * (nrOfDoubles % 8));
+}
+
+
+void ShuffleInt2Groups(const char* src, char* dst, int nrOfInts, int firstGroup)
+{
+  const int blockLength = nrOfInts / 8;
+  const size_t passSize = 8 * static_cast<size_t>(blockLength);
+
+  for (int group = firstGroup; group < blockLength; group++)
+  {
+    for (int elem = 0; elem < 8; elem++)
+    {
+      for (int byte = 0; byte < 4; byte++)
+      {
+        dst[(3 - byte) * passSize + 8 * group + IntPosition(elem)] = src[32 * group + 4 * elem + byte];
+      }
+    }
+  }
+
+  memcpy(dst + 32 * blockLength, src + 32 * blockLength, 4 * (nrOfInts % 8));
+}
+
+
+void DeshuffleInt2Groups(const char* src, char* dst, int nrOfInts, int firstGroup)
+{
+  const int blockLength = nrOfInts / 8;
+  const size_t passSize = 8 * static_cast<size_t>(blockLength);
+
+  for (int group = firstGroup; group < blockLength; group++)
+  {
+    for (int elem = 0; elem < 8; elem++)
+    {
+      for (int byte = 0; byte < 4; byte++)
+      {
+        dst[32 * group + 4 * elem + byte] = src[(3 - byte) * passSize + 8 * group + IntPosition(elem)];
+      }
+    }
+  }
+
+  memcpy(dst + 32 * blockLength, src + 32 * blockLength, 4 * (nrOfInts % 8));
+}
+
+
+#ifdef FST_SIMD_X86
+
+// The vectorized kernels transpose 128 bytes at a time, held in 8 vectors of 16 bytes (or in each 128 bit lane
+// of 8 AVX2 vectors). Interleaving vector k with vector k + 4 (k < 4) with unpacklo/unpackhi_epi8 into vectors 2k
+// and 2k + 1 rotates the 7 bit address (vector, position) of every byte one bit to the left. The elements are first
+// loaded in their shuffled order, after which a rotation of 4 (doubles) or 5 (integers) bits moves byte b of every
+// element into the vectors of pass b. Deshuffling completes the rotation to 7 bits.
+
+template<int NR_OF_BITS>
+FST_TARGET_SSE2 inline void RotateSse2(__m128i* vec)
+{
+  for (int bit = 0; bit < NR_OF_BITS; bit++)
+  {
+    const __m128i vec0 = vec[0], vec1 = vec[1], vec2 = vec[2], vec3 = vec[3];
+
+    vec[0] = _mm_unpacklo_epi8(vec0, vec[4]);
+    vec[1] = _mm_unpackhi_epi8(vec0, vec[4]);
+    vec[2] = _mm_unpacklo_epi8(vec1, vec[5]);
+    vec[3] = _mm_unpackhi_epi8(vec1, vec[5]);
+    vec[4] = _mm_unpacklo_epi8(vec2, vec[6]);
+    vec[5] = _mm_unpackhi_epi8(vec2, vec[6]);
+    vec[6] = _mm_unpacklo_epi8(vec3, vec[7]);
+    vec[7] = _mm_unpackhi_epi8(vec3, vec[7]);
+  }
+}
+
+
+template<int NR_OF_BITS>
+FST_TARGET_AVX2 inline void RotateAvx2(__m256i* vec)
+{
+  for (int bit = 0; bit < NR_OF_BITS; bit++)
+  {
+    const __m256i vec0 = vec[0], vec1 = vec[1], vec2 = vec[2], vec3 = vec[3];
+
+    vec[0] = _mm256_unpacklo_epi8(vec0, vec[4]);
+    vec[1] = _mm256_unpackhi_epi8(vec0, vec[4]);
+    vec[2] = _mm256_unpacklo_epi8(vec1, vec[5]);
+    vec[3] = _mm256_unpackhi_epi8(vec1, vec[5]);
+    vec[4] = _mm256_unpacklo_epi8(vec2, vec[6]);
+    vec[5] = _mm256_unpackhi_epi8(vec2, vec[6]);
+    vec[6] = _mm256_unpacklo_epi8(vec3, vec[7]);
+    vec[7] = _mm256_unpackhi_epi8(vec3, vec[7]);
+  }
+}
+
+
+// Load two 16 byte vectors into the lanes of a 32 byte vector
+FST_TARGET_AVX2 inline __m256i LoadLanes(const char* low, const char* high)
+{
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(low))),
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(high)), 1);
+}
+
+
+// Store the lanes of a 32 byte vector
+FST_TARGET_AVX2 inline void StoreLanes(char* low, char* high, __m256i vec)
+{
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(low), _mm256_castsi256_si128(vec));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(high), _mm256_extracti128_si256(vec, 1));
+}
+
+
+// Doubles, 2 groups of 8 doubles per 128 bytes. Within a group, the doubles are stored in reverse order, so the
+// pairs of doubles are loaded from back to front and swapped.
+
+FST_TARGET_SSE2 void ShuffleRealSse2(double* inVec, double* outVec, int nrOfDoubles)
+{
+  const char* src = reinterpret_cast<const char*>(inVec);
+  char* dst = reinterpret_cast<char*>(outVec);
+
+  const int nrOfUnits = nrOfDoubles / 16;
+  const size_t passSize = 8 * static_cast<size_t>(nrOfDoubles / 8);
+
+  for (int unit = 0; unit < nrOfUnits; unit++)
+  {
+    const __m128i* in = reinterpret_cast<const __m128i*>(src + 128 * unit);
+    __m128i vec[8];
+
+    for (int pair = 0; pair < 4; pair++)
+    {
+      vec[pair]     = _mm_shuffle_epi32(_mm_loadu_si128(in + 3 - pair), 0x4E);
+      vec[pair + 4] = _mm_shuffle_epi32(_mm_loadu_si128(in + 7 - pair), 0x4E);
+    }
+
+    RotateSse2<4>(vec);
+
+    for (int byte = 0; byte < 8; byte++)
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (7 - byte) * passSize + 16 * unit), vec[byte]);
+    }
+  }
+
+  ShuffleRealGroups(src, dst, nrOfDoubles, 2 * nrOfUnits);
+}
+
+
+FST_TARGET_SSE2 void DeshuffleRealSse2(double* inVec, double* outVec, int nrOfDoubles)
+{
+  const char* src = reinterpret_cast<const char*>(inVec);
+  char* dst = reinterpret_cast<char*>(outVec);
+
+  const int nrOfUnits = nrOfDoubles / 16;
+  const size_t passSize = 8 * static_cast<size_t>(nrOfDoubles / 8);
+
+  for (int unit = 0; unit < nrOfUnits; unit++)
+  {
+    __m128i vec[8];
+
+    for (int byte = 0; byte < 8; byte++)
+    {
+      vec[byte] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (7 - byte) * passSize + 16 * unit));
+    }
+
+    RotateSse2<3>(vec);
+
+    __m128i* out = reinterpret_cast<__m128i*>(dst + 128 * unit);
+
+    for (int pair = 0; pair < 4; pair++)
+    {
+      _mm_storeu_si128(out + 3 - pair, _mm_shuffle_epi32(vec[pair], 0x4E));
+      _mm_storeu_si128(out + 7 - pair, _mm_shuffle_epi32(vec[pair + 4], 0x4E));
+    }
+  }
+
+  DeshuffleRealGroups(src, dst, nrOfDoubles, 2 * nrOfUnits);
+}
+
+
+FST_TARGET_AVX2 void ShuffleRealAvx2(double* inVec, double* outVec, int nrOfDoubles)
+{
+  const char* src = reinterpret_cast<const char*>(inVec);
+  char* dst = reinterpret_cast<char*>(outVec);
+
+  const int nrOfUnits = 2 * (nrOfDoubles / 32);  // lanes process consecutive units
+  const size_t passSize = 8 * static_cast<size_t>(nrOfDoubles / 8);
+
+  for (int unit = 0; unit < nrOfUnits; unit += 2)
+  {
+    const char* in = src + 128 * unit;
+    __m256i vec[8];
+
+    for (int pair = 0; pair < 4; pair++)
+    {
+      vec[pair]     = _mm256_shuffle_epi32(LoadLanes(in + 16 * (3 - pair), in + 128 + 16 * (3 - pair)), 0x4E);
+      vec[pair + 4] = _mm256_shuffle_epi32(LoadLanes(in + 16 * (7 - pair), in + 128 + 16 * (7 - pair)), 0x4E);
+    }
+
+    RotateAvx2<4>(vec);
+
+    for (int byte = 0; byte < 8; byte++)
+    {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + (7 - byte) * passSize + 16 * unit), vec[byte]);
+    }
+  }
+
+  ShuffleRealGroups(src, dst, nrOfDoubles, 2 * nrOfUnits);
+}
+
+
+FST_TARGET_AVX2 void DeshuffleRealAvx2(double* inVec, double* outVec, int nrOfDoubles)
+{
+  const char* src = reinterpret_cast<const char*>(inVec);
+  char* dst = reinterpret_cast<char*>(outVec);
+
+  const int nrOfUnits = 2 * (nrOfDoubles / 32);
+  const size_t passSize = 8 * static_cast<size_t>(nrOfDoubles / 8);
+
+  for (int unit = 0; unit < nrOfUnits; unit += 2)
+  {
+    __m256i vec[8];
+
+    for (int byte = 0; byte < 8; byte++)
+    {
+      vec[byte] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (7 - byte) * passSize + 16 * unit));
+    }
+
+    RotateAvx2<3>(vec);
+
+    char* out = dst + 128 * unit;
+
+    for (int pair = 0; pair < 4; pair++)
+    {
+      StoreLanes(out + 16 * (3 - pair), out + 128 + 16 * (3 - pair), _mm256_shuffle_epi32(vec[pair], 0x4E));
+      StoreLanes(out + 16 * (7 - pair), out + 128 + 16 * (7 - pair), _mm256_shuffle_epi32(vec[pair + 4], 0x4E));
+    }
+  }
+
+  DeshuffleRealGroups(src, dst, nrOfDoubles, 2 * nrOfUnits);
+}
+
+
+// Integers, 4 groups of 8 integers per 128 bytes. Within a group, the integers are stored in the order
+// 6, 4, 2, 0, 7, 5, 3, 1, so each group is split in a vector with the even and a vector with the odd elements.
+
+FST_TARGET_SSE2 void ShuffleInt2Sse2(int* inVec, int* outVec, int nrOfInts)
+{
+  const char* src = reinterpret_cast<const char*>(inVec);
+  char* dst = reinterpret_cast<char*>(outVec);
+
+  const int nrOfUnits = nrOfInts / 32;
+  const size_t passSize = 8 * static_cast<size_t>(nrOfInts / 8);
+
+  for (int unit = 0; unit < nrOfUnits; unit++)
+  {
+    const __m128i* in = reinterpret_cast<const __m128i*>(src + 128 * unit);
+    __m128i vec[8];
+
+    for (int group = 0; group < 4; group++)
+    {
+      // elements 2, 0, 3, 1 and 6, 4, 7, 5
+      const __m128i low = _mm_shuffle_epi32(_mm_loadu_si128(in + 2 * group), _MM_SHUFFLE(1, 3, 0, 2));
+      const __m128i high = _mm_shuffle_epi32(_mm_loadu_si128(in + 2 * group + 1), _MM_SHUFFLE(1, 3, 0, 2));
+
+      vec[2 * group]     = _mm_unpacklo_epi64(high, low);
+      vec[2 * group + 1] = _mm_unpackhi_epi64(high, low);
+    }
+
+    RotateSse2<5>(vec);
+
+    for (int byte = 0; byte < 4; byte++)
+    {
+      char* out = dst + (3 - byte) * passSize + 32 * unit;
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), vec[2 * byte]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), vec[2 * byte + 1]);
+    }
+  }
+
+  ShuffleInt2Groups(src, dst, nrOfInts, 4 * nrOfUnits);
+}
+
+
+FST_TARGET_SSE2 void DeshuffleInt2Sse2(int* inVec, int* outVec, int nrOfInts)
+{
+  const char* src = reinterpret_cast<const char*>(inVec);
+  char* dst = reinterpret_cast<char*>(outVec);
+
+  const int nrOfUnits = nrOfInts / 32;
+  const size_t passSize = 8 * static_cast<size_t>(nrOfInts / 8);
+
+  for (int unit = 0; unit < nrOfUnits; unit++)
+  {
+    __m128i vec[8];
+
+    for (int byte = 0; byte < 4; byte++)
+    {
+      const char* in = src + (3 - byte) * passSize + 32 * unit;
+      vec[2 * byte]     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+      vec[2 * byte + 1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16));
+    }
+
+    RotateSse2<2>(vec);
+
+    __m128i* out = reinterpret_cast<__m128i*>(dst + 128 * unit);
+
+    for (int group = 0; group < 4; group++)
+    {
+      const __m128i low = _mm_unpackhi_epi64(vec[2 * group], vec[2 * group + 1]);
+      const __m128i high = _mm_unpacklo_epi64(vec[2 * group], vec[2 * group + 1]);
+
+      _mm_storeu_si128(out + 2 * group, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 0, 3, 1)));
+      _mm_storeu_si128(out + 2 * group + 1, _mm_shuffle_epi32(high, _MM_SHUFFLE(2, 0, 3, 1)));
+    }
+  }
+
+  DeshuffleInt2Groups(src, dst, nrOfInts, 4 * nrOfUnits);
+}
+
+
+FST_TARGET_AVX2 void ShuffleInt2Avx2(int* inVec, int* outVec, int nrOfInts)
+{
+  const char* src = reinterpret_cast<const char*>(inVec);
+  char* dst = reinterpret_cast<char*>(outVec);
+
+  const int nrOfUnits = 2 * (nrOfInts / 64);  // lanes process consecutive units
+  const size_t passSize = 8 * static_cast<size_t>(nrOfInts / 8);
+
+  for (int unit = 0; unit < nrOfUnits; unit += 2)
+  {
+    const char* in = src + 128 * unit;
+    __m256i vec[8];
+
+    for (int group = 0; group < 4; group++)
+    {
+      const __m256i low = _mm256_shuffle_epi32(LoadLanes(in + 32 * group, in + 128 + 32 * group),
+        _MM_SHUFFLE(1, 3, 0, 2));
+      const __m256i high = _mm256_shuffle_epi32(LoadLanes(in + 32 * group + 16, in + 144 + 32 * group),
+        _MM_SHUFFLE(1, 3, 0, 2));
+
+      vec[2 * group]     = _mm256_unpacklo_epi64(high, low);
+      vec[2 * group + 1] = _mm256_unpackhi_epi64(high, low);
+    }
+
+    RotateAvx2<5>(vec);
+
+    for (int byte = 0; byte < 4; byte++)
+    {
+      // both halves of a unit are stored consecutively
+      __m256i* out = reinterpret_cast<__m256i*>(dst + (3 - byte) * passSize + 32 * unit);
+      _mm256_storeu_si256(out, _mm256_permute2x128_si256(vec[2 * byte], vec[2 * byte + 1], 0x20));
+      _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(vec[2 * byte], vec[2 * byte + 1], 0x31));
+    }
+  }
+
+  ShuffleInt2Groups(src, dst, nrOfInts, 4 * nrOfUnits);
+}
+
+
+FST_TARGET_AVX2 void DeshuffleInt2Avx2(int* inVec, int* outVec, int nrOfInts)
+{
+  const char* src = reinterpret_cast<const char*>(inVec);
+  char* dst = reinterpret_cast<char*>(outVec);
+
+  const int nrOfUnits = 2 * (nrOfInts / 64);
+  const size_t passSize = 8 * static_cast<size_t>(nrOfInts / 8);
+
+  for (int unit = 0; unit < nrOfUnits; unit += 2)
+  {
+    __m256i vec[8];
+
+    for (int byte = 0; byte < 4; byte++)
+    {
+      const char* in = src + (3 - byte) * passSize + 32 * unit;
+      const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+      const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32));
+
+      vec[2 * byte]     = _mm256_permute2x128_si256(first, second, 0x20);
+      vec[2 * byte + 1] = _mm256_permute2x128_si256(first, second, 0x31);
+    }
+
+    RotateAvx2<2>(vec);
+
+    char* out = dst + 128 * unit;
+
+    for (int group = 0; group < 4; group++)
+    {
+      const __m256i low = _mm256_unpackhi_epi64(vec[2 * group], vec[2 * group + 1]);
+      const __m256i high = _mm256_unpacklo_epi64(vec[2 * group], vec[2 * group + 1]);
+
+      StoreLanes(out + 32 * group, out + 128 + 32 * group, _mm256_shuffle_epi32(low, _MM_SHUFFLE(2, 0, 3, 1)));
+      StoreLanes(out + 32 * group + 16, out + 144 + 32 * group, _mm256_shuffle_epi32(high, _MM_SHUFFLE(2, 0, 3, 1)));
+    }
+  }
+
+  DeshuffleInt2Groups(src, dst, nrOfInts, 4 * nrOfUnits);
+}
+
+
+bool CpuSupports(ShuffleKernel kernel)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  const int maxLeaf = info[0];
+
+  __cpuid(info, 1);
+  if (kernel == ShuffleKernel::SSE2) return (info[3] & (1 << 26)) != 0;
+
+  // AVX2 also requires the OS to save the upper halves of the ymm registers
+  const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+  if (!osSavesYmm || maxLeaf < 7) return false;
+
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  __builtin_cpu_init();
+
+  if (kernel == ShuffleKernel::SSE2) return __builtin_cpu_supports("sse2") != 0;
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif  // FST_SIMD_X86
+
+
+const ShuffleKernels* GetShuffleKernels(ShuffleKernel kernel)
+{
+  static const ShuffleKernels scalarKernels { ShuffleRealScalar, DeshuffleRealScalar, ShuffleInt2Scalar,
+    DeshuffleInt2Scalar };
+
+  if (kernel == ShuffleKernel::SCALAR) return &scalarKernels;
+
+#ifdef FST_SIMD_X86
+  static const ShuffleKernels sse2Kernels { ShuffleRealSse2, DeshuffleRealSse2, ShuffleInt2Sse2, DeshuffleInt2Sse2 };
+  static const ShuffleKernels avx2Kernels { ShuffleRealAvx2, DeshuffleRealAvx2, ShuffleInt2Avx2, DeshuffleInt2Avx2 };
+
+  if (!CpuSupports(kernel)) return nullptr;
+
+  return kernel == ShuffleKernel::SSE2 ? &sse2Kernels : &avx2Kernels;
+#else
+  return nullptr;
+#endif
+}
+
+
+ShuffleKernel ActiveShuffleKernel()
+{
+  static const ShuffleKernel activeKernel =
+    GetShuffleKernels(ShuffleKernel::AVX2) != nullptr ? ShuffleKernel::AVX2 :
+    GetShuffleKernels(ShuffleKernel::SSE2) != nullptr ? ShuffleKernel::SSE2 :
+    ShuffleKernel::SCALAR;
+
+  return activeKernel;
+}
+
+
+const ShuffleKernels &ActiveShuffleKernels()
+{
+  static const ShuffleKernels* activeKernels = GetShuffleKernels(ActiveShuffleKernel());
+  return *activeKernels;
+}
@@ -0,0 +1,66 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef SHUFFLE_KERNELS_H
+#define SHUFFLE_KERNELS_H
+
+
+/**
+ * \brief Instruction sets with an implementation of the byte shuffle used by the SHUF4 and SHUF8 compressors.
+ * All kernels produce output that is bit-identical to the scalar implementation.
+ */
+enum class ShuffleKernel
+{
+  SCALAR = 0,  // portable implementation (ShuffleRealScalar and friends)
+  SSE2,        // 128 bit vectors, x86 only
+  AVX2         // 256 bit vectors, x86 only
+};
+
+
+/**
+ * \brief Set of shuffle and deshuffle methods for a single instruction set.
+ */
+struct ShuffleKernels
+{
+  void (*shuffleReal)(double* inVec, double* outVec, int nrOfDoubles);
+  void (*deshuffleReal)(double* inVec, double* outVec, int nrOfDoubles);
+  void (*shuffleInt2)(int* inVec, int* outVec, int nrOfInts);
+  void (*deshuffleInt2)(int* inVec, int* outVec, int nrOfInts);
+};
+
+
+/**
+ * \brief Kernels for a specific instruction set.
+ * \param kernel requested instruction set.
+ * \return the kernels or nullptr if the instruction set is not supported by the CPU or the build.
+ */
+const ShuffleKernels* GetShuffleKernels(ShuffleKernel kernel);
+
+
+/**
+ * \brief Fastest instruction set supported by the CPU, detected once at runtime.
+ */
+ShuffleKernel ActiveShuffleKernel();
+
+
+/**
+ * \brief Kernels of the fastest instruction set supported by the CPU, used by ShuffleReal and ShuffleInt2.
+ */
+const ShuffleKernels &ActiveShuffleKernels();
+
+
+#endif  // SHUFFLE_KERNELS_H
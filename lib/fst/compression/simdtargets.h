@@ -0,0 +1,44 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef SIMD_TARGETS_H
+#define SIMD_TARGETS_H
+
+
+// The vectorized kernels are compiled for their own instruction set and selected at runtime, so the library itself
+// can be built for the baseline architecture (see ActiveShuffleKernel)
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && !defined(FST_NO_SIMD)
+  #define FST_SIMD_X86
+#endif
+
+#ifdef FST_SIMD_X86
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+  #define FST_TARGET_SSE2
+  #define FST_TARGET_AVX2
+#else
+  #define FST_TARGET_SSE2 __attribute__((target("sse2")))
+  #define FST_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#include <immintrin.h>
+
+#endif  // FST_SIMD_X86
+
+
+#endif  // SIMD_TARGETS_H
@@ -0,0 +1,295 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+#endif
+
+#include <compression/xorcodec.h>
+
+
+#define XOR_FLAG_BITS    2
+#define XOR_LEAD_BITS    3
+#define XOR_CENTER_BITS  6
+#define XOR_MIN_TRAIL    6  // minimum number of trailing zeros for a center encoding (flag 01)
+#define XOR_MAX_BITS     (XOR_FLAG_BITS + XOR_LEAD_BITS + 64)  // longest encoding of a single value
+#define XOR_NO_LEAD      65  // no leading zero count to reuse
+
+// Leading zero counts that can be encoded, rounding a count down to one of these values costs at most a few bits
+static const int leadingZeroValue[8] = { 0, 8, 12, 16, 18, 20, 22, 24 };
+
+// Code of the rounded leading zero count for each count (0 - 64)
+static const unsigned char leadingZeroCode[65] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7
+};
+
+
+// Number of leading and trailing zero bits of a nonzero value
+
+inline int LeadingZeros(const unsigned long long value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return 63 - static_cast<int>(index);
+#else
+  return __builtin_clzll(value);
+#endif
+}
+
+
+inline int TrailingZeros(const unsigned long long value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctzll(value);
+#endif
+}
+
+
+/**
+ * \brief Little-endian bit writer that stops writing when the capacity of the output buffer is exceeded.
+ */
+class XorBitWriter
+{
+  unsigned char* start;
+  unsigned char* out;
+  unsigned char* outEnd;
+  unsigned long long bits = 0;  // pending bits
+  int nrOfBits = 0;             // number of pending bits (less than 32 between calls)
+
+public:
+  XorBitWriter(char* dst, const unsigned int dstCapacity) :
+    start(reinterpret_cast<unsigned char*>(dst)), out(start), outEnd(start + dstCapacity)
+  {
+  }
+
+  bool Overflow() const { return out > outEnd; }
+
+  // Write the lower 'count' bits of 'value' (at most 32, higher bits must be zero)
+  inline void Write(const unsigned long long value, const int count)
+  {
+    bits |= value << nrOfBits;
+    nrOfBits += count;
+
+    if (nrOfBits < 32) return;
+
+    if (out + 4 <= outEnd)
+    {
+      const unsigned int word = static_cast<unsigned int>(bits);
+      memcpy(out, &word, 4);
+    }
+
+    out += 4;
+    bits >>= 32;
+    nrOfBits -= 32;
+  }
+
+  // Write the lower 'count' bits of 'value' (at most 64)
+  inline void WriteLong(const unsigned long long value, const int count)
+  {
+    if (count <= 32)
+    {
+      Write(value, count);
+      return;
+    }
+
+    Write(value & 0xFFFFFFFFULL, 32);
+    Write(value >> 32, count - 32);
+  }
+
+  // Write the pending bits and return the total size in bytes
+  unsigned int Flush()
+  {
+    const int nrOfBytes = (nrOfBits + 7) / 8;
+
+    if (out + nrOfBytes <= outEnd) memcpy(out, &bits, nrOfBytes);
+    out += nrOfBytes;
+
+    return static_cast<unsigned int>(out - start);
+  }
+};
+
+
+/**
+ * \brief Little-endian bit reader. Reads beyond the end of the data return zero bits, which is detected afterwards
+ * with Overrun.
+ */
+class XorBitReader
+{
+  const unsigned char* data;
+  size_t size;
+  unsigned long long bitPos = 0;
+
+public:
+  XorBitReader(const char* src, const unsigned int compressedSize) :
+    data(reinterpret_cast<const unsigned char*>(src)), size(compressedSize)
+  {
+  }
+
+  bool Overrun() const { return bitPos > 8 * static_cast<unsigned long long>(size); }
+
+  // Read 'count' bits (at most 56)
+  inline unsigned long long Read(const int count)
+  {
+    const size_t bytePos = static_cast<size_t>(bitPos >> 3);
+    const int shift = static_cast<int>(bitPos & 7);
+    unsigned long long word = 0;
+
+    if (bytePos + 8 <= size)
+    {
+      memcpy(&word, data + bytePos, 8);
+    }
+    else if (bytePos < size)
+    {
+      memcpy(&word, data + bytePos, size - bytePos);
+    }
+
+    bitPos += count;
+
+    return (word >> shift) & ((1ULL << count) - 1);
+  }
+
+  // Read 'count' bits (at most 64)
+  inline unsigned long long ReadLong(const int count)
+  {
+    if (count <= 56) return Read(count);
+
+    const unsigned long long low = Read(32);
+    return low | (Read(count - 32) << 32);
+  }
+};
+
+
+unsigned int XorSizeBound(unsigned int blockSize)
+{
+  const unsigned int nrOfDoubles = (blockSize + 7) / 8;
+  return (nrOfDoubles * XOR_MAX_BITS + 7) / 8;
+}
+
+
+unsigned int XOR_DOUBLE_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize, int)
+{
+  const unsigned int nrOfDoubles = srcSize / 8;
+  XorBitWriter writer(dst, dstCapacity);
+
+  unsigned long long previous = 0;
+  int previousLead = XOR_NO_LEAD;
+
+  for (unsigned int pos = 0; pos < nrOfDoubles; pos++)
+  {
+    unsigned long long value;
+    memcpy(&value, src + 8 * static_cast<size_t>(pos), 8);
+
+    const unsigned long long delta = value ^ previous;
+    previous = value;
+
+    if (delta == 0)
+    {
+      writer.Write(0, XOR_FLAG_BITS);
+      previousLead = XOR_NO_LEAD;
+      continue;
+    }
+
+    const int leadCode = leadingZeroCode[LeadingZeros(delta)];
+    const int lead = leadingZeroValue[leadCode];
+    const int trail = TrailingZeros(delta);
+
+    if (trail > XOR_MIN_TRAIL)
+    {
+      const int centerBits = 64 - lead - trail;
+
+      writer.Write(1 | (leadCode << XOR_FLAG_BITS) | (centerBits << (XOR_FLAG_BITS + XOR_LEAD_BITS)),
+        XOR_FLAG_BITS + XOR_LEAD_BITS + XOR_CENTER_BITS);
+      writer.WriteLong(delta >> trail, centerBits);
+      previousLead = XOR_NO_LEAD;
+    }
+    else if (lead == previousLead)
+    {
+      writer.Write(2, XOR_FLAG_BITS);
+      writer.WriteLong(delta, 64 - lead);
+    }
+    else
+    {
+      writer.Write(3 | (leadCode << XOR_FLAG_BITS), XOR_FLAG_BITS + XOR_LEAD_BITS);
+      writer.WriteLong(delta, 64 - lead);
+      previousLead = lead;
+    }
+
+    if (writer.Overflow()) return 0;
+  }
+
+  const unsigned int size = writer.Flush();
+
+  return writer.Overflow() ? 0 : size;
+}
+
+
+unsigned int XOR_DOUBLE_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize)
+{
+  const unsigned int nrOfDoubles = dstCapacity / 8;
+  XorBitReader reader(src, compressedSize);
+
+  unsigned long long value = 0;
+  int previousLead = XOR_NO_LEAD;
+
+  for (unsigned int pos = 0; pos < nrOfDoubles; pos++)
+  {
+    const int flag = static_cast<int>(reader.Read(XOR_FLAG_BITS));
+
+    switch (flag)
+    {
+      case 0:
+        previousLead = XOR_NO_LEAD;
+        break;
+
+      case 1:
+      {
+        const unsigned long long header = reader.Read(XOR_LEAD_BITS + XOR_CENTER_BITS);
+        const int lead = leadingZeroValue[header & 7];
+        const int centerBits = static_cast<int>(header >> XOR_LEAD_BITS);
+
+        if (centerBits == 0 || lead + centerBits > 64) return 1;
+
+        value ^= reader.ReadLong(centerBits) << (64 - lead - centerBits);
+        previousLead = XOR_NO_LEAD;
+        break;
+      }
+
+      case 2:
+        if (previousLead == XOR_NO_LEAD) return 1;
+
+        value ^= reader.ReadLong(64 - previousLead);
+        break;
+
+      default:
+        previousLead = leadingZeroValue[reader.Read(XOR_LEAD_BITS)];
+        value ^= reader.ReadLong(64 - previousLead);
+        break;
+    }
+
+    memcpy(dst + 8 * static_cast<size_t>(pos), &value, 8);
+  }
+
+  return reader.Overrun() ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef XOR_CODEC_H
+#define XOR_CODEC_H
+
+
+// XOR codec for double vectors (after the Gorilla and Chimp time series encodings). Each value is XOR'ed with the
+// previous value and only the bits between the leading and trailing zeros of the result are stored. Slowly varying
+// series share the sign, exponent and upper mantissa bits of consecutive values, so few bits remain.
+//
+// Every value starts with a 2 bit flag:
+//
+// 00: identical to the previous value
+// 01: 3 bit leading zero code, 6 bit length and the center bits (for more than 6 trailing zeros)
+// 10: the bits after the leading zeros of the previous value
+// 11: 3 bit leading zero code and the bits after the leading zeros
+//
+// Leading zero counts are rounded down to one of 8 values. Bits are written in little-endian order.
+
+
+/**
+ * \brief Maximum size of XOR encoded data for a block of 'blockSize' bytes.
+ */
+unsigned int XorSizeBound(unsigned int blockSize);
+
+
+/**
+ * \brief XOR encode a double vector with the interface of CompAlgorithm (see compression.h).
+ * \return size of the encoded data or zero if it does not fit in 'dstCapacity' bytes. Encoding stops as soon as the
+ * capacity is exceeded, so a small capacity can be used to only accept the encoding when it is smaller than a limit.
+ */
+unsigned int XOR_DOUBLE_C(char* dst, unsigned int dstCapacity, const char* src, unsigned int srcSize,
+  int compressionLevel);
+
+
+/**
+ * \brief Decode XOR encoded data into 'dstCapacity' bytes.
+ * \return zero on success, a nonzero value for corrupted data.
+ */
+unsigned int XOR_DOUBLE_D(char* dst, unsigned int dstCapacity, const char* src, unsigned int compressedSize);
+
+
+#endif  // XOR_CODEC_H
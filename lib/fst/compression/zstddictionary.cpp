@@ -0,0 +1,86 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <stdexcept>
+
+#include <zdict.h>
+
+#include <compression/zstddictionary.h>
+#include <compression/compressioncontext.h>
+#include <interface/fstdefines.h>
+
+
+ZstdDictionary::ZstdDictionary(const char* dict, const size_t dictSize, const int compressionLevel) :
+  content(dict, dict + dictSize), compressionLevel(compressionLevel)
+{
+}
+
+
+ZstdDictionary::~ZstdDictionary()
+{
+  ZSTD_freeCDict(compressionDict);
+  ZSTD_freeDDict(decompressionDict);
+}
+
+
+void ZstdDictionary::Train(const std::vector<char> &samples, const std::vector<size_t> &sampleSizes, const size_t capacity,
+  std::vector<char> &dict)
+{
+  dict.resize(capacity);
+
+  const size_t dictSize = ZDICT_trainFromBuffer(dict.data(), capacity, samples.data(), sampleSizes.data(),
+    static_cast<unsigned int>(sampleSizes.size()));
+
+  // too few or too small samples
+  if (ZDICT_isError(dictSize))
+  {
+    dict.clear();
+    return;
+  }
+
+  dict.resize(dictSize);
+}
+
+
+size_t ZstdDictionary::Compress(char* dst, const size_t dstCapacity, const char* src, const size_t srcSize)
+{
+  if (compressionDict == nullptr)
+  {
+    compressionDict = ZSTD_createCDict(content.data(), content.size(), compressionLevel);
+    if (compressionDict == nullptr) throw(std::runtime_error(FSTERROR_COMPRESSION_CONTEXT));
+  }
+
+  const size_t compressedSize = ZSTD_compress_usingCDict(CompressionContext::ForThread().ZstdCompression(), dst,
+    dstCapacity, src, srcSize, compressionDict);
+
+  return ZSTD_isError(compressedSize) ? 0 : compressedSize;
+}
+
+
+void ZstdDictionary::Decompress(char* dst, const size_t dstSize, const char* src, const size_t compressedSize)
+{
+  if (decompressionDict == nullptr)
+  {
+    decompressionDict = ZSTD_createDDict(content.data(), content.size());
+    if (decompressionDict == nullptr) throw(std::runtime_error(FSTERROR_COMPRESSION_CONTEXT));
+  }
+
+  const size_t size = ZSTD_decompress_usingDDict(CompressionContext::ForThread().ZstdDecompression(), dst, dstSize,
+    src, compressedSize, decompressionDict);
+
+  if (size != dstSize) throw(std::runtime_error(FSTERROR_COMP_STREAM));
+}
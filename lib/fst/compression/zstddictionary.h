@@ -0,0 +1,85 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef ZSTD_DICTIONARY_H
+#define ZSTD_DICTIONARY_H
+
+#include <cstddef>
+#include <vector>
+
+#include <zstd.h>
+
+
+/**
+ * \brief A ZSTD dictionary that is shared by all compression blocks of a column. Small blocks of similar data compress
+ * much better when the compressor starts with a dictionary of frequent byte sequences instead of an empty history.
+ *
+ * The digested dictionaries are created on first use, so a dictionary used for writing never digests the
+ * decompression dictionary and vice versa. Blocks are (de)compressed with the contexts of the calling thread
+ * (see CompressionContext).
+ */
+class ZstdDictionary
+{
+  std::vector<char> content;
+  int compressionLevel;
+
+  ZSTD_CDict* compressionDict = nullptr;
+  ZSTD_DDict* decompressionDict = nullptr;
+
+public:
+  /**
+   * \brief Create a dictionary from its serialized content.
+   * \param dict dictionary content.
+   * \param dictSize size of the dictionary in bytes.
+   * \param compressionLevel ZSTD compression level used by Compress.
+   */
+  ZstdDictionary(const char* dict, size_t dictSize, int compressionLevel = 1);
+
+  ~ZstdDictionary();
+
+  ZstdDictionary(const ZstdDictionary &) = delete;
+  ZstdDictionary &operator=(const ZstdDictionary &) = delete;
+
+  /**
+   * \brief Train a dictionary from a set of samples.
+   * \param samples concatenated samples.
+   * \param sampleSizes size of each sample in bytes.
+   * \param capacity maximum size of the dictionary in bytes.
+   * \param dict trained dictionary (output), empty if no dictionary could be trained from the samples.
+   */
+  static void Train(const std::vector<char> &samples, const std::vector<size_t> &sampleSizes, size_t capacity,
+    std::vector<char> &dict);
+
+  const char* Data() const { return content.data(); }
+
+  size_t Size() const { return content.size(); }
+
+  /**
+   * \brief Compress 'src' using the dictionary.
+   * \return size of the compressed data or zero if it does not fit in 'dstCapacity' bytes.
+   */
+  size_t Compress(char* dst, size_t dstCapacity, const char* src, size_t srcSize);
+
+  /**
+   * \brief Decompress data that was compressed with Compress. Throws if the data does not decompress to exactly
+   * 'dstSize' bytes.
+   */
+  void Decompress(char* dst, size_t dstSize, const char* src, size_t compressedSize);
+};
+
+
+#endif  // ZSTD_DICTIONARY_H
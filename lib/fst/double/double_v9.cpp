@@ -18,38 +18,85 @@
 // Framework libraries
 #include <blockstreamer/blockstreamer_v2.h>
 #include <compression/compressor.h>
+#include <compression/decimalcodec.h>
 #include <interface/fstdefines.h>
 
 
 using namespace std;
 
-void fdsWriteRealVec_v9(ofstream &myfile, double* doubleVector, unsigned long long nrOfRows, unsigned int compression,
-  std::string annotation, bool hasAnnotation)
+
+// Compressor for the blocks that need the strongest compression
+inline Compressor* DoubleStrongCompressor(int compressionLevel, bool fastDecompression)
+{
+  if (fastDecompression) return new Lz4HighCompressor(CompAlgo::LZ4, compressionLevel);
+
+  return new SingleCompressor(CompAlgo::ZSTD, compressionLevel);
+}
+
+
+// Wrap a compressor with the codecs that compete with it for each block
+inline Compressor* DoubleCodecs(Compressor* compressor, bool extendedCodecs, int decimals)
+{
+  if (extendedCodecs) compressor = new XorDoubleCompressor(compressor);
+
+  // fixed decimals are also used without the other extended codecs
+  if (extendedCodecs || decimals != DECIMAL_DETECT) compressor = new DecimalDoubleCompressor(compressor, decimals);
+
+  return compressor;
+}
+
+
+void fdsWriteRealVec_v9(ostream &myfile, double* doubleVector, unsigned long long nrOfRows, unsigned int compression,
+  std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics, unsigned int blockSize, bool extendedCodecs,
+  bool adaptiveCompression, bool fastDecompression, int decimals)
 {
-  int blockSize = 8 * BLOCKSIZE_REAL;  // block size in bytes
+  const int blockSizeElems = blockSize / 8;  // number of elements in a compression block
 
   if (compression == 0)
   {
-    return fdsStreamUncompressed_v2(myfile, reinterpret_cast<char*>(doubleVector), nrOfRows, 8, BLOCKSIZE_REAL, nullptr, annotation, hasAnnotation);
+    return fdsStreamUncompressed_v2(myfile, reinterpret_cast<char*>(doubleVector), nrOfRows, 8, BLOCKSIZE_REAL, nullptr, annotation, hasAnnotation, columnStatistics);
+  }
+
+  if (adaptiveCompression)  // the codec of each block is selected from a compressed sample
+  {
+    Compressor* compress1 = DoubleCodecs(new SingleCompressor(CompAlgo::LZ4, compression), extendedCodecs, decimals);
+    Compressor* compress2 = DoubleCodecs(DoubleStrongCompressor(compression, fastDecompression), extendedCodecs,
+      decimals);
+
+    StreamCompressor* streamCompressor = new StreamAdaptiveCompressor(compress1, compress2, compression);
+    streamCompressor->CompressBufferSize(blockSize);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(doubleVector), nrOfRows, 8, streamCompressor,
+      blockSizeElems, annotation, hasAnnotation, columnStatistics);
+
+    delete compress1;
+    delete compress2;
+    delete streamCompressor;
+    return;
   }
 
   if (compression <= 50)  // low compression: linear mix of uncompressed and LZ4
   {
-    Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4, 50);
+    Compressor* compress1 = DoubleCodecs(new SingleCompressor(CompAlgo::LZ4, 50), extendedCodecs, decimals);
+
     StreamCompressor* streamCompressor = new StreamLinearCompressor(compress1, 2.0F * compression);
     streamCompressor->CompressBufferSize(blockSize);
-    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(doubleVector), nrOfRows, 8, streamCompressor, BLOCKSIZE_REAL, annotation, hasAnnotation);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(doubleVector), nrOfRows, 8, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
     delete compress1;
     delete streamCompressor;
     return;
   }
 
-  Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4, compression);
-  Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD, compression - 50);
+  Compressor* compress1 = DoubleCodecs(new SingleCompressor(CompAlgo::LZ4, compression), extendedCodecs, decimals);
+  // the high compression LZ4 encoder uses the full range of levels
+  const int strongLevel = fastDecompression ? 2 * (compression - 50) : compression - 50;
+  Compressor* compress2 = DoubleCodecs(DoubleStrongCompressor(strongLevel, fastDecompression), extendedCodecs,
+    decimals);
+
   StreamCompressor* streamCompressor = new StreamCompositeCompressor(compress1, compress2, 2.0F * (compression - 50));
   streamCompressor->CompressBufferSize(blockSize);
-  fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(doubleVector), nrOfRows, 8, streamCompressor, BLOCKSIZE_REAL, annotation, hasAnnotation);
+  fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(doubleVector), nrOfRows, 8, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
   delete compress1;
   delete compress2;
@@ -60,8 +107,9 @@ void fdsWriteRealVec_v9(ofstream &myfile, double* doubleVector, unsigned long lo
 
 
 void fdsReadRealVec_v9(istream &myfile, double* doubleVector, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size, std::string &annotation, bool &hasAnnotation)
+  unsigned long long length, unsigned long long size, std::string &annotation, bool &hasAnnotation,
+  const IFstSource* positionalReader, ColumnMetaCache* metaCache)
 {
   return fdsReadColumn_v2(myfile, reinterpret_cast<char*>(doubleVector), blockPos, startRow, length, size, 8, annotation,
-    BATCH_SIZE_READ_DOUBLE, hasAnnotation);
+    BATCH_SIZE_READ_DOUBLE, hasAnnotation, positionalReader, metaCache);
 }
@@ -22,11 +22,28 @@
 #include <ostream>
 #include <istream>
 
+#include <interface/fstdefines.h>
+#include <compression/decimalcodec.h>
 
-void fdsWriteRealVec_v9(std::ofstream &myfile, double* doubleVector, unsigned long long nrOfRows, unsigned int compression,
-  std::string annotation, bool hasAnnotation);
+
+class IFstSource;
+class ColumnMetaCache;
+class ColumnStatistics;
+
+
+// Parameter 'extendedCodecs' allows the compressed blocks to be stored with the XOR_DOUBLE or DECIMAL_DOUBLE codec.
+// Parameter 'adaptiveCompression' selects the codec of each block from a compressed sample (see
+// StreamAdaptiveCompressor).
+// Parameter 'fastDecompression' replaces ZSTD with the high compression LZ4 encoder (see Lz4HighCompressor).
+// Parameter 'decimals' is the number of decimals of the values, blocks can then be stored with the DECIMAL_DOUBLE codec
+// without enabling the extended codecs. With DECIMAL_DETECT the decimals of each block are detected (extended codecs).
+void fdsWriteRealVec_v9(std::ostream &myfile, double* doubleVector, unsigned long long nrOfRows, unsigned int compression,
+  std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics = nullptr, unsigned int blockSize = BLOCKSIZE, bool extendedCodecs = false,
+  bool adaptiveCompression = false, bool fastDecompression = false, int decimals = DECIMAL_DETECT);
 
 void fdsReadRealVec_v9(std::istream &myfile, double* doubleVector, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size, std::string &annotation, bool &hasAnnotation);
+  unsigned long long length, unsigned long long size, std::string &annotation, bool &hasAnnotation,
+  const IFstSource* positionalReader = nullptr, ColumnMetaCache* metaCache = nullptr);
 
 #endif // DOUBLE_v9_H
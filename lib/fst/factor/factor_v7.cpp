@@ -20,6 +20,9 @@
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
 
 // Framework headers
 #include <interface/istringwriter.h>
@@ -36,8 +39,9 @@ using namespace std;
 #define HEADER_SIZE_FACTOR 16
 #define VERSION_NUMBER_FACTOR 1
 
-void fdsWriteFactorVec_v7(ofstream &myfile, int* intP, IStringWriter* blockRunner, unsigned long long size, unsigned int compression,
-	StringEncoding stringEncoding, std::string annotation, bool hasAnnotation)
+void fdsWriteFactorVec_v7(ostream &myfile, int* intP, IStringWriter* blockRunner, unsigned long long size, unsigned int compression,
+	StringEncoding stringEncoding, std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics, unsigned int blockSize, bool extendedCodecs)
 {
   unsigned long long blockPos = myfile.tellp();  // offset for factor
   unsigned int nrOfFactorLevels = blockRunner->vecLength;
@@ -114,7 +118,7 @@ void fdsWriteFactorVec_v7(ofstream &myfile, int* intP, IStringWriter* blockRunne
   //  return;
   //}
 
-  const int blockSize = 4 * BLOCKSIZE_INT;  // block size in bytes
+  const int blockSizeElems = blockSize / 4;  // number of elements in a compression block
 
   if (*nrOfLevels < 128)  // use 1 byte per int (Na encoding takes 1 bit)
   {
@@ -122,11 +126,18 @@ void fdsWriteFactorVec_v7(ofstream &myfile, int* intP, IStringWriter* blockRunne
     {
       Compressor* defaultCompress = new SingleCompressor(CompAlgo::INT_TO_BYTE, 0);  // just pack the bytes
       Compressor* compress2 = new SingleCompressor(CompAlgo::LZ4_INT_TO_BYTE, compression);  // maximum compression of 80
+
+      if (extendedCodecs)  // run-length encoding and bit-packing compete with both algorithms
+      {
+        defaultCompress = new IntegerPackCompressor(defaultCompress, false);
+        compress2 = new IntegerPackCompressor(compress2, false);
+      }
+
       StreamCompressor* streamCompressor = new StreamCompositeCompressor(defaultCompress, compress2, 2 * compression);
 
       streamCompressor->CompressBufferSize(blockSize);
 
-      fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, BLOCKSIZE_INT, annotation, hasAnnotation);
+      fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
       delete streamCompressor;
       delete compress2;
@@ -137,11 +148,18 @@ void fdsWriteFactorVec_v7(ofstream &myfile, int* intP, IStringWriter* blockRunne
 
     Compressor* defaultCompress = new SingleCompressor(CompAlgo::LZ4_INT_TO_BYTE, compression);  // maximum LZ4 compression on smaller vectors
     Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD_INT_TO_BYTE, compression - 50);  // maximum compression of 80
+
+    if (extendedCodecs)  // run-length encoding and bit-packing compete with both algorithms
+    {
+      defaultCompress = new IntegerPackCompressor(defaultCompress, false);
+      compress2 = new IntegerPackCompressor(compress2, false);
+    }
+
     StreamCompressor* streamCompressor = new StreamCompositeCompressor(defaultCompress, compress2, 2 * (compression - 50));
 
     streamCompressor->CompressBufferSize(blockSize);
 
-    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, BLOCKSIZE_INT, annotation, hasAnnotation);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
     delete streamCompressor;
     delete compress2;
@@ -156,11 +174,18 @@ void fdsWriteFactorVec_v7(ofstream &myfile, int* intP, IStringWriter* blockRunne
     {
       Compressor* defaultCompress = new SingleCompressor(CompAlgo::LZ4_INT_TO_SHORT_SHUF2, 0);  // just pack the bytes
       Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD_INT_TO_SHORT_SHUF2, 0);  // maximum compression of 80
+
+      if (extendedCodecs)  // run-length encoding and bit-packing compete with both algorithms
+      {
+        defaultCompress = new IntegerPackCompressor(defaultCompress, false);
+        compress2 = new IntegerPackCompressor(compress2, false);
+      }
+
       StreamCompressor* streamCompressor = new StreamCompositeCompressor(defaultCompress, compress2, 2 * compression);
 
       streamCompressor->CompressBufferSize(blockSize);
 
-      fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, BLOCKSIZE_INT, annotation, hasAnnotation);
+      fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
       delete streamCompressor;
       delete compress2;
@@ -171,11 +196,18 @@ void fdsWriteFactorVec_v7(ofstream &myfile, int* intP, IStringWriter* blockRunne
 
     Compressor* defaultCompress = new SingleCompressor(CompAlgo::ZSTD_INT_TO_SHORT_SHUF2, 0);  // maximum LZ4 compression on smaller vectors
     Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD_INT_TO_SHORT_SHUF2, compression - 50);  // maximum compression of 80
+
+    if (extendedCodecs)  // run-length encoding and bit-packing compete with both algorithms
+    {
+      defaultCompress = new IntegerPackCompressor(defaultCompress, false);
+      compress2 = new IntegerPackCompressor(compress2, false);
+    }
+
     StreamCompressor* streamCompressor = new StreamCompositeCompressor(defaultCompress, compress2, 2 * (compression - 50));
 
     streamCompressor->CompressBufferSize(blockSize);
 
-    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, BLOCKSIZE_INT, annotation, hasAnnotation);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
     delete streamCompressor;
     delete compress2;
@@ -189,10 +221,12 @@ void fdsWriteFactorVec_v7(ofstream &myfile, int* intP, IStringWriter* blockRunne
   if (compression <= 50)  // low compression: linear mix of uncompressed and LZ4_SHUF
   {
     Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_SHUF4, 0);
+    if (extendedCodecs) compress1 = new IntegerPackCompressor(compress1, false);
+
     StreamCompressor* streamCompressor = new StreamLinearCompressor(compress1, 2 * compression);
 
     streamCompressor->CompressBufferSize(blockSize);
-    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, BLOCKSIZE_INT, annotation, hasAnnotation);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
     delete compress1;
     delete streamCompressor;
@@ -201,9 +235,16 @@ void fdsWriteFactorVec_v7(ofstream &myfile, int* intP, IStringWriter* blockRunne
 
   Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_SHUF4, 0);
   Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD_SHUF4, 2 * (compression - 50));
+
+  if (extendedCodecs)  // run-length encoding and bit-packing compete with both algorithms
+  {
+    compress1 = new IntegerPackCompressor(compress1, false);
+    compress2 = new IntegerPackCompressor(compress2, false);
+  }
+
   StreamCompressor* streamCompressor = new StreamCompositeCompressor(compress1, compress2, 2 * (compression - 50));
   streamCompressor->CompressBufferSize(blockSize);
-  fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, BLOCKSIZE_INT, annotation, hasAnnotation);
+  fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(intP), nrOfRows, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
   delete compress1;
   delete compress2;
@@ -216,14 +257,12 @@ void fdsWriteFactorVec_v7(ofstream &myfile, int* intP, IStringWriter* blockRunne
 // Parameter 'startRow' is zero based
 // Data vector intP is expected to point to a memory block 4 * size bytes long
 void fdsReadFactorVec_v7(IFstTable &tableReader, istream &myfile, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size, FstColumnAttribute col_attribute, IColumnFactory* columnFactory, int colSel)
+  unsigned long long length, unsigned long long size, FstColumnAttribute col_attribute, IColumnFactory* columnFactory, int colSel,
+  const IFstSource* positionalReader)
 {
-  // Jump to factor level
-  myfile.seekg(blockPos);
-
   // Get vector meta data
   char meta[HEADER_SIZE_FACTOR];
-  myfile.read(meta, HEADER_SIZE_FACTOR);
+  ReadAt(myfile, positionalReader, meta, HEADER_SIZE_FACTOR, blockPos);
   unsigned int* versionNr = (unsigned int*) &meta;
 
   if (*versionNr > VERSION_NUMBER_FACTOR)
@@ -256,14 +295,150 @@ void fdsReadFactorVec_v7(IFstTable &tableReader, istream &myfile, unsigned long
   else
   {
     // non-empty level vector
-    fdsReadCharVec_v6(myfile, blockReader, blockPos + HEADER_SIZE_FACTOR, 0, *nrOfLevels, *nrOfLevels);  // get level strings
+    fdsReadCharVec_v6(myfile, blockReader, blockPos + HEADER_SIZE_FACTOR, 0, *nrOfLevels, *nrOfLevels, 0,
+      positionalReader);  // get level strings
 
     // Read level values
     std::string annotation;
     bool hasAnnotation;
 
-    fdsReadColumn_v2(myfile, reinterpret_cast<char*>(intP), *levelVecPos, startRow, length, size, 4, annotation, BATCH_SIZE_READ_FACTOR, hasAnnotation);
+    fdsReadColumn_v2(myfile, reinterpret_cast<char*>(intP), *levelVecPos, startRow, length, size, 4, annotation, BATCH_SIZE_READ_FACTOR,
+      hasAnnotation, positionalReader);
   }
 
   return;
 }
+
+
+// Each data chunk of a factor column has its own level set. The level values of all chunks are
+// remapped to the union of the chunk levels (in order of first appearance).
+void fdsReadFactorChunks_v7(IFstTable &tableReader, istream &myfile, const vector<unsigned long long> &blockPos,
+  const vector<unsigned long long> &startRow, const vector<unsigned long long> &length, const vector<unsigned long long> &size,
+  FstColumnAttribute col_attribute, IColumnFactory* columnFactory, int colSel, const IFstSource* positionalReader,
+  const unsigned long long* rowIndex)
+{
+  const size_t nrOfChunks = blockPos.size();
+
+  vector<unsigned long long> levelVecPos(nrOfChunks);
+  vector<vector<int>> levelMap(nrOfChunks);  // chunk level to result level (one-based)
+  vector<size_t> mapChunk(nrOfChunks);       // chunk that holds the level map
+  vector<string> levels;
+  unordered_map<string, int> levelIndex;
+  StringEncoding stringEncoding = StringEncoding::NATIVE;
+  unsigned long long totLength = 0;
+
+  for (size_t chunk = 0; chunk < nrOfChunks; ++chunk)
+  {
+    totLength += length[chunk];
+
+    // consecutive slices of the same data chunk share their levels
+    if (chunk > 0 && blockPos[chunk] == blockPos[chunk - 1])
+    {
+      levelVecPos[chunk] = levelVecPos[chunk - 1];
+      mapChunk[chunk] = mapChunk[chunk - 1];
+      continue;
+    }
+
+    mapChunk[chunk] = chunk;
+
+    char meta[HEADER_SIZE_FACTOR];
+    ReadAt(myfile, positionalReader, meta, HEADER_SIZE_FACTOR, blockPos[chunk]);
+    unsigned int* versionNr = (unsigned int*) &meta;
+
+    if (*versionNr > VERSION_NUMBER_FACTOR)
+    {
+      throw runtime_error("Incompatible fst file.");
+    }
+
+    unsigned int* nrOfLevels = (unsigned int*) &meta[4];
+    levelVecPos[chunk] = *(unsigned long long*) &meta[8];
+
+    if (*nrOfLevels == 0) continue;
+
+    std::unique_ptr<IStringColumn> chunkLevelsP(columnFactory->CreateStringColumn(*nrOfLevels, FstColumnAttribute::NONE));
+    IStringColumn* chunkLevels = chunkLevelsP.get();
+    chunkLevels->AllocateVec(*nrOfLevels);
+
+    fdsReadCharVec_v6(myfile, chunkLevels, blockPos[chunk] + HEADER_SIZE_FACTOR, 0, *nrOfLevels, *nrOfLevels, 0, positionalReader);
+    stringEncoding = chunkLevels->GetEncoding();
+
+    vector<int> &chunkMap = levelMap[chunk];
+    chunkMap.resize(*nrOfLevels);
+
+    for (unsigned int level = 0; level < *nrOfLevels; ++level)
+    {
+      string levelStr(chunkLevels->GetElement(level));
+      auto res = levelIndex.emplace(levelStr, static_cast<int>(levels.size()) + 1);
+      if (res.second) levels.push_back(levelStr);
+
+      chunkMap[level] = res.first->second;
+    }
+  }
+
+  std::unique_ptr<IFactorColumn> factorColumnP(columnFactory->CreateFactorColumn(totLength, levels.size(), col_attribute));
+  IFactorColumn* factorColumn = factorColumnP.get();
+
+  // add to table
+  tableReader.SetFactorColumn(factorColumn, colSel);
+
+  // Set merged level strings using the character block layout (cumulative sizes followed by NA bits)
+  const unsigned long long nrOfLevels = levels.size();
+
+  if (nrOfLevels > 0)
+  {
+    const unsigned long long nrOfNAInts = 1 + nrOfLevels / 32;
+    std::unique_ptr<unsigned int[]> sizeMetaP(new unsigned int[nrOfLevels + nrOfNAInts]());
+    unsigned int* sizeMeta = sizeMetaP.get();
+
+    string levelBuf;
+    for (unsigned long long level = 0; level < nrOfLevels; ++level)
+    {
+      levelBuf += levels[level];
+      sizeMeta[level] = static_cast<unsigned int>(levelBuf.size());
+    }
+
+    IStringColumn* levelColumn = factorColumn->Levels();
+    levelColumn->SetEncoding(stringEncoding);
+    levelColumn->BufferToVec(nrOfLevels, 0, nrOfLevels - 1, 0, sizeMeta, &levelBuf[0]);
+  }
+
+  // Read and remap level values
+  int* intP = factorColumn->LevelData();
+
+  for (size_t chunk = 0; chunk < nrOfChunks; ++chunk)
+  {
+    const vector<int> &chunkMap = levelMap[mapChunk[chunk]];
+
+    if (chunkMap.empty())
+    {
+      // All level values must be NA
+      for (unsigned long long pos = 0; pos < length[chunk]; pos++)
+      {
+        intP[pos] = FST_NA_INT;
+      }
+    }
+    else
+    {
+      std::string annotation;
+      bool hasAnnotation;
+
+      if (rowIndex != nullptr)
+      {
+        fdsGatherColumn_v2(myfile, reinterpret_cast<char*>(intP), levelVecPos[chunk], &rowIndex[startRow[chunk]], length[chunk],
+          size[chunk], 4, annotation, hasAnnotation, positionalReader);
+      }
+      else
+      {
+        fdsReadColumn_v2(myfile, reinterpret_cast<char*>(intP), levelVecPos[chunk], startRow[chunk], length[chunk], size[chunk], 4,
+          annotation, BATCH_SIZE_READ_FACTOR, hasAnnotation, positionalReader);
+      }
+
+      for (unsigned long long pos = 0; pos < length[chunk]; pos++)
+      {
+        if (intP[pos] > 0) intP[pos] = chunkMap[intP[pos] - 1];
+      }
+    }
+
+    intP += length[chunk];
+  }
+}
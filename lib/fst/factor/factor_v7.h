@@ -21,20 +21,38 @@
 
 #include <iostream>
 #include <fstream>
+#include <vector>
 
+#include <interface/fstdefines.h>
 #include <interface/istringwriter.h>
 #include <interface/ifstcolumn.h>
 #include <interface/icolumnfactory.h>
 #include <interface/ifsttable.h>
+#include <blockstreamer/positionalreader.h>
+#include <statistics/columnstatistics.h>
 
 
-void fdsWriteFactorVec_v7(std::ofstream &myfile, int* intP, IStringWriter* blockRunner, unsigned long long size, unsigned int compression,
-	StringEncoding stringEncoding, std::string annotation, bool hasAnnotation);
+// Parameter 'extendedCodecs' allows the compressed blocks of level values to be stored with RLE_INT run-length
+// encoding or with bit-packing.
+void fdsWriteFactorVec_v7(std::ostream &myfile, int* intP, IStringWriter* blockRunner, unsigned long long size, unsigned int compression,
+	StringEncoding stringEncoding, std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics = nullptr, unsigned int blockSize = BLOCKSIZE, bool extendedCodecs = false);
 
 
 // Parameter 'startRow' is zero based.
 void fdsReadFactorVec_v7(IFstTable &tableReader, std::istream &myfile, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size, FstColumnAttribute col_attribute, IColumnFactory* columnFactory, int colSel);
+  unsigned long long length, unsigned long long size, FstColumnAttribute col_attribute, IColumnFactory* columnFactory, int colSel,
+  const IFstSource* positionalReader = nullptr);
+
+
+// Read a factor column that spans multiple data chunks, one entry per chunk in each vector.
+// Parameter 'startRow' is zero based and relative to the start of the chunk. Consecutive entries with the same
+// 'blockPos' are slices of a single data chunk and share its levels. If 'rowIndex' is given, entry 'chunk' selects the
+// (zero based) rows rowIndex[startRow[chunk]] up to rowIndex[startRow[chunk] + length[chunk] - 1] instead of a row range.
+void fdsReadFactorChunks_v7(IFstTable &tableReader, std::istream &myfile, const std::vector<unsigned long long> &blockPos,
+  const std::vector<unsigned long long> &startRow, const std::vector<unsigned long long> &length,
+  const std::vector<unsigned long long> &size, FstColumnAttribute col_attribute, IColumnFactory* columnFactory, int colSel,
+  const IFstSource* positionalReader = nullptr, const unsigned long long* rowIndex = nullptr);
 
 
 #endif  // FACTOR_v7_H
@@ -24,23 +24,58 @@
 using namespace std;
 
 
-void fdsWriteIntVec_v8(ofstream &myfile, int* integerVector, unsigned long long nrOfRows, unsigned int compression,
-  std::string annotation, bool hasAnnotation)
+// Compressor for the blocks that need the strongest compression
+inline Compressor* IntStrongCompressor(int compressionLevel, bool fastDecompression)
 {
-  int blockSize = 4 * BLOCKSIZE_INT;  // block size in bytes
+  if (fastDecompression) return new Lz4HighCompressor(CompAlgo::LZ4_SHUF4, compressionLevel);
+
+  return new SingleCompressor(CompAlgo::ZSTD_SHUF4, compressionLevel);
+}
+
+
+void fdsWriteIntVec_v8(ostream &myfile, int* integerVector, unsigned long long nrOfRows, unsigned int compression,
+  std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics, unsigned int blockSize, bool extendedCodecs,
+  bool adaptiveCompression, bool fastDecompression)
+{
+  const int blockSizeElems = blockSize / 4;  // number of elements in a compression block
 
   if (compression == 0)
   {
-    return fdsStreamUncompressed_v2(myfile, reinterpret_cast<char*>(integerVector), nrOfRows, 4, BLOCKSIZE_INT, nullptr, annotation, hasAnnotation);
+    return fdsStreamUncompressed_v2(myfile, reinterpret_cast<char*>(integerVector), nrOfRows, 4, BLOCKSIZE_INT, nullptr, annotation, hasAnnotation, columnStatistics);
+  }
+
+  if (adaptiveCompression)  // the codec of each block is selected from a compressed sample
+  {
+    Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_SHUF4, 0);
+    Compressor* compress2 = IntStrongCompressor(compression, fastDecompression);
+
+    if (extendedCodecs)  // bit-packing competes with both algorithms
+    {
+      compress1 = new IntegerPackCompressor(compress1, false);
+      compress2 = new IntegerPackCompressor(compress2, false);
+    }
+
+    StreamCompressor* streamCompressor = new StreamAdaptiveCompressor(compress1, compress2, compression);
+    streamCompressor->CompressBufferSize(blockSize);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(integerVector), nrOfRows, 4, streamCompressor,
+      blockSizeElems, annotation, hasAnnotation, columnStatistics);
+
+    delete compress1;
+    delete compress2;
+    delete streamCompressor;
+    return;
   }
 
   if (compression <= 50)  // low compression: linear mix of uncompressed and LZ4_SHUF
   {
     Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_SHUF4, 0);
+    if (extendedCodecs) compress1 = new IntegerPackCompressor(compress1, false);
+
     StreamCompressor* streamCompressor = new StreamLinearCompressor(compress1, 2.0F * compression);
 
     streamCompressor->CompressBufferSize(blockSize);
-    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(integerVector), nrOfRows, 4, streamCompressor, BLOCKSIZE_INT, annotation, hasAnnotation);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(integerVector), nrOfRows, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
     delete compress1;
     delete streamCompressor;
@@ -48,10 +83,17 @@ void fdsWriteIntVec_v8(ofstream &myfile, int* integerVector, unsigned long long
   }
 
   Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_SHUF4, 0);
-  Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD_SHUF4, 2 * (compression - 50));
+  Compressor* compress2 = IntStrongCompressor(2 * (compression - 50), fastDecompression);
+
+  if (extendedCodecs)  // bit-packing competes with both algorithms
+  {
+    compress1 = new IntegerPackCompressor(compress1, false);
+    compress2 = new IntegerPackCompressor(compress2, false);
+  }
+
   StreamCompressor* streamCompressor = new StreamCompositeCompressor(compress1, compress2, 2.0f * (compression - 50));
   streamCompressor->CompressBufferSize(blockSize);
-  fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(integerVector), nrOfRows, 4, streamCompressor, BLOCKSIZE_INT, annotation, hasAnnotation);
+  fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(integerVector), nrOfRows, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
   delete compress1;
   delete compress2;
@@ -62,7 +104,9 @@ void fdsWriteIntVec_v8(ofstream &myfile, int* integerVector, unsigned long long
 
 
 void fdsReadIntVec_v8(istream &myfile, int* integerVec, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size, std::string &annotation, bool &hasAnnotation)
+  unsigned long long length, unsigned long long size, std::string &annotation, bool &hasAnnotation,
+  const IFstSource* positionalReader, ColumnMetaCache* metaCache)
 {
-  return fdsReadColumn_v2(myfile, reinterpret_cast<char*>(integerVec), blockPos, startRow, length, size, 4, annotation, BATCH_SIZE_READ_INT, hasAnnotation);
+  return fdsReadColumn_v2(myfile, reinterpret_cast<char*>(integerVec), blockPos, startRow, length, size, 4, annotation, BATCH_SIZE_READ_INT,
+    hasAnnotation, positionalReader, metaCache);
 }
@@ -22,11 +22,26 @@
 #include <ostream>
 #include <istream>
 
+#include <interface/fstdefines.h>
 
-void fdsWriteIntVec_v8(std::ofstream &myfile, int* integerVector, unsigned long long nrOfRows, unsigned int compression,
-  std::string annotation, bool hasAnnotation);
+
+class IFstSource;
+class ColumnMetaCache;
+class ColumnStatistics;
+
+
+// Parameter 'extendedCodecs' allows the compressed blocks to be stored with DELTA_INT or FOR_INT bit-packing or
+// with RLE_INT run-length encoding.
+// Parameter 'adaptiveCompression' selects the codec of each block from a compressed sample (see
+// StreamAdaptiveCompressor).
+// Parameter 'fastDecompression' replaces ZSTD with the high compression LZ4 encoder (see Lz4HighCompressor).
+void fdsWriteIntVec_v8(std::ostream &myfile, int* integerVector, unsigned long long nrOfRows, unsigned int compression,
+  std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics = nullptr, unsigned int blockSize = BLOCKSIZE, bool extendedCodecs = false,
+  bool adaptiveCompression = false, bool fastDecompression = false);
 
 void fdsReadIntVec_v8(std::istream &myfile, int* integerVector, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size, std::string &annotation, bool &hasAnnotation);
+  unsigned long long length, unsigned long long size, std::string &annotation, bool &hasAnnotation,
+  const IFstSource* positionalReader = nullptr, ColumnMetaCache* metaCache = nullptr);
 
 #endif // INTEGER_V8_H
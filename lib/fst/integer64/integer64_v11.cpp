@@ -24,22 +24,57 @@
 using namespace std;
 
 
-void fdsWriteInt64Vec_v11(ofstream &myfile, long long* int64Vector, unsigned long long nrOfRows, unsigned int compression,
-  std::string annotation, bool hasAnnotation)
+// Compressor for the blocks that need the strongest compression
+inline Compressor* Int64StrongCompressor(int compressionLevel, bool fastDecompression)
 {
-  int blockSize = 8 * BLOCKSIZE_INT64;  // block size in bytes
+  if (fastDecompression) return new Lz4HighCompressor(CompAlgo::LZ4_SHUF8, compressionLevel);
+
+  return new SingleCompressor(CompAlgo::ZSTD_SHUF8, compressionLevel);
+}
+
+
+void fdsWriteInt64Vec_v11(ostream &myfile, long long* int64Vector, unsigned long long nrOfRows, unsigned int compression,
+  std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics, unsigned int blockSize, bool extendedCodecs,
+  bool adaptiveCompression, bool fastDecompression)
+{
+  const int blockSizeElems = blockSize / 8;  // number of elements in a compression block
 
   if (compression == 0)
   {
-    return fdsStreamUncompressed_v2(myfile, reinterpret_cast<char*>(int64Vector), nrOfRows, 8, BLOCKSIZE_INT64, nullptr, annotation, hasAnnotation);
+    return fdsStreamUncompressed_v2(myfile, reinterpret_cast<char*>(int64Vector), nrOfRows, 8, BLOCKSIZE_INT64, nullptr, annotation, hasAnnotation, columnStatistics);
+  }
+
+  if (adaptiveCompression)  // the codec of each block is selected from a compressed sample
+  {
+    Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_SHUF8, 100);
+    Compressor* compress2 = Int64StrongCompressor(compression, fastDecompression);
+
+    if (extendedCodecs)  // bit-packing competes with both algorithms
+    {
+      compress1 = new IntegerPackCompressor(compress1, true);
+      compress2 = new IntegerPackCompressor(compress2, true);
+    }
+
+    StreamCompressor* streamCompressor = new StreamAdaptiveCompressor(compress1, compress2, compression);
+    streamCompressor->CompressBufferSize(blockSize);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(int64Vector), nrOfRows, 8, streamCompressor,
+      blockSizeElems, annotation, hasAnnotation, columnStatistics);
+
+    delete compress1;
+    delete compress2;
+    delete streamCompressor;
+    return;
   }
 
   if (compression <= 50)  // low compression: linear mix of uncompressed and LZ4_SHUF8
   {
     Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_SHUF8, 2 * compression);
+    if (extendedCodecs) compress1 = new IntegerPackCompressor(compress1, true);
+
     StreamCompressor* streamCompressor = new StreamLinearCompressor(compress1, 2 * compression);
     streamCompressor->CompressBufferSize(blockSize);
-    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(int64Vector), nrOfRows, 8, streamCompressor, BLOCKSIZE_INT64, annotation, hasAnnotation);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(int64Vector), nrOfRows, 8, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
     delete compress1;
     delete streamCompressor;
@@ -49,10 +84,19 @@ void fdsWriteInt64Vec_v11(ofstream &myfile, long long* int64Vector, unsigned lon
   // higher compression: linear mix of LZ4_SHUF8 and ZSTD_SHUF8
 
   Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_SHUF8, 100);
-  Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD_SHUF8, compression - 50);
+  // the high compression LZ4 encoder uses the full range of levels
+  const int strongLevel = fastDecompression ? 2 * (compression - 50) : compression - 50;
+  Compressor* compress2 = Int64StrongCompressor(strongLevel, fastDecompression);
+
+  if (extendedCodecs)  // bit-packing competes with both algorithms
+  {
+    compress1 = new IntegerPackCompressor(compress1, true);
+    compress2 = new IntegerPackCompressor(compress2, true);
+  }
+
   StreamCompressor* streamCompressor = new StreamCompositeCompressor(compress1, compress2, 2 * (compression - 50));
   streamCompressor->CompressBufferSize(blockSize);
-  fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(int64Vector), nrOfRows, 8, streamCompressor, BLOCKSIZE_INT64, annotation, hasAnnotation);
+  fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(int64Vector), nrOfRows, 8, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
   delete compress1;
   delete compress2;
@@ -63,11 +107,11 @@ void fdsWriteInt64Vec_v11(ofstream &myfile, long long* int64Vector, unsigned lon
 
 
 void fdsReadInt64Vec_v11(istream &myfile, long long* int64Vector, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size)
+  unsigned long long length, unsigned long long size, const IFstSource* positionalReader, ColumnMetaCache* metaCache)
 {
   std::string annotation;
   bool hasAnnotation;
 
   return fdsReadColumn_v2(myfile, reinterpret_cast<char*>(int64Vector), blockPos, startRow, length, size, 8, annotation,
-    BATCH_SIZE_READ_INT64, hasAnnotation);
+    BATCH_SIZE_READ_INT64, hasAnnotation, positionalReader, metaCache);
 }
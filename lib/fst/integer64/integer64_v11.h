@@ -21,11 +21,26 @@
 // System libraries
 #include <ostream>
 
+#include <interface/fstdefines.h>
 
-void fdsWriteInt64Vec_v11(std::ofstream &myfile, long long* int64Vector, unsigned long long nrOfRows, unsigned int compression,
-  std::string annotation, bool hasAnnotation);
+
+class IFstSource;
+class ColumnMetaCache;
+class ColumnStatistics;
+
+
+// Parameter 'extendedCodecs' allows the compressed blocks to be stored with DELTA_INT64 or FOR_INT64 bit-packing or
+// with RLE_INT64 run-length encoding.
+// Parameter 'adaptiveCompression' selects the codec of each block from a compressed sample (see
+// StreamAdaptiveCompressor).
+// Parameter 'fastDecompression' replaces ZSTD with the high compression LZ4 encoder (see Lz4HighCompressor).
+void fdsWriteInt64Vec_v11(std::ostream &myfile, long long* int64Vector, unsigned long long nrOfRows, unsigned int compression,
+  std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics = nullptr, unsigned int blockSize = BLOCKSIZE, bool extendedCodecs = false,
+  bool adaptiveCompression = false, bool fastDecompression = false);
 
 void fdsReadInt64Vec_v11(std::istream &myfile, long long* int64Vector, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size);
+  unsigned long long length, unsigned long long size, const IFstSource* positionalReader = nullptr,
+  ColumnMetaCache* metaCache = nullptr);
 
 #endif // INT64_V11_H
@@ -0,0 +1,86 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#include <cstring>
+
+#include <interface/fstdefines.h>
+#include <interface/columnnameindex.h>
+
+#include <xxhash.h>
+
+
+using namespace std;
+
+
+inline uint64_t HashName(const char* colName)
+{
+  return ZSTD_XXH64(colName, strlen(colName), FST_HASH_SEED);
+}
+
+
+void ColumnNameIndex::Build(IStringColumn* colNames, const int nrOfCols)
+{
+  this->colNames = colNames;
+
+  // power of two with a load factor of at most 0.5
+  uint64_t nrOfSlots = 2;
+  while (nrOfSlots < 2 * static_cast<uint64_t>(nrOfCols)) nrOfSlots *= 2;
+
+  mask = nrOfSlots - 1;
+  slots.assign(nrOfSlots, 0);
+  hashes.assign(nrOfSlots, 0);
+
+  for (int colNr = 0; colNr < nrOfCols; ++colNr)
+  {
+    const char* colName = colNames->GetElement(colNr);
+    const uint64_t hash = HashName(colName);
+    const uint32_t tag = static_cast<uint32_t>(hash >> 32);
+
+    // linear probing
+    uint64_t slot = hash & mask;
+
+    while (slots[slot] != 0)
+    {
+      // keep the first column of a duplicate name
+      if (hashes[slot] == tag && strcmp(colNames->GetElement(slots[slot] - 1), colName) == 0) break;
+
+      slot = (slot + 1) & mask;
+    }
+
+    if (slots[slot] != 0) continue;
+
+    slots[slot] = colNr + 1;
+    hashes[slot] = tag;
+  }
+}
+
+
+int ColumnNameIndex::Find(const char* colName) const
+{
+  if (colNames == nullptr) return -1;
+
+  const uint64_t hash = HashName(colName);
+  const uint32_t tag = static_cast<uint32_t>(hash >> 32);
+
+  for (uint64_t slot = hash & mask; slots[slot] != 0; slot = (slot + 1) & mask)
+  {
+    if (hashes[slot] == tag && strcmp(colNames->GetElement(slots[slot] - 1), colName) == 0) return slots[slot] - 1;
+  }
+
+  return -1;
+}
@@ -0,0 +1,58 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#ifndef COLUMN_NAME_INDEX_H
+#define COLUMN_NAME_INDEX_H
+
+
+#include <cstdint>
+#include <vector>
+
+#include <interface/ifstcolumn.h>
+
+
+/**
+ * \brief Hash index of the column names of a table. A column name is resolved with a single hash and (usually) a
+ * single string comparison, instead of a comparison with each column name. The index refers to the names in the
+ * column name vector, which should outlive the index.
+ */
+class ColumnNameIndex
+{
+  IStringColumn* colNames = nullptr;
+  std::vector<int> slots;        // column number + 1 of each slot, 0 for an empty slot
+  std::vector<uint32_t> hashes;  // high bits of the name hash of each slot to skip most string comparisons
+  uint64_t mask = 0;
+
+public:
+  /**
+   * \brief Build the index for the column names.
+   * \param colNames column names, for duplicate names the first column is used.
+   * \param nrOfCols number of columns.
+   */
+  void Build(IStringColumn* colNames, int nrOfCols);
+
+  bool IsEmpty() const { return colNames == nullptr; }
+
+  /**
+   * \brief Column number of a column name or -1 if the table has no such column.
+   */
+  int Find(const char* colName) const;
+};
+
+
+#endif  // COLUMN_NAME_INDEX_H
@@ -0,0 +1,96 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <interface/fstdefines.h>
+#include <interface/fstbatchreader.h>
+#include <interface/readcache.h>
+
+
+using namespace std;
+
+
+FstBatchReader::FstBatchReader(const std::string &fstFile, IColumnFactory* columnFactory, IStringArray* columnSelection,
+  const unsigned long long batchRows, const bool memoryMapped) : fstStore(fstFile), cache(new ReadCache())
+{
+  if (batchRows == 0)
+  {
+    throw(runtime_error(FSTERROR_BATCH_ROWS));
+  }
+
+  this->batchRows = BATCH_ROWS_ALIGNMENT * ((batchRows + BATCH_ROWS_ALIGNMENT - 1) / BATCH_ROWS_ALIGNMENT);
+
+  fstStore.SetMemoryMapped(memoryMapped);
+
+  colNames = std::unique_ptr<IStringColumn>(columnFactory->CreateStringColumn(0, FstColumnAttribute::NONE));
+
+  fstStore.OpenTable(colNames.get(), *cache);
+  fstStore.OpenReadCache(*cache, true);
+
+  // the column headers and block indexes are read once per data chunk instead of once per batch
+  cache->columnMeta = std::unique_ptr<ColumnMetaCache>(new ColumnMetaCache());
+
+  if (columnSelection != nullptr) cache->columnIndex.Build(colNames.get(), fstStore.nrOfCols);
+
+  nrOfSelect = fstStore.SelectColumns(*cache, columnSelection, colIndex);
+}
+
+
+// ReadCache is only complete in this unit
+FstBatchReader::~FstBatchReader() { }
+
+
+bool FstBatchReader::NextBatch(IFstTable &tableReader, IColumnFactory* columnFactory, vector<int> &keyIndex,
+  IStringArray* selectedCols)
+{
+  const vector<unsigned long long> &chunkRows = cache->chunkRows;
+
+  // skip to the data chunk that contains the next row
+  while (chunk < chunkRows.size() && nextRow >= chunkStart + chunkRows[chunk])
+  {
+    chunkStart += chunkRows[chunk++];
+    cache->columnMeta->Clear();  // metadata of the previous data chunk is not used again
+  }
+
+  if (chunk == chunkRows.size()) return false;
+
+  const unsigned long long batchEnd = min(nextRow + batchRows, chunkStart + chunkRows[chunk]);
+
+  fstStore.ReadColumnRange(*cache, tableReader, colIndex.get(), nrOfSelect, nextRow + 1, batchEnd, columnFactory, keyIndex,
+    selectedCols, colNames.get());
+
+  nextRow = batchEnd;
+
+  return true;
+}
+
+
+void FstBatchReader::Reset()
+{
+  nextRow = 0;
+  chunk = 0;
+  chunkStart = 0;
+}
+
+
+unsigned long long FstBatchReader::NrOfRows() const
+{
+  return cache->NrOfRows();
+}
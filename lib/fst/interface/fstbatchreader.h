@@ -0,0 +1,95 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#ifndef FST_BATCH_READER_H
+#define FST_BATCH_READER_H
+
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <interface/fststore.h>
+
+
+/**
+ * \brief Iterates over the rows of a fst file in batches, for files that are larger than memory. The table metadata
+ * (including the data chunk headers) is read once and the column selection is resolved once, so a full scan reads
+ * each header only once. The column headers and block indexes of the fixed-width columns are kept for the data chunk
+ * that is being read, so they are not read again for every batch.
+ *
+ * Batches never span multiple data chunks and their size is a multiple of BATCH_ROWS_ALIGNMENT rows, so batch
+ * boundaries coincide with the compression block boundaries of all fixed-width columns and no block is decompressed
+ * for more than one batch. Memory use is bounded by the size of a single batch.
+ */
+class FstBatchReader
+{
+  FstStore fstStore;
+  std::unique_ptr<IStringColumn> colNames;
+  std::unique_ptr<ReadCache> cache;
+
+  std::unique_ptr<int[]> colIndex;  // selected columns
+  int nrOfSelect;
+
+  unsigned long long batchRows;
+  unsigned long long nextRow = 0;     // first row of the next batch (zero based)
+  size_t chunk = 0;                   // data chunk that contains nextRow
+  unsigned long long chunkStart = 0;  // first row of that data chunk
+
+public:
+  /**
+   * \brief Open a fst file for reading in batches.
+   * \param fstFile path of the fst file.
+   * \param columnFactory factory used to create the column names vector.
+   * \param columnSelection names of the columns to read, nullptr for all columns.
+   * \param batchRows maximum number of rows in a batch, rounded up to a multiple of BATCH_ROWS_ALIGNMENT.
+   * \param memoryMapped map the file into memory once and use it for all batches (see FstStore::SetMemoryMapped).
+   */
+  FstBatchReader(const std::string &fstFile, IColumnFactory* columnFactory, IStringArray* columnSelection,
+    unsigned long long batchRows, bool memoryMapped = false);
+
+  ~FstBatchReader();
+
+  /**
+   * \brief Read the next batch of rows.
+   * \param tableReader result table.
+   * \return false if all rows have been read (the table is not used).
+   */
+  bool NextBatch(IFstTable &tableReader, IColumnFactory* columnFactory, std::vector<int> &keyIndex,
+    IStringArray* selectedCols);
+
+  /**
+   * \brief Restart at the first row of the file.
+   */
+  void Reset();
+
+  unsigned long long NrOfRows() const;
+
+  /**
+   * \brief Number of rows in a (full) batch.
+   */
+  unsigned long long BatchRows() const { return batchRows; }
+
+  /**
+   * \brief Zero based row number of the first row of the next batch.
+   */
+  unsigned long long NextRow() const { return nextRow; }
+};
+
+
+#endif  // FST_BATCH_READER_H
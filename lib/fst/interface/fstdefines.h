@@ -31,15 +31,44 @@
 #define FST_VERSION          (FST_VERSION_MAJOR * 256 + FST_VERSION_MINOR)
 #define FST_COMPRESS_VERSION 1
 
+// Files that use the format extensions below are marked with a feature version as the minimum version required to
+// read them. Feature versions are fixed values above FST_VERSION_FEATURES, which exceeds MAJOR * 256 + MINOR for any
+// major version below 256. They never collide with a future FST_VERSION and don't change when the version is raised.
+// Older readers refuse these files, readers accept the feature versions up to FST_VERSION_READ.
+#define FST_VERSION_FEATURES    0x10000
+
+// Minimum version required to read files with more than one data chunk (see FstStore::fstAppend). Older readers only
+// read the rows of the first data chunk.
+#define FST_VERSION_MULTI_CHUNK (FST_VERSION_FEATURES + 1)
+
+// Minimum version required to read files with compression blocks larger than BLOCKSIZE (see FstStore::SetBlockSize).
+// Older readers use fixed size block buffers, so these files are only marked with this version when large blocks are
+// used.
+#define FST_VERSION_BLOCK_SIZE  (FST_VERSION_FEATURES + 2)
+
+// Minimum version required to read files with character columns that are compressed with a dictionary (see
+// FstStore::SetCharacterDictionary).
+#define FST_VERSION_CHAR_DICT   (FST_VERSION_FEATURES + 3)
+
+// Minimum version required to read files with blocks that are compressed with the extended integer codecs (see
+// FstStore::SetExtendedCodecs).
+#define FST_VERSION_CODECS      (FST_VERSION_FEATURES + 4)
+#define FST_VERSION_READ        FST_VERSION_CODECS  // highest feature version that can be read
+
 #define FST_MAGIC_NUMBER     0x50414150         // magic number and signature of the fst format
 #define TABLE_META_SIZE      48                 // size of table meta-data block
 #define FST_FILE_ID          0xa91c12f8b245a71d // identifies a fst file or memory block
 #define FST_HASH_SEED        912824571          // default seed used for xxhash algorithm
 #define CHUNKSET_HEADER_SIZE 80                 // size of chunkset header
 #define CHUNK_INDEX_SIZE     96                 // size of chunk index header
+#define CHUNK_INDEX_SLOTS    4                  // number of data chunk slots in a chunk index
 #define DATA_INDEX_SIZE      24                 // size of data index header
 #define CHAR_HEADER_SIZE     8                  // meta data header size
 #define CHAR_INDEX_SIZE      16                 // size of 1 index entry
+#define CHAR_DICT_SIZE       65536              // maximum size of a character column dictionary
+#define CHAR_DICT_MIN_BLOCKS 8                  // minimum number of character blocks to train a dictionary
+#define CHAR_DICT_TRAIN_SIZE 1048576            // maximum number of sampled bytes used to train a dictionary
+#define CHAR_DICT_SAMPLE     4096               // sampled blocks are split in samples of this size
 #define BASIC_HEAP_SIZE      1048576            // starting size of heap buffer
 
 // Format flags
@@ -52,6 +81,12 @@
 #define BATCH_SIZE_READ_FACTOR          25
 #define BATCH_SIZE_READ_DOUBLE          25
 #define BATCH_SIZE_READ_BYTE            25
+#define READ_TASK_ROWS                  1048576  // maximum number of rows in a single column read task (multiple of all block sizes)
+#define BATCH_ROWS_ALIGNMENT            16384    // row batches of FstBatchReader are a multiple of all fixed-width block sizes
+#define GATHER_RUN_ROWS                 64       // filtered reads with shorter average runs of matching rows use a row selection
+#define WRITE_BUFFER_SIZE               1048576  // size of the write buffers handed to the writer thread
+#define WRITE_QUEUE_SIZE               67108864  // maximum number of bytes queued for the writer thread
+#define SOURCE_BUFFER_SIZE              65536    // read buffer of streams for metadata reads from a source
 
 // Cache-size related defines
 #define CACHEFACTOR                     1
@@ -74,19 +109,32 @@
 #define BLOCKSIZE_INT64                 (2048 * CACHEFACTOR)          // number of long long in default compression block
 #define BLOCKSIZE_INT                   (4096 * CACHEFACTOR)          // number of integers in default compression block
 #define BLOCKSIZE_BYTE                  (16384 * CACHEFACTOR)         // number of bytes in default compression block
+#define MAX_BLOCK_SIZE                  (1048576 * CACHEFACTOR)       // largest configurable compression block in bytes
 
 // fst specific errors
 #define FSTERROR_NOT_IMPLEMENTED     "Feature not implemented yet"
 #define FSTERROR_ERROR_OPENING_FILE  "Error opening fst file for reading, please check access rights and file availability"
 #define FSTERROR_NO_APPEND           "This version of the fst file format does not allow appending data"
+#define FSTERROR_APPEND_KEYED        "Data can not be appended to a table with key columns"
+#define FSTERROR_APPEND_COL_TYPES    "Column types of the appended data do not match the column types of the fst file"
+#define FSTERROR_APPEND_ROW_COUNT    "The number of rows of the added columns does not match the number of rows of the fst file"
 #define FSTERROR_DAMAGED_HEADER      "It seems the file header was damaged or incomplete"
 #define FSTERROR_DAMAGED_CHUNKINDEX  "The chunk index header is damaged or incomplete"
 #define FSTERROR_DAMAGED_METADATA    "The file contains damaged or missing metadata"
+#define FSTERROR_DAMAGED_STATISTICS  "The column statistics are damaged or incomplete"
+#define FSTERROR_ROWS_NOT_SORTED     "Selected rows should be sorted in increasing order"
+#define FSTERROR_STREAM_CLOSED       "Rows can not be written to a closed streamer"
+#define FSTERROR_BATCH_ROWS          "The number of rows in a batch should be positive"
+#define FSTERROR_BLOCK_SIZE          "The block size should be a power of two between 16 KB and 1 MB"
+#define FSTERROR_COLUMN_INDEX        "Column index is out of range"
+#define FSTERROR_DECIMALS            "The number of decimals should be between 0 and 9"
+#define FSTERROR_PREDICATE_COL_TYPE  "Predicates are only supported for integer, integer64, double and logical columns"
 #define FSTERROR_INCORRECT_COL_COUNT "Data frame has an incorrect amount of columns"
 #define FSTERROR_NON_FST_FILE        "File format was not recognised as a fst file"
 #define FSTERROR_NO_DATA             "The dataset contains no data"
 #define FSTERROR_ERROR_OPEN_WRITE    "There was an error creating the file, please check path"
 #define FSTERROR_ERROR_OPEN_READ     "There was an error opening the file, it seems to be incomplete or damaged."
+#define FSTERROR_READ_FAILED         "There was an error reading data from the file, it seems to be incomplete or damaged."
 #define FSTERROR_UPDATE_FST          "Incompatible fst file: file was created by a newer version of fst"
 #define FSTERROR_COMP_DATA_HASH      "Incorrect input vector: data block hash does not match."
 #define FSTERROR_COMP_STREAM         "An error was detected in the compressed data stream."
@@ -94,6 +142,8 @@
 #define FSTERROR_COMP_HEADER         "Incorrect header information found in raw vector."
 #define FSTERROR_COMP_NO_DATA        "Source contains no data."
 #define FSTERROR_COMP_FUTURE_VERSION "Data has been compressed with a newer version than the current."
+#define FSTERROR_COMPRESSION_CONTEXT "Unable to allocate a compression context."
+#define FSTERROR_LZ4_HIGH_ALGORITHM  "High compression LZ4 requires the LZ4, LZ4_SHUF4 or LZ4_SHUF8 algorithm."
 
 #define FST_NA_INT					         0x80000000
 
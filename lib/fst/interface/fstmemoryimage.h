@@ -0,0 +1,65 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef FST_MEMORY_IMAGE_H
+#define FST_MEMORY_IMAGE_H
+
+#include <vector>
+
+
+/**
+ * \brief Contiguous block of memory that contains a serialized fst table. A FstStore created with a memory image
+ * writes to and reads from the image instead of a file, so tables can be serialized to RAM (for caches or
+ * inter-process communication) and read back without a round trip through the file system. The content is identical
+ * to a fst file, so an image can be written to disk as is and a fst file can be loaded into an image.
+ *
+ * An image should not be modified while it is being read.
+ */
+class FstMemoryImage
+{
+  std::vector<char> data;
+
+public:
+  /**
+   * \brief Create an empty image, for example to serialize a table into.
+   */
+  FstMemoryImage() { }
+
+  /**
+   * \brief Create an image with a copy of a serialized fst table.
+   * \param buffer start of the serialized table.
+   * \param size size of the serialized table in bytes.
+   */
+  FstMemoryImage(const char* buffer, unsigned long long size) : data(buffer, buffer + size) { }
+
+  /**
+   * \brief Create an image that takes ownership of a serialized fst table.
+   */
+  explicit FstMemoryImage(std::vector<char> &&buffer) : data(std::move(buffer)) { }
+
+  const char* Data() const { return data.data(); }
+
+  unsigned long long Size() const { return data.size(); }
+
+  /**
+   * \brief The underlying buffer, for example to move the serialized table elsewhere.
+   */
+  std::vector<char> &Buffer() { return data; }
+};
+
+
+#endif  // FST_MEMORY_IMAGE_H
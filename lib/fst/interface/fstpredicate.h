@@ -0,0 +1,94 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef FST_PREDICATE_H
+#define FST_PREDICATE_H
+
+#include <string>
+#include <vector>
+
+
+enum class FstPredicateType
+{
+  RANGE = 0,  // value within an (inclusive) range
+  EQUAL,      // value equal to a single value
+  IN          // value equal to one of a set of values
+};
+
+
+/**
+ * \brief Row filter on a single INT_32, INT_64, DOUBLE_64 or BOOL_2 column, used with FstStore::fstReadFiltered.
+ * Values can be specified as integers (exact for 64 bit integer columns) or as doubles. NA values never match.
+ */
+class FstPredicate
+{
+public:
+  std::string columnName;
+  FstPredicateType type;
+  bool isReal;  // values are specified in realValues instead of intValues
+  std::vector<long long> intValues;
+  std::vector<double> realValues;
+
+  /**
+   * \brief Select rows with lower <= value <= upper.
+   */
+  static FstPredicate Range(const std::string &columnName, long long lower, long long upper)
+  {
+    return FstPredicate(columnName, FstPredicateType::RANGE, std::vector<long long> { lower, upper });
+  }
+
+  static FstPredicate Range(const std::string &columnName, double lower, double upper)
+  {
+    return FstPredicate(columnName, FstPredicateType::RANGE, std::vector<double> { lower, upper });
+  }
+
+  /**
+   * \brief Select rows with value == 'value'.
+   */
+  static FstPredicate Equal(const std::string &columnName, long long value)
+  {
+    return FstPredicate(columnName, FstPredicateType::EQUAL, std::vector<long long> { value });
+  }
+
+  static FstPredicate Equal(const std::string &columnName, double value)
+  {
+    return FstPredicate(columnName, FstPredicateType::EQUAL, std::vector<double> { value });
+  }
+
+  /**
+   * \brief Select rows with a value that is equal to one of 'values'.
+   */
+  static FstPredicate In(const std::string &columnName, const std::vector<long long> &values)
+  {
+    return FstPredicate(columnName, FstPredicateType::IN, values);
+  }
+
+  static FstPredicate In(const std::string &columnName, const std::vector<double> &values)
+  {
+    return FstPredicate(columnName, FstPredicateType::IN, values);
+  }
+
+private:
+  FstPredicate(const std::string &columnName, FstPredicateType type, const std::vector<long long> &values) :
+    columnName(columnName), type(type), isReal(false), intValues(values) { }
+
+  FstPredicate(const std::string &columnName, FstPredicateType type, const std::vector<double> &values) :
+    columnName(columnName), type(type), isReal(true), realValues(values) { }
+};
+
+
+#endif  // FST_PREDICATE_H
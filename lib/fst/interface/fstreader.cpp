@@ -0,0 +1,75 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#include <stdexcept>
+
+#include <interface/fstreader.h>
+#include <interface/readcache.h>
+
+
+using namespace std;
+
+
+FstReader::FstReader(const std::string &fstFile, IColumnFactory* columnFactory, const bool memoryMapped) :
+  fstStore(fstFile), cache(new ReadCache())
+{
+  fstStore.SetMemoryMapped(memoryMapped);
+
+  colNames = std::unique_ptr<IStringColumn>(columnFactory->CreateStringColumn(0, FstColumnAttribute::NONE));
+
+  fstStore.OpenTable(colNames.get(), *cache);
+  fstStore.OpenReadCache(*cache, true);
+
+  // column selections are resolved with a hash index of the column names
+  cache->columnIndex.Build(colNames.get(), fstStore.nrOfCols);
+}
+
+
+// ReadCache is only complete in this unit
+FstReader::~FstReader() { }
+
+
+unsigned long long FstReader::NrOfRows() const
+{
+  return cache->NrOfRows();
+}
+
+
+void FstReader::fstRead(IFstTable &tableReader, IStringArray* columnSelection, const int64_t startRow, const int64_t endRow,
+  IColumnFactory* columnFactory, vector<int> &keyIndex, IStringArray* selectedCols) const
+{
+  fstStore.ReadRange(*cache, tableReader, columnSelection, startRow, endRow, columnFactory, keyIndex, selectedCols,
+    colNames.get());
+}
+
+
+void FstReader::fstReadRows(IFstTable &tableReader, IStringArray* columnSelection, const vector<int64_t> &rows,
+  IColumnFactory* columnFactory, vector<int> &keyIndex, IStringArray* selectedCols) const
+{
+  fstStore.ReadSelection(*cache, tableReader, columnSelection, rows, columnFactory, keyIndex, selectedCols,
+    colNames.get());
+}
+
+
+void FstReader::fstReadFiltered(IFstTable &tableReader, IStringArray* columnSelection,
+  const vector<FstPredicate> &predicates, IColumnFactory* columnFactory, vector<int> &keyIndex,
+  IStringArray* selectedCols) const
+{
+  fstStore.ReadFiltered(*cache, tableReader, columnSelection, predicates, columnFactory, keyIndex, selectedCols,
+    colNames.get());
+}
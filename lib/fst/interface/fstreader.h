@@ -0,0 +1,84 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#ifndef FST_READER_H
+#define FST_READER_H
+
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <interface/fststore.h>
+
+
+/**
+ * \brief Long-lived reader for a fst file. The table metadata (header, column names, chunk index and data chunk
+ * headers) is parsed and verified once on construction and the file stays open for positional reads, so repeated
+ * reads only touch the column data. All read methods are const and can be called concurrently from multiple threads,
+ * as long as each call uses its own result table and a thread-safe (or per-thread) column factory.
+ *
+ * The reader reflects the state of the file at construction: rows appended afterwards are not visible, but existing
+ * data is never rewritten by fstAppend so the reader remains valid.
+ */
+class FstReader
+{
+  FstStore fstStore;
+  std::unique_ptr<IStringColumn> colNames;
+  std::unique_ptr<ReadCache> cache;
+
+public:
+  /**
+   * \brief Open a fst file and read its metadata.
+   * \param fstFile path of the fst file.
+   * \param columnFactory factory used to create the column names vector.
+   * \param memoryMapped map the file into memory once and use it for all reads (see FstStore::SetMemoryMapped).
+   */
+  FstReader(const std::string &fstFile, IColumnFactory* columnFactory, bool memoryMapped = false);
+
+  ~FstReader();
+
+  unsigned long long NrOfRows() const;
+
+  int NrOfColumns() const { return fstStore.nrOfCols; }
+
+  IStringColumn* ColumnNames() const { return colNames.get(); }
+
+  const unsigned short int* ColumnTypes() const { return fstStore.colTypes; }
+
+  /**
+   * \brief Read a range of rows, see FstStore::fstRead.
+   */
+  void fstRead(IFstTable &tableReader, IStringArray* columnSelection, int64_t startRow, int64_t endRow,
+    IColumnFactory* columnFactory, std::vector<int> &keyIndex, IStringArray* selectedCols) const;
+
+  /**
+   * \brief Read a sorted selection of rows, see FstStore::fstReadRows.
+   */
+  void fstReadRows(IFstTable &tableReader, IStringArray* columnSelection, const std::vector<int64_t> &rows,
+    IColumnFactory* columnFactory, std::vector<int> &keyIndex, IStringArray* selectedCols) const;
+
+  /**
+   * \brief Read the rows that satisfy all predicates, see FstStore::fstReadFiltered.
+   */
+  void fstReadFiltered(IFstTable &tableReader, IStringArray* columnSelection, const std::vector<FstPredicate> &predicates,
+    IColumnFactory* columnFactory, std::vector<int> &keyIndex, IStringArray* selectedCols) const;
+};
+
+
+#endif  // FST_READER_H
@@ -19,6 +19,7 @@
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
+#include <exception>
 #include <cstring>
 #include <algorithm>
 #include <memory>
@@ -28,6 +29,9 @@
 #include <interface/icolumnfactory.h>
 #include <interface/fstdefines.h>
 #include <interface/fststore.h>
+#include <interface/fsttableview.h>
+#include <interface/openmphelper.h>
+#include <interface/readcache.h>
 
 #include <character/character_v6.h>
 #include <factor/factor_v7.h>
@@ -37,6 +41,15 @@
 #include <integer64/integer64_v11.h>
 #include <byte/byte_v12.h>
 #include <byteblock/byteblock_v13.h>
+#include <blockstreamer/blockstreamer_v2.h>
+#include <blockstreamer/positionalreader.h>
+#include <blockstreamer/memorymappedfile.h>
+#include <blockstreamer/pipelinedwriter.h>
+#include <blockstreamer/memorystream.h>
+#include <blockstreamer/sourcestream.h>
+#include <compression/decimalcodec.h>
+#include <statistics/columnstatistics.h>
+#include <statistics/predicatefilter.h>
 
 #include <xxhash.h>
 #include "byteblock/byteblock_v13.h"
@@ -50,7 +63,7 @@ using namespace std;
 //  4                      | unsigned int       | FST_VERSION        // table header fst version
 //  4                      | int                | table flags        // binary table flags
 //  8                      |                    | free bytes         // possible future use
-//  4                      | unsigned int       | FST_VERSION_MAX    // minimum fst version required
+//  4                      | unsigned int       | FST_VERSION_MAX    // minimum fst version or feature version required
 //  4                      | int                | nrOfCols           // total number of columns in primary chunkset
 //  8                      | unsigned long long | primaryChunkSetLoc // reference to the table's primary chunkset
 //  4                      | int                | keyLength          // number of keys in table
@@ -101,7 +114,7 @@ using namespace std;
 //  8                      | unsigned long long | hash value         // hash of chunkset data header
 //  4                      | unsigned int       | FST_VERSION
 //  4                      | int                | index flags        // binary horizontal chunk flags
-//  8                      |                    | free bytes         // possible future use
+//  8                      | unsigned long long | nextChunkIndex     // reference to next chunk index (0 if last)
 //  2                      | unsigned int       | nrOfChunkSlots     // number of chunk slots
 //  6                      |                    | free bytes         // possible future use
 //  8 * 4                  | unsigned long long | chunkPos           // data chunk addresses
@@ -112,12 +125,16 @@ using namespace std;
 //  8                      | unsigned long long | hash value         // hash of chunkset data header
 //  4                      | unsigned int       | FST_VERSION
 //  4                      | int                | data chunk flags
-//  8                      |                    | free bytes         // possible future use
+//  8                      | unsigned long long | statisticsPos      // reference to the column statistics (0 if absent)
 //  8 * nrOfCols           | unsigned long long | positionData       // columnar position data
 //
+// Appended data chunks are registered in the first free slot of the last chunk index. When all slots
+// are taken, a new chunk index is written and linked to the previous one using nextChunkIndex.
 
 // Column data blocks [leaf of E]
 //  y                      |                    | column data        // data blocks with column element values
+//
+// Column statistics [leaf of E], see statistics/columnstatistics.h
 
 
 FstStore::FstStore(std::string fstFile)
@@ -126,7 +143,52 @@ FstStore::FstStore(std::string fstFile)
   // this->blockReader   = nullptr;
   this->keyColPos     = nullptr;
   this->p_nrOfRows    = nullptr;
+  p_primChunksetIndex = nullptr;
   metaDataBlock       = nullptr;
+  memoryMapped        = false;
+  blockSize           = BLOCKSIZE;
+  charDictionary      = false;
+  extendedCodecs      = false;
+  adaptiveCompression = false;
+  fastDecompression   = false;
+}
+
+
+FstStore::FstStore(std::shared_ptr<FstMemoryImage> memoryImage) : FstStore(std::string())
+{
+  this->memoryImage = std::move(memoryImage);
+}
+
+
+std::unique_ptr<IFstSource> FstStore::OpenSource() const
+{
+  std::unique_ptr<IFstSource> source;
+
+  if (memoryImage) source = std::unique_ptr<IFstSource>(new MemorySource(memoryImage));
+  else source = std::unique_ptr<IFstSource>(new PositionalReader(fstFile));
+
+  if (!source->IsOpen())
+  {
+    throw(runtime_error(FSTERROR_ERROR_OPENING_FILE));
+  }
+
+  return source;
+}
+
+
+std::unique_ptr<IFstSink> FstStore::OpenSink(const bool truncate) const
+{
+  std::unique_ptr<IFstSink> sink;
+
+  if (memoryImage) sink = std::unique_ptr<IFstSink>(new MemorySink(memoryImage, truncate));
+  else sink = std::unique_ptr<IFstSink>(new PipelinedWriter(fstFile, truncate));
+
+  if (!sink->IsOpen())
+  {
+    throw(runtime_error(FSTERROR_ERROR_OPEN_WRITE));
+  }
+
+  return sink;
 }
 
 
@@ -137,7 +199,7 @@ FstStore::FstStore(std::string fstFile)
  * \param nrOfColsFirstChunk the number of columns in the first chunkset (output)
  * \return
  */
-inline unsigned int ReadHeader(ifstream &myfile, int &keyLength, int &nrOfColsFirstChunk)
+inline unsigned int ReadHeader(istream &myfile, int &keyLength, int &nrOfColsFirstChunk)
 {
   // Get meta-information for table
   char tableMeta[TABLE_META_SIZE];
@@ -145,7 +207,6 @@ inline unsigned int ReadHeader(ifstream &myfile, int &keyLength, int &nrOfColsFi
 
   if (!myfile)
   {
-    myfile.close();
     throw(runtime_error(FSTERROR_ERROR_OPEN_READ));
   }
 
@@ -164,14 +225,15 @@ inline unsigned int ReadHeader(ifstream &myfile, int &keyLength, int &nrOfColsFi
 
   if (hHash != *p_headerHash)
   {
-    myfile.close();
     throw(runtime_error(FSTERROR_NON_FST_FILE));
   }
 
-  // Compare file version with current
-  if (*p_tableVersionMax > FST_VERSION)
+  // Compare file version with current, files with format extensions require a known feature version
+  const unsigned int versionMax = *p_tableVersionMax;
+  const bool knownFeatures = versionMax > FST_VERSION_FEATURES && versionMax <= FST_VERSION_READ;
+
+  if (versionMax > FST_VERSION && !knownFeatures)
   {
-    myfile.close();
     throw(runtime_error(FSTERROR_UPDATE_FST));
   }
 
@@ -182,7 +244,7 @@ inline unsigned int ReadHeader(ifstream &myfile, int &keyLength, int &nrOfColsFi
 }
 
 
-inline void SetKeyIndex(vector<int> &keyIndex, const int keyLength, const int nrOfSelect, int* keyColPos, int* colIndex)
+inline void SetKeyIndex(vector<int> &keyIndex, const int keyLength, const int nrOfSelect, int* keyColPos, const int* colIndex)
 {
   for (int i = 0; i < keyLength; ++i)
   {
@@ -203,6 +265,443 @@ inline void SetKeyIndex(vector<int> &keyIndex, const int keyLength, const int nr
 }
 
 
+/**
+ * \brief Collect the data chunk positions and sizes from the (linked) chunk indexes of a chunkset
+ * \param myfile a stream to a fst file
+ * \param chunkIndexPos position of the first chunk index
+ * \param chunkPos data chunk header positions (output)
+ * \param chunkRows number of rows of each data chunk (output)
+ * \param chunkIndex buffer of CHUNK_INDEX_SIZE bytes that will contain the last chunk index (output)
+ * \return position of the last chunk index
+ */
+inline unsigned long long ReadChunkIndexes(istream &myfile, unsigned long long chunkIndexPos, vector<unsigned long long> &chunkPos,
+  vector<unsigned long long> &chunkRows, char* chunkIndex)
+{
+  unsigned long long* p_chunkIndexHash = reinterpret_cast<unsigned long long*>(chunkIndex);
+  unsigned long long* p_nextChunkIndex = reinterpret_cast<unsigned long long*>(&chunkIndex[16]);
+  unsigned short int* p_nrOfChunkSlots = reinterpret_cast<unsigned short int*>(&chunkIndex[24]);
+  unsigned long long* p_chunkPos       = reinterpret_cast<unsigned long long*>(&chunkIndex[32]);
+  unsigned long long* p_chunkRows      = reinterpret_cast<unsigned long long*>(&chunkIndex[64]);
+
+  while (true)
+  {
+    myfile.seekg(chunkIndexPos);
+    myfile.read(chunkIndex, CHUNK_INDEX_SIZE);
+
+    const unsigned long long chunkIndexHash = ZSTD_XXH64(&chunkIndex[8], CHUNK_INDEX_SIZE - 8, FST_HASH_SEED);
+
+    if (!myfile || *p_chunkIndexHash != chunkIndexHash || *p_nrOfChunkSlots > CHUNK_INDEX_SLOTS)
+    {
+      throw(runtime_error(FSTERROR_DAMAGED_CHUNKINDEX));
+    }
+
+    // slots are filled in order
+    for (int slot = 0; slot < *p_nrOfChunkSlots && p_chunkPos[slot] != 0; ++slot)
+    {
+      chunkPos.push_back(p_chunkPos[slot]);
+      chunkRows.push_back(p_chunkRows[slot]);
+    }
+
+    if (*p_nextChunkIndex == 0) return chunkIndexPos;
+
+    chunkIndexPos = *p_nextChunkIndex;
+  }
+}
+
+
+/**
+ * \brief Read and verify a data chunk header
+ * \param myfile a stream to a fst file, only used when no positional reader is available
+ * \param positionalReader positional reader for the fst file or nullptr
+ * \param chunkPos position of the data chunk header
+ * \param dataChunk buffer of DATA_INDEX_SIZE + 8 * nrOfCols bytes (output)
+ * \param nrOfCols number of columns in the chunkset
+ */
+inline void ReadDataChunkHeader(istream &myfile, const IFstSource* positionalReader, const unsigned long long chunkPos,
+  char* dataChunk, const int nrOfCols)
+{
+  const unsigned long long dataChunkSize = DATA_INDEX_SIZE + 8 * nrOfCols;
+
+  ReadAt(myfile, positionalReader, dataChunk, dataChunkSize, chunkPos);
+
+  unsigned long long* p_chunkDataHash = reinterpret_cast<unsigned long long*>(dataChunk);
+  const unsigned long long chunkDataHash = ZSTD_XXH64(&dataChunk[8], dataChunkSize - 8, FST_HASH_SEED);
+
+  if (!myfile || *p_chunkDataHash != chunkDataHash)
+  {
+    throw(runtime_error(FSTERROR_DAMAGED_CHUNKINDEX));
+  }
+}
+
+
+// Ranges of rows to read from the data chunks, in the order of the result table
+struct RowSlices
+{
+  vector<unsigned long long> pos;     // data chunk header position
+  vector<unsigned long long> start;   // first row to read from data chunk (zero based)
+  vector<unsigned long long> length;  // number of rows to read from data chunk
+  vector<unsigned long long> rows;    // number of rows in data chunk
+  vector<unsigned long long> offset;  // position of first row in result
+
+  // In gather mode, slice 'i' reads the rows index[start[i]] up to index[start[i] + length[i] - 1] of the data chunk
+  // instead of a row range
+  bool gather = false;
+  vector<unsigned long long> index;  // sorted row numbers (zero based, relative to data chunk)
+
+  void Add(unsigned long long chunkPos, unsigned long long sliceStart, unsigned long long sliceLength,
+    unsigned long long chunkRows, unsigned long long sliceOffset)
+  {
+    pos.push_back(chunkPos);
+    start.push_back(sliceStart);
+    length.push_back(sliceLength);
+    rows.push_back(chunkRows);
+    offset.push_back(sliceOffset);
+  }
+};
+
+
+// Convert slices of row ranges to a row selection with a single slice per data chunk
+inline void GatherRowSlices(RowSlices &slices)
+{
+  RowSlices gatherSlices;
+  gatherSlices.gather = true;
+
+  for (size_t slice = 0; slice < slices.pos.size(); ++slice)
+  {
+    const unsigned long long indexPos = gatherSlices.index.size();
+
+    if (gatherSlices.pos.empty() || gatherSlices.pos.back() != slices.pos[slice])
+    {
+      gatherSlices.Add(slices.pos[slice], indexPos, 0, slices.rows[slice], indexPos);
+    }
+
+    for (unsigned long long row = slices.start[slice]; row < slices.start[slice] + slices.length[slice]; ++row)
+    {
+      gatherSlices.index.push_back(row);
+    }
+
+    gatherSlices.length.back() += slices.length[slice];
+  }
+
+  slices = std::move(gatherSlices);
+}
+
+
+// A read task covers a range of rows of a single fixed-width column in a single data chunk
+struct ColumnReadTask
+{
+  int colSel;                   // column in result table
+  unsigned short int colType;   // column type
+  char* outVec;                 // result vector position of the first row
+  unsigned long long blockPos;  // position of the column data
+  unsigned long long startRow;  // first row to read (zero based, relative to data chunk)
+  unsigned long long length;    // number of rows to read
+  unsigned long long size;      // number of rows in data chunk
+  const unsigned long long* rowIndex;  // rows to read (zero based, relative to data chunk) instead of a row range, or nullptr
+};
+
+
+/**
+ * \brief Split a column slice into read tasks of at most READ_TASK_ROWS rows
+ * \param readTasks read tasks (output)
+ * \param colSel column in result table
+ * \param colType column type
+ * \param outVec result vector position of the first row of the slice
+ * \param elementSize size of a single element in bytes
+ * \param blockPos position of the column data
+ * \param sliceStart first row of the slice (zero based, relative to data chunk)
+ * \param sliceLength number of rows in the slice
+ * \param chunkRows number of rows in the data chunk
+ */
+inline void AddReadTasks(vector<ColumnReadTask> &readTasks, const int colSel, const unsigned short int colType, char* outVec,
+  const int elementSize, const unsigned long long blockPos, const unsigned long long sliceStart, const unsigned long long sliceLength,
+  const unsigned long long chunkRows)
+{
+  const unsigned long long sliceEnd = sliceStart + sliceLength;
+  unsigned long long taskStart = sliceStart;
+
+  // task boundaries are multiples of READ_TASK_ROWS to avoid decompressing blocks twice
+  do
+  {
+    const unsigned long long taskEnd = min(sliceEnd, (taskStart / READ_TASK_ROWS + 1) * READ_TASK_ROWS);
+    const ColumnReadTask task = { colSel, colType, &outVec[(taskStart - sliceStart) * elementSize], blockPos, taskStart,
+      taskEnd - taskStart, chunkRows, nullptr };
+
+    readTasks.push_back(task);
+    taskStart = taskEnd;
+  }
+  while (taskStart < sliceEnd);
+}
+
+
+/**
+ * \brief Add read tasks for a selection of rows of a fixed-width column in a single data chunk. Like AddReadTasks, each
+ * task covers rows within a single range of READ_TASK_ROWS rows.
+ * \param readTasks vector of tasks to extend
+ * \param colSel column in result table
+ * \param colType column type
+ * \param outVec result vector position of the first selected row
+ * \param elementSize size of a single element in bytes
+ * \param blockPos position of the column data
+ * \param rowIndex sorted row numbers (zero based, relative to data chunk)
+ * \param nrOfRows number of selected rows
+ * \param chunkRows number of rows in the data chunk
+ */
+inline void AddGatherTasks(vector<ColumnReadTask> &readTasks, const int colSel, const unsigned short int colType, char* outVec,
+  const int elementSize, const unsigned long long blockPos, const unsigned long long* rowIndex, const unsigned long long nrOfRows,
+  const unsigned long long chunkRows)
+{
+  unsigned long long taskStart = 0;
+
+  while (taskStart < nrOfRows)
+  {
+    const unsigned long long taskBoundary = (rowIndex[taskStart] / READ_TASK_ROWS + 1) * READ_TASK_ROWS;
+    const unsigned long long taskEnd = lower_bound(&rowIndex[taskStart], &rowIndex[nrOfRows], taskBoundary) - rowIndex;
+
+    const ColumnReadTask task = { colSel, colType, &outVec[taskStart * elementSize], blockPos, 0, taskEnd - taskStart,
+      chunkRows, &rowIndex[taskStart] };
+
+    readTasks.push_back(task);
+    taskStart = taskEnd;
+  }
+}
+
+
+/**
+ * \brief Add the read tasks for a single slice of a fixed-width column, see AddReadTasks and AddGatherTasks
+ * \param slices row slices to read
+ * \param slice slice to add
+ */
+inline void AddSliceTasks(vector<ColumnReadTask> &readTasks, const int colSel, const unsigned short int colType, char* outVec,
+  const int elementSize, const unsigned long long blockPos, const RowSlices &slices, const size_t slice)
+{
+  if (slices.gather)
+  {
+    AddGatherTasks(readTasks, colSel, colType, outVec, elementSize, blockPos, &slices.index[slices.start[slice]],
+      slices.length[slice], slices.rows[slice]);
+
+    return;
+  }
+
+  AddReadTasks(readTasks, colSel, colType, outVec, elementSize, blockPos, slices.start[slice], slices.length[slice],
+    slices.rows[slice]);
+}
+
+
+/**
+ * \brief Locate the data of an uncompressed column in the memory-mapped fst file
+ * \param mappedFile memory-mapped fst file, or nullptr if the memory-mapped read mode is not active
+ * \param blockPos file position of the column
+ * \param startRow first row to read (zero based)
+ * \param length number of rows to read
+ * \param elementSize size of a single element in bytes
+ * \param annotation column annotation (output)
+ * \param hasAnnotation true if the column has an annotation (output)
+ * \return pointer to the first element or nullptr if the column can't be used without a copy
+ */
+inline char* MappedColumnData(const std::shared_ptr<MemoryMappedFile> &mappedFile, const unsigned long long blockPos,
+  const unsigned long long startRow, const unsigned long long length, const int elementSize, std::string &annotation,
+  bool &hasAnnotation)
+{
+  if (!mappedFile) return nullptr;
+
+  return fdsColumnView_v2(mappedFile->Data(), mappedFile->Size(), blockPos, startRow, length, elementSize, annotation,
+    hasAnnotation);
+}
+
+
+/**
+ * \brief Execute a single read task
+ * \param myfile a stream to a fst file, only used when no positional reader is available
+ * \param positionalReader positional reader for the fst file or nullptr
+ * \param task task to execute
+ * \param annotation column annotation (output)
+ * \param hasAnnotation true if the column has an annotation (output)
+ * \param metaCache cached column headers and block indexes for row range reads, or nullptr
+ */
+inline void ReadColumnTask(istream &myfile, const IFstSource* positionalReader, const ColumnReadTask &task,
+  std::string &annotation, bool &hasAnnotation, ColumnMetaCache* metaCache)
+{
+  if (task.rowIndex != nullptr)
+  {
+    const int elementSize = task.colType == 12 ? 1 : (task.colType == 9 || task.colType == 11 ? 8 : 4);
+
+    fdsGatherColumn_v2(myfile, task.outVec, task.blockPos, task.rowIndex, task.length, task.size, elementSize, annotation,
+      hasAnnotation, positionalReader);
+
+    return;
+  }
+
+  switch (task.colType)
+  {
+    case 8:
+      fdsReadIntVec_v8(myfile, reinterpret_cast<int*>(task.outVec), task.blockPos, task.startRow, task.length, task.size,
+        annotation, hasAnnotation, positionalReader, metaCache);
+      break;
+
+    case 9:
+      fdsReadRealVec_v9(myfile, reinterpret_cast<double*>(task.outVec), task.blockPos, task.startRow, task.length, task.size,
+        annotation, hasAnnotation, positionalReader, metaCache);
+      break;
+
+    case 10:
+      fdsReadLogicalVec_v10(myfile, reinterpret_cast<int*>(task.outVec), task.blockPos, task.startRow, task.length, task.size,
+        positionalReader, metaCache);
+      break;
+
+    case 11:
+      fdsReadInt64Vec_v11(myfile, reinterpret_cast<long long*>(task.outVec), task.blockPos, task.startRow, task.length, task.size,
+        positionalReader, metaCache);
+      break;
+
+    case 12:
+      fdsReadByteVec_v12(myfile, task.outVec, task.blockPos, task.startRow, task.length, task.size, positionalReader,
+        metaCache);
+      break;
+
+    default:
+      throw(runtime_error("Unknown type found in column."));
+  }
+}
+
+
+/**
+ * \brief Write the column data of a dataset
+ * \param myfile stream to write the column data to
+ * \param fstTable interface to a dataset
+ * \param compress compression factor in the range 0 - 100
+ * \param positionData stream positions of the columns (output)
+ * \param colTypes column storage types (output)
+ * \param colBaseTypes column base types (output)
+ * \param colAttributeTypes column attributes (output)
+ * \param colScales column scales (output)
+ * \param columnStatistics per-block statistics of the columns (output)
+ * \param blockSizes compression block size of each column in bytes
+ * \param decimals number of decimals of each column (DECIMAL_DETECT if not fixed)
+ * \param charDictionary compress character columns with a dictionary
+ * \param extendedCodecs allow the codecs that require FST_VERSION_CODECS
+ * \param adaptiveCompression select the codec of each compression block from a compressed sample
+ * \param fastDecompression use high compression LZ4 instead of ZSTD
+ */
+inline void WriteColumns(ostream &myfile, IFstTable &fstTable, const int compress, unsigned long long* positionData,
+  unsigned short int* colTypes, unsigned short int* colBaseTypes, unsigned short int* colAttributeTypes, unsigned short int* colScales,
+  ColumnStatistics* columnStatistics, const unsigned int* blockSizes, const int* decimals, const bool charDictionary,
+  const bool extendedCodecs, const bool adaptiveCompression, const bool fastDecompression)
+{
+  const int nrOfCols = fstTable.NrOfColumns();
+  const uint64_t nrOfRows = fstTable.NrOfRows();
+
+  for (int colNr = 0; colNr < nrOfCols; ++colNr)
+  {
+  	FstColumnAttribute colAttribute;
+  	std::string annotation = "";
+    short int scale = 0;
+    bool hasAnnotation;
+
+  	// get type and add annotation
+    const FstColumnType colType = fstTable.ColumnType(colNr, colAttribute, scale, annotation, hasAnnotation);
+
+    // align uncompressed 32 and 64 bit column data in the file, so the data can be used directly in the memory-mapped
+    // read mode
+    if (compress == 0 && (colType == FstColumnType::INT_32 || colType == FstColumnType::DOUBLE_64 || colType == FstColumnType::INT_64))
+    {
+      const char padding[8] = { 0 };
+      myfile.write(padding, fdsUncompressedPadding_v2(myfile.tellp(), annotation.length(), 8));
+    }
+
+    positionData[colNr] = myfile.tellp();  // current location
+
+    colBaseTypes[colNr] = static_cast<unsigned short int>(colType);
+  	colAttributeTypes[colNr] = static_cast<unsigned short int>(colAttribute);
+    colScales[colNr] = scale;
+
+    switch (colType)
+    {
+      case FstColumnType::CHARACTER:
+      {
+        colTypes[colNr] = 6;
+        std::unique_ptr<IStringWriter> stringWriterP(fstTable.GetStringWriter(colNr));
+     		IStringWriter* stringWriter = stringWriterP.get();  // TODO: keep writer as part of fstTable (don't create)
+        fdsWriteCharVec_v6(myfile, stringWriter, compress, stringWriter->Encoding(), charDictionary);
+        break;
+      }
+
+      case FstColumnType::FACTOR:
+      {
+        colTypes[colNr] = 7;
+        int* intP = fstTable.GetIntWriter(colNr);  // level values pointer
+
+        std::unique_ptr<IStringWriter> stringWriterP(fstTable.GetLevelWriter(colNr));
+     		IStringWriter* stringWriter = stringWriterP.get();
+        columnStatistics[colNr] = ColumnStatistics(StatisticsType::INT_32);
+        fdsWriteFactorVec_v7(myfile, intP, stringWriter, nrOfRows, compress, stringWriter->Encoding(), annotation, hasAnnotation,
+          &columnStatistics[colNr], blockSizes[colNr], extendedCodecs);
+        break;
+      }
+
+      case FstColumnType::INT_32:
+      {
+        colTypes[colNr] = 8;
+        int* intP = fstTable.GetIntWriter(colNr);
+        columnStatistics[colNr] = ColumnStatistics(StatisticsType::INT_32);
+        fdsWriteIntVec_v8(myfile, intP, nrOfRows, compress, annotation, hasAnnotation, &columnStatistics[colNr], blockSizes[colNr],
+          extendedCodecs, adaptiveCompression, fastDecompression);
+        break;
+      }
+
+      case FstColumnType::DOUBLE_64:
+      {
+        colTypes[colNr] = 9;
+        double* doubleP = fstTable.GetDoubleWriter(colNr);
+        columnStatistics[colNr] = ColumnStatistics(StatisticsType::DOUBLE_64);
+        fdsWriteRealVec_v9(myfile, doubleP, nrOfRows, compress, annotation, hasAnnotation, &columnStatistics[colNr],
+          blockSizes[colNr], extendedCodecs, adaptiveCompression, fastDecompression, decimals[colNr]);
+        break;
+      }
+
+      case FstColumnType::BOOL_2:
+      {
+        colTypes[colNr] = 10;
+        int* intP = fstTable.GetLogicalWriter(colNr);
+        columnStatistics[colNr] = ColumnStatistics(StatisticsType::INT_32);
+        fdsWriteLogicalVec_v10(myfile, intP, nrOfRows, compress, annotation, hasAnnotation, &columnStatistics[colNr],
+          blockSizes[colNr], extendedCodecs);
+        break;
+      }
+
+      case FstColumnType::INT_64:
+      {
+        colTypes[colNr] = 11;
+        long long* intP = fstTable.GetInt64Writer(colNr);
+        columnStatistics[colNr] = ColumnStatistics(StatisticsType::INT_64);
+        fdsWriteInt64Vec_v11(myfile, intP, nrOfRows, compress, annotation, hasAnnotation, &columnStatistics[colNr],
+          blockSizes[colNr], extendedCodecs, adaptiveCompression, fastDecompression);
+        break;
+      }
+
+	  case FstColumnType::BYTE:
+	  {
+		  colTypes[colNr] = 12;
+		  char* byteP = fstTable.GetByteWriter(colNr);
+		  fdsWriteByteVec_v12(myfile, byteP, nrOfRows, compress, annotation, hasAnnotation, blockSizes[colNr]);
+		  break;
+	  }
+
+    case FstColumnType::BYTE_BLOCK:
+    {
+        colTypes[colNr] = 13;
+        IByteBlockColumn* p_byte_block = fstTable.GetByteBlockWriter(colNr);
+        fdsWriteByteBlockVec_v13(myfile, p_byte_block, nrOfRows, static_cast<uint32_t>(compress));
+        break;
+    }
+
+	  default:
+        throw(runtime_error("Unknown type found in column."));
+    }
+  }
+}
+
+
 /**
  * \brief Write a dataset to a fst file
  * \param fstTable interface to a dataset
@@ -295,7 +794,7 @@ void FstStore::fstWrite(IFstTable &fstTable, const int compress) const
 
   *p_fst_magic_number               = FST_MAGIC_NUMBER;
   *p_freeBytes1                     = 0;
-  *p_tableVersionMax                = FST_VERSION;
+  *p_tableVersionMax                = RequiredTableVersion(compress);
 
   if (isLittleEndian) *p_tableFlags = 1;
 
@@ -333,26 +832,12 @@ void FstStore::fstWrite(IFstTable &fstTable, const int compress) const
   *p_colNamesFlags         = 0;
   *p_freeBytes5            = 0;
 
-  // Create file buffer
-  //const size_t bufsize = 4096;
-  //char buf[bufsize];
-
-  // Create file and set buffer
-  ofstream myfile;
-  //myfile.rdbuf()->pubsetbuf(nullptr, 0);
-  //myfile.rdbuf()->pubsetbuf(buf, bufsize);  // set write buffer
-
   *p_colNamesHash = ZSTD_XXH64(p_colNamesVersion, colNamesHeaderSize - 8, FST_HASH_SEED);
 
 
-  // Open file in binary mode
-  myfile.open(fstFile.c_str(), ios::out | ios::binary);  // write stream only
-
-  if (myfile.fail())
-  {
-    myfile.close();
-    throw(runtime_error(FSTERROR_ERROR_OPEN_WRITE));
-  }
+  // Create file, written data is flushed to disk by a separate writer thread
+  std::unique_ptr<IFstSink> sink = OpenSink(true);
+  ostream myfile(sink->StreamBuffer());
 
   // Write table meta information
   myfile.write(metaDataWriteBlock, metaDataSize);  // table meta data
@@ -378,7 +863,7 @@ void FstStore::fstWrite(IFstTable &fstTable, const int compress) const
   unsigned long long* p_chunkIndexHash = reinterpret_cast<unsigned long long*>(chunkIndex);
   unsigned int* p_chunkIndexVersion    = reinterpret_cast<unsigned int*>(&chunkIndex[8]);
   int* p_chunkIndexFlags               = reinterpret_cast<int*>(&chunkIndex[12]);
-  unsigned long long* p_freeBytes6     = reinterpret_cast<unsigned long long*>(&chunkIndex[16]);
+  unsigned long long* p_nextChunkIndex = reinterpret_cast<unsigned long long*>(&chunkIndex[16]);
   unsigned short int* p_nrOfChunkSlots = reinterpret_cast<unsigned short int*>(&chunkIndex[24]);
   unsigned short int* p_freeBytes7     = reinterpret_cast<unsigned short int*>(&chunkIndex[26]);
   unsigned long long* p_chunkPos       = reinterpret_cast<unsigned long long*>(&chunkIndex[32]);
@@ -389,7 +874,7 @@ void FstStore::fstWrite(IFstTable &fstTable, const int compress) const
   unsigned long long* p_chunkDataHash  = reinterpret_cast<unsigned long long*>(&chunkIndex[96]);
   unsigned int* p_chunkDataVersion     = reinterpret_cast<unsigned int*>(&chunkIndex[104]);
   int* p_chunkDataFlags                = reinterpret_cast<int*>(&chunkIndex[108]);
-  unsigned long long* p_freeBytes8     = reinterpret_cast<unsigned long long*>(&chunkIndex[112]);
+  unsigned long long* p_statisticsPos  = reinterpret_cast<unsigned long long*>(&chunkIndex[112]);
   unsigned long long* positionData     = reinterpret_cast<unsigned long long*>(&chunkIndex[120]);  // column position index
 
 
@@ -397,8 +882,8 @@ void FstStore::fstWrite(IFstTable &fstTable, const int compress) const
 
   *p_chunkIndexVersion = FST_VERSION;
   *p_chunkIndexFlags   = 0;
-  *p_freeBytes6        = 0;
-  *p_nrOfChunkSlots    = 4;
+  *p_nextChunkIndex    = 0;
+  *p_nrOfChunkSlots    = CHUNK_INDEX_SLOTS;
    p_freeBytes7[0]     = p_freeBytes7[1] = p_freeBytes7[2] = 0;
   *p_chunkRows         = nrOfRows;
 
@@ -406,7 +891,7 @@ void FstStore::fstWrite(IFstTable &fstTable, const int compress) const
 
   *p_chunkDataVersion = FST_VERSION;
   *p_chunkDataFlags   = 0;
-  *p_freeBytes8       = 0;
+  *p_statisticsPos    = 0;
 
 
   // Row and column meta data
@@ -416,98 +901,17 @@ void FstStore::fstWrite(IFstTable &fstTable, const int compress) const
   *p_chunkPos = (unsigned long long)(myfile.tellp()) - 8 * nrOfCols - DATA_INDEX_SIZE;
 
   // column data
-  for (int colNr = 0; colNr < nrOfCols; ++colNr)
-  {
-    positionData[colNr] = myfile.tellp();  // current location
-  	FstColumnAttribute colAttribute;
-  	std::string annotation = "";
-    short int scale = 0;
-    bool hasAnnotation;
-
-  	// get type and add annotation
-    const FstColumnType colType = fstTable.ColumnType(colNr, colAttribute, scale, annotation, hasAnnotation);
-
-    colBaseTypes[colNr] = static_cast<unsigned short int>(colType);
-  	colAttributeTypes[colNr] = static_cast<unsigned short int>(colAttribute);
-    colScales[colNr] = scale;
-
-    switch (colType)
-    {
-      case FstColumnType::CHARACTER:
-      {
-        colTypes[colNr] = 6;
-        std::unique_ptr<IStringWriter> stringWriterP(fstTable.GetStringWriter(colNr));
-     		IStringWriter* stringWriter = stringWriterP.get();  // TODO: keep writer as part of fstTable (don't create)
-        fdsWriteCharVec_v6(myfile, stringWriter, compress, stringWriter->Encoding());   // column names
-        break;
-      }
-
-      case FstColumnType::FACTOR:
-      {
-        colTypes[colNr] = 7;
-        int* intP = fstTable.GetIntWriter(colNr);  // level values pointer
-
-        std::unique_ptr<IStringWriter> stringWriterP(fstTable.GetLevelWriter(colNr));
-     		IStringWriter* stringWriter = stringWriterP.get();
-        fdsWriteFactorVec_v7(myfile, intP, stringWriter, nrOfRows, compress, stringWriter->Encoding(), annotation, hasAnnotation);
-        break;
-      }
-
-      case FstColumnType::INT_32:
-      {
-        colTypes[colNr] = 8;
-        int* intP = fstTable.GetIntWriter(colNr);
-        fdsWriteIntVec_v8(myfile, intP, nrOfRows, compress, annotation, hasAnnotation);
-        break;
-      }
-
-      case FstColumnType::DOUBLE_64:
-      {
-        colTypes[colNr] = 9;
-        double* doubleP = fstTable.GetDoubleWriter(colNr);
-        fdsWriteRealVec_v9(myfile, doubleP, nrOfRows, compress, annotation, hasAnnotation);
-        break;
-      }
-
-      case FstColumnType::BOOL_2:
-      {
-        colTypes[colNr] = 10;
-        int* intP = fstTable.GetLogicalWriter(colNr);
-        fdsWriteLogicalVec_v10(myfile, intP, nrOfRows, compress, annotation, hasAnnotation);
-        break;
-      }
-
-      case FstColumnType::INT_64:
-      {
-        colTypes[colNr] = 11;
-        long long* intP = fstTable.GetInt64Writer(colNr);
-        fdsWriteInt64Vec_v11(myfile, intP, nrOfRows, compress, annotation, hasAnnotation);
-        break;
-      }
-
-	  case FstColumnType::BYTE:
-	  {
-		  colTypes[colNr] = 12;
-		  char* byteP = fstTable.GetByteWriter(colNr);
-		  fdsWriteByteVec_v12(myfile, byteP, nrOfRows, compress, annotation, hasAnnotation);
-		  break;
-	  }
+  std::vector<ColumnStatistics> columnStatistics(nrOfCols);
+  const vector<unsigned int> blockSizes = ColumnBlockSizes(nrOfCols);
+  const vector<int> decimals = ColumnDecimals(nrOfCols);
+  WriteColumns(myfile, fstTable, compress, positionData, colTypes, colBaseTypes, colAttributeTypes, colScales, columnStatistics.data(),
+    blockSizes.data(), decimals.data(), charDictionary, extendedCodecs, adaptiveCompression, fastDecompression);
 
-    case FstColumnType::BYTE_BLOCK:
-    {
-        colTypes[colNr] = 13;
-        IByteBlockColumn* p_byte_block = fstTable.GetByteBlockWriter(colNr);
-        fdsWriteByteBlockVec_v13(myfile, p_byte_block, nrOfRows, static_cast<uint32_t>(compress));
-        break;
-    }
-
-	  default:
-        myfile.close();
-        throw(runtime_error("Unknown type found in column."));
-    }
-  }
+  // per-block statistics of the columns
+  *p_statisticsPos = fdsWriteStatistics(myfile, columnStatistics.data(), nrOfCols);
 
   // Calculate header hashes
+  *p_primChunksetIndex = *p_chunkPos - CHUNK_INDEX_SIZE;
   *p_chunksetHash = ZSTD_XXH64(&metaDataWriteBlock[tableHeaderSize + keyIndexHeaderSize + 8], chunksetHeaderSize - 8, FST_HASH_SEED);
   *p_chunkIndexHash = ZSTD_XXH64(&chunkIndex[8], CHUNK_INDEX_SIZE - 8, FST_HASH_SEED);
 
@@ -521,32 +925,20 @@ void FstStore::fstWrite(IFstTable &fstTable, const int compress) const
 
   // Check file status only here for performance.
   // Any error that was generated earlier will result in a fail here.
-  if (myfile.fail())
+  if (!sink->Close() || myfile.fail())
   {
-	  myfile.close();
-
 	  throw(runtime_error("There was an error during the write operation, fst file might be corrupted. Please check available disk space and access rights."));
   }
-
-  myfile.close();
 }
 
 
-void FstStore::fstMeta(IColumnFactory* columnFactory, IStringColumn* col_names)
+/**
+ * \brief Read and verify the key index, chunkset header and column names header of a fst file
+ * \param myfile a stream to a fst file, positioned directly after the table header
+ * \return size of the metadata that was read
+ */
+unsigned long long FstStore::ReadMetaData(istream &myfile)
 {
-  // fst file stream using a stack buffer
-  ifstream myfile;
-  myfile.open(fstFile.c_str(), ios::in | ios::binary);
-
-  if (myfile.fail())
-  {
-    myfile.close();
-    throw(runtime_error(FSTERROR_ERROR_OPENING_FILE));
-  }
-
-  // Read variables from fst file header and check header hash
-  tableVersionMax = ReadHeader(myfile, keyLength, nrOfCols);
-
   unsigned long long keyIndexHeaderSize = 0;
 
   if (keyLength != 0)
@@ -565,23 +957,24 @@ void FstStore::fstMeta(IColumnFactory* columnFactory, IStringColumn* col_names)
 
   myfile.read(metaDataBlock, metaSize);
 
+  keyColPos = nullptr;
+
   if (keyLength != 0)
   {
-    keyColPos = reinterpret_cast<int*>(&metaDataBlock[8]);  // equals nullptr if there are no keys
+    keyColPos = reinterpret_cast<int*>(&metaDataBlock[8]);  // TODO: why not unsigned ?
 
     unsigned long long* p_keyIndexHash = reinterpret_cast<unsigned long long*>(metaDataBlock);
     const unsigned long long hHash = ZSTD_XXH64(&metaDataBlock[8], keyIndexHeaderSize - 8, FST_HASH_SEED);
 
     if (*p_keyIndexHash != hHash)
     {
-      myfile.close();
       throw(runtime_error(FSTERROR_DAMAGED_HEADER));
     }
   }
 
   // Chunkset header [node C, free leaf of A or other chunkset header] [size: 80 + 8 * nrOfCols]
 
-  unsigned long long* p_chunksetHash        = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize]);
+  unsigned long long* p_chunksetHash      = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize]);
   //unsigned int* p_chunksetHeaderVersion   = reinterpret_cast<unsigned int*>(&metaDataBlock[keyIndexHeaderSize + 8]);
   //int* p_chunksetFlags                    = reinterpret_cast<int*>(&metaDataBlock[keyIndexHeaderSize + 12]);
   //unsigned long long* p_freeBytes2        = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 16]);
@@ -589,298 +982,1337 @@ void FstStore::fstMeta(IColumnFactory* columnFactory, IStringColumn* col_names)
   //unsigned long long* p_colNamesPos       = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 32]);
 
   //unsigned long long* p_nextHorzChunkSet  = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 40]);
-  //unsigned long long* p_primChunksetIndex = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 48]);
+  p_primChunksetIndex                     = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 48]);
   //unsigned long long* p_secChunksetIndex  = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 56]);
   p_nrOfRows                              = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 64]);
   //int* p_nrOfChunksetCols                 = reinterpret_cast<int*>(&metaDataBlock[keyIndexHeaderSize + 72]);
+  //int* p_freeBytes4                       = reinterpret_cast<int*>(&metaDataBlock[offset + 76]);
 
-  colAttributeTypes                       = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + 80]);
-  colTypes                                = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + 80 + 2 * nrOfCols]);
-  colBaseTypes                            = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + 80 + 4 * nrOfCols]);
-  colScales                               = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + 80 + 6 * nrOfCols]);
+  colAttributeTypes                       = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + CHUNKSET_HEADER_SIZE]);
+  colTypes                                = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + CHUNKSET_HEADER_SIZE + 2 * nrOfCols]);
+  colBaseTypes                            = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + CHUNKSET_HEADER_SIZE + 4 * nrOfCols]);
+  colScales                               = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + CHUNKSET_HEADER_SIZE + 6 * nrOfCols]);
 
   const unsigned long long chunksetHash = ZSTD_XXH64(&metaDataBlock[keyIndexHeaderSize + 8], chunksetHeaderSize - 8, FST_HASH_SEED);
   if (*p_chunksetHash != chunksetHash)
   {
-    myfile.close();
     throw(runtime_error(FSTERROR_DAMAGED_HEADER));
   }
 
   // Column names header
 
-  const unsigned long long offset = keyIndexHeaderSize + chunksetHeaderSize;
+  const unsigned long long offset          = keyIndexHeaderSize + chunksetHeaderSize;
   unsigned long long* p_colNamesHash = reinterpret_cast<unsigned long long*>(&metaDataBlock[offset]);
-  //unsigned int* p_colNamesVersion = reinterpret_cast<unsigned int*>(&metaDataBlock[offset + 8]);
-  //int* p_colNamesFlags = reinterpret_cast<int*>(&metaDataBlock[offset + 12]);
-  //unsigned long long* p_freeBytes4 = reinterpret_cast<unsigned long long*>(&metaDataBlock[16]);
+  //unsigned int* p_colNamesVersion    = reinterpret_cast<unsigned int*>(&metaDataBlock[offset + 8]);
+  //int* p_colNamesFlags               = reinterpret_cast<int*>(&metaDataBlock[offset + 12]);
+  //unsigned long long* p_freeBytes5   = reinterpret_cast<unsigned long long*>(&metaDataBlock[offset + 16]);
 
   const unsigned long long colNamesHash = ZSTD_XXH64(&metaDataBlock[offset + 8], colNamesHeaderSize - 8, FST_HASH_SEED);
+  if (*p_colNamesHash != colNamesHash)
+  {
+    throw(runtime_error(FSTERROR_DAMAGED_HEADER));
+  }
+
+  ReadChunksets(myfile, keyIndexHeaderSize, metaSize);
+
+  return metaSize;
+}
+
+
+/**
+ * \brief Read and verify the headers of the additional (horizontal) chunksets that are linked to the primary chunkset.
+ * After this call, nrOfCols and the column type vectors cover the columns of all chunksets.
+ * \param myfile a stream to a fst file
+ * \param keyIndexHeaderSize size of the key index vector
+ * \param metaSize size of the metadata of the primary chunkset
+ */
+void FstStore::ReadChunksets(istream &myfile, const unsigned long long keyIndexHeaderSize, const unsigned long long metaSize)
+{
+  const ChunksetInfo primary = { TABLE_META_SIZE + keyIndexHeaderSize, *p_primChunksetIndex, TABLE_META_SIZE + metaSize, 0,
+    nrOfCols };
+
+  chunksets.assign(1, primary);
+  chunksetHeaders.clear();
+
+  unsigned long long nextHorzChunkSet = *reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 40]);
+
+  if (nextHorzChunkSet == 0) return;
+
+  int totalCols = nrOfCols;
+
+  while (nextHorzChunkSet != 0)
+  {
+    // the number of columns is part of the fixed size header
+    char fixedHeader[CHUNKSET_HEADER_SIZE];
+    myfile.seekg(nextHorzChunkSet);
+    myfile.read(fixedHeader, CHUNKSET_HEADER_SIZE);
+
+    const int nrOfChunksetCols = *reinterpret_cast<int*>(&fixedHeader[72]);
+
+    if (!myfile || nrOfChunksetCols <= 0)
+    {
+      throw(runtime_error(FSTERROR_DAMAGED_HEADER));
+    }
+
+    const unsigned long long chunksetHeaderSize = CHUNKSET_HEADER_SIZE + 8 * nrOfChunksetCols;
+    std::unique_ptr<char[]> chunksetHeaderP(new char[chunksetHeaderSize]);
+    char* chunksetHeader = chunksetHeaderP.get();
+
+    memcpy(chunksetHeader, fixedHeader, CHUNKSET_HEADER_SIZE);
+    myfile.read(&chunksetHeader[CHUNKSET_HEADER_SIZE], chunksetHeaderSize - CHUNKSET_HEADER_SIZE);
+
+    unsigned long long* p_chunksetHash      = reinterpret_cast<unsigned long long*>(chunksetHeader);
+    unsigned long long* p_colNamesPos       = reinterpret_cast<unsigned long long*>(&chunksetHeader[32]);
+    unsigned long long* p_nextHorzChunkSet  = reinterpret_cast<unsigned long long*>(&chunksetHeader[40]);
+    unsigned long long* p_chunksetIndex     = reinterpret_cast<unsigned long long*>(&chunksetHeader[48]);
+    unsigned long long* p_chunksetRows      = reinterpret_cast<unsigned long long*>(&chunksetHeader[64]);
+
+    const unsigned long long chunksetHash = ZSTD_XXH64(&chunksetHeader[8], chunksetHeaderSize - 8, FST_HASH_SEED);
+
+    // all chunksets contain the same rows
+    if (!myfile || *p_chunksetHash != chunksetHash || *p_chunksetRows != *p_nrOfRows)
+    {
+      throw(runtime_error(FSTERROR_DAMAGED_HEADER));
+    }
+
+    const ChunksetInfo chunkset = { nextHorzChunkSet, *p_chunksetIndex, *p_colNamesPos, totalCols, nrOfChunksetCols };
+    chunksets.push_back(chunkset);
+
+    totalCols += nrOfChunksetCols;
+    nextHorzChunkSet = *p_nextHorzChunkSet;
+    chunksetHeaders.push_back(std::move(chunksetHeaderP));
+  }
+
+  // Column types of all chunksets
+
+  colInfoP = std::unique_ptr<unsigned short int[]>(new unsigned short int[4 * totalCols]);
+  unsigned short int* colInfo = colInfoP.get();
+
+  for (size_t chunksetNr = 0; chunksetNr < chunksets.size(); ++chunksetNr)
+  {
+    const ChunksetInfo &chunkset = chunksets[chunksetNr];
+    const char* chunksetHeader = chunksetNr == 0 ? &metaDataBlock[keyIndexHeaderSize] : chunksetHeaders[chunksetNr - 1].get();
+    const unsigned short int* chunksetInfo = reinterpret_cast<const unsigned short int*>(&chunksetHeader[CHUNKSET_HEADER_SIZE]);
+
+    // attribute types, types, base types and scales
+    for (int info = 0; info < 4; ++info)
+    {
+      memcpy(&colInfo[info * totalCols + chunkset.firstCol], &chunksetInfo[info * chunkset.nrOfCols],
+        2 * chunkset.nrOfCols);
+    }
+  }
+
+  nrOfCols          = totalCols;
+  colAttributeTypes = colInfo;
+  colTypes          = &colInfo[totalCols];
+  colBaseTypes      = &colInfo[2 * totalCols];
+  colScales         = &colInfo[3 * totalCols];
+}
+
+
+/**
+ * \brief Read the column names of all chunksets
+ * \param myfile a stream to a fst file
+ * \param col_names column names (output)
+ */
+void FstStore::ReadColumnNames(istream &myfile, IStringColumn* col_names) const
+{
+  col_names->AllocateVec(static_cast<unsigned int>(nrOfCols));
+
+  for (const ChunksetInfo &chunkset : chunksets)
+  {
+    fdsReadCharVec_v6(myfile, col_names, chunkset.colNamesPos, 0, static_cast<unsigned int>(chunkset.nrOfCols),
+      static_cast<unsigned int>(chunkset.nrOfCols), chunkset.firstCol);
+  }
+}
+
+
+int FstStore::ChunksetOfColumn(const int colNr) const
+{
+  int chunksetNr = static_cast<int>(chunksets.size()) - 1;
+  while (chunksets[chunksetNr].firstCol > colNr) --chunksetNr;
+
+  return chunksetNr;
+}
+
+
+/**
+ * \brief Write a data chunk at the end of a fst file and register it in the last chunk index of a chunkset. When all
+ * slots of the last chunk index are taken, a new chunk index is written and linked to it.
+ * \param outfile stream to the fst file, positioned at the end of the file
+ * \param fstTable columns of the data chunk
+ * \param compress compression factor in the range 0 - 100
+ * \param lastIndex the last chunk index of the chunkset, updated to the (new) last chunk index
+ * \param lastIndexPos position of the last chunk index
+ * \param colInfo attribute types, types, base types and scales of the columns (output, 4 * nrOfCols elements)
+ * \param blockSizes compression block size of each column in bytes
+ * \param decimals number of decimals of each column (DECIMAL_DETECT if not fixed)
+ * \param charDictionary compress character columns with a dictionary
+ * \param extendedCodecs allow the codecs that require FST_VERSION_CODECS
+ * \param adaptiveCompression select the codec of each compression block from a compressed sample
+ * \param fastDecompression use high compression LZ4 instead of ZSTD
+ * \return position of the (new) last chunk index
+ */
+inline unsigned long long AppendDataChunk(ostream &outfile, IFstTable &fstTable, const int compress, char* lastIndex,
+  const unsigned long long lastIndexPos, unsigned short int* colInfo, const unsigned int* blockSizes,
+  const int* decimals, const bool charDictionary, const bool extendedCodecs, const bool adaptiveCompression,
+  const bool fastDecompression)
+{
+  const int nrOfCols = fstTable.NrOfColumns();
+  const uint64_t nrOfRows = fstTable.NrOfRows();
+
+  unsigned long long* p_lastIndexHash  = reinterpret_cast<unsigned long long*>(lastIndex);
+  unsigned long long* p_nextChunkIndex = reinterpret_cast<unsigned long long*>(&lastIndex[16]);
+  unsigned short int* p_nrOfChunkSlots = reinterpret_cast<unsigned short int*>(&lastIndex[24]);
+  unsigned long long* p_chunkPos       = reinterpret_cast<unsigned long long*>(&lastIndex[32]);
+  unsigned long long* p_chunkRows      = reinterpret_cast<unsigned long long*>(&lastIndex[64]);
+
+  int freeSlot = 0;
+  while (freeSlot < *p_nrOfChunkSlots && p_chunkPos[freeSlot] != 0) ++freeSlot;
+
+  // Chunk index [node D, leaf of C] [size: 96], only used when the last chunk index is full
+
+  char newIndex[CHUNK_INDEX_SIZE];
+  memset(newIndex, 0, CHUNK_INDEX_SIZE);
+
+  unsigned long long* p_newIndexHash      = reinterpret_cast<unsigned long long*>(newIndex);
+  unsigned int* p_newIndexVersion         = reinterpret_cast<unsigned int*>(&newIndex[8]);
+  unsigned short int* p_newNrOfChunkSlots = reinterpret_cast<unsigned short int*>(&newIndex[24]);
+  unsigned long long* p_newChunkPos       = reinterpret_cast<unsigned long long*>(&newIndex[32]);
+  unsigned long long* p_newChunkRows      = reinterpret_cast<unsigned long long*>(&newIndex[64]);
+
+  unsigned long long newIndexPos = 0;
+
+  if (freeSlot == *p_nrOfChunkSlots)
+  {
+    newIndexPos = outfile.tellp();
+    *p_newIndexVersion   = FST_VERSION;
+    *p_newNrOfChunkSlots = CHUNK_INDEX_SLOTS;
+
+    outfile.write(newIndex, CHUNK_INDEX_SIZE);  // rewritten when the data chunk is complete
+  }
+
+  // Data chunk header [node E, leaf of D] [size: 24 + 8 * nrOfCols]
+
+  const unsigned long long dataChunkSize = DATA_INDEX_SIZE + 8 * nrOfCols;
+  std::unique_ptr<char[]> dataChunkP(new char[dataChunkSize]);
+  char* dataChunk = dataChunkP.get();
+  memset(dataChunk, 0, dataChunkSize);
+
+  unsigned long long* p_chunkDataHash = reinterpret_cast<unsigned long long*>(dataChunk);
+  unsigned int* p_chunkDataVersion    = reinterpret_cast<unsigned int*>(&dataChunk[8]);
+  unsigned long long* p_statisticsPos = reinterpret_cast<unsigned long long*>(&dataChunk[16]);
+  unsigned long long* positionData    = reinterpret_cast<unsigned long long*>(&dataChunk[DATA_INDEX_SIZE]);  // column position index
+
+  *p_chunkDataVersion = FST_VERSION;
+
+  const unsigned long long dataChunkPos = outfile.tellp();
+  outfile.write(dataChunk, dataChunkSize);
+
+  // column data
+  std::vector<ColumnStatistics> columnStatistics(nrOfCols);
+  WriteColumns(outfile, fstTable, compress, positionData, &colInfo[nrOfCols], &colInfo[2 * nrOfCols], colInfo,
+    &colInfo[3 * nrOfCols], columnStatistics.data(), blockSizes, decimals, charDictionary,
+    extendedCodecs, adaptiveCompression, fastDecompression);
+
+  *p_statisticsPos = fdsWriteStatistics(outfile, columnStatistics.data(), nrOfCols);
+
+  *p_chunkDataHash = ZSTD_XXH64(&dataChunk[8], dataChunkSize - 8, FST_HASH_SEED);
+  const unsigned long long endPos = outfile.tellp();
+  outfile.seekp(dataChunkPos);
+  outfile.write(dataChunk, dataChunkSize);
+
+  // Register data chunk in the chunk index
+
+  if (newIndexPos != 0)
+  {
+    *p_newChunkPos  = dataChunkPos;
+    *p_newChunkRows = nrOfRows;
+    *p_newIndexHash = ZSTD_XXH64(&newIndex[8], CHUNK_INDEX_SIZE - 8, FST_HASH_SEED);
+
+    outfile.seekp(newIndexPos);
+    outfile.write(newIndex, CHUNK_INDEX_SIZE);
+
+    *p_nextChunkIndex = newIndexPos;
+  }
+  else
+  {
+    p_chunkPos[freeSlot]  = dataChunkPos;
+    p_chunkRows[freeSlot] = nrOfRows;
+  }
+
+  *p_lastIndexHash = ZSTD_XXH64(&lastIndex[8], CHUNK_INDEX_SIZE - 8, FST_HASH_SEED);
+  outfile.seekp(lastIndexPos);
+  outfile.write(lastIndex, CHUNK_INDEX_SIZE);
+
+  outfile.seekp(endPos);
+
+  if (newIndexPos == 0) return lastIndexPos;
+
+  memcpy(lastIndex, newIndex, CHUNK_INDEX_SIZE);
+  return newIndexPos;
+}
+
+
+/**
+ * \brief Read the metadata of an existing fst file and locate the last chunk index of each chunkset
+ * \param lastIndexPos position of the last chunk index of each chunkset (output)
+ * \param lastIndexes the last chunk index of each chunkset (output, CHUNK_INDEX_SIZE bytes per chunkset)
+ */
+void FstStore::OpenAppend(vector<unsigned long long> &lastIndexPos, std::unique_ptr<char[]> &lastIndexes)
+{
+  std::unique_ptr<IFstSource> source = OpenSource();
+  SourceStream myfile(source.get());
+
+  tableVersionMax = ReadHeader(myfile, keyLength, nrOfCols);
+  ReadMetaData(myfile);
+
+  // appended rows would invalidate the sort order of the key columns
+  if (keyLength != 0)
+  {
+    throw(runtime_error(FSTERROR_APPEND_KEYED));
+  }
+
+  // files without a reference to the chunk index were written before appending was supported
+  if (*p_primChunksetIndex == 0)
+  {
+    throw(runtime_error(FSTERROR_NO_APPEND));
+  }
+
+  const size_t nrOfChunksets = chunksets.size();
+  lastIndexPos.resize(nrOfChunksets);
+  lastIndexes = std::unique_ptr<char[]>(new char[nrOfChunksets * CHUNK_INDEX_SIZE]);
+
+  for (size_t chunksetNr = 0; chunksetNr < nrOfChunksets; ++chunksetNr)
+  {
+    vector<unsigned long long> chunkPos;
+    vector<unsigned long long> chunkRows;
+
+    lastIndexPos[chunksetNr] = ReadChunkIndexes(myfile, chunksets[chunksetNr].chunkIndexPos, chunkPos, chunkRows,
+      &lastIndexes[chunksetNr * CHUNK_INDEX_SIZE]);
+  }
+
+}
+
+
+/**
+ * \brief Write the rows of a dataset as a new data chunk in each chunkset, the row counts of the chunkset headers
+ * are updated in memory only (see WriteChunksetHeaders)
+ * \param outfile stream to the fst file
+ * \param fstTable interface to a dataset with the same column types as the fst file
+ * \param compress compression factor in the range 0 - 100
+ * \param lastIndexPos position of the last chunk index of each chunkset, updated when a new chunk index is created
+ * \param lastIndexes the last chunk index of each chunkset
+ */
+void FstStore::AppendRows(ostream &outfile, IFstTable &fstTable, const int compress, vector<unsigned long long> &lastIndexPos,
+  char* lastIndexes)
+{
+  if (static_cast<int>(fstTable.NrOfColumns()) != nrOfCols)
+  {
+    throw(runtime_error(FSTERROR_INCORRECT_COL_COUNT));
+  }
+
+  for (int colNr = 0; colNr < nrOfCols; ++colNr)
+  {
+    FstColumnAttribute colAttribute;
+    std::string annotation;
+    short int scale;
+    bool hasAnnotation;
+
+    const FstColumnType colType = fstTable.ColumnType(colNr, colAttribute, scale, annotation, hasAnnotation);
+
+    // appended data is read with the attribute and scale of the first data chunk
+    if (static_cast<unsigned short int>(colType) != colBaseTypes[colNr] ||
+      static_cast<unsigned short int>(colAttribute) != colAttributeTypes[colNr] ||
+      static_cast<unsigned short int>(scale) != colScales[colNr])
+    {
+      throw(runtime_error(FSTERROR_APPEND_COL_TYPES));
+    }
+  }
+
+  const uint64_t nrOfRows = fstTable.NrOfRows();
+
+  if (nrOfRows == 0) return;
+
+  // column types were verified above
+  std::unique_ptr<unsigned short int[]> colInfo(new unsigned short int[4 * nrOfCols]);
+  const vector<unsigned int> blockSizes = ColumnBlockSizes(nrOfCols);
+  const vector<int> decimals = ColumnDecimals(nrOfCols);
+
+  // the file gets a second data chunk, which older readers would silently skip
+  RaiseTableVersion(outfile, std::max(RequiredTableVersion(compress),
+    static_cast<unsigned int>(FST_VERSION_MULTI_CHUNK)));
+
+  for (size_t chunksetNr = 0; chunksetNr < chunksets.size(); ++chunksetNr)
+  {
+    const ChunksetInfo &chunkset = chunksets[chunksetNr];
+    FstTableView chunksetColumns(&fstTable, chunkset.firstCol, chunkset.nrOfCols, 0, nrOfRows);
+
+    lastIndexPos[chunksetNr] = AppendDataChunk(outfile, chunksetColumns, compress, &lastIndexes[chunksetNr * CHUNK_INDEX_SIZE],
+      lastIndexPos[chunksetNr], colInfo.get(), &blockSizes[chunkset.firstCol],
+      &decimals[chunkset.firstCol], charDictionary, extendedCodecs, adaptiveCompression, fastDecompression);
+  }
+
+  *p_nrOfRows += nrOfRows;
+
+  for (size_t chunksetNr = 1; chunksetNr < chunksets.size(); ++chunksetNr)
+  {
+    *reinterpret_cast<unsigned long long*>(&chunksetHeaders[chunksetNr - 1][64]) += nrOfRows;
+  }
+}
+
+
+/**
+ * \brief Rehash the chunkset headers and write them to the fst file (the table has no key index)
+ */
+void FstStore::WriteChunksetHeaders(ostream &outfile)
+{
+  const unsigned long long chunksetHeaderSize = CHUNKSET_HEADER_SIZE + 8 * chunksets[0].nrOfCols;
+  unsigned long long* p_chunksetHash = reinterpret_cast<unsigned long long*>(metaDataBlock);
+
+  *p_chunksetHash = ZSTD_XXH64(&metaDataBlock[8], chunksetHeaderSize - 8, FST_HASH_SEED);
+
+  outfile.seekp(TABLE_META_SIZE);
+  outfile.write(metaDataBlock, chunksetHeaderSize);
+
+  for (size_t chunksetNr = 1; chunksetNr < chunksets.size(); ++chunksetNr)
+  {
+    const unsigned long long horzHeaderSize = CHUNKSET_HEADER_SIZE + 8 * chunksets[chunksetNr].nrOfCols;
+    char* chunksetHeader = chunksetHeaders[chunksetNr - 1].get();
+
+    *reinterpret_cast<unsigned long long*>(chunksetHeader) = ZSTD_XXH64(&chunksetHeader[8], horzHeaderSize - 8, FST_HASH_SEED);
+
+    outfile.seekp(chunksets[chunksetNr].headerPos);
+    outfile.write(chunksetHeader, horzHeaderSize);
+  }
+
+  outfile.seekp(0, ios_base::end);
+}
+
+
+/**
+ * \brief Compression block size of each column of a table that is written
+ * \param nrOfCols number of columns in the table
+ */
+vector<unsigned int> FstStore::ColumnBlockSizes(const int nrOfCols) const
+{
+  vector<unsigned int> blockSizes(nrOfCols, blockSize);
+
+  for (int colNr = 0; colNr < min(nrOfCols, static_cast<int>(columnBlockSizes.size())); ++colNr)
+  {
+    if (columnBlockSizes[colNr] != 0) blockSizes[colNr] = columnBlockSizes[colNr];
+  }
+
+  return blockSizes;
+}
+
+
+/**
+ * \brief Number of decimals of each column of a table that is written (DECIMAL_DETECT if not set)
+ * \param nrOfCols number of columns in the table
+ */
+vector<int> FstStore::ColumnDecimals(const int nrOfCols) const
+{
+  vector<int> decimals(nrOfCols, DECIMAL_DETECT);
+
+  for (int colNr = 0; colNr < min(nrOfCols, static_cast<int>(columnDecimals.size())); ++colNr)
+  {
+    decimals[colNr] = columnDecimals[colNr];
+  }
+
+  return decimals;
+}
+
+
+/**
+ * \brief True if columns can be written with blocks larger than BLOCKSIZE, which older readers can't handle
+ */
+bool FstStore::HasLargeBlocks() const
+{
+  if (blockSize > BLOCKSIZE) return true;
+
+  return any_of(columnBlockSizes.begin(), columnBlockSizes.end(), [](unsigned int size) { return size > BLOCKSIZE; });
+}
+
+
+/**
+ * \brief Minimum fst version required to read the data written with the current settings
+ * \param compress compression level of the data
+ */
+unsigned int FstStore::RequiredTableVersion(const int compress) const
+{
+  // logical and factor columns use the extended codecs at compression level 0 as well
+  if (extendedCodecs) return FST_VERSION_CODECS;
+
+  if (compress == 0) return HasLargeBlocks() ? FST_VERSION_BLOCK_SIZE : FST_VERSION;
+
+  if (any_of(columnDecimals.begin(), columnDecimals.end(), [](int decimals) { return decimals != DECIMAL_DETECT; }))
+  {
+    return FST_VERSION_CODECS;
+  }
+
+  if (charDictionary) return FST_VERSION_CHAR_DICT;
+
+  return HasLargeBlocks() ? FST_VERSION_BLOCK_SIZE : FST_VERSION;
+}
+
+
+/**
+ * \brief Update the minimum fst version required to read the file in the table header of an existing fst file
+ * \param outfile stream to the fst file, positioned at the end of the file
+ * \param version required version, the header is only rewritten if the current version is lower
+ */
+void FstStore::RaiseTableVersion(ostream &outfile, const unsigned int version)
+{
+  if (tableVersionMax >= version) return;
+
+  char tableMeta[TABLE_META_SIZE];
+  std::unique_ptr<IFstSource> source = OpenSource();
+
+  if (!source->Read(tableMeta, TABLE_META_SIZE, 0))
+  {
+    throw(runtime_error(FSTERROR_READ_FAILED));
+  }
+
+  *reinterpret_cast<unsigned int*>(&tableMeta[24]) = version;
+  *reinterpret_cast<unsigned long long*>(tableMeta) = ZSTD_XXH64(&tableMeta[8], TABLE_META_SIZE - 8, FST_HASH_SEED);
+
+  outfile.seekp(0);
+  outfile.write(tableMeta, TABLE_META_SIZE);
+  outfile.seekp(0, ios_base::end);
+
+  tableVersionMax = version;
+}
+
+
+inline void CheckBlockSize(const unsigned int blockSize)
+{
+  if (blockSize < BLOCKSIZE || blockSize > MAX_BLOCK_SIZE || (blockSize & (blockSize - 1)) != 0)
+  {
+    throw(runtime_error(FSTERROR_BLOCK_SIZE));
+  }
+}
+
+
+void FstStore::SetBlockSize(const unsigned int blockSize)
+{
+  CheckBlockSize(blockSize);
+  this->blockSize = blockSize;
+}
+
+
+void FstStore::SetColumnBlockSize(const int colNr, const unsigned int blockSize)
+{
+  CheckBlockSize(blockSize);
+
+  if (colNr < 0)
+  {
+    throw(runtime_error(FSTERROR_COLUMN_INDEX));
+  }
+
+  if (colNr >= static_cast<int>(columnBlockSizes.size())) columnBlockSizes.resize(colNr + 1, 0);
+  columnBlockSizes[colNr] = blockSize;
+}
+
+
+void FstStore::SetColumnDecimals(const int colNr, const int decimals)
+{
+  if (decimals < 0 || decimals > DECIMAL_MAX_SCALE)
+  {
+    throw(runtime_error(FSTERROR_DECIMALS));
+  }
+
+  if (colNr < 0)
+  {
+    throw(runtime_error(FSTERROR_COLUMN_INDEX));
+  }
+
+  if (colNr >= static_cast<int>(columnDecimals.size())) columnDecimals.resize(colNr + 1, DECIMAL_DETECT);
+  columnDecimals[colNr] = decimals;
+}
+
+
+/**
+ * \brief Append a dataset to an existing fst file. The rows are stored in a new data chunk that is linked
+ * to the chunk index of the file, existing data is not rewritten. For tables with multiple chunksets, a data chunk
+ * is added to each chunkset.
+ * \param fstTable interface to a dataset with the same column types as the fst file
+ * \param compress compression factor in the range 0 - 100
+ */
+void FstStore::fstAppend(IFstTable &fstTable, const int compress)
+{
+  vector<unsigned long long> lastIndexPos;
+  std::unique_ptr<char[]> lastIndexes;
+
+  OpenAppend(lastIndexPos, lastIndexes);
+
+  // Open file for update, existing content is kept
+  std::unique_ptr<IFstSink> sink = OpenSink(false);
+  ostream outfile(sink->StreamBuffer());
+
+  outfile.seekp(0, ios_base::end);
+
+  AppendRows(outfile, fstTable, compress, lastIndexPos, lastIndexes.get());
+  WriteChunksetHeaders(outfile);
+
+  if (!sink->Close() || outfile.fail())
+  {
+    throw(runtime_error("There was an error during the write operation, fst file might be corrupted. Please check available disk space and access rights."));
+  }
+}
+
+
+/**
+ * \brief Add columns to an existing fst file. The columns are stored in a new (horizontal) chunkset at the end of the
+ * file that is linked to the last chunkset of the table, existing data is not rewritten. The rows of the new columns
+ * are split into data chunks with the same sizes as the data chunks of the primary chunkset.
+ * \param fstTable interface to a dataset with the same number of rows as the fst file
+ * \param compress compression factor in the range 0 - 100
+ */
+void FstStore::fstAppendColumns(IFstTable &fstTable, const int compress)
+{
+  std::unique_ptr<IFstSource> source = OpenSource();
+  SourceStream myfile(source.get());
+
+  tableVersionMax = ReadHeader(myfile, keyLength, nrOfCols);
+  ReadMetaData(myfile);
+
+  // files without a reference to the chunk index were written before appending was supported
+  if (*p_primChunksetIndex == 0)
+  {
+    throw(runtime_error(FSTERROR_NO_APPEND));
+  }
+
+  const int nrOfNewCols = fstTable.NrOfColumns();
+
+  if (nrOfNewCols == 0)
+  {
+    return;
+  }
+
+  if (fstTable.NrOfRows() != *p_nrOfRows)
+  {
+    throw(runtime_error(FSTERROR_APPEND_ROW_COUNT));
+  }
+
+  // Data chunk sizes of the primary chunkset
+
+  vector<unsigned long long> chunkPos;
+  vector<unsigned long long> chunkRows;
+  char chunkIndex[CHUNK_INDEX_SIZE];
+
+  ReadChunkIndexes(myfile, *p_primChunksetIndex, chunkPos, chunkRows, chunkIndex);
+
+
+  // Open file for update, existing content is kept
+  std::unique_ptr<IFstSink> sink = OpenSink(false);
+  ostream outfile(sink->StreamBuffer());
+
+  outfile.seekp(0, ios_base::end);
+
+  // Chunkset header [node C, leaf of the last chunkset header] [size: 80 + 8 * nrOfNewCols]
+
+  const unsigned long long chunksetHeaderSize = CHUNKSET_HEADER_SIZE + 8 * nrOfNewCols;
+  std::unique_ptr<char[]> chunksetHeaderP(new char[chunksetHeaderSize]);
+  char* chunksetHeader = chunksetHeaderP.get();
+  memset(chunksetHeader, 0, chunksetHeaderSize);
+
+  unsigned long long* p_chunksetHash      = reinterpret_cast<unsigned long long*>(chunksetHeader);
+  unsigned int* p_chunksetHeaderVersion   = reinterpret_cast<unsigned int*>(&chunksetHeader[8]);
+  unsigned long long* p_colNamesPos       = reinterpret_cast<unsigned long long*>(&chunksetHeader[32]);
+  unsigned long long* p_chunksetIndex     = reinterpret_cast<unsigned long long*>(&chunksetHeader[48]);
+  unsigned long long* p_chunksetRows      = reinterpret_cast<unsigned long long*>(&chunksetHeader[64]);
+  int* p_nrOfChunksetCols                 = reinterpret_cast<int*>(&chunksetHeader[72]);
+  unsigned short int* colInfo             = reinterpret_cast<unsigned short int*>(&chunksetHeader[CHUNKSET_HEADER_SIZE]);
+
+  *p_chunksetHeaderVersion = FST_VERSION;
+  *p_chunksetRows          = *p_nrOfRows;
+  *p_nrOfChunksetCols      = nrOfNewCols;
+
+  const unsigned long long chunksetPos = outfile.tellp();
+  outfile.write(chunksetHeader, chunksetHeaderSize);  // rewritten when the column data is complete
+
+  // Column names header [leaf to C]  [size: 24 + x]
+
+  char colNamesHeader[24];
+  memset(colNamesHeader, 0, 24);
+
+  *reinterpret_cast<unsigned int*>(&colNamesHeader[8]) = FST_VERSION;
+  *reinterpret_cast<unsigned long long*>(colNamesHeader) = ZSTD_XXH64(&colNamesHeader[8], 16, FST_HASH_SEED);
+
+  *p_colNamesPos = static_cast<unsigned long long>(outfile.tellp()) + 24;
+  outfile.write(colNamesHeader, 24);
+
+  {
+    std::unique_ptr<IStringWriter> blockRunnerP(fstTable.GetColNameWriter());
+    IStringWriter* blockRunner = blockRunnerP.get();
+    fdsWriteCharVec_v6(outfile, blockRunner, 0, blockRunner->Encoding());   // column names
+  }
+
+  // Chunk index [node D, leaf of C] [size: 96], slots are filled by AppendDataChunk
+
+  char lastIndex[CHUNK_INDEX_SIZE];
+  memset(lastIndex, 0, CHUNK_INDEX_SIZE);
+
+  *reinterpret_cast<unsigned int*>(&lastIndex[8]) = FST_VERSION;
+  *reinterpret_cast<unsigned short int*>(&lastIndex[24]) = CHUNK_INDEX_SLOTS;
+
+  *p_chunksetIndex = outfile.tellp();
+  outfile.write(lastIndex, CHUNK_INDEX_SIZE);
+
+  // Data chunks with the same rows as the data chunks of the primary chunkset
+
+  unsigned long long lastIndexPos = *p_chunksetIndex;
+  unsigned long long firstRow = 0;
+  const vector<unsigned int> blockSizes = ColumnBlockSizes(nrOfNewCols);
+  const vector<int> decimals = ColumnDecimals(nrOfNewCols);
+
+  for (size_t chunk = 0; chunk < chunkRows.size(); ++chunk)
+  {
+    FstTableView chunkRange(&fstTable, 0, nrOfNewCols, firstRow, chunkRows[chunk]);
+    lastIndexPos = AppendDataChunk(outfile, chunkRange, compress, lastIndex, lastIndexPos, colInfo, blockSizes.data(),
+      decimals.data(), charDictionary, extendedCodecs, adaptiveCompression, fastDecompression);
+
+    firstRow += chunkRows[chunk];
+  }
+
+  *p_chunksetHash = ZSTD_XXH64(&chunksetHeader[8], chunksetHeaderSize - 8, FST_HASH_SEED);
+  outfile.seekp(chunksetPos);
+  outfile.write(chunksetHeader, chunksetHeaderSize);
+
+  // Link the new chunkset to the last chunkset of the table
+
+  const ChunksetInfo &lastChunkset = chunksets.back();
+  char* lastHeader = chunksets.size() == 1 ? &metaDataBlock[lastChunkset.headerPos - TABLE_META_SIZE] :
+    chunksetHeaders.back().get();
+  const unsigned long long lastHeaderSize = CHUNKSET_HEADER_SIZE + 8 * lastChunkset.nrOfCols;
+
+  *reinterpret_cast<unsigned long long*>(&lastHeader[40]) = chunksetPos;
+  *reinterpret_cast<unsigned long long*>(lastHeader) = ZSTD_XXH64(&lastHeader[8], lastHeaderSize - 8, FST_HASH_SEED);
+
+  outfile.seekp(lastChunkset.headerPos);
+  outfile.write(lastHeader, lastHeaderSize);
+
+  RaiseTableVersion(outfile, RequiredTableVersion(compress));
+
+  if (!sink->Close() || outfile.fail())
+  {
+    throw(runtime_error("There was an error during the write operation, fst file might be corrupted. Please check available disk space and access rights."));
+  }
+}
+
+
+void FstStore::fstMeta(IColumnFactory* columnFactory, IStringColumn* col_names)
+{
+  std::unique_ptr<IFstSource> source = OpenSource();
+  SourceStream myfile(source.get());
+
+  // Read variables from fst file header and check header hash
+  tableVersionMax = ReadHeader(myfile, keyLength, nrOfCols);
+  ReadMetaData(myfile);
+
+  // Read column names of all chunksets
+  ReadColumnNames(myfile, col_names);
+}
+
+
+void FstStore::fstColumnStatistics(const int colNr, vector<ColumnStatistics> &chunkStatistics)
+{
+  std::unique_ptr<IFstSource> source = OpenSource();
+  SourceStream myfile(source.get());
+
+  tableVersionMax = ReadHeader(myfile, keyLength, nrOfCols);
+  ReadMetaData(myfile);
+
+  if (colNr < 0 || colNr >= nrOfCols)
+  {
+    throw(runtime_error("Column number out of range."));
+  }
+
+  chunkStatistics.clear();
+
+  // files without a reference to the chunk index have a single data chunk without statistics
+  if (*p_primChunksetIndex == 0)
+  {
+    chunkStatistics.emplace_back();
+    return;
+  }
+
+  // statistics are stored with the data chunks of the column's chunkset
+  const ChunksetInfo &chunkset = chunksets[ChunksetOfColumn(colNr)];
+
+  vector<unsigned long long> chunkPos;
+  vector<unsigned long long> chunkRows;
+  char chunkIndex[CHUNK_INDEX_SIZE];
+
+  ReadChunkIndexes(myfile, chunkset.chunkIndexPos, chunkPos, chunkRows, chunkIndex);
+
+  std::unique_ptr<char[]> dataChunkP(new char[DATA_INDEX_SIZE + 8 * chunkset.nrOfCols]);
+  char* dataChunk = dataChunkP.get();
+
+  chunkStatistics.resize(chunkPos.size());
+
+  for (size_t chunk = 0; chunk < chunkPos.size(); ++chunk)
+  {
+    ReadDataChunkHeader(myfile, nullptr, chunkPos[chunk], dataChunk, chunkset.nrOfCols);
+
+    const unsigned long long statisticsPos = *reinterpret_cast<unsigned long long*>(&dataChunk[16]);
+    fdsReadStatistics(myfile, nullptr, statisticsPos, colNr - chunkset.firstCol, chunkset.nrOfCols, chunkStatistics[chunk]);
+  }
+
+}
+
+
+void FstStore::OpenTable(IStringColumn* col_names, ReadCache &cache)
+{
+  // Metadata is read with a buffered stream, column data with positional reads on the source, which allows for
+  // concurrent reads without a shared file position
+  cache.source = OpenSource();
+  SourceStream myfile(cache.source.get());
+
+  tableVersionMax = ReadHeader(myfile, keyLength, nrOfCols);
+  ReadMetaData(myfile);
+
+  // Column names of all chunksets
+  ReadColumnNames(myfile, col_names);
+
+  // The chunk index directly follows the column names in files that have no reference to it (and a single chunkset)
+  unsigned long long chunkIndexPos = *p_primChunksetIndex;
+
+  if (chunkIndexPos == 0)
+  {
+    chunkIndexPos = myfile.tellg();
+  }
+
+  // Data chunk positions and sizes
+  char chunkIndex[CHUNK_INDEX_SIZE];
+
+  ReadChunkIndexes(myfile, chunkIndexPos, cache.chunkPos, cache.chunkRows, chunkIndex);
+
+  // The data chunks of additional chunksets are aligned with the data chunks of the primary chunkset
+  cache.horzChunkPos.resize(chunksets.size() - 1);
+
+  for (size_t chunksetNr = 1; chunksetNr < chunksets.size(); ++chunksetNr)
+  {
+    vector<unsigned long long> chunkRows;
+    ReadChunkIndexes(myfile, chunksets[chunksetNr].chunkIndexPos, cache.horzChunkPos[chunksetNr - 1], chunkRows, chunkIndex);
+
+    if (chunkRows != cache.chunkRows)
+    {
+      throw(runtime_error(FSTERROR_DAMAGED_CHUNKINDEX));
+    }
+  }
+}
+
+
+void FstStore::OpenReadCache(ReadCache &cache, const bool cacheHeaders) const
+{
+  if (!cacheHeaders) return;
+
+  // memory images are read with copies only
+  if (memoryMapped && !memoryImage)
+  {
+    cache.mappedFile = std::make_shared<MemoryMappedFile>(fstFile);
+
+    if (!cache.mappedFile->IsOpen())
+    {
+      throw(runtime_error(FSTERROR_ERROR_OPENING_FILE));
+    }
+  }
+
+  SourceStream myfile(cache.source.get());  // not used with a positional reader
+
+  for (size_t chunksetNr = 0; chunksetNr < chunksets.size(); ++chunksetNr)
+  {
+    const int nrOfChunksetCols = chunksets[chunksetNr].nrOfCols;
+    const vector<unsigned long long> &chunkPos = chunksetNr == 0 ? cache.chunkPos : cache.horzChunkPos[chunksetNr - 1];
+
+    const unsigned long long dataChunkSize = DATA_INDEX_SIZE + 8 * nrOfChunksetCols;
+    std::unique_ptr<char[]> chunkHeaders(new char[chunkPos.size() * dataChunkSize]);
+
+    for (size_t chunk = 0; chunk < chunkPos.size(); ++chunk)
+    {
+      ReadDataChunkHeader(myfile, cache.source.get(), chunkPos[chunk], &chunkHeaders[chunk * dataChunkSize],
+        nrOfChunksetCols);
+    }
+
+    cache.chunkHeaders.push_back(std::move(chunkHeaders));
+  }
+}
+
+
+const char* FstStore::ChunkHeader(const ReadCache &cache, const size_t chunkset, const size_t chunk, char* dataChunk) const
+{
+  const int nrOfChunksetCols = chunksets[chunkset].nrOfCols;
+  const unsigned long long dataChunkSize = DATA_INDEX_SIZE + 8 * nrOfChunksetCols;
+
+  if (!cache.chunkHeaders.empty()) return &cache.chunkHeaders[chunkset][chunk * dataChunkSize];
+
+  const unsigned long long chunkPos = chunkset == 0 ? cache.chunkPos[chunk] : cache.horzChunkPos[chunkset - 1][chunk];
+
+  SourceStream myfile(cache.source.get());  // not used with a positional reader
+  ReadDataChunkHeader(myfile, cache.source.get(), chunkPos, dataChunk, nrOfChunksetCols);
+
+  return dataChunk;
+}
+
+
+int FstStore::SelectColumns(const ReadCache &cache, IStringArray* columnSelection, std::unique_ptr<int[]> &colIndexP) const
+{
+  int *colIndex = nullptr;
+  int nrOfSelect;
+
+  if (columnSelection == nullptr)
+  {
+    colIndexP = std::unique_ptr<int[]>(new int[nrOfCols]);
+    colIndex = colIndexP.get();
+
+    for (int colNr = 0; colNr < nrOfCols; ++colNr)
+    {
+      colIndex[colNr] = colNr;
+    }
+    nrOfSelect = nrOfCols;
+  }
+  else  // determine column numbers of column names
+  {
+    nrOfSelect = columnSelection->Length();
+
+    colIndexP = std::unique_ptr<int[]>(new int[nrOfSelect]);
+    colIndex = colIndexP.get();
+
+    for (int colSel = 0; colSel < nrOfSelect; ++colSel)
+    {
+      const char* str1 = columnSelection->GetElement(colSel);
+      const int equal = cache.columnIndex.Find(str1);
+
+      if (equal == -1)
+      {
+        std::string error = "Column '";
+        error.append(str1);
+        error.append("' not found");
+        throw(runtime_error(error));
+      }
+
+      colIndex[colSel] = equal;
+    }
+  }
+
+  return nrOfSelect;
+}
+
+
+void FstStore::fstRead(IFstTable &tableReader, IStringArray* columnSelection, const int64_t startRow, const int64_t endRow,
+  IColumnFactory* columnFactory, vector<int> &keyIndex, IStringArray* selectedCols, IStringColumn* col_names)
+{
+  ReadCache cache;
+
+  OpenTable(col_names, cache);
+  OpenReadCache(cache, false);
+
+  if (columnSelection != nullptr) cache.columnIndex.Build(col_names, nrOfCols);
+
+  ReadRange(cache, tableReader, columnSelection, startRow, endRow, columnFactory, keyIndex, selectedCols, col_names);
+}
+
+
+void FstStore::ReadRange(const ReadCache &cache, IFstTable &tableReader, IStringArray* columnSelection,
+  const int64_t startRow, const int64_t endRow, IColumnFactory* columnFactory, vector<int> &keyIndex, IStringArray* selectedCols,
+  IStringColumn* col_names) const
+{
+  // Determine column selection
+  std::unique_ptr<int[]> colIndexP;
+  const int nrOfSelect = SelectColumns(cache, columnSelection, colIndexP);
+
+  ReadColumnRange(cache, tableReader, colIndexP.get(), nrOfSelect, startRow, endRow, columnFactory, keyIndex, selectedCols,
+    col_names);
+}
+
+
+void FstStore::ReadColumnRange(const ReadCache &cache, IFstTable &tableReader, const int* colIndex, const int nrOfSelect,
+  const int64_t startRow, const int64_t endRow, IColumnFactory* columnFactory, vector<int> &keyIndex,
+  IStringArray* selectedCols, IStringColumn* col_names) const
+{
+  RowSlices slices;
+  const long long length = RangeSlices(cache, startRow, endRow, slices);
+
+  ReadSlices(cache, tableReader, colIndex, nrOfSelect, slices, length, columnFactory, keyIndex, selectedCols, col_names);
+}
+
+
+void FstStore::fstReadRows(IFstTable &tableReader, IStringArray* columnSelection, const vector<int64_t> &rows,
+  IColumnFactory* columnFactory, vector<int> &keyIndex, IStringArray* selectedCols, IStringColumn* col_names)
+{
+  ReadCache cache;
+
+  OpenTable(col_names, cache);
+  OpenReadCache(cache, false);
+
+  if (columnSelection != nullptr) cache.columnIndex.Build(col_names, nrOfCols);
+
+  ReadSelection(cache, tableReader, columnSelection, rows, columnFactory, keyIndex, selectedCols, col_names);
+}
+
+
+void FstStore::ReadSelection(const ReadCache &cache, IFstTable &tableReader, IStringArray* columnSelection,
+  const vector<int64_t> &rows, IColumnFactory* columnFactory, vector<int> &keyIndex, IStringArray* selectedCols,
+  IStringColumn* col_names) const
+{
+  // Determine column selection
+  std::unique_ptr<int[]> colIndexP;
+  const int nrOfSelect = SelectColumns(cache, columnSelection, colIndexP);
+
+  RowSlices slices;
+  const long long length = SelectionSlices(cache, rows, slices);
+
+  ReadSlices(cache, tableReader, colIndexP.get(), nrOfSelect, slices, length, columnFactory, keyIndex, selectedCols, col_names);
+}
+
+
+void FstStore::fstReadFiltered(IFstTable &tableReader, IStringArray* columnSelection, const vector<FstPredicate> &predicates,
+  IColumnFactory* columnFactory, vector<int> &keyIndex, IStringArray* selectedCols, IStringColumn* col_names)
+{
+  ReadCache cache;
+
+  OpenTable(col_names, cache);
+  OpenReadCache(cache, false);
+  cache.columnIndex.Build(col_names, nrOfCols);
+
+  ReadFiltered(cache, tableReader, columnSelection, predicates, columnFactory, keyIndex, selectedCols, col_names);
+}
+
+
+long long FstStore::fstCountFiltered(const vector<FstPredicate> &predicates, IStringColumn* col_names)
+{
+  ReadCache cache;
+
+  OpenTable(col_names, cache);
+  OpenReadCache(cache, false);
+  cache.columnIndex.Build(col_names, nrOfCols);
+
+  RowSlices slices;
+  return FilteredSlices(cache, predicates, slices);
+}
+
+
+void FstStore::ReadFiltered(const ReadCache &cache, IFstTable &tableReader, IStringArray* columnSelection,
+  const vector<FstPredicate> &predicates, IColumnFactory* columnFactory, vector<int> &keyIndex, IStringArray* selectedCols,
+  IStringColumn* col_names) const
+{
+  // Determine column selection
+  std::unique_ptr<int[]> colIndexP;
+  const int nrOfSelect = SelectColumns(cache, columnSelection, colIndexP);
+
+  RowSlices slices;
+  const long long length = FilteredSlices(cache, predicates, slices);
+
+  ReadSlices(cache, tableReader, colIndexP.get(), nrOfSelect, slices, length, columnFactory, keyIndex, selectedCols, col_names);
+}
+
+
+long long FstStore::RangeSlices(const ReadCache &cache, const int64_t startRow, const int64_t endRow, RowSlices &slices) const
+{
+  // Check range of selected rows
+  const long long firstRow = startRow - 1;
+
+  const vector<unsigned long long> &chunkPos = cache.chunkPos;
+  const vector<unsigned long long> &chunkRows = cache.chunkRows;
+  const uint64_t nrOfRows = cache.NrOfRows();  // TODO: check for row numbers > INT_MAX !!!
 
-  if (*p_colNamesHash != colNamesHash)
+  if (nrOfRows != 0 && (firstRow >= static_cast<long long>(nrOfRows) || firstRow < 0))
   {
-    myfile.close();
-    throw(runtime_error(FSTERROR_DAMAGED_HEADER));
+    if (firstRow < 0)
+    {
+      throw(runtime_error("Parameter fromRow should have a positive value."));
+    }
+
+    throw(runtime_error("Row selection is out of range."));
   }
 
-  // Read column names
-  const unsigned long long colNamesOffset = metaSize + TABLE_META_SIZE;
+  long long length = max(static_cast<long long>(nrOfRows) - firstRow, 0LL);
 
-  col_names->AllocateVec(static_cast<unsigned int>(nrOfCols));
-  fdsReadCharVec_v6(myfile, col_names, colNamesOffset, 0, static_cast<unsigned int>(nrOfCols), static_cast<unsigned int>(nrOfCols));
+  // Determine vector length
+  if (endRow != -1)
+  {
+    if (static_cast<long long>(endRow) <= firstRow)
+    {
+      throw(runtime_error("Incorrect row range specified."));
+    }
 
-  // cleanup
-  myfile.close();
-}
+    length = max(min(endRow - firstRow, static_cast<long long>(nrOfRows) - firstRow), 0LL);
+  }
 
 
-void FstStore::fstRead(IFstTable &tableReader, IStringArray* columnSelection, const int64_t startRow, const int64_t endRow,
-  IColumnFactory* columnFactory, vector<int> &keyIndex, IStringArray* selectedCols, IStringColumn* col_names)
-{
-  // fst file stream using a stack buffer
-  ifstream myfile;
-  myfile.open(fstFile.c_str(), ios::in | ios::binary);  // only nead an input stream reader
+  // Determine the data chunks that overlap with the selected rows
 
-  if (myfile.fail())
+  unsigned long long chunkStart = 0;
+  for (size_t chunk = 0; chunk < chunkPos.size(); ++chunk)
   {
-    myfile.close();
-    throw(runtime_error(FSTERROR_ERROR_OPENING_FILE));
-  }
+    const unsigned long long chunkEnd = chunkStart + chunkRows[chunk];
+    const unsigned long long sliceFrom = max(chunkStart, static_cast<unsigned long long>(firstRow));
+    const unsigned long long sliceTo = min(chunkEnd, static_cast<unsigned long long>(firstRow + length));
 
-  int keyLength;
-  tableVersionMax = ReadHeader(myfile, keyLength, nrOfCols);
+    if (sliceFrom < sliceTo)
+    {
+      slices.Add(chunkPos[chunk], sliceFrom - chunkStart, sliceTo - sliceFrom, chunkRows[chunk], sliceFrom - firstRow);
+    }
 
-  unsigned long long keyIndexHeaderSize = 0;
+    chunkStart = chunkEnd;
+  }
 
-  if (keyLength != 0)
+  // an empty selection reads the (empty) columns of the first data chunk
+  if (slices.pos.empty())
   {
-    // size of key index vector and hash and a possible allignment correction
-    keyIndexHeaderSize = (keyLength % 2) * 4 + 4 * (keyLength + 2);
+    slices.Add(chunkPos[0], 0, 0, chunkRows[0], 0);
   }
 
-  const unsigned long long chunksetHeaderSize = CHUNKSET_HEADER_SIZE + 8 * nrOfCols;
-  const unsigned long long colNamesHeaderSize = 24;
-  const unsigned long long metaSize = keyIndexHeaderSize + chunksetHeaderSize + colNamesHeaderSize;
-
-  // Read format headers
-  metaDataBlockP = std::unique_ptr<char[]>(new char[metaSize]);
-  metaDataBlock = metaDataBlockP.get();
+  return length;
+}
 
-  myfile.read(metaDataBlock, metaSize);
 
-  int* keyColPos = reinterpret_cast<int*>(&metaDataBlock[8]);  // TODO: why not unsigned ?
+long long FstStore::SelectionSlices(const ReadCache &cache, const vector<int64_t> &rows, RowSlices &slices) const
+{
+  // Check selected rows
+  const vector<unsigned long long> &chunkPos = cache.chunkPos;
+  const vector<unsigned long long> &chunkRows = cache.chunkRows;
+  const uint64_t nrOfRows = cache.NrOfRows();
 
-  if (keyLength != 0)
+  for (size_t pos = 0; pos < rows.size(); ++pos)
   {
-    unsigned long long* p_keyIndexHash = reinterpret_cast<unsigned long long*>(metaDataBlock);
-    const unsigned long long hHash = ZSTD_XXH64(&metaDataBlock[8], keyIndexHeaderSize - 8, FST_HASH_SEED);
+    if (rows[pos] < 1 || static_cast<uint64_t>(rows[pos]) > nrOfRows)
+    {
+      throw(runtime_error("Row selection is out of range."));
+    }
 
-    if (*p_keyIndexHash != hHash)
+    if (pos > 0 && rows[pos] < rows[pos - 1])
     {
-      myfile.close();
-      throw(runtime_error(FSTERROR_DAMAGED_HEADER));
+      throw(runtime_error(FSTERROR_ROWS_NOT_SORTED));
     }
   }
 
-  // Chunkset header [node C, free leaf of A or other chunkset header] [size: 80 + 8 * nrOfCols]
-
-  unsigned long long* p_chunksetHash      = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize]);
-  //unsigned int* p_chunksetHeaderVersion   = reinterpret_cast<unsigned int*>(&metaDataBlock[keyIndexHeaderSize + 8]);
-  //int* p_chunksetFlags                    = reinterpret_cast<int*>(&metaDataBlock[keyIndexHeaderSize + 12]);
-  //unsigned long long* p_freeBytes2        = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 16]);
-  //unsigned long long* p_freeBytes3        = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 24]);
-  //unsigned long long* p_colNamesPos       = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 32]);
-
-  //unsigned long long* p_nextHorzChunkSet  = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 40]);
-  //unsigned long long* p_primChunksetIndex = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 48]);
-  //unsigned long long* p_secChunksetIndex  = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 56]);
-  //unsigned long long* p_nrOfRows          = reinterpret_cast<unsigned long long*>(&metaDataBlock[keyIndexHeaderSize + 64]);
-  //int* p_nrOfChunksetCols                 = reinterpret_cast<int*>(&metaDataBlock[keyIndexHeaderSize + 72]);
-  //int* p_freeBytes4                       = reinterpret_cast<int*>(&metaDataBlock[offset + 76]);
+  // Each data chunk with selected rows is read as a single slice
 
+  slices.gather = true;
+  slices.index.reserve(rows.size());
 
-  colAttributeTypes                       = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + CHUNKSET_HEADER_SIZE]);
-  colTypes                                = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + CHUNKSET_HEADER_SIZE + 2 * nrOfCols]);
-  colBaseTypes                            = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + CHUNKSET_HEADER_SIZE + 4 * nrOfCols]);
-  colScales                               = reinterpret_cast<unsigned short int*>(&metaDataBlock[keyIndexHeaderSize + CHUNKSET_HEADER_SIZE + 6 * nrOfCols]);
+  size_t pos = 0;
+  unsigned long long chunkStart = 0;
 
-  const unsigned long long chunksetHash = ZSTD_XXH64(&metaDataBlock[keyIndexHeaderSize + 8], chunksetHeaderSize - 8, FST_HASH_SEED);
-  if (*p_chunksetHash != chunksetHash)
+  for (size_t chunk = 0; chunk < chunkPos.size(); ++chunk)
   {
-    myfile.close();
-    throw(runtime_error(FSTERROR_DAMAGED_HEADER));
-  }
+    const unsigned long long chunkEnd = chunkStart + chunkRows[chunk];
+    const size_t sliceFrom = pos;
 
-  // Column names header
+    for (; pos < rows.size() && static_cast<unsigned long long>(rows[pos]) <= chunkEnd; ++pos)
+    {
+      slices.index.push_back(rows[pos] - 1 - chunkStart);
+    }
 
-  const unsigned long long offset          = keyIndexHeaderSize + chunksetHeaderSize;
-  unsigned long long* p_colNamesHash = reinterpret_cast<unsigned long long*>(&metaDataBlock[offset]);
-  //unsigned int* p_colNamesVersion    = reinterpret_cast<unsigned int*>(&metaDataBlock[offset + 8]);
-  //int* p_colNamesFlags               = reinterpret_cast<int*>(&metaDataBlock[offset + 12]);
-  //unsigned long long* p_freeBytes5   = reinterpret_cast<unsigned long long*>(&metaDataBlock[offset + 16]);
+    if (pos > sliceFrom)
+    {
+      slices.Add(chunkPos[chunk], sliceFrom, pos - sliceFrom, chunkRows[chunk], sliceFrom);
+    }
 
-  const unsigned long long colNamesHash = ZSTD_XXH64(&metaDataBlock[offset + 8], colNamesHeaderSize - 8, FST_HASH_SEED);
-  if (*p_colNamesHash != colNamesHash)
+    chunkStart = chunkEnd;
+  }
+
+  // an empty selection reads the (empty) columns of the first data chunk
+  if (slices.pos.empty())
   {
-    myfile.close();
-    throw(runtime_error(FSTERROR_DAMAGED_HEADER));
+    slices.gather = false;
+    slices.Add(chunkPos[0], 0, 0, chunkRows[0], 0);
   }
 
-  // Column names
+  return static_cast<long long>(rows.size());
+}
 
-  const unsigned long long colNamesOffset = metaSize + TABLE_META_SIZE;
 
-  // blockReaderP = std::unique_ptr<IStringColumn>(columnFactory->CreateStringColumn(nrOfCols, FstColumnAttribute::NONE));
-  // blockReader = blockReaderP.get();
+long long FstStore::FilteredSlices(const ReadCache &cache, const vector<FstPredicate> &predicates, RowSlices &slices) const
+{
+  // Determine predicate columns
+  const size_t nrOfPredicates = predicates.size();
+  vector<int> predicateCols(nrOfPredicates);
+  vector<int> predicateChunksets(nrOfPredicates);
+  vector<PredicateFilter> filters;
 
-  col_names->AllocateVec(static_cast<unsigned int>(nrOfCols));
-  fdsReadCharVec_v6(myfile, col_names, colNamesOffset, 0, static_cast<unsigned int>(nrOfCols), static_cast<unsigned int>(nrOfCols));
+  for (size_t predicate = 0; predicate < nrOfPredicates; ++predicate)
+  {
+    const char* str1 = predicates[predicate].columnName.c_str();
+    const int colNr = cache.columnIndex.Find(str1);
 
-  // Size of chunkset index header plus data chunk header
-  const unsigned long long chunkIndexSize = CHUNK_INDEX_SIZE + DATA_INDEX_SIZE + 8 * nrOfCols;
-  char* chunkIndex = new char[chunkIndexSize];
-  std::unique_ptr<char[]> chunkIndexPtr = std::unique_ptr<char[]>(chunkIndex);
+    if (colNr == -1)
+    {
+      std::string error = "Column '";
+      error.append(str1);
+      error.append("' not found");
+      throw(runtime_error(error));
+    }
 
-  myfile.read(chunkIndex, chunkIndexSize);
+    StatisticsType statisticsType;
 
-  // Chunk index [node D, leaf of C] [size: 96]
+    switch (colTypes[colNr])
+    {
+      case 8:
+      case 10:
+        statisticsType = StatisticsType::INT_32;
+        break;
 
-  unsigned long long* p_chunkIndexHash = reinterpret_cast<unsigned long long*>(chunkIndex);
-  //unsigned int* p_chunkIndexVersion    = reinterpret_cast<unsigned int*>(&chunkIndex[8]);
-  //int* p_chunkIndexFlags               = reinterpret_cast<int*>(&chunkIndex[12]);
-  //unsigned long long* p_freeBytes6     = reinterpret_cast<unsigned long long*>(&chunkIndex[16]);
-  //unsigned short int* p_nrOfChunkSlots = reinterpret_cast<unsigned short int*>(&chunkIndex[24]);
-  //unsigned short int* p_freeBytes7     = reinterpret_cast<unsigned short int*>(&chunkIndex[26]);
-  //unsigned long long* p_chunkPos       = reinterpret_cast<unsigned long long*>(&chunkIndex[32]);
-  unsigned long long* p_chunkRows      = reinterpret_cast<unsigned long long*>(&chunkIndex[64]);
+      case 9:
+        statisticsType = StatisticsType::DOUBLE_64;
+        break;
 
-  // Chunk data header [node E, leaf of D] [size: 24 + 8 * nrOfCols]
+      case 11:
+        statisticsType = StatisticsType::INT_64;
+        break;
 
-  unsigned long long* p_chunkDataHash  = reinterpret_cast<unsigned long long*>(&chunkIndex[96]);
-  //unsigned int* p_chunkDataVersion     = reinterpret_cast<unsigned int*>(&chunkIndex[104]);
-  //int* p_chunkDataFlags                = reinterpret_cast<int*>(&chunkIndex[108]);
-  //unsigned long long* p_freeBytes8     = reinterpret_cast<unsigned long long*>(&chunkIndex[112]);
-  unsigned long long* positionData     = reinterpret_cast<unsigned long long*>(&chunkIndex[120]);  // column position index
+      default:
+        throw(runtime_error(FSTERROR_PREDICATE_COL_TYPE));
+    }
 
+    predicateChunksets[predicate] = ChunksetOfColumn(colNr);
+    predicateCols[predicate] = colNr - chunksets[predicateChunksets[predicate]].firstCol;  // column within chunkset
+    filters.emplace_back(predicates[predicate], statisticsType);
+  }
 
-  // Check chunk hashes
+  const vector<unsigned long long> &chunkPos = cache.chunkPos;
+  const vector<unsigned long long> &chunkRows = cache.chunkRows;
+  const IFstSource* positionalReader = cache.source.get();
+  SourceStream myfile(cache.source.get());  // not used with a positional reader
 
-  const unsigned long long chunkIndexHash = ZSTD_XXH64(&chunkIndex[8], CHUNK_INDEX_SIZE - 8, FST_HASH_SEED);
+  // Evaluate the predicates for each data chunk, the matching rows are read as slices of the data chunk
 
-  if (*p_chunkIndexHash != chunkIndexHash)
-  {
-    myfile.close();
-    throw(runtime_error(FSTERROR_DAMAGED_CHUNKINDEX));
-  }
+  std::unique_ptr<char[]> dataChunkP(new char[DATA_INDEX_SIZE + 8 * nrOfCols]);
 
-  const unsigned long long chunkDataHash = ZSTD_XXH64(&chunkIndex[CHUNK_INDEX_SIZE + 8], chunkIndexSize - (CHUNK_INDEX_SIZE + 8), FST_HASH_SEED);
+  unsigned long long length = 0;
 
-  if (*p_chunkDataHash != chunkDataHash)
+  for (size_t chunk = 0; chunk < chunkPos.size(); ++chunk)
   {
-    myfile.close();
-    throw(runtime_error(FSTERROR_DAMAGED_CHUNKINDEX));
-  }
+    if (chunkRows[chunk] == 0) continue;
 
+    RowRanges candidates { { 0, chunkRows[chunk] } };
 
-  // Read block positions
-  unsigned long long* blockPos = positionData;
+    for (size_t predicate = 0; predicate < nrOfPredicates && !candidates.empty(); ++predicate)
+    {
+      const int colNr = predicateCols[predicate];
+      const int chunksetNr = predicateChunksets[predicate];
 
+      const char* dataChunk = ChunkHeader(cache, chunksetNr, chunk, dataChunkP.get());
+      const unsigned long long* chunkBlockPos = reinterpret_cast<const unsigned long long*>(&dataChunk[DATA_INDEX_SIZE]);
 
-  // Determine column selection
-  std::unique_ptr<int[]> colIndexP;
-  int *colIndex = nullptr;
+      // files without a reference to the chunk index have no statistics
+      const unsigned long long statisticsPos = *p_primChunksetIndex == 0 ? 0 :
+        *reinterpret_cast<const unsigned long long*>(&dataChunk[16]);
 
-  int nrOfSelect;
+      ColumnStatistics stats;
+      fdsReadStatistics(myfile, positionalReader, statisticsPos, colNr, chunksets[chunksetNr].nrOfCols, stats);
 
-  if (columnSelection == nullptr)
-  {
-    colIndexP = std::unique_ptr<int[]>(new int[nrOfCols]);
-    colIndex = colIndexP.get();
+      RowRanges matches;
+      fdsFilterColumn_v2(myfile, positionalReader, chunkBlockPos[colNr], chunkRows[chunk], filters[predicate], stats,
+        candidates, matches);
 
-    for (int colNr = 0; colNr < nrOfCols; ++colNr)
+      candidates.swap(matches);
+    }
+
+    for (const auto &range : candidates)
     {
-      colIndex[colNr] = colNr;
+      slices.Add(chunkPos[chunk], range.first, range.second - range.first, chunkRows[chunk], length);
+      length += range.second - range.first;
     }
-    nrOfSelect = nrOfCols;
   }
-  else  // determine column numbers of column names
+
+  // without matching rows, the (empty) columns of the first data chunk are read
+  if (slices.pos.empty())
   {
-    nrOfSelect = columnSelection->Length();
+    slices.Add(chunkPos[0], 0, 0, chunkRows[0], 0);
+  }
 
-    colIndexP = std::unique_ptr<int[]>(new int[nrOfSelect]);
-    colIndex = colIndexP.get();
+  // short runs of matching rows are read as a row selection to avoid decompressing blocks more than once
+  if (slices.pos.size() > chunkPos.size() && length < GATHER_RUN_ROWS * slices.pos.size())
+  {
+    GatherRowSlices(slices);
+  }
 
-    for (int colSel = 0; colSel < nrOfSelect; ++colSel)
-    {
-      int equal = -1;
-      const char* str1 = columnSelection->GetElement(colSel);
+  return static_cast<long long>(length);
+}
 
-      for (int colNr = 0; colNr < nrOfCols; ++colNr)
-      {
-        const char* str2 = col_names->GetElement(colNr);
-        if (strcmp(str1, str2) == 0)
-        {
-          equal = colNr;
-          break;
-        }
-      }
 
-      if (equal == -1)
-      {
-        myfile.close();
-        std::string error = "Column '";
-        error.append(str1);
-        error.append("' not found");
-        throw(runtime_error(error));
-      }
+void FstStore::ReadSlices(const ReadCache &cache, IFstTable &tableReader, const int* colIndex, const int nrOfSelect,
+  const RowSlices &slices, const long long length, IColumnFactory* columnFactory, vector<int> &keyIndex,
+  IStringArray* selectedCols, IStringColumn* col_names) const
+{
+  SourceStream myfile(cache.source.get());  // not used with a positional reader
+  const IFstSource &positionalReader = *cache.source;
+  ColumnMetaCache* metaCache = cache.columnMeta.get();  // only kept by a FstBatchReader
 
-      colIndex[colSel] = equal;
-    }
-  }
+  const vector<unsigned long long> &slicePos = slices.pos;
+  const vector<unsigned long long> &sliceStart = slices.start;
+  const vector<unsigned long long> &sliceLength = slices.length;
+  const vector<unsigned long long> &sliceRows = slices.rows;
+  const vector<unsigned long long> &sliceOffset = slices.offset;
 
+  const size_t nrOfSlices = slicePos.size();
 
-  // Check range of selected rows
-  const long long firstRow = startRow - 1;
-  const uint64_t nrOfRows = *p_chunkRows;  // TODO: check for row numbers > INT_MAX !!!
+  std::unique_ptr<char[]> dataChunkP(new char[DATA_INDEX_SIZE + 8 * nrOfCols]);
 
-  if (nrOfRows != 0 && (firstRow >= static_cast<long long>(nrOfRows) || firstRow < 0))
+  // Column positions of each selected data chunk, collected from the data chunk headers of all chunksets
+  vector<std::unique_ptr<unsigned long long[]>> chunkBlockPos;
+  vector<const unsigned long long*> blockPos(nrOfSlices);
+  size_t chunk = 0;
+
+  for (size_t slice = 0; slice < nrOfSlices; ++slice)
   {
-    myfile.close();
+    // consecutive slices of the same data chunk share the header
+    if (slice > 0 && slicePos[slice] == slicePos[slice - 1])
+    {
+      blockPos[slice] = blockPos[slice - 1];
+      continue;
+    }
 
-    if (firstRow < 0)
+    // slices are ordered by data chunk
+    while (cache.chunkPos[chunk] != slicePos[slice]) ++chunk;
+
+    std::unique_ptr<unsigned long long[]> positions(new unsigned long long[nrOfCols]);
+
+    for (size_t chunksetNr = 0; chunksetNr < chunksets.size(); ++chunksetNr)
     {
-      throw(runtime_error("Parameter fromRow should have a positive value."));
+      const char* dataChunk = ChunkHeader(cache, chunksetNr, chunk, dataChunkP.get());
+      memcpy(&positions[chunksets[chunksetNr].firstCol], &dataChunk[DATA_INDEX_SIZE], 8 * chunksets[chunksetNr].nrOfCols);
     }
 
-    throw(runtime_error("Row selection is out of range."));
+    blockPos[slice] = positions.get();
+    chunkBlockPos.push_back(std::move(positions));
   }
 
-  long long length = max(static_cast<long long>(nrOfRows) - firstRow, 0LL);
+  // In the memory-mapped read mode, uncompressed fixed-width columns of a single data chunk are used directly
+  // from the mapped file if the column factory supports column views
+  std::shared_ptr<MemoryMappedFile> mappedFile;
 
-  // Determine vector length
-  if (endRow != -1)
+  if (memoryMapped && !memoryImage && nrOfSlices == 1 && !slices.gather && length > 0)
   {
-    if (static_cast<long long>(endRow) <= firstRow)
+    mappedFile = cache.mappedFile ? cache.mappedFile : std::make_shared<MemoryMappedFile>(fstFile);
+
+    if (!mappedFile->IsOpen())
     {
-      myfile.close();
-      throw(runtime_error("Incorrect row range specified."));
+      throw(runtime_error(FSTERROR_ERROR_OPENING_FILE));
     }
-
-    length = max(min(endRow - firstRow, static_cast<long long>(nrOfRows) - firstRow), 0LL);
   }
 
   tableReader.InitTable(nrOfSelect, length);
 
+  // Fixed-width columns are split into read tasks that are executed after all columns are created
+  vector<ColumnReadTask> readTasks;
+  vector<std::shared_ptr<void>> columnHolders;  // keeps fixed-width columns alive until read
+  vector<IIntegerColumn*> integerColumns(nrOfSelect, nullptr);
+  vector<IDoubleColumn*> doubleColumns(nrOfSelect, nullptr);
+
   for (int colSel = 0; colSel < nrOfSelect; ++colSel)
   {
     const int colNr = colIndex[colSel];
 
     if (colNr < 0 || colNr >= nrOfCols)
     {
-      myfile.close();
       throw(runtime_error("Column selection is out of range."));
     }
 
-    const uint64_t pos = blockPos[colNr];
     const short int scale = colScales[colNr];
 
     switch (colTypes[colNr])
@@ -894,7 +2326,19 @@ void FstStore::fstRead(IFstTable &tableReader, IStringArray* columnSelection, co
         stringColumn->AllocateVec(static_cast<uint64_t>(length));
         tableReader.SetStringColumn(stringColumn, colSel);
 
-        fdsReadCharVec_v6(myfile, stringColumn, pos, firstRow, length, nrOfRows);
+        for (size_t slice = 0; slice < nrOfSlices; ++slice)
+        {
+          if (slices.gather)
+          {
+            fdsGatherCharVec_v6(myfile, stringColumn, blockPos[slice][colNr], &slices.index[sliceStart[slice]], sliceLength[slice],
+              sliceRows[slice], sliceOffset[slice], &positionalReader);
+
+            continue;
+          }
+
+          fdsReadCharVec_v6(myfile, stringColumn, blockPos[slice][colNr], sliceStart[slice], sliceLength[slice], sliceRows[slice],
+            sliceOffset[slice], &positionalReader);
+        }
 
         break;
       }
@@ -902,20 +2346,33 @@ void FstStore::fstRead(IFstTable &tableReader, IStringArray* columnSelection, co
       // Integer vector
       case 8:
       {
-        std::unique_ptr<IIntegerColumn> integerColumnP(columnFactory->CreateIntegerColumn(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), scale));
-        IIntegerColumn* integerColumn = integerColumnP.get();
+        std::string annotation;
+        bool hasAnnotation = false;
+        char* view = MappedColumnData(mappedFile, blockPos[0][colNr], sliceStart[0], length, 4, annotation, hasAnnotation);
 
-        tableReader.SetIntegerColumn(integerColumn, colSel);
+        if (view != nullptr)
+        {
+          std::unique_ptr<IIntegerColumn> viewColumn(columnFactory->CreateIntegerColumnView(length,
+            static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), scale, reinterpret_cast<int*>(view), mappedFile));
+
+          if (viewColumn)
+          {
+            tableReader.SetIntegerColumn(viewColumn.get(), colSel);
+            if (hasAnnotation) viewColumn->Annotate(annotation);
+            break;
+          }
+        }
 
-        std::string annotation = "";
-        bool hasAnnotation;
+        std::shared_ptr<IIntegerColumn> integerColumn(columnFactory->CreateIntegerColumn(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), scale));
+        tableReader.SetIntegerColumn(integerColumn.get(), colSel);
 
-        fdsReadIntVec_v8(myfile, integerColumn->Data(), pos, firstRow, length, nrOfRows, annotation, hasAnnotation);
+        columnHolders.push_back(integerColumn);
+        integerColumns[colSel] = integerColumn.get();
 
-        if (hasAnnotation)
+        for (size_t slice = 0; slice < nrOfSlices; ++slice)
         {
-          integerColumn->Annotate(annotation);
-          break;
+          AddSliceTasks(readTasks, colSel, 8, reinterpret_cast<char*>(&integerColumn->Data()[sliceOffset[slice]]), 4,
+            blockPos[slice][colNr], slices, slice);
         }
 
         break;
@@ -924,19 +2381,33 @@ void FstStore::fstRead(IFstTable &tableReader, IStringArray* columnSelection, co
       // Double vector
       case 9:
       {
-        std::unique_ptr<IDoubleColumn> doubleColumnP(columnFactory->CreateDoubleColumn(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), scale));
-        IDoubleColumn* doubleColumn = doubleColumnP.get();
+        std::string annotation;
+        bool hasAnnotation = false;
+        char* view = MappedColumnData(mappedFile, blockPos[0][colNr], sliceStart[0], length, 8, annotation, hasAnnotation);
 
-        tableReader.SetDoubleColumn(doubleColumn, colSel);
+        if (view != nullptr)
+        {
+          std::unique_ptr<IDoubleColumn> viewColumn(columnFactory->CreateDoubleColumnView(length,
+            static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), scale, reinterpret_cast<double*>(view), mappedFile));
+
+          if (viewColumn)
+          {
+            tableReader.SetDoubleColumn(viewColumn.get(), colSel);
+            if (hasAnnotation) viewColumn->Annotate(annotation);
+            break;
+          }
+        }
 
-        std::string annotation = "";
-        bool hasAnnotation;
+        std::shared_ptr<IDoubleColumn> doubleColumn(columnFactory->CreateDoubleColumn(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), scale));
+        tableReader.SetDoubleColumn(doubleColumn.get(), colSel);
 
-        fdsReadRealVec_v9(myfile, doubleColumn->Data(), pos, firstRow, length, nrOfRows, annotation, hasAnnotation);
+        columnHolders.push_back(doubleColumn);
+        doubleColumns[colSel] = doubleColumn.get();
 
-        if (hasAnnotation)
+        for (size_t slice = 0; slice < nrOfSlices; ++slice)
         {
-          doubleColumn->Annotate(annotation);
+          AddSliceTasks(readTasks, colSel, 9, reinterpret_cast<char*>(&doubleColumn->Data()[sliceOffset[slice]]), 8,
+            blockPos[slice][colNr], slices, slice);
         }
 
         break;
@@ -945,10 +2416,17 @@ void FstStore::fstRead(IFstTable &tableReader, IStringArray* columnSelection, co
       // Logical vector
       case 10:
       {
-        std::unique_ptr<ILogicalColumn> logicalColumnP(columnFactory->CreateLogicalColumn(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr])));
-        ILogicalColumn* logicalColumn = logicalColumnP.get();
-        tableReader.SetLogicalColumn(logicalColumn, colSel);
-        fdsReadLogicalVec_v10(myfile, logicalColumn->Data(), pos, firstRow, length, nrOfRows);
+        std::shared_ptr<ILogicalColumn> logicalColumn(columnFactory->CreateLogicalColumn(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr])));
+        tableReader.SetLogicalColumn(logicalColumn.get(), colSel);
+
+        columnHolders.push_back(logicalColumn);
+
+        for (size_t slice = 0; slice < nrOfSlices; ++slice)
+        {
+          AddSliceTasks(readTasks, colSel, 10, reinterpret_cast<char*>(&logicalColumn->Data()[sliceOffset[slice]]), 4,
+            blockPos[slice][colNr], slices, slice);
+        }
+
         break;
       }
 
@@ -956,7 +2434,24 @@ void FstStore::fstRead(IFstTable &tableReader, IStringArray* columnSelection, co
       case 7:
       {
         FstColumnAttribute col_attribute = static_cast<FstColumnAttribute>(colAttributeTypes[colNr]);
-        fdsReadFactorVec_v7(tableReader, myfile, pos, firstRow, length, nrOfRows, col_attribute, columnFactory, colSel);
+
+        if (nrOfSlices == 1 && !slices.gather)
+        {
+          fdsReadFactorVec_v7(tableReader, myfile, blockPos[0][colNr], sliceStart[0], sliceLength[0], sliceRows[0], col_attribute,
+            columnFactory, colSel, &positionalReader);
+
+          break;
+        }
+
+        // level sets of data chunks are merged
+        vector<unsigned long long> colPos(nrOfSlices);
+        for (size_t slice = 0; slice < nrOfSlices; ++slice)
+        {
+          colPos[slice] = blockPos[slice][colNr];
+        }
+
+        fdsReadFactorChunks_v7(tableReader, myfile, colPos, sliceStart, sliceLength, sliceRows, col_attribute, columnFactory, colSel,
+          &positionalReader, slices.gather ? slices.index.data() : nullptr);
 
         break;
       }
@@ -964,39 +2459,149 @@ void FstStore::fstRead(IFstTable &tableReader, IStringArray* columnSelection, co
 	  // integer64 vector
 	  case 11:
 	  {
-      std::unique_ptr<IInt64Column> int64ColumP(columnFactory->CreateInt64Column(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), scale));
-      IInt64Column* int64Column = int64ColumP.get();
-      tableReader.SetInt64Column(int64Column, colSel);
-      fdsReadInt64Vec_v11(myfile, int64Column->Data(), pos, firstRow, static_cast<uint64_t>(length), nrOfRows);
+      std::string annotation;
+      bool hasAnnotation = false;
+      char* view = MappedColumnData(mappedFile, blockPos[0][colNr], sliceStart[0], length, 8, annotation, hasAnnotation);
+
+      if (view != nullptr)
+      {
+        std::unique_ptr<IInt64Column> viewColumn(columnFactory->CreateInt64ColumnView(length,
+          static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), scale, reinterpret_cast<long long*>(view), mappedFile));
+
+        if (viewColumn)
+        {
+          tableReader.SetInt64Column(viewColumn.get(), colSel);
+          break;
+        }
+      }
+
+      std::shared_ptr<IInt64Column> int64Column(columnFactory->CreateInt64Column(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), scale));
+      tableReader.SetInt64Column(int64Column.get(), colSel);
+
+      columnHolders.push_back(int64Column);
+
+      for (size_t slice = 0; slice < nrOfSlices; ++slice)
+      {
+        AddSliceTasks(readTasks, colSel, 11, reinterpret_cast<char*>(&int64Column->Data()[sliceOffset[slice]]), 8,
+          blockPos[slice][colNr], slices, slice);
+      }
+
       break;
 	  }
 
 	  // byte vector
 	  case 12:
 	  {
-      std::unique_ptr<IByteColumn> byteColumnP(columnFactory->CreateByteColumn(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr])));
-      IByteColumn* byteColumn = byteColumnP.get();
-		  tableReader.SetByteColumn(byteColumn, colSel);
-		  fdsReadByteVec_v12(myfile, byteColumn->Data(), pos, firstRow, length, nrOfRows);
+      std::string annotation;
+      bool hasAnnotation = false;
+      char* view = MappedColumnData(mappedFile, blockPos[0][colNr], sliceStart[0], length, 1, annotation, hasAnnotation);
+
+      if (view != nullptr)
+      {
+        std::unique_ptr<IByteColumn> viewColumn(columnFactory->CreateByteColumnView(length,
+          static_cast<FstColumnAttribute>(colAttributeTypes[colNr]), view, mappedFile));
+
+        if (viewColumn)
+        {
+          tableReader.SetByteColumn(viewColumn.get(), colSel);
+          break;
+        }
+      }
+
+      std::shared_ptr<IByteColumn> byteColumn(columnFactory->CreateByteColumn(length, static_cast<FstColumnAttribute>(colAttributeTypes[colNr])));
+		  tableReader.SetByteColumn(byteColumn.get(), colSel);
+
+      columnHolders.push_back(byteColumn);
+
+      for (size_t slice = 0; slice < nrOfSlices; ++slice)
+      {
+        AddSliceTasks(readTasks, colSel, 12, &byteColumn->Data()[sliceOffset[slice]], 1,
+          blockPos[slice][colNr], slices, slice);
+      }
+
 		  break;
 	  }
 
     // byte block vector
     case 13:
     {
+      if (nrOfSlices > 1 || slices.gather)
+      {
+        throw(runtime_error(FSTERROR_NOT_IMPLEMENTED));
+      }
+
       IByteBlockColumn* byte_block = tableReader.add_byte_block_column(colSel);
 
-      read_byte_block_vec_v13(myfile, byte_block, pos, firstRow, length, nrOfRows);
+      read_byte_block_vec_v13(myfile, byte_block, blockPos[0][colNr], sliceStart[0], sliceLength[0], sliceRows[0]);
       break;
     }
 
     default:
-      myfile.close();
       throw(runtime_error("Unknown type found in column."));
     }
   }
 
-  myfile.close();
+  // Read fixed-width columns. The read tasks of all columns are distributed over the available threads, which share
+  // the positional reader. With a single task, parallelism is used within the column instead.
+
+  const int nrOfTasks = static_cast<int>(readTasks.size());
+  const int nrOfThreads = min(GetFstThreads(), nrOfTasks);
+
+  vector<std::string> taskAnnotation(nrOfTasks);
+  vector<char> taskHasAnnotation(nrOfTasks, 0);
+
+  if (nrOfThreads <= 1)
+  {
+    for (int task = 0; task < nrOfTasks; ++task)
+    {
+      bool hasAnnotation = false;
+      ReadColumnTask(myfile, &positionalReader, readTasks[task], taskAnnotation[task], hasAnnotation, metaCache);
+      taskHasAnnotation[task] = hasAnnotation;
+    }
+  }
+  else
+  {
+    // exceptions can't cross the boundary of the parallel region, the first one is rethrown afterwards
+    std::exception_ptr firstError;
+
+#pragma omp parallel num_threads(nrOfThreads)
+    {
+#ifdef _OPENMP
+      omp_set_num_threads(1);  // the column readers of a task run on the thread of the task (GetFstThreads() == 1)
+#endif
+
+#pragma omp for schedule(dynamic, 1)
+      for (int task = 0; task < nrOfTasks; ++task)
+      {
+        try
+        {
+          // the stream is not used when a positional reader is available
+          bool hasAnnotation = false;
+          ReadColumnTask(myfile, &positionalReader, readTasks[task], taskAnnotation[task], hasAnnotation, metaCache);
+          taskHasAnnotation[task] = hasAnnotation;
+        }
+        catch (...)
+        {
+#pragma omp critical
+          {
+            if (!firstError) firstError = std::current_exception();
+          }
+        }
+      }
+    }
+
+    if (firstError) std::rethrow_exception(firstError);
+  }
+
+  for (int task = 0; task < nrOfTasks; ++task)
+  {
+    if (!taskHasAnnotation[task]) continue;
+
+    const int colSel = readTasks[task].colSel;
+
+    if (integerColumns[colSel] != nullptr) integerColumns[colSel]->Annotate(taskAnnotation[task]);
+    if (doubleColumns[colSel] != nullptr) doubleColumns[colSel]->Annotate(taskAnnotation[task]);
+  }
 
   // Key index
   SetKeyIndex(keyIndex, keyLength, nrOfSelect, keyColPos, colIndex);
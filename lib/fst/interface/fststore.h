@@ -22,15 +22,121 @@
 
 #include <vector>
 #include <memory>
+#include <fstream>
 
 #include <interface/icolumnfactory.h>
 #include <interface/ifsttable.h>
+#include <interface/fstpredicate.h>
+#include <interface/fstmemoryimage.h>
+#include <interface/ifstsource.h>
+#include <interface/ifstsink.h>
+#include <statistics/columnstatistics.h>
+
+
+struct RowSlices;
+struct ReadCache;
+
+
+// Location and columns of a (horizontal) chunkset
+struct ChunksetInfo
+{
+  unsigned long long headerPos;      // position of the chunkset header
+  unsigned long long chunkIndexPos;  // position of the first chunk index (0 for files without a chunk index reference)
+  unsigned long long colNamesPos;    // position of the column names vector
+  int firstCol;                      // table column of the first column in the chunkset
+  int nrOfCols;                      // number of columns in the chunkset
+};
 
 
 class FstStore
 {
+  friend class FstReader;
+  friend class FstStreamer;
+  friend class FstBatchReader;
+
   std::string fstFile;
+  std::shared_ptr<FstMemoryImage> memoryImage;  // used instead of fstFile when set
   std::unique_ptr<char[]> metaDataBlockP;
+  unsigned long long* p_primChunksetIndex;
+  bool memoryMapped;
+
+  // compression block sizes in bytes, columns without an entry (or with a zero entry) use blockSize
+  unsigned int blockSize;
+  std::vector<unsigned int> columnBlockSizes;
+  bool charDictionary;  // compress character columns with a dictionary
+  bool extendedCodecs;  // allow the codecs that require FST_VERSION_CODECS
+  bool adaptiveCompression;  // select the codec of each compression block from a compressed sample
+  bool fastDecompression;  // use high compression LZ4 instead of ZSTD
+  std::vector<int> columnDecimals;  // decimals of double columns, DECIMAL_DETECT for columns without a fixed number
+
+  // Chunksets of the table, the first chunkset is the primary chunkset. Additional chunksets contain columns that
+  // were added to the table with fstAppendColumns.
+  std::vector<ChunksetInfo> chunksets;
+  std::vector<std::unique_ptr<char[]>> chunksetHeaders;  // headers of the additional chunksets
+  std::unique_ptr<unsigned short int[]> colInfoP;        // column types of all chunksets
+
+  std::unique_ptr<IFstSource> OpenSource() const;
+
+  std::unique_ptr<IFstSink> OpenSink(bool truncate) const;
+
+  unsigned long long ReadMetaData(std::istream &myfile);
+
+  void ReadChunksets(std::istream &myfile, unsigned long long keyIndexHeaderSize, unsigned long long metaSize);
+
+  void ReadColumnNames(std::istream &myfile, IStringColumn* col_names) const;
+
+  int ChunksetOfColumn(int colNr) const;
+
+  void OpenAppend(std::vector<unsigned long long> &lastIndexPos, std::unique_ptr<char[]> &lastIndexes);
+
+  void AppendRows(std::ostream &outfile, IFstTable &fstTable, int compress, std::vector<unsigned long long> &lastIndexPos,
+    char* lastIndexes);
+
+  void WriteChunksetHeaders(std::ostream &outfile);
+
+  std::vector<unsigned int> ColumnBlockSizes(int nrOfCols) const;
+
+  std::vector<int> ColumnDecimals(int nrOfCols) const;
+
+  bool HasLargeBlocks() const;
+
+  unsigned int RequiredTableVersion(int compress) const;
+
+  void RaiseTableVersion(std::ostream &outfile, unsigned int version);
+
+  void OpenTable(IStringColumn* col_names, ReadCache &cache);
+
+  void OpenReadCache(ReadCache &cache, bool cacheHeaders) const;
+
+  const char* ChunkHeader(const ReadCache &cache, size_t chunkset, size_t chunk, char* dataChunk) const;
+
+  int SelectColumns(const ReadCache &cache, IStringArray* columnSelection, std::unique_ptr<int[]> &colIndexP) const;
+
+  long long RangeSlices(const ReadCache &cache, int64_t startRow, int64_t endRow, RowSlices &slices) const;
+
+  long long SelectionSlices(const ReadCache &cache, const std::vector<int64_t> &rows, RowSlices &slices) const;
+
+  long long FilteredSlices(const ReadCache &cache, const std::vector<FstPredicate> &predicates, RowSlices &slices) const;
+
+  void ReadRange(const ReadCache &cache, IFstTable &tableReader, IStringArray* columnSelection, int64_t startRow,
+    int64_t endRow, IColumnFactory* columnFactory, std::vector<int> &keyIndex, IStringArray* selectedCols,
+    IStringColumn* col_names) const;
+
+  void ReadColumnRange(const ReadCache &cache, IFstTable &tableReader, const int* colIndex, int nrOfSelect, int64_t startRow,
+    int64_t endRow, IColumnFactory* columnFactory, std::vector<int> &keyIndex, IStringArray* selectedCols,
+    IStringColumn* col_names) const;
+
+  void ReadSelection(const ReadCache &cache, IFstTable &tableReader, IStringArray* columnSelection,
+    const std::vector<int64_t> &rows, IColumnFactory* columnFactory, std::vector<int> &keyIndex,
+    IStringArray* selectedCols, IStringColumn* col_names) const;
+
+  void ReadFiltered(const ReadCache &cache, IFstTable &tableReader, IStringArray* columnSelection,
+    const std::vector<FstPredicate> &predicates, IColumnFactory* columnFactory, std::vector<int> &keyIndex,
+    IStringArray* selectedCols, IStringColumn* col_names) const;
+
+  void ReadSlices(const ReadCache &cache, IFstTable &tableReader, const int* colIndex, int nrOfSelect,
+    const RowSlices &slices, long long length, IColumnFactory* columnFactory, std::vector<int> &keyIndex,
+    IStringArray* selectedCols, IStringColumn* col_names) const;
 
   public:
     unsigned long long* p_nrOfRows;
@@ -49,6 +155,13 @@ class FstStore
 
     FstStore(std::string fstFile);
 
+    /**
+     * \brief Use a memory image instead of a file. All methods write to and read from the image, which has the same
+     * content as a fst file. The memory-mapped read mode has no effect for memory images.
+     * \param memoryImage image to serialize a table into (fstWrite) or that contains a serialized table.
+     */
+    FstStore(std::shared_ptr<FstMemoryImage> memoryImage);
+
     ~FstStore() { }
 
 	/**
@@ -58,10 +171,144 @@ class FstStore
      */
     void fstWrite(IFstTable &fstTable, int compress) const;
 
+    /**
+     * \brief Append the rows of a data table to an existing fst file as a new data chunk
+     * \param fstTable Table to append, columns must have the same types (and order) as the columns in the file
+     * \param compress Compression factor with a value 0-100
+     */
+    void fstAppend(IFstTable &fstTable, int compress);
+
+    /**
+     * \brief Add columns to an existing fst file without rewriting it (cbind). The columns are stored in a new horizontal
+     * chunkset that is linked to the table, reads resolve column names over all chunksets. Rows appended later with
+     * fstAppend are added to all chunksets.
+     * \param fstTable Columns to add, with the same number of rows as the fst file
+     * \param compress Compression factor with a value 0-100
+     */
+    void fstAppendColumns(IFstTable &fstTable, int compress);
+
+    /**
+     * \brief Enable or disable the memory-mapped read mode (disabled by default). In this mode, fstRead maps the file
+     * into memory and uncompressed INT_32, DOUBLE_64, INT_64 and BYTE columns are handed to the column factory as views
+     * into the mapped file (see IColumnFactory::CreateIntegerColumnView), without copying the data. Views are only used
+     * for selections within a single data chunk, other columns are read as usual.
+     * \param enable true to use the memory-mapped read mode.
+     */
+    void SetMemoryMapped(bool enable) { memoryMapped = enable; }
+
+    /**
+     * \brief Set the size of the compression blocks used by fstWrite, fstAppend and fstAppendColumns (16 KB by default).
+     * Larger blocks compress better and have smaller block indexes, smaller blocks make reading a selection of rows
+     * (fstReadRows, fstReadFiltered) cheaper. The block size is recorded in the column data, so readers don't need to
+     * know it. Character columns and uncompressed INT_32, DOUBLE_64, INT_64 and BYTE columns always use the default
+     * blocks. Files with larger blocks can not be read by fstlib versions before 0.1.9.
+     * \param blockSize block size in bytes, a power of two between BLOCKSIZE and MAX_BLOCK_SIZE.
+     */
+    void SetBlockSize(unsigned int blockSize);
+
+    /**
+     * \brief Set the compression block size of a single column, overrides the size set with SetBlockSize.
+     * \param colNr index of the column in the tables that are written.
+     * \param blockSize block size in bytes, a power of two between BLOCKSIZE and MAX_BLOCK_SIZE.
+     */
+    void SetColumnBlockSize(int colNr, unsigned int blockSize);
+
+    /**
+     * \brief Store a double column as scaled integers with a fixed number of decimals. Compression blocks in which all
+     * values are exactly representable with that number of decimals are stored as delta or frame-of-reference
+     * bit-packed integers (DECIMAL_DOUBLE) when that is smaller, other blocks use the default codecs. With
+     * SetExtendedCodecs the decimals are detected for each block, setting them skips the detection. Files with scaled
+     * decimals can not be read by fstlib versions before 0.1.9.
+     * \param colNr index of the column in the tables that are written.
+     * \param decimals number of decimals, between 0 and DECIMAL_MAX_SCALE.
+     */
+    void SetColumnDecimals(int colNr, int decimals);
+
+    /**
+     * \brief Compress the character data of character columns with a ZSTD dictionary that is trained from a sample
+     * of the column's blocks (disabled by default). The dictionary is stored once per column in each data chunk and
+     * used for all of its blocks, which improves the compression of short and repetitive strings such as codes, URLs
+     * or JSON fragments. Only used for compressed columns with at least CHAR_DICT_MIN_BLOCKS blocks. Files with
+     * dictionaries can not be read by fstlib versions before 0.1.9.
+     * \param enable true to use dictionaries for character columns that are written next.
+     */
+    void SetCharacterDictionary(bool enable) { charDictionary = enable; }
+
+    /**
+     * \brief Allow codecs that are not part of the original fst format (disabled by default). Compression blocks of
+     * integer and int64 columns are stored with delta or frame-of-reference bit-packing and blocks of double columns
+     * with XOR encoding when that is smaller than the default compression, which is typically the case for sorted
+     * keys, timestamps and slowly varying series. Blocks of integer, int64, factor and logical columns with few runs
+     * of equal values are run-length encoded, predicates on those blocks are evaluated on the runs. Files with
+     * extended codecs can not be read by fstlib versions before 0.1.9.
+     * \param enable true to use the extended codecs for columns that are written next.
+     */
+    void SetExtendedCodecs(bool enable) { extendedCodecs = enable; }
+
+    /**
+     * \brief Select the codec of each compression block of integer, int64 and double columns from a compressed
+     * sample of the block (disabled by default). Incompressible blocks are stored uncompressed, highly compressible
+     * blocks with ZSTD and other blocks with LZ4, so mixed columns get the cheapest codec that is still effective.
+     * Higher compression levels move more blocks to ZSTD. Only existing codecs are used, so the resulting files can be
+     * read by all fstlib versions (unless extended codecs are also enabled).
+     * \param enable true to use adaptive compression for columns that are written next.
+     */
+    void SetAdaptiveCompression(bool enable) { adaptiveCompression = enable; }
+
+    /**
+     * \brief Favour decompression speed at high compression levels (disabled by default). Blocks of integer, int64
+     * and double columns that would be compressed with ZSTD are compressed with a high compression LZ4 encoder
+     * instead. The ratio is lower than with ZSTD, but the blocks decompress at LZ4 speed, which suits data that is
+     * written once and read many times. Writing is slower than with ZSTD. The blocks are regular LZ4 blocks, so the
+     * resulting files can be read by all fstlib versions.
+     * \param enable true to favour decompression speed for columns that are written next.
+     */
+    void SetFastDecompression(bool enable) { fastDecompression = enable; }
+
     void fstMeta(IColumnFactory* columnFactory, IStringColumn* col_names);
 
+    /**
+     * \brief Read the per-block statistics (minimum, maximum and NA count) of a column. Statistics are stored for
+     * INT_32, INT_64, DOUBLE_64, FACTOR and BOOL_2 columns.
+     * \param colNr index of the column in the file.
+     * \param chunkStatistics statistics of the column for each data chunk (output). Data chunks without statistics
+     * (for example written by a previous version of fstlib) have an entry without blocks.
+     */
+    void fstColumnStatistics(int colNr, std::vector<ColumnStatistics> &chunkStatistics);
+
     void fstRead(IFstTable &tableReader, IStringArray* columnSelection, int64_t startRow, int64_t endRow,
       IColumnFactory* columnFactory, std::vector<int> &keyIndex, IStringArray* selectedCols, IStringColumn* col_names);
+
+    /**
+     * \brief Read a selection of rows of a table. Only the blocks that contain selected rows are decompressed.
+     * \param tableReader result table.
+     * \param columnSelection names of the columns to read, nullptr for all columns.
+     * \param rows row numbers (one based, like 'startRow' in fstRead) sorted in increasing order. Rows can be
+     * selected more than once.
+     */
+    void fstReadRows(IFstTable &tableReader, IStringArray* columnSelection, const std::vector<int64_t> &rows,
+      IColumnFactory* columnFactory, std::vector<int> &keyIndex, IStringArray* selectedCols, IStringColumn* col_names);
+
+    /**
+     * \brief Read the rows of a table that satisfy all predicates. Predicates are evaluated data chunk by data chunk,
+     * blocks of the predicate columns are skipped (or accepted) using the column statistics where possible. The
+     * selected columns are only read for the rows that match.
+     * \param tableReader result table.
+     * \param columnSelection names of the columns to read, nullptr for all columns.
+     * \param predicates row filters on INT_32, INT_64, DOUBLE_64 or BOOL_2 columns, combined with a logical AND. The
+     * predicate columns don't have to be part of the column selection.
+     */
+    void fstReadFiltered(IFstTable &tableReader, IStringArray* columnSelection, const std::vector<FstPredicate> &predicates,
+      IColumnFactory* columnFactory, std::vector<int> &keyIndex, IStringArray* selectedCols, IStringColumn* col_names);
+
+    /**
+     * \brief Count the rows of a table that satisfy all predicates without reading any column data. Predicates are
+     * evaluated like in fstReadFiltered, so blocks are skipped or accepted using the column statistics and run-length
+     * encoded blocks are evaluated on their runs (see SetExtendedCodecs).
+     * \param predicates row filters on INT_32, INT_64, DOUBLE_64 or BOOL_2 columns, combined with a logical AND.
+     * \return number of matching rows.
+     */
+    long long fstCountFiltered(const std::vector<FstPredicate> &predicates, IStringColumn* col_names);
 };
 
 
@@ -0,0 +1,114 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#include <stdexcept>
+
+#include <interface/fstdefines.h>
+#include <interface/fststreamer.h>
+
+
+using namespace std;
+
+
+FstStreamer::FstStreamer(const std::string &fstFile, const int compress, const bool append) :
+  fstStore(fstFile), compress(compress)
+{
+  if (append) Open();
+}
+
+
+FstStreamer::~FstStreamer()
+{
+  if (!outfile) return;
+
+  try
+  {
+    Close();
+  }
+  catch (...)
+  {
+  }
+}
+
+
+// Read the metadata of the file and open it for update
+void FstStreamer::Open()
+{
+  fstStore.OpenAppend(lastIndexPos, lastIndexes);
+
+  sink = fstStore.OpenSink(false);
+  outfile = std::unique_ptr<ostream>(new ostream(sink->StreamBuffer()));
+  outfile->seekp(0, ios_base::end);
+}
+
+
+void FstStreamer::WriteBatch(IFstTable &batch)
+{
+  if (closed)
+  {
+    throw(runtime_error(FSTERROR_STREAM_CLOSED));
+  }
+
+  // the first batch creates the file
+  if (!outfile)
+  {
+    // the sort order of key columns can not be guaranteed over batches
+    if (batch.NrOfKeys() != 0)
+    {
+      throw(runtime_error(FSTERROR_APPEND_KEYED));
+    }
+
+    fstStore.fstWrite(batch, compress);
+    Open();
+
+    return;
+  }
+
+  fstStore.AppendRows(*outfile, batch, compress, lastIndexPos, lastIndexes.get());
+  fstStore.WriteChunksetHeaders(*outfile);
+}
+
+
+void FstStreamer::Close()
+{
+  if (closed) return;
+  closed = true;
+
+  if (!outfile)
+  {
+    throw(runtime_error(FSTERROR_NO_DATA));
+  }
+
+  const bool writeError = outfile->fail();
+  outfile.reset();
+
+  if (!sink->Close() || writeError)
+  {
+    sink.reset();
+    throw(runtime_error("There was an error during the write operation, fst file might be corrupted. Please check available disk space and access rights."));
+  }
+
+  sink.reset();
+}
+
+
+unsigned long long FstStreamer::NrOfRows() const
+{
+  // metadata is available once the file was opened
+  return lastIndexes ? *fstStore.p_nrOfRows : 0;
+}
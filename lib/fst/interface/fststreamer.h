@@ -19,27 +19,100 @@
 #ifndef FSTSTREAMER_H
 #define FSTSTREAMER_H
 
+#include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
+
+#include <interface/fststore.h>
 
 
 /**
- Interface to a fst file.
-*/
+ * \brief Streaming writer for tables that are larger than memory. Rows are written in batches, each batch is compressed
+ * and written as a new data chunk as soon as it is received, so memory use is bounded by the size of a single batch
+ * (plus the queue of the writer thread) whatever the total number of rows.
+ *
+ * The file stays open between batches and the row counts in the file header are updated after each batch, so the file
+ * can be read with FstStore or FstReader once the batch has been flushed. Each batch is a separate data chunk, so
+ * batches should not be too small (at least several compression blocks, e.g. 10000 rows or more) for good compression
+ * and read performance.
+ */
 class FstStreamer
 {
-  FstStreamer();
-
-  // Open connection to an existing fst file
-  int open(std::string filename, std::string mode);
-
-  int close();
-
-  FstMetaData metaData();
-
-  int cbindChunk(FstChunk chunk);
-
-  int rbindChunk(FstChunk chunk);
+  FstStore fstStore;
+  int compress;
+  bool closed = false;
+
+  std::unique_ptr<IFstSink> sink;
+  std::unique_ptr<std::ostream> outfile;
+
+  // last chunk index of each chunkset
+  std::vector<unsigned long long> lastIndexPos;
+  std::unique_ptr<char[]> lastIndexes;
+
+  void Open();
+
+public:
+  /**
+   * \brief Create a streaming writer.
+   * \param fstFile path of the fst file.
+   * \param compress compression factor in the range 0 - 100.
+   * \param append if true, batches are appended to an existing fst file (see FstStore::fstAppend). Otherwise the file
+   * is created by the first batch, which also determines the column names and types.
+   */
+  FstStreamer(const std::string &fstFile, int compress, bool append = false);
+
+  /**
+   * \brief Close the file if Close() was not called. Errors can only be detected with an explicit call to Close().
+   */
+  ~FstStreamer();
+
+  FstStreamer(const FstStreamer&) = delete;
+  FstStreamer& operator=(const FstStreamer&) = delete;
+
+  /**
+   * \brief Set the compression block size of the batches that are written next (see FstStore::SetBlockSize).
+   * \param blockSize block size in bytes, a power of two between BLOCKSIZE and MAX_BLOCK_SIZE.
+   */
+  void SetBlockSize(unsigned int blockSize) { fstStore.SetBlockSize(blockSize); }
+
+  /**
+   * \brief Compress the character columns of the batches that are written next with a dictionary (see
+   * FstStore::SetCharacterDictionary). Each batch trains its own dictionaries.
+   */
+  void SetCharacterDictionary(bool enable) { fstStore.SetCharacterDictionary(enable); }
+
+  /**
+   * \brief Use the extended codecs for the batches that are written next (see FstStore::SetExtendedCodecs).
+   */
+  void SetExtendedCodecs(bool enable) { fstStore.SetExtendedCodecs(enable); }
+
+  /**
+   * \brief Use adaptive compression for the batches that are written next (see FstStore::SetAdaptiveCompression).
+   */
+  void SetAdaptiveCompression(bool enable) { fstStore.SetAdaptiveCompression(enable); }
+
+  /**
+   * \brief Favour decompression speed for the batches that are written next (see FstStore::SetFastDecompression).
+   */
+  void SetFastDecompression(bool enable) { fstStore.SetFastDecompression(enable); }
+
+  /**
+   * \brief Write a batch of rows. Batches after the first should have the same column types (and order).
+   * \param batch rows to write, the table is not used after the call returns.
+   */
+  void WriteBatch(IFstTable &batch);
+
+  /**
+   * \brief Write all pending data and close the file.
+   */
+  void Close();
+
+  /**
+   * \brief Total number of rows in the file.
+   */
+  unsigned long long NrOfRows() const;
 };
 
 
-#endif FSTSTREAMER_H
+#endif  // FSTSTREAMER_H
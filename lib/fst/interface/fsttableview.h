@@ -0,0 +1,162 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#ifndef FST_TABLE_VIEW_H
+#define FST_TABLE_VIEW_H
+
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <interface/ifsttable.h>
+#include <interface/fstdefines.h>
+
+
+/**
+ * \brief String writer for a range of rows of a string column.
+ */
+class StringWriterView : public IStringWriter
+{
+  std::unique_ptr<IStringWriter> stringWriter;
+  uint64_t firstRow;
+
+public:
+  StringWriterView(IStringWriter* stringWriter, uint64_t firstRow, uint64_t nrOfRows) :
+    stringWriter(stringWriter), firstRow(firstRow)
+  {
+    vecLength = nrOfRows;
+  }
+
+  StringEncoding Encoding() { return stringWriter->Encoding(); }
+
+  void SetBuffersFromVec(uint64_t startCount, uint64_t endCount)
+  {
+    stringWriter->SetBuffersFromVec(firstRow + startCount, firstRow + endCount);
+
+    strSizes  = stringWriter->strSizes;
+    naInts    = stringWriter->naInts;
+    bufSize   = stringWriter->bufSize;
+    activeBuf = stringWriter->activeBuf;
+  }
+};
+
+
+/**
+ * \brief Byte block writer for a range of rows of a byte block column.
+ */
+class ByteBlockView : public IByteBlockColumn
+{
+  IByteBlockColumn* byteBlock;
+  uint64_t firstRow;
+
+public:
+  ByteBlockView(IByteBlockColumn* byteBlock, uint64_t firstRow, uint64_t nrOfRows) :
+    byteBlock(byteBlock), firstRow(firstRow)
+  {
+    vecLength = nrOfRows;
+  }
+
+  void SetSizesAndPointers(const char** elements, uint64_t* sizes, uint64_t row_start, uint64_t block_size)
+  {
+    byteBlock->SetSizesAndPointers(elements, sizes, firstRow + row_start, block_size);
+  }
+};
+
+
+/**
+ * \brief Writer interface to a rectangular part (a range of columns and rows) of a table, used to store the columns
+ * of a table in multiple chunksets and the rows in multiple data chunks. Key columns and column names are not part of
+ * the view and the reader interface is not available.
+ */
+class FstTableView : public IFstTable
+{
+  IFstTable* fstTable;
+  uint32_t firstCol, nrOfCols;
+  uint64_t firstRow, nrOfRows;
+  std::vector<std::unique_ptr<ByteBlockView>> byteBlockViews;
+
+public:
+  FstTableView(IFstTable* fstTable, uint32_t firstCol, uint32_t nrOfCols, uint64_t firstRow, uint64_t nrOfRows) :
+    fstTable(fstTable), firstCol(firstCol), nrOfCols(nrOfCols), firstRow(firstRow), nrOfRows(nrOfRows) { }
+
+  FstColumnType ColumnType(uint32_t colNr, FstColumnAttribute &columnAttribute, short int &scale, std::string &annotation,
+    bool &hasAnnotation)
+  {
+    return fstTable->ColumnType(firstCol + colNr, columnAttribute, scale, annotation, hasAnnotation);
+  }
+
+  IStringWriter* GetStringWriter(uint32_t colNr)
+  {
+    return new StringWriterView(fstTable->GetStringWriter(firstCol + colNr), firstRow, nrOfRows);
+  }
+
+  int* GetLogicalWriter(uint32_t colNr) { return &fstTable->GetLogicalWriter(firstCol + colNr)[firstRow]; }
+
+  int* GetIntWriter(uint32_t colNr) { return &fstTable->GetIntWriter(firstCol + colNr)[firstRow]; }
+
+  long long* GetInt64Writer(uint32_t colNr) { return &fstTable->GetInt64Writer(firstCol + colNr)[firstRow]; }
+
+  char* GetByteWriter(uint32_t colNr) { return &fstTable->GetByteWriter(firstCol + colNr)[firstRow]; }
+
+  double* GetDoubleWriter(uint32_t colNr) { return &fstTable->GetDoubleWriter(firstCol + colNr)[firstRow]; }
+
+  IByteBlockColumn* GetByteBlockWriter(uint32_t col_nr)
+  {
+    byteBlockViews.emplace_back(new ByteBlockView(fstTable->GetByteBlockWriter(firstCol + col_nr), firstRow, nrOfRows));
+    return byteBlockViews.back().get();
+  }
+
+  // factor levels are shared by all rows
+  IStringWriter* GetLevelWriter(uint32_t colNr) { return fstTable->GetLevelWriter(firstCol + colNr); }
+
+  IStringWriter* GetColNameWriter() { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void GetKeyColumns(int*) { }
+
+  uint32_t NrOfKeys() { return 0; }
+
+  uint32_t NrOfColumns() { return nrOfCols; }
+
+  uint64_t NrOfRows() { return nrOfRows; }
+
+  void InitTable(uint32_t, uint64_t) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  IByteBlockColumn* add_byte_block_column(unsigned) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void SetStringColumn(IStringColumn*, int) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void SetLogicalColumn(ILogicalColumn*, int) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void SetIntegerColumn(IIntegerColumn*, int) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void SetDoubleColumn(IDoubleColumn*, int) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void SetFactorColumn(IFactorColumn*, int) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void SetInt64Column(IInt64Column*, int) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void SetByteColumn(IByteColumn*, int) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void SetColNames(IStringArray*) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+
+  void SetKeyColumns(int*, uint32_t) { throw(std::runtime_error(FSTERROR_NOT_IMPLEMENTED)); }
+};
+
+
+#endif  // FST_TABLE_VIEW_H
@@ -20,6 +20,8 @@
 #define IFST_COLUMN_FACTORY_H
 
 
+#include <memory>
+
 #include "ifstcolumn.h"
 
 class IColumnFactory
@@ -34,6 +36,22 @@ public:
   virtual IInt64Column* CreateInt64Column(uint64_t nrOfRows, FstColumnAttribute columnAttribute, short int scale) = 0;
   virtual IStringColumn* CreateStringColumn(uint64_t nrOfRows, FstColumnAttribute columnAttribute) = 0;
   virtual IStringArray* CreateStringArray() = 0;
+
+  // Column views are used in the memory-mapped read mode of uncompressed columns. A view uses 'data' directly
+  // instead of allocating a new vector and holds a copy of 'dataOwner' to keep the memory mapping alive.
+  // The default implementations return nullptr, in which case the data is copied into a regular column.
+
+  virtual IIntegerColumn* CreateIntegerColumnView(uint64_t /*nrOfRows*/, FstColumnAttribute /*columnAttribute*/,
+    short int /*scale*/, int* /*data*/, std::shared_ptr<void> /*dataOwner*/) { return nullptr; }
+
+  virtual IDoubleColumn* CreateDoubleColumnView(uint64_t /*nrOfRows*/, FstColumnAttribute /*columnAttribute*/,
+    short int /*scale*/, double* /*data*/, std::shared_ptr<void> /*dataOwner*/) { return nullptr; }
+
+  virtual IInt64Column* CreateInt64ColumnView(uint64_t /*nrOfRows*/, FstColumnAttribute /*columnAttribute*/,
+    short int /*scale*/, long long* /*data*/, std::shared_ptr<void> /*dataOwner*/) { return nullptr; }
+
+  virtual IByteColumn* CreateByteColumnView(uint64_t /*nrOfRows*/, FstColumnAttribute /*columnAttribute*/,
+    char* /*data*/, std::shared_ptr<void> /*dataOwner*/) { return nullptr; }
 };
 
 #endif // IFST_COLUMN_FACTORY_H
@@ -0,0 +1,55 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#ifndef IFST_SINK_H
+#define IFST_SINK_H
+
+#include <streambuf>
+
+
+/**
+ * \brief Destination of a serialized fst table, such as a fst file (PipelinedWriter) or a growing block of memory
+ * (MemorySink). Data is written through a seekable stream buffer, previously written data can be overwritten (to patch
+ * headers and indexes). Use with a std::ostream:
+ *
+ *   std::ostream myfile(sink->StreamBuffer());
+ */
+class IFstSink
+{
+public:
+  virtual ~IFstSink() {}
+
+  /**
+   * \brief Check if the sink was opened successfully.
+   */
+  virtual bool IsOpen() const = 0;
+
+  /**
+   * \brief Stream buffer to write the data to.
+   */
+  virtual std::streambuf* StreamBuffer() = 0;
+
+  /**
+   * \brief Write all pending data and close the sink.
+   * \return false if any of the write operations failed.
+   */
+  virtual bool Close() = 0;
+};
+
+
+#endif  // IFST_SINK_H
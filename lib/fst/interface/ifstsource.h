@@ -0,0 +1,54 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#ifndef IFST_SOURCE_H
+#define IFST_SOURCE_H
+
+
+/**
+ * \brief Random access source of a serialized fst table, such as a fst file (PositionalReader) or a contiguous block of
+ * memory (MemorySource). Data is read at absolute offsets, there is no shared read position, so implementations
+ * must allow concurrent reads from multiple threads.
+ */
+class IFstSource
+{
+public:
+  virtual ~IFstSource() {}
+
+  /**
+   * \brief Check if the source was opened successfully.
+   */
+  virtual bool IsOpen() const = 0;
+
+  /**
+   * \brief Total size of the source in bytes.
+   */
+  virtual unsigned long long Size() const = 0;
+
+  /**
+   * \brief Read a range of bytes from the source. This method is thread-safe.
+   * \param buf buffer to read the data into, must have room for at least 'size' bytes.
+   * \param size number of bytes to read.
+   * \param pos offset of the first byte to read.
+   * \return true if all requested bytes were read, false otherwise.
+   */
+  virtual bool Read(char* buf, unsigned long long size, unsigned long long pos) const = 0;
+};
+
+
+#endif  // IFST_SOURCE_H
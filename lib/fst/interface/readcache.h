@@ -0,0 +1,60 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+
+#ifndef READ_CACHE_H
+#define READ_CACHE_H
+
+
+#include <memory>
+#include <vector>
+
+#include <blockstreamer/blockstreamer_v2.h>
+#include <blockstreamer/positionalreader.h>
+#include <blockstreamer/memorymappedfile.h>
+#include <interface/columnnameindex.h>
+
+
+/**
+ * \brief File resources and table metadata used by a read. FstStore creates a cache for each read, a FstReader keeps
+ * a single instance (including the verified data chunk headers) for all its reads.
+ */
+struct ReadCache
+{
+  std::vector<unsigned long long> chunkPos;   // data chunk header positions of the primary chunkset
+  std::vector<unsigned long long> chunkRows;  // number of rows in each data chunk
+
+  // data chunk header positions of each additional (horizontal) chunkset, data chunks of all chunksets have the same
+  // number of rows as the data chunks of the primary chunkset
+  std::vector<std::vector<unsigned long long>> horzChunkPos;
+
+  std::unique_ptr<IFstSource> source;                 // positional reads of column data
+  std::shared_ptr<MemoryMappedFile> mappedFile;       // memory-mapped file that is reused by all reads, or nullptr
+  std::vector<std::unique_ptr<char[]>> chunkHeaders;  // verified data chunk headers of each chunkset in chunk order, or empty
+  ColumnNameIndex columnIndex;                        // only built when column names have to be resolved
+  std::unique_ptr<ColumnMetaCache> columnMeta;        // headers and block indexes of the columns read before, or nullptr
+
+  unsigned long long NrOfRows() const
+  {
+    unsigned long long nrOfRows = 0;
+    for (unsigned long long rows : chunkRows) nrOfRows += rows;
+    return nrOfRows;
+  }
+};
+
+
+#endif  // READ_CACHE_H
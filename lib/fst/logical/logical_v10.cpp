@@ -19,27 +19,33 @@
 #include <blockstreamer/blockstreamer_v2.h>
 #include <compression/compressor.h>
 
-#define BLOCKSIZE_LOGICAL 4096  // number of logicals in default compression block
-
 
 using namespace std;
 
 
 // Logical vectors are always compressed to fill all available bits (factor 16 compression).
 // On top of that, we can compress the resulting bytes with a custom compressor.
-void fdsWriteLogicalVec_v10(ofstream &myfile, int* boolVector, unsigned long long nrOfLogicals, int compression,
-  std::string annotation, bool hasAnnotation)
+void fdsWriteLogicalVec_v10(ostream &myfile, int* boolVector, unsigned long long nrOfLogicals, int compression,
+  std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics, unsigned int blockSize, bool extendedCodecs)
 {
-  const int blockSize = 4 * BLOCKSIZE_LOGICAL;  // block size in bytes
+  const int blockSizeElems = blockSize / 4;  // number of elements in a compression block
 
   if (compression <= 50)  // compress 1 - 50
   {
     Compressor* defaultCompress = new SingleCompressor(CompAlgo::LOGIC64, 0);  // compression not relevant here
     Compressor* compress2 = new SingleCompressor(CompAlgo::LZ4_LOGIC64, 100);  // use maximum compression for LZ4 algorithm
+
+    if (extendedCodecs)  // run-length encoding and bit-packing compete with both algorithms
+    {
+      defaultCompress = new IntegerPackCompressor(defaultCompress, false);
+      compress2 = new IntegerPackCompressor(compress2, false);
+    }
+
     StreamCompressor* streamCompressor = new StreamCompositeCompressor(defaultCompress, compress2, 2.0F * compression);
     streamCompressor->CompressBufferSize(blockSize);
 
-    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(boolVector), nrOfLogicals, 4, streamCompressor, BLOCKSIZE_LOGICAL, annotation, hasAnnotation);
+    fdsStreamcompressed_v2(myfile, reinterpret_cast<char*>(boolVector), nrOfLogicals, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
     delete defaultCompress;
     delete compress2;
@@ -51,9 +57,16 @@ void fdsWriteLogicalVec_v10(ofstream &myfile, int* boolVector, unsigned long lon
   {
     Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_LOGIC64, 100);
     Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD_LOGIC64, 2 * (compression - 50));
+
+    if (extendedCodecs)  // run-length encoding and bit-packing compete with both algorithms
+    {
+      compress1 = new IntegerPackCompressor(compress1, false);
+      compress2 = new IntegerPackCompressor(compress2, false);
+    }
+
     StreamCompressor* streamCompressor = new StreamCompositeCompressor(compress1, compress2, 2.0F * (compression - 50));
     streamCompressor->CompressBufferSize(blockSize);
-    fdsStreamcompressed_v2(myfile, (char*) boolVector, nrOfLogicals, 4, streamCompressor, BLOCKSIZE_LOGICAL, annotation, hasAnnotation);
+    fdsStreamcompressed_v2(myfile, (char*) boolVector, nrOfLogicals, 4, streamCompressor, blockSizeElems, annotation, hasAnnotation, columnStatistics);
 
     delete compress1;
     delete compress2;
@@ -65,10 +78,11 @@ void fdsWriteLogicalVec_v10(ofstream &myfile, int* boolVector, unsigned long lon
 
 
 void fdsReadLogicalVec_v10(istream &myfile, int* boolVector, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size)
+  unsigned long long length, unsigned long long size, const IFstSource* positionalReader, ColumnMetaCache* metaCache)
 {
   std::string annotation;
   bool hasAnnotation;
 
-  return fdsReadColumn_v2(myfile, (char*) boolVector, blockPos, startRow, length, size, 4, annotation, BATCH_SIZE_READ_LOGICAL, hasAnnotation);
+  return fdsReadColumn_v2(myfile, (char*) boolVector, blockPos, startRow, length, size, 4, annotation, BATCH_SIZE_READ_LOGICAL,
+    hasAnnotation, positionalReader, metaCache);
 }
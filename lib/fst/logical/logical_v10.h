@@ -22,14 +22,25 @@
 #include <istream>
 #include <ostream>
 
+#include <interface/fstdefines.h>
+
 
 // Logical vectors are always compressed to fill all available bits (factor 16 compression).
 // On top of that, we can compress the resulting bytes with a custom compressor.
-void fdsWriteLogicalVec_v10(std::ofstream &myfile, int* boolVector, unsigned long long nrOfLogicals, int compression,
-  std::string annotation, bool hasAnnotation);
+class IFstSource;
+class ColumnMetaCache;
+class ColumnStatistics;
+
+
+// Parameter 'extendedCodecs' allows the compressed blocks to be stored with RLE_INT run-length encoding or
+// with bit-packing.
+void fdsWriteLogicalVec_v10(std::ostream &myfile, int* boolVector, unsigned long long nrOfLogicals, int compression,
+  std::string annotation, bool hasAnnotation,
+  ColumnStatistics* columnStatistics = nullptr, unsigned int blockSize = BLOCKSIZE, bool extendedCodecs = false);
 
 
 void fdsReadLogicalVec_v10(std::istream &myfile, int* boolVector, unsigned long long blockPos, unsigned long long startRow,
-  unsigned long long length, unsigned long long size);
+  unsigned long long length, unsigned long long size, const IFstSource* positionalReader = nullptr,
+  ColumnMetaCache* metaCache = nullptr);
 
 #endif // LOGICAL_v10_H
@@ -0,0 +1,252 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include <interface/fstdefines.h>
+#include <blockstreamer/positionalreader.h>
+#include <statistics/columnstatistics.h>
+
+#include <xxhash.h>
+
+
+using namespace std;
+
+
+#define STATISTICS_HEADER_SIZE        24  // size of statistics header without column positions
+#define COLUMN_STATISTICS_HEADER_SIZE 24  // size of column statistics header
+
+
+static_assert(sizeof(BlockStatistics) == 24, "Block statistics are serialized as 24 bytes");
+
+
+// Integer statistics. The NA value is the smallest value of the type, so it never determines the maximum unless
+// all values are NA. The loop has no branches to allow for auto-vectorization.
+template<typename T>
+inline void IntegerBlockStatistics(const T* values, unsigned int nrOfElements, BlockStatistics &stats)
+{
+  const T naValue = numeric_limits<T>::min();
+  T minValue = numeric_limits<T>::max();
+  T maxValue = numeric_limits<T>::min();
+  unsigned long long naCount = 0;
+
+  for (unsigned int pos = 0; pos < nrOfElements; ++pos)
+  {
+    const T value = values[pos];
+    naCount += value == naValue;
+    minValue = min(minValue, value == naValue ? numeric_limits<T>::max() : value);
+    maxValue = max(maxValue, value);
+  }
+
+  stats.naCount = naCount;
+
+  // all values NA: minimum larger than maximum
+  if (naCount == nrOfElements)
+  {
+    stats.min.int64 = numeric_limits<long long>::max();
+    stats.max.int64 = numeric_limits<long long>::min();
+    return;
+  }
+
+  stats.min.int64 = minValue;
+  stats.max.int64 = maxValue;
+}
+
+
+// Double statistics, all NaN values (including NA) are ignored as comparisons with NaN are false
+inline void DoubleBlockStatistics(const double* values, unsigned int nrOfElements, BlockStatistics &stats)
+{
+  double minValue = numeric_limits<double>::infinity();
+  double maxValue = -numeric_limits<double>::infinity();
+  unsigned long long naCount = 0;
+
+  for (unsigned int pos = 0; pos < nrOfElements; ++pos)
+  {
+    const double value = values[pos];
+    naCount += value != value;
+    minValue = value < minValue ? value : minValue;
+    maxValue = value > maxValue ? value : maxValue;
+  }
+
+  stats.naCount = naCount;
+  stats.min.real = minValue;
+  stats.max.real = maxValue;
+}
+
+
+void ColumnStatistics::Allocate(unsigned long long nrOfRows, unsigned int blockSizeElems)
+{
+  if (type == StatisticsType::NONE) return;
+
+  this->blockSizeElems = blockSizeElems;
+  blocks.resize((nrOfRows + blockSizeElems - 1) / blockSizeElems);
+}
+
+
+void ColumnStatistics::CalculateBlock(const char* blockData, unsigned long long block, unsigned int nrOfElements)
+{
+  BlockStatistics &stats = blocks[block];
+
+  switch (type)
+  {
+    case StatisticsType::INT_32:
+      IntegerBlockStatistics(reinterpret_cast<const int*>(blockData), nrOfElements, stats);
+      break;
+
+    case StatisticsType::INT_64:
+      IntegerBlockStatistics(reinterpret_cast<const long long*>(blockData), nrOfElements, stats);
+      break;
+
+    case StatisticsType::DOUBLE_64:
+      DoubleBlockStatistics(reinterpret_cast<const double*>(blockData), nrOfElements, stats);
+      break;
+
+    default:
+      break;
+  }
+}
+
+
+void ColumnStatistics::Write(ostream &myfile) const
+{
+  const unsigned long long nrOfBlocks = blocks.size();
+  const unsigned long long statsSize = COLUMN_STATISTICS_HEADER_SIZE + sizeof(BlockStatistics) * nrOfBlocks;
+
+  std::unique_ptr<char[]> statsP(new char[statsSize]);
+  char* stats = statsP.get();
+
+  unsigned long long* p_statsHash      = reinterpret_cast<unsigned long long*>(stats);
+  unsigned int* p_statsType            = reinterpret_cast<unsigned int*>(&stats[8]);
+  unsigned int* p_blockSizeElems       = reinterpret_cast<unsigned int*>(&stats[12]);
+  unsigned long long* p_nrOfBlocks     = reinterpret_cast<unsigned long long*>(&stats[16]);
+
+  *p_statsType = static_cast<unsigned int>(type);
+  *p_blockSizeElems = blockSizeElems;
+  *p_nrOfBlocks = nrOfBlocks;
+  memcpy(&stats[COLUMN_STATISTICS_HEADER_SIZE], blocks.data(), sizeof(BlockStatistics) * nrOfBlocks);
+
+  *p_statsHash = ZSTD_XXH64(&stats[8], statsSize - 8, FST_HASH_SEED);
+
+  myfile.write(stats, statsSize);
+}
+
+
+void ColumnStatistics::Read(istream &myfile, const IFstSource* positionalReader, unsigned long long pos)
+{
+  char header[COLUMN_STATISTICS_HEADER_SIZE];
+  ReadAt(myfile, positionalReader, header, COLUMN_STATISTICS_HEADER_SIZE, pos);
+
+  const unsigned int statsType = *reinterpret_cast<unsigned int*>(&header[8]);
+  const unsigned int blockSize = *reinterpret_cast<unsigned int*>(&header[12]);
+  const unsigned long long nrOfBlocks = *reinterpret_cast<unsigned long long*>(&header[16]);
+
+  if (!myfile || statsType == 0 || statsType > static_cast<unsigned int>(StatisticsType::DOUBLE_64) || blockSize == 0 ||
+    nrOfBlocks > 0xffffffffULL)
+  {
+    throw(runtime_error(FSTERROR_DAMAGED_STATISTICS));
+  }
+
+  const unsigned long long statsSize = COLUMN_STATISTICS_HEADER_SIZE + sizeof(BlockStatistics) * nrOfBlocks;
+  std::unique_ptr<char[]> statsP(new char[statsSize]);
+  char* stats = statsP.get();
+
+  memcpy(stats, header, COLUMN_STATISTICS_HEADER_SIZE);
+  ReadAt(myfile, positionalReader, &stats[COLUMN_STATISTICS_HEADER_SIZE], statsSize - COLUMN_STATISTICS_HEADER_SIZE,
+    pos + COLUMN_STATISTICS_HEADER_SIZE);
+
+  if (!myfile || *reinterpret_cast<unsigned long long*>(stats) != ZSTD_XXH64(&stats[8], statsSize - 8, FST_HASH_SEED))
+  {
+    throw(runtime_error(FSTERROR_DAMAGED_STATISTICS));
+  }
+
+  type = static_cast<StatisticsType>(statsType);
+  blockSizeElems = blockSize;
+  blocks.resize(nrOfBlocks);
+  memcpy(blocks.data(), &stats[COLUMN_STATISTICS_HEADER_SIZE], sizeof(BlockStatistics) * nrOfBlocks);
+}
+
+
+unsigned long long fdsWriteStatistics(ostream &myfile, const ColumnStatistics* columnStatistics, const int nrOfCols)
+{
+  const unsigned long long headerSize = STATISTICS_HEADER_SIZE + 8 * nrOfCols;
+  const unsigned long long statisticsPos = myfile.tellp();
+
+  std::unique_ptr<char[]> headerP(new char[headerSize]);
+  char* header = headerP.get();
+  memset(header, 0, headerSize);
+
+  unsigned long long* p_headerHash     = reinterpret_cast<unsigned long long*>(header);
+  unsigned int* p_headerVersion        = reinterpret_cast<unsigned int*>(&header[8]);
+  unsigned long long* columnStatsPos   = reinterpret_cast<unsigned long long*>(&header[STATISTICS_HEADER_SIZE]);
+
+  *p_headerVersion = FST_VERSION;
+
+  // column statistics directly follow the header
+  unsigned long long pos = statisticsPos + headerSize;
+  bool hasStatistics = false;
+
+  for (int colNr = 0; colNr < nrOfCols; ++colNr)
+  {
+    const unsigned long long nrOfBlocks = columnStatistics[colNr].NrOfBlocks();
+    if (nrOfBlocks == 0) continue;
+
+    columnStatsPos[colNr] = pos;
+    pos += COLUMN_STATISTICS_HEADER_SIZE + sizeof(BlockStatistics) * nrOfBlocks;
+    hasStatistics = true;
+  }
+
+  if (!hasStatistics) return 0;
+
+  *p_headerHash = ZSTD_XXH64(&header[8], headerSize - 8, FST_HASH_SEED);
+  myfile.write(header, headerSize);
+
+  for (int colNr = 0; colNr < nrOfCols; ++colNr)
+  {
+    if (columnStatsPos[colNr] != 0) columnStatistics[colNr].Write(myfile);
+  }
+
+  return statisticsPos;
+}
+
+
+void fdsReadStatistics(istream &myfile, const IFstSource* positionalReader, const unsigned long long statisticsPos,
+  const int colNr, const int nrOfCols, ColumnStatistics &columnStatistics)
+{
+  columnStatistics = ColumnStatistics();
+
+  if (statisticsPos == 0) return;
+
+  const unsigned long long headerSize = STATISTICS_HEADER_SIZE + 8 * nrOfCols;
+  std::unique_ptr<char[]> headerP(new char[headerSize]);
+  char* header = headerP.get();
+
+  ReadAt(myfile, positionalReader, header, headerSize, statisticsPos);
+
+  if (!myfile || *reinterpret_cast<unsigned long long*>(header) != ZSTD_XXH64(&header[8], headerSize - 8, FST_HASH_SEED))
+  {
+    throw(runtime_error(FSTERROR_DAMAGED_STATISTICS));
+  }
+
+  const unsigned long long columnStatsPos = reinterpret_cast<unsigned long long*>(&header[STATISTICS_HEADER_SIZE])[colNr];
+
+  if (columnStatsPos == 0) return;
+
+  columnStatistics.Read(myfile, positionalReader, columnStatsPos);
+}
@@ -0,0 +1,162 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef COLUMN_STATISTICS_H
+#define COLUMN_STATISTICS_H
+
+#include <ostream>
+#include <istream>
+#include <vector>
+
+
+class IFstSource;
+
+
+// Statistics header [leaf of E] [size: 24 + 8 * nrOfCols]
+//
+//  8                      | unsigned long long | hash value         // hash of statistics header
+//  4                      | unsigned int       | FST_VERSION
+//  4                      | int                | statistics flags
+//  8                      |                    | free bytes         // possible future use
+//  8 * nrOfCols           | unsigned long long | columnStatsPos     // column statistics positions (0 if absent)
+//
+// The statistics header is referenced from the data chunk header (statisticsPos, 0 if absent).
+
+// Column statistics [leaf of statistics header] [size: 24 + 24 * nrOfBlocks]
+//
+//  8                      | unsigned long long | hash value         // hash of column statistics
+//  4                      | unsigned int       | statistics type    // see StatisticsType
+//  4                      | unsigned int       | blockSizeElems     // number of elements per block
+//  8                      | unsigned long long | nrOfBlocks         // number of blocks
+//  24 * nrOfBlocks        | BlockStatistics    | block statistics   // minimum, maximum and NA count per block
+
+
+/**
+ * \brief Type of the minimum and maximum values in the statistics of a column.
+ */
+enum class StatisticsType : unsigned int
+{
+  NONE = 0,       // no statistics available
+  INT_32,         // 32 bit integers stored as 64 bit values, NA is FST_NA_INT (INT_32, FACTOR and BOOL_2 columns)
+  INT_64,         // 64 bit integers, NA is the minimum 64 bit value
+  DOUBLE_64       // doubles, NA is any NaN value
+};
+
+
+union StatisticsValue
+{
+  long long int64;
+  double real;
+};
+
+
+/**
+ * \brief Statistics of a single block of column values. NA values are not used for the minimum and maximum,
+ * when all values of the block are NA, the minimum is larger than the maximum.
+ */
+struct BlockStatistics
+{
+  StatisticsValue min;
+  StatisticsValue max;
+  unsigned long long naCount;
+};
+
+
+/**
+ * \brief Per-block statistics (zone map) of a single column in a single data chunk. The blocks coincide with the
+ * compression blocks of the column, so a reader can determine which blocks can be skipped without decompressing
+ * them.
+ */
+class ColumnStatistics
+{
+  StatisticsType type;
+  unsigned int blockSizeElems = 0;
+  std::vector<BlockStatistics> blocks;
+
+public:
+  /**
+   * \brief Create (empty) statistics for a column.
+   * \param type type of the column values, no statistics are calculated for StatisticsType::NONE.
+   */
+  explicit ColumnStatistics(StatisticsType type = StatisticsType::NONE) : type(type) { }
+
+  /**
+   * \brief Allocate the block statistics of a column. Called by the block streamer before compression starts.
+   * \param nrOfRows number of elements in the column.
+   * \param blockSizeElems number of elements per block (the last block may be smaller).
+   */
+  void Allocate(unsigned long long nrOfRows, unsigned int blockSizeElems);
+
+  /**
+   * \brief Calculate the statistics of a single block. Different blocks can be calculated concurrently.
+   * \param blockData pointer to the first element of the block.
+   * \param block block number.
+   * \param nrOfElements number of elements in the block.
+   */
+  void CalculateBlock(const char* blockData, unsigned long long block, unsigned int nrOfElements);
+
+  StatisticsType Type() const { return type; }
+
+  unsigned int BlockSizeElems() const { return blockSizeElems; }
+
+  /**
+   * \brief Number of blocks with statistics, zero if no statistics are available.
+   */
+  unsigned long long NrOfBlocks() const { return type == StatisticsType::NONE ? 0 : blocks.size(); }
+
+  const BlockStatistics& Block(unsigned long long block) const { return blocks[block]; }
+
+  /**
+   * \brief Serialize the column statistics.
+   * \param myfile stream to write the statistics to.
+   */
+  void Write(std::ostream &myfile) const;
+
+  /**
+   * \brief Read column statistics that were written with Write(). Throws if the statistics are damaged.
+   * \param myfile stream used when no positional reader is available.
+   * \param positionalReader positional reader or nullptr.
+   * \param pos file position of the column statistics.
+   */
+  void Read(std::istream &myfile, const IFstSource* positionalReader, unsigned long long pos);
+};
+
+
+/**
+ * \brief Write the statistics header and the statistics of all columns of a data chunk.
+ * \param myfile stream to write to, positioned at the end of the column data.
+ * \param columnStatistics statistics of each column.
+ * \param nrOfCols number of columns in the data chunk.
+ * \return file position of the statistics header or 0 if none of the columns has statistics (nothing is written).
+ */
+unsigned long long fdsWriteStatistics(std::ostream &myfile, const ColumnStatistics* columnStatistics, int nrOfCols);
+
+
+/**
+ * \brief Read the statistics of a single column of a data chunk.
+ * \param myfile stream used when no positional reader is available.
+ * \param positionalReader positional reader or nullptr.
+ * \param statisticsPos file position of the statistics header (from the data chunk header).
+ * \param colNr column number.
+ * \param nrOfCols number of columns in the data chunk.
+ * \param columnStatistics column statistics (output), of type StatisticsType::NONE when not available.
+ */
+void fdsReadStatistics(std::istream &myfile, const IFstSource* positionalReader, unsigned long long statisticsPos,
+  int colNr, int nrOfCols, ColumnStatistics &columnStatistics);
+
+
+#endif  // COLUMN_STATISTICS_H
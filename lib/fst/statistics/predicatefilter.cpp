@@ -0,0 +1,423 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include <interface/fstdefines.h>
+#include <blockstreamer/blockstreamer_v2.h>
+#include <compression/runlength.h>
+#include <statistics/predicatefilter.h>
+
+
+using namespace std;
+
+
+// Convert a real value to the integer domain [minValue, maxValue]
+inline long long ClampToInteger(double value, long long minValue, long long maxValue)
+{
+  if (value <= static_cast<double>(minValue)) return minValue;
+  if (value >= static_cast<double>(maxValue)) return maxValue;
+  return static_cast<long long>(value);
+}
+
+
+PredicateFilter::PredicateFilter(const FstPredicate &predicate, StatisticsType columnType) :
+  type(predicate.type), columnType(columnType)
+{
+  // an equality is a range with a single value
+  if (type == FstPredicateType::EQUAL) type = FstPredicateType::RANGE;
+
+  vector<long long> intSource = predicate.intValues;
+  vector<double> realSource = predicate.realValues;
+
+  if (predicate.type == FstPredicateType::EQUAL)
+  {
+    if (predicate.isReal) realSource.push_back(realSource[0]);
+    else intSource.push_back(intSource[0]);
+  }
+
+  // a range requires a lower and upper bound
+  if (type == FstPredicateType::RANGE && (predicate.isReal ? realSource.size() : intSource.size()) != 2)
+  {
+    empty = true;
+    return;
+  }
+
+  if (columnType == StatisticsType::DOUBLE_64)
+  {
+    if (!predicate.isReal)
+    {
+      for (long long value : intSource) realSource.push_back(static_cast<double>(value));
+    }
+
+    if (type == FstPredicateType::RANGE)
+    {
+      realLower = realSource[0];
+      realUpper = realSource[1];
+      empty = !(realLower <= realUpper);  // also true for NaN bounds
+      return;
+    }
+
+    for (double value : realSource)
+    {
+      if (!std::isnan(value)) realValues.push_back(value);
+    }
+
+    sort(realValues.begin(), realValues.end());
+    realValues.erase(unique(realValues.begin(), realValues.end()), realValues.end());
+    empty = realValues.empty();
+
+    return;
+  }
+
+  // Integer columns, the smallest value of the type is used for NA
+  const long long minValue = columnType == StatisticsType::INT_32 ? static_cast<long long>(numeric_limits<int>::min()) + 1 :
+    numeric_limits<long long>::min() + 1;
+  const long long maxValue = columnType == StatisticsType::INT_32 ? static_cast<long long>(numeric_limits<int>::max()) :
+    numeric_limits<long long>::max();
+
+  if (type == FstPredicateType::RANGE)
+  {
+    if (predicate.isReal)
+    {
+      const double lower = ceil(realSource[0]);
+      const double upper = floor(realSource[1]);
+
+      if (!(lower <= upper) || lower > static_cast<double>(maxValue) || upper < static_cast<double>(minValue))
+      {
+        empty = true;
+        return;
+      }
+
+      intLower = ClampToInteger(lower, minValue, maxValue);
+      intUpper = ClampToInteger(upper, minValue, maxValue);
+      return;
+    }
+
+    intLower = max(intSource[0], minValue);
+    intUpper = min(intSource[1], maxValue);
+    empty = intLower > intUpper;
+    return;
+  }
+
+  // only integral values within the range of the column type can match
+  if (predicate.isReal)
+  {
+    for (double value : realSource)
+    {
+      if (value == floor(value) && value >= static_cast<double>(minValue) && value < static_cast<double>(maxValue))
+      {
+        intValues.push_back(static_cast<long long>(value));
+      }
+    }
+  }
+  else
+  {
+    for (long long value : intSource)
+    {
+      if (value >= minValue && value <= maxValue) intValues.push_back(value);
+    }
+  }
+
+  sort(intValues.begin(), intValues.end());
+  intValues.erase(unique(intValues.begin(), intValues.end()), intValues.end());
+  empty = intValues.empty();
+}
+
+
+template<typename T>
+inline BlockMatch MatchBlockValues(T minValue, T maxValue, bool hasNA, FstPredicateType type, T lower, T upper,
+  const vector<T> &values)
+{
+  // all values NA
+  if (minValue > maxValue) return BlockMatch::NONE;
+
+  if (type == FstPredicateType::RANGE)
+  {
+    if (maxValue < lower || minValue > upper) return BlockMatch::NONE;
+    if (!hasNA && minValue >= lower && maxValue <= upper) return BlockMatch::ALL;
+    return BlockMatch::SOME;
+  }
+
+  // first value of the set that is not smaller than the block minimum
+  auto it = lower_bound(values.begin(), values.end(), minValue);
+  if (it == values.end() || *it > maxValue) return BlockMatch::NONE;
+  if (!hasNA && minValue == maxValue) return BlockMatch::ALL;
+
+  return BlockMatch::SOME;
+}
+
+
+BlockMatch PredicateFilter::MatchBlock(const BlockStatistics &stats, unsigned long long nrOfElements) const
+{
+  if (empty || stats.naCount >= nrOfElements) return BlockMatch::NONE;
+
+  if (columnType == StatisticsType::DOUBLE_64)
+  {
+    return MatchBlockValues(stats.min.real, stats.max.real, stats.naCount != 0, type, realLower, realUpper, realValues);
+  }
+
+  return MatchBlockValues(stats.min.int64, stats.max.int64, stats.naCount != 0, type, intLower, intUpper, intValues);
+}
+
+
+void AddRowRange(RowRanges &ranges, unsigned long long first, unsigned long long last)
+{
+  if (!ranges.empty() && ranges.back().second == first)
+  {
+    ranges.back().second = last;
+    return;
+  }
+
+  ranges.emplace_back(first, last);
+}
+
+
+// Add runs of consecutive matching values to the row ranges
+template<typename T, typename V, typename Match>
+inline void MatchValues(const T* values, unsigned long long nrOfElements, unsigned long long firstRow, RowRanges &matches,
+  Match isMatch)
+{
+  unsigned long long runStart = 0;
+  bool inRun = false;
+
+  for (unsigned long long pos = 0; pos < nrOfElements; ++pos)
+  {
+    const bool match = isMatch(static_cast<V>(values[pos]));
+    if (match == inRun) continue;
+
+    if (match) runStart = pos;
+    else AddRowRange(matches, firstRow + runStart, firstRow + pos);
+
+    inRun = match;
+  }
+
+  if (inRun) AddRowRange(matches, firstRow + runStart, firstRow + nrOfElements);
+}
+
+
+void PredicateFilter::MatchRows(const char* values, unsigned long long nrOfElements, unsigned long long firstRow,
+  RowRanges &matches) const
+{
+  if (empty) return;
+
+  // NA values are outside the (clamped) integer bounds and comparisons with NaN are false
+  if (columnType == StatisticsType::DOUBLE_64)
+  {
+    const double* realP = reinterpret_cast<const double*>(values);
+    const double lower = realLower, upper = realUpper;
+    const vector<double> &set = realValues;
+
+    if (type == FstPredicateType::RANGE)
+    {
+      MatchValues<double, double>(realP, nrOfElements, firstRow, matches,
+        [lower, upper](double value) { return value >= lower && value <= upper; });
+      return;
+    }
+
+    MatchValues<double, double>(realP, nrOfElements, firstRow, matches,
+      [&set](double value) { return value == value && binary_search(set.begin(), set.end(), value); });
+    return;
+  }
+
+  const long long lower = intLower, upper = intUpper;
+  const vector<long long> &set = intValues;
+
+  if (columnType == StatisticsType::INT_32)
+  {
+    const int* intP = reinterpret_cast<const int*>(values);
+
+    if (type == FstPredicateType::RANGE)
+    {
+      MatchValues<int, long long>(intP, nrOfElements, firstRow, matches,
+        [lower, upper](long long value) { return value >= lower && value <= upper; });
+      return;
+    }
+
+    MatchValues<int, long long>(intP, nrOfElements, firstRow, matches,
+      [&set](long long value) { return binary_search(set.begin(), set.end(), value); });
+    return;
+  }
+
+  const long long* int64P = reinterpret_cast<const long long*>(values);
+
+  if (type == FstPredicateType::RANGE)
+  {
+    MatchValues<long long, long long>(int64P, nrOfElements, firstRow, matches,
+      [lower, upper](long long value) { return value >= lower && value <= upper; });
+    return;
+  }
+
+  MatchValues<long long, long long>(int64P, nrOfElements, firstRow, matches,
+    [&set](long long value) { return binary_search(set.begin(), set.end(), value); });
+}
+
+
+void PredicateFilter::MatchRuns(const vector<unsigned int> &runLengths, const vector<long long> &runValues,
+  unsigned long long firstRow, unsigned long long from, unsigned long long to, RowRanges &matches) const
+{
+  if (empty) return;
+
+  // NA values are outside the (clamped) integer bounds
+  const long long lower = intLower, upper = intUpper;
+  const vector<long long> &set = intValues;
+  const bool isRange = type == FstPredicateType::RANGE;
+
+  unsigned long long runStart = firstRow;
+
+  for (size_t run = 0; run < runLengths.size() && runStart < to; ++run)
+  {
+    const unsigned long long runEnd = runStart + runLengths[run];
+    const long long value = runValues[run];
+
+    if (runEnd > from && (isRange ? value >= lower && value <= upper : binary_search(set.begin(), set.end(), value)))
+    {
+      AddRowRange(matches, max(runStart, from), min(runEnd, to));
+    }
+
+    runStart = runEnd;
+  }
+}
+
+
+// Decompress rows [from, to) in parts of at most READ_TASK_ROWS rows and test their values
+inline void TestRows(istream &myfile, const IFstSource* positionalReader, unsigned long long blockPos,
+  unsigned long long size, const PredicateFilter &filter, unsigned long long from, unsigned long long to,
+  std::unique_ptr<char[]> &buffer, RowRanges &matches)
+{
+  if (from >= to) return;
+
+  const int elementSize = filter.ElementSize();
+
+  if (!buffer) buffer = std::unique_ptr<char[]>(new char[static_cast<size_t>(READ_TASK_ROWS) * elementSize]);
+
+  for (unsigned long long partStart = from; partStart < to; partStart += READ_TASK_ROWS)
+  {
+    const unsigned long long partLength = min(to - partStart, static_cast<unsigned long long>(READ_TASK_ROWS));
+
+    std::string annotation;
+    bool hasAnnotation;
+
+    fdsReadColumn_v2(myfile, buffer.get(), blockPos, partStart, partLength, size, elementSize, annotation,
+      elementSize == 4 ? BATCH_SIZE_READ_INT : BATCH_SIZE_READ_DOUBLE, hasAnnotation, positionalReader);
+
+    filter.MatchRows(buffer.get(), partLength, partStart, matches);
+  }
+}
+
+
+// Test rows [from, to) of a run-length encoded block on its runs
+inline void TestRuns(istream &myfile, const IFstSource* positionalReader, const vector<unsigned long long> &blockIndex,
+  unsigned long long dataPos, unsigned long long block, unsigned long long blockStart, unsigned long long blockEnd,
+  const PredicateFilter &filter, unsigned long long from, unsigned long long to, vector<char> &compBuf,
+  RowRanges &matches)
+{
+  const unsigned long long compSize = fdsReadCompressedBlock_v2(myfile, blockIndex, dataPos, block, compBuf,
+    positionalReader);
+
+  vector<unsigned int> runLengths;
+  vector<long long> runValues;
+
+  if (RunLengthRuns(compBuf.data(), static_cast<unsigned int>(compSize), filter.ElementSize(),
+    static_cast<unsigned int>(blockEnd - blockStart), runLengths, runValues) != 0)
+  {
+    throw(runtime_error(FSTERROR_COMP_STREAM));
+  }
+
+  filter.MatchRuns(runLengths, runValues, blockStart, from, to, matches);
+}
+
+
+void fdsFilterColumn_v2(istream &myfile, const IFstSource* positionalReader, unsigned long long blockPos,
+  unsigned long long size, const PredicateFilter &filter, const ColumnStatistics &stats, const RowRanges &candidates,
+  RowRanges &matches)
+{
+  // statistics are only used when they cover the complete data chunk
+  const unsigned long long statsBlockSize = stats.BlockSizeElems();
+  const bool useStats = stats.NrOfBlocks() > 0 && stats.NrOfBlocks() == (size + statsBlockSize - 1) / statsBlockSize;
+
+  // run-length encoded blocks are located with the block index, which requires blocks that coincide with the
+  // statistics blocks
+  vector<unsigned long long> blockIndex;
+  unsigned long long compBlockSize = 0;
+  unsigned long long dataPos = 0;
+
+  const bool useRuns = filter.IntegerValues() && fdsReadBlockIndex_v2(myfile, blockPos, size, filter.ElementSize(),
+    blockIndex, compBlockSize, dataPos, positionalReader) && (!useStats || compBlockSize == statsBlockSize);
+
+  const unsigned long long blockSize = useStats ? statsBlockSize : useRuns ? compBlockSize : max(size, 1ULL);
+  const unsigned short runAlgorithm = static_cast<unsigned short>(filter.ElementSize() == 4 ? CompAlgo::RLE_INT :
+    CompAlgo::RLE_INT64);
+
+  std::unique_ptr<char[]> buffer;
+  vector<char> compBuf;
+
+  // consecutive rows that require testing are decompressed together
+  unsigned long long pendingStart = 0;
+  unsigned long long pendingEnd = 0;
+
+  for (const auto &range : candidates)
+  {
+    unsigned long long row = range.first;
+
+    while (row < range.second)
+    {
+      const unsigned long long block = row / blockSize;
+      const unsigned long long blockStart = block * blockSize;
+      const unsigned long long blockEnd = min(blockStart + blockSize, size);
+      const unsigned long long segmentEnd = min(blockEnd, range.second);
+
+      const BlockMatch match = useStats ? filter.MatchBlock(stats.Block(block), blockEnd - blockStart) : BlockMatch::SOME;
+      const bool isRuns = match == BlockMatch::SOME && useRuns &&
+        fdsBlockAlgorithm_v2(blockIndex, block) == runAlgorithm;
+
+      if (match == BlockMatch::SOME && !isRuns)
+      {
+        if (pendingEnd != row)
+        {
+          TestRows(myfile, positionalReader, blockPos, size, filter, pendingStart, pendingEnd, buffer, matches);
+          pendingStart = row;
+        }
+
+        pendingEnd = segmentEnd;
+      }
+      else
+      {
+        TestRows(myfile, positionalReader, blockPos, size, filter, pendingStart, pendingEnd, buffer, matches);
+        pendingStart = pendingEnd = 0;
+
+        if (isRuns)
+        {
+          TestRuns(myfile, positionalReader, blockIndex, dataPos, block, blockStart, blockEnd, filter, row, segmentEnd,
+            compBuf, matches);
+        }
+        else if (match == BlockMatch::ALL)
+        {
+          AddRowRange(matches, row, segmentEnd);
+        }
+      }
+
+      row = segmentEnd;
+    }
+  }
+
+  TestRows(myfile, positionalReader, blockPos, size, filter, pendingStart, pendingEnd, buffer, matches);
+}
@@ -0,0 +1,132 @@
+/*
+  fstlib - A C++ library for ultra fast storage and retrieval of datasets
+
+  Copyright (C) 2017-present, Mark AJ Klik
+
+  This file is part of fstlib.
+
+  This Source Code Form is subject to the terms of the Mozilla Public
+  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+  You can obtain one at https://mozilla.org/MPL/2.0/.
+
+  https://www.mozilla.org/en-US/MPL/2.0/FAQ/
+
+  You can contact the author at:
+  - fstlib source repository : https://github.com/fstpackage/fstlib
+*/
+
+#ifndef PREDICATE_FILTER_H
+#define PREDICATE_FILTER_H
+
+#include <istream>
+#include <vector>
+#include <utility>
+
+#include <interface/fstpredicate.h>
+#include <statistics/columnstatistics.h>
+
+
+class IFstSource;
+
+
+// Sorted and non-overlapping row ranges [first, second) of a data chunk
+typedef std::vector<std::pair<unsigned long long, unsigned long long>> RowRanges;
+
+
+enum class BlockMatch
+{
+  NONE = 0,  // no value of the block can match
+  SOME,      // block values have to be tested
+  ALL        // all values of the block match
+};
+
+
+/**
+ * \brief Evaluates a predicate on the values of a column with a specific value type. Predicate values are converted
+ * to the type of the column once, for example a real range on an integer column is narrowed to the integers
+ * within that range.
+ */
+class PredicateFilter
+{
+  FstPredicateType type;
+  StatisticsType columnType;
+  bool empty = false;  // no value can match
+
+  long long intLower = 0, intUpper = 0;
+  double realLower = 0.0, realUpper = 0.0;
+  std::vector<long long> intValues;  // sorted set of values (IN)
+  std::vector<double> realValues;    // sorted set of values (IN)
+
+public:
+  /**
+   * \brief Prepare a predicate for evaluation.
+   * \param predicate predicate to evaluate.
+   * \param columnType value type of the column, StatisticsType::INT_32 columns hold 32 bit integers.
+   */
+  PredicateFilter(const FstPredicate &predicate, StatisticsType columnType);
+
+  /**
+   * \brief Size of a single column element in bytes.
+   */
+  int ElementSize() const { return columnType == StatisticsType::INT_32 ? 4 : 8; }
+
+  /**
+   * \brief Determine whether a block can contain matching values using its statistics.
+   */
+  BlockMatch MatchBlock(const BlockStatistics &stats, unsigned long long nrOfElements) const;
+
+  /**
+   * \brief Test a range of column values and add the matching rows to 'matches'.
+   * \param values column values.
+   * \param nrOfElements number of values.
+   * \param firstRow row number of the first value.
+   * \param matches row ranges to extend, ranges are merged with the last range where possible.
+   */
+  void MatchRows(const char* values, unsigned long long nrOfElements, unsigned long long firstRow, RowRanges &matches) const;
+
+  /**
+   * \brief True for integer columns, which can be evaluated on the runs of run-length encoded blocks.
+   */
+  bool IntegerValues() const { return columnType != StatisticsType::DOUBLE_64; }
+
+  /**
+   * \brief Test rows [from, to) of a run-length encoded block and add the matching rows to 'matches'. Each run is
+   * tested once, without expanding it to the values of the block.
+   * \param runLengths length of each run of the block.
+   * \param runValues value of each run of the block.
+   * \param firstRow row number of the first value of the block.
+   * \param from first row to test.
+   * \param to end of the rows to test.
+   * \param matches row ranges to extend, ranges are merged with the last range where possible.
+   */
+  void MatchRuns(const std::vector<unsigned int> &runLengths, const std::vector<long long> &runValues,
+    unsigned long long firstRow, unsigned long long from, unsigned long long to, RowRanges &matches) const;
+};
+
+
+/**
+ * \brief Add a row range to a set of sorted ranges, merging it with the last range when adjacent.
+ */
+void AddRowRange(RowRanges &ranges, unsigned long long first, unsigned long long last);
+
+
+/**
+ * \brief Evaluate a predicate on a fixed-width column of a data chunk. Only rows within 'candidates' are evaluated.
+ * Blocks are skipped or accepted as a whole using the column statistics where possible. Run-length encoded blocks of
+ * integer columns are tested run by run, the remaining blocks are decompressed with fdsReadColumn_v2 and tested value
+ * by value.
+ * \param myfile stream used when no positional reader is available.
+ * \param positionalReader positional reader or nullptr.
+ * \param blockPos file position of the column data.
+ * \param size number of rows in the data chunk.
+ * \param filter predicate to evaluate.
+ * \param stats statistics of the column in this data chunk (may have no blocks).
+ * \param candidates row ranges to evaluate.
+ * \param matches row ranges that satisfy the predicate (output).
+ */
+void fdsFilterColumn_v2(std::istream &myfile, const IFstSource* positionalReader, unsigned long long blockPos,
+  unsigned long long size, const PredicateFilter &filter, const ColumnStatistics &stats, const RowRanges &candidates,
+  RowRanges &matches);
+
+
+#endif  // PREDICATE_FILTER_H
@@ -50,6 +50,30 @@ class ColumnFactory : public IColumnFactory
 	{
 		return nullptr;
 	}
+
+	IIntegerColumn* CreateIntegerColumnView(uint64_t /*nrOfRows*/, FstColumnAttribute columnAttribute, short int scale,
+		int* data, std::shared_ptr<void> dataOwner)
+	{
+		return new IntVectorAdapter(data, dataOwner, columnAttribute, scale);
+	}
+
+	IDoubleColumn* CreateDoubleColumnView(uint64_t /*nrOfRows*/, FstColumnAttribute columnAttribute, short int scale,
+		double* data, std::shared_ptr<void> dataOwner)
+	{
+		return new DoubleVectorAdapter(data, dataOwner, columnAttribute, scale);
+	}
+
+	IInt64Column* CreateInt64ColumnView(uint64_t /*nrOfRows*/, FstColumnAttribute columnAttribute, short int scale,
+		long long* data, std::shared_ptr<void> dataOwner)
+	{
+		return new Int64VectorAdapter(data, dataOwner, columnAttribute, scale);
+	}
+
+	IByteColumn* CreateByteColumnView(uint64_t /*nrOfRows*/, FstColumnAttribute /*columnAttribute*/, char* data,
+		std::shared_ptr<void> dataOwner)
+	{
+		return new ByteVectorAdapter(data, dataOwner);
+	}
 };
 
 
@@ -82,6 +82,7 @@ public:
 class IntVector : public DestructableObject
 {
 	int* data = nullptr;
+	std::shared_ptr<void> dataOwner;  // only set for a view on external memory
 
 public:
 	IntVector(uint64_t length)
@@ -92,9 +93,14 @@ public:
 		}
 	}
 
+	// View on external memory that is kept alive by dataOwner
+	IntVector(int* data, std::shared_ptr<void> dataOwner) : data(data), dataOwner(dataOwner)
+	{
+	}
+
 	~IntVector()
 	{
-		delete[] data;
+		if (!dataOwner) delete[] data;
 	}
 
 	int* Data()
@@ -107,6 +113,7 @@ public:
 class ByteVector : public DestructableObject
 {
 	char* data;
+	std::shared_ptr<void> dataOwner;  // only set for a view on external memory
 
 public:
 	ByteVector(uint64_t length)
@@ -114,9 +121,14 @@ public:
 		this->data = new char[length];
 	}
 
+	// View on external memory that is kept alive by dataOwner
+	ByteVector(char* data, std::shared_ptr<void> dataOwner) : data(data), dataOwner(dataOwner)
+	{
+	}
+
 	~ByteVector()
 	{
-		delete[] data;
+		if (!dataOwner) delete[] data;
 	}
 
 	char* Data()
@@ -129,6 +141,7 @@ public:
 class LongVector : public DestructableObject
 {
 	long long* data;
+	std::shared_ptr<void> dataOwner;  // only set for a view on external memory
 
 public:
 	LongVector(uint64_t length)
@@ -136,9 +149,14 @@ public:
 		this->data = new long long[length];
 	}
 
+	// View on external memory that is kept alive by dataOwner
+	LongVector(long long* data, std::shared_ptr<void> dataOwner) : data(data), dataOwner(dataOwner)
+	{
+	}
+
 	~LongVector()
 	{
-		delete[] data;
+		if (!dataOwner) delete[] data;
 	}
 
 	long long* Data()
@@ -151,6 +169,7 @@ public:
 class DoubleVector : public DestructableObject
 {
 	double* data;
+	std::shared_ptr<void> dataOwner;  // only set for a view on external memory
 
 public:
 	DoubleVector(uint64_t length)
@@ -158,9 +177,14 @@ public:
 		this->data = new double[length];
 	}
 
+	// View on external memory that is kept alive by dataOwner
+	DoubleVector(double* data, std::shared_ptr<void> dataOwner) : data(data), dataOwner(dataOwner)
+	{
+	}
+
 	~DoubleVector()
 	{
-		delete[] data;
+		if (!dataOwner) delete[] data;
 	}
 
 	double* Data()
@@ -262,6 +286,13 @@ public:
 	  this->scale = scale;
 	}
 
+	IntVectorAdapter(int* data, std::shared_ptr<void> dataOwner, FstColumnAttribute columnAttribute, short int scale)
+	{
+		shared_data = std::make_shared<IntVector>(data, dataOwner);
+		this->columnAttribute = columnAttribute;
+		this->scale = scale;
+	}
+
 	~IntVectorAdapter()
 	{
 	}
@@ -303,6 +334,11 @@ public:
 		shared_data = std::make_shared<ByteVector>(std::max(length, (uint64_t) 1));
 	}
 
+	ByteVectorAdapter(char* data, std::shared_ptr<void> dataOwner)
+	{
+		shared_data = std::make_shared<ByteVector>(data, dataOwner);
+	}
+
 	~ByteVectorAdapter()
 	{
 	}
@@ -333,6 +369,13 @@ public:
 	    this->scale = scale;
 	}
 
+	Int64VectorAdapter(long long* data, std::shared_ptr<void> dataOwner, FstColumnAttribute columnAttribute, short int scale)
+	{
+		shared_data = std::make_shared<LongVector>(data, dataOwner);
+		this->columnAttribute = columnAttribute;
+		this->scale = scale;
+	}
+
 	~Int64VectorAdapter()
 	{
 	}
@@ -430,6 +473,13 @@ public:
 	    this->scale = scale;
 	}
 
+	DoubleVectorAdapter(double* data, std::shared_ptr<void> dataOwner, FstColumnAttribute columnAttribute, short int scale)
+	{
+		shared_data = std::make_shared<DoubleVector>(data, dataOwner);
+		this->columnAttribute = columnAttribute;
+		this->scale = scale;
+	}
+
 	~DoubleVectorAdapter()
 	{
 	}
@@ -0,0 +1,190 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <interface/openmphelper.h>
+#include <compression/compressor.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class AdaptiveTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("adaptive.fst");
+  }
+
+  // Algorithm selected for a single block of integers
+  static CompAlgo BlockAlgorithm(const vector<int> &values, int compression)
+  {
+    Compressor* compress1 = new SingleCompressor(CompAlgo::LZ4_SHUF4, 0);
+    Compressor* compress2 = new SingleCompressor(CompAlgo::ZSTD_SHUF4, compression);
+    StreamAdaptiveCompressor streamCompressor(compress1, compress2, static_cast<float>(compression));
+
+    const unsigned int srcSize = static_cast<unsigned int>(4 * values.size());
+    vector<char> compBuf(streamCompressor.CompressBufferSize(srcSize));
+    vector<char> src(srcSize);
+    memcpy(src.data(), values.data(), srcSize);
+
+    CompAlgo algorithm;
+    const int compSize = streamCompressor.Compress(src.data(), srcSize, compBuf.data(), algorithm, 0);
+    EXPECT_GT(compSize, 0);
+
+    if (algorithm == CompAlgo::UNCOMPRESS)
+    {
+      EXPECT_EQ(compSize, static_cast<int>(srcSize));
+      EXPECT_EQ(memcmp(compBuf.data(), src.data(), srcSize), 0);
+    }
+
+    delete compress1;
+    delete compress2;
+
+    return algorithm;
+  }
+
+  // Consecutive ranges of random, constant and small values
+  static int IntValue(int row)
+  {
+    const int pattern = (row / 20000) % 3;
+    const unsigned int hash = static_cast<unsigned int>(row) * 2654435761U;
+
+    if (pattern == 0) return static_cast<int>(hash);
+    if (pattern == 1) return row / 20000;
+    return static_cast<int>(hash >> 16);
+  }
+
+  static long long Int64Value(int row)
+  {
+    // wraps around for large values, computed unsigned to avoid signed overflow
+    return static_cast<long long>(1000000000000ULL * static_cast<unsigned long long>(IntValue(row)) +
+      static_cast<unsigned long long>(row));
+  }
+
+  static double DoubleValue(int row)
+  {
+    return (row / 20000) % 3 == 1 ? 2.5 : IntValue(row) / 7.0;
+  }
+
+  void WriteRows(int nrOfRows, int compression, bool adaptiveCompression, bool extendedCodecs)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(3, nrOfRows);
+
+    IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    Int64VectorAdapter int64Vec(nrOfRows, FstColumnAttribute::INT_64_BASE, 0);
+    DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      intVec.Data()[row] = IntValue(row);
+      int64Vec.Data()[row] = Int64Value(row);
+      doubleVec.Data()[row] = DoubleValue(row);
+    }
+
+    fstTable.SetIntegerColumn(&intVec, 0);
+    fstTable.SetInt64Column(&int64Vec, 1);
+    fstTable.SetDoubleColumn(&doubleVec, 2);
+    fstTable.SetColumnNames(vector<std::string>{ "Int", "Int64", "Double" });
+
+    FstStore fstStore(filePath);
+    fstStore.SetAdaptiveCompression(adaptiveCompression);
+    fstStore.SetExtendedCodecs(extendedCodecs);
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  void CheckRows(int nrOfRows)
+  {
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    ReadRows(fstStore, tableRead, 1, -1);
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(nrOfRows));
+
+    int* intP = ColumnVector<IntVector>(tableRead, 0)->Data();
+    long long* int64P = ColumnVector<LongVector>(tableRead, 1)->Data();
+    double* doubleP = ColumnVector<DoubleVector>(tableRead, 2)->Data();
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      ASSERT_EQ(intP[row], IntValue(row));
+      ASSERT_EQ(int64P[row], Int64Value(row));
+      ASSERT_EQ(doubleP[row], DoubleValue(row));
+    }
+  }
+
+  vector<char> FileContent()
+  {
+    ifstream file(filePath, ios::binary);
+    return vector<char>(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+  }
+};
+
+
+TEST_F(AdaptiveTest, BlockSelection)
+{
+  for (unsigned int size : { 4U, 100U, 4096U })
+  {
+    // incompressible blocks are stored as is
+    const vector<int> random = PatternValues<int>(size, ValuePattern::RANDOM, size);
+
+    EXPECT_EQ(BlockAlgorithm(random, 0), CompAlgo::UNCOMPRESS);
+    EXPECT_EQ(BlockAlgorithm(random, 100), CompAlgo::UNCOMPRESS);
+  }
+
+  // redundant blocks always use the strong compressor
+  EXPECT_EQ(BlockAlgorithm(PatternValues<int>(4096, ValuePattern::CONSTANT, 0), 0), CompAlgo::ZSTD_SHUF4);
+
+  // moderately compressible blocks (only the lower two bytes vary) depend on the compression level
+  const vector<int> small = PatternValues<int>(4096, ValuePattern::SMALL_RANDOM, 1);
+
+  EXPECT_EQ(BlockAlgorithm(small, 0), CompAlgo::LZ4_SHUF4);
+  EXPECT_EQ(BlockAlgorithm(small, 100), CompAlgo::ZSTD_SHUF4);
+}
+
+
+TEST_F(AdaptiveTest, MixedColumns)
+{
+  for (int compression : { 1, 50, 100 })
+  {
+    WriteRows(250007, compression, true, false);
+    CheckRows(250007);
+
+    // only existing codecs are used
+    EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION));
+
+    WriteRows(250007, compression, true, true);
+    CheckRows(250007);
+  }
+}
+
+
+TEST_F(AdaptiveTest, Deterministic)
+{
+  const int prevThreads = ThreadsFst(1);
+
+  WriteRows(250007, 70, true, true);
+  const vector<char> singleThreaded = FileContent();
+
+  ThreadsFst(4);
+
+  WriteRows(250007, 70, true, true);
+  EXPECT_EQ(FileContent(), singleThreaded);
+
+  ThreadsFst(prevThreads);
+}
@@ -0,0 +1,272 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <xxhash.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class AppendTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("append.fst");
+  }
+
+  // Write or append rows [from, from + nrOfRows) with an integer, double, character and factor column.
+  // Factor values alternate between the two given levels.
+  void WriteRows(int from, int nrOfRows, const std::string &level1, const std::string &level2, bool append, int compression)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(4, nrOfRows);
+
+    IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    StringColumn strVec;
+    strVec.AllocateVec(nrOfRows);
+    FactorVectorAdapter factorVec(nrOfRows, 2, FstColumnAttribute::FACTOR_BASE);
+
+    vector<std::string>* strings = strVec.StrVector()->StrVec();
+    vector<std::string>* levels = factorVec.DataPtr()->Levels()->StrVector()->StrVec();
+    (*levels)[0] = level1;
+    (*levels)[1] = level2;
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      intVec.Data()[row] = from + row;
+      doubleVec.Data()[row] = 0.5 * (from + row);
+      (*strings)[row] = "s" + to_string(from + row);
+      factorVec.LevelData()[row] = 1 + (from + row) % 2;
+    }
+
+    fstTable.SetIntegerColumn(&intVec, 0);
+    fstTable.SetDoubleColumn(&doubleVec, 1);
+    fstTable.SetStringColumn(&strVec, 2);
+    fstTable.SetFactorColumn(&factorVec, 3);
+    fstTable.SetColumnNames(vector<std::string>{ "Int", "Double", "String", "Factor" });
+
+    FstStore fstStore(filePath);
+
+    if (append)
+    {
+      fstStore.fstAppend(fstTable, compression);
+      return;
+    }
+
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  // Overwrite the minimum version required to read the file in the table header
+  void SetTableVersion(unsigned int version)
+  {
+    std::fstream file(filePath, ios::in | ios::out | ios::binary);
+    char tableMeta[TABLE_META_SIZE];
+    file.read(tableMeta, TABLE_META_SIZE);
+
+    *reinterpret_cast<unsigned int*>(&tableMeta[24]) = version;
+    *reinterpret_cast<unsigned long long*>(tableMeta) = ZSTD_XXH64(&tableMeta[8], TABLE_META_SIZE - 8, FST_HASH_SEED);
+
+    file.seekp(0);
+    file.write(tableMeta, TABLE_META_SIZE);
+  }
+
+  // Read rows and compare with the generated values, levels are 'a' for even and 'b' or 'c' for odd rows
+  void CheckRows(int64_t startRow, int64_t endRow, int nrOfRows)
+  {
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    StringArray selectedCols;
+    ColumnFactory columnFactory;
+    std::vector<int> keyIndex;
+    std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+    fstStore.fstRead(tableRead, nullptr, startRow, endRow, &columnFactory, keyIndex, &selectedCols, col_names.get());
+
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(nrOfRows));
+
+    std::shared_ptr<DestructableObject> column;
+    FstColumnType type;
+    std::string colName, annotation;
+    short int scale;
+
+    tableRead.GetColumn(0, column, type, colName, scale, annotation);
+    int* intP = static_cast<IntVector*>(&*column)->Data();
+
+    tableRead.GetColumn(1, column, type, colName, scale, annotation);
+    double* doubleP = static_cast<DoubleVector*>(&*column)->Data();
+
+    tableRead.GetColumn(2, column, type, colName, scale, annotation);
+    vector<std::string>* strings = static_cast<StringVector*>(&*column)->StrVec();
+
+    tableRead.GetColumn(3, column, type, colName, scale, annotation);
+    FactorVector* factorVec = static_cast<FactorVector*>(&*column);
+    vector<std::string>* levels = factorVec->Levels()->StrVector()->StrVec();
+
+    for (int pos = 0; pos < nrOfRows; pos++)
+    {
+      const int row = static_cast<int>(startRow) - 1 + pos;
+
+      EXPECT_EQ(intP[pos], row);
+      EXPECT_EQ(doubleP[pos], 0.5 * row);
+      EXPECT_EQ((*strings)[pos], "s" + to_string(row));
+
+      const std::string &level = (*levels)[factorVec->Data()[pos] - 1];
+
+      if (row % 2 == 0)
+      {
+        EXPECT_EQ(level, "a");
+      }
+      else
+      {
+        EXPECT_EQ(level, row < 1000 ? "b" : "c");
+      }
+    }
+  }
+};
+
+
+TEST_F(AppendTest, SingleAppend)
+{
+  WriteRows(0, 1000, "a", "b", false, 0);
+  WriteRows(1000, 5000, "a", "c", true, 0);
+
+  CheckRows(1, -1, 6000);
+  CheckRows(990, 1010, 21);
+  CheckRows(2000, 3000, 1001);
+}
+
+
+TEST_F(AppendTest, LinkedChunkIndexes)
+{
+  // more data chunks than available slots in a single chunk index
+  WriteRows(0, 1000, "a", "b", false, 50);
+
+  for (int chunk = 1; chunk < 10; chunk++)
+  {
+    WriteRows(chunk * 1000, 1000, "a", "c", true, 70);
+  }
+
+  CheckRows(1, -1, 10000);
+  CheckRows(3500, 8200, 4701);
+  CheckRows(9001, 10000, 1000);
+
+  // meta data reflects the total number of rows
+  FstStore fstStore(filePath);
+  ColumnFactory columnFactory;
+  std::unique_ptr<StringColumn> col_names(new StringColumn());
+  fstStore.fstMeta(&columnFactory, col_names.get());
+
+  EXPECT_EQ(*fstStore.p_nrOfRows, 10000ULL);
+}
+
+
+TEST_F(AppendTest, TableVersion)
+{
+  WriteRows(0, 1000, "a", "b", false, 50);
+
+  FstStore fstStore(filePath);
+  ColumnFactory columnFactory;
+  std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+  fstStore.fstMeta(&columnFactory, col_names.get());
+  EXPECT_EQ(fstStore.tableVersionMax, static_cast<unsigned int>(FST_VERSION));
+
+  // readers that only use the first data chunk refuse files with appended rows
+  WriteRows(1000, 1000, "a", "c", true, 50);
+
+  fstStore.fstMeta(&columnFactory, col_names.get());
+  EXPECT_EQ(fstStore.tableVersionMax, static_cast<unsigned int>(FST_VERSION_MULTI_CHUNK));
+
+  CheckRows(1, -1, 2000);
+}
+
+
+TEST_F(AppendTest, FutureVersions)
+{
+  WriteRows(0, 100, "a", "b", false, 50);
+
+  // a next minor version and unknown feature versions are refused
+  for (unsigned int version : { FST_VERSION + 1, FST_VERSION_FEATURES, FST_VERSION_READ + 1 })
+  {
+    SetTableVersion(version);
+
+    FstStore fstStore(filePath);
+    ColumnFactory columnFactory;
+    std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+    EXPECT_THROW(fstStore.fstMeta(&columnFactory, col_names.get()), std::runtime_error);
+  }
+
+  SetTableVersion(FST_VERSION_MULTI_CHUNK);
+  CheckRows(1, -1, 100);
+}
+
+
+TEST_F(AppendTest, IncorrectColumns)
+{
+  WriteRows(0, 100, "a", "b", false, 0);
+
+  const int nrOfRows = 10;
+  FstTable fstTable(nrOfRows);
+  fstTable.InitTable(1, nrOfRows);
+  IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+  fstTable.SetIntegerColumn(&intVec, 0);
+  fstTable.SetColumnNames(vector<std::string>{ "Int" });
+
+  FstStore fstStore(filePath);
+  EXPECT_THROW(fstStore.fstAppend(fstTable, 0), std::runtime_error);
+}
+
+
+TEST_F(AppendTest, IncorrectAttributes)
+{
+  const int nrOfRows = 10;
+
+  // write a file with a plain integer and an int64 column
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(2, nrOfRows);
+    IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    Int64VectorAdapter int64Vec(nrOfRows, FstColumnAttribute::INT_64_BASE, 0);
+    fstTable.SetIntegerColumn(&intVec, 0);
+    fstTable.SetInt64Column(&int64Vec, 1);
+    fstTable.SetColumnNames(vector<std::string>{ "Int", "Int64" });
+
+    FstStore fstStore(filePath);
+    fstStore.fstWrite(fstTable, 0);
+  }
+
+  // same column types with a different attribute or scale
+  for (int mismatch = 0; mismatch < 3; mismatch++)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(2, nrOfRows);
+    IntVectorAdapter intVec(nrOfRows, mismatch == 0 ? FstColumnAttribute::INT_32_DATE_DAYS : FstColumnAttribute::NONE,
+      mismatch == 1 ? 3 : 0);
+    Int64VectorAdapter int64Vec(nrOfRows, mismatch == 2 ? FstColumnAttribute::INT_64_TIME_SECONDS :
+      FstColumnAttribute::INT_64_BASE, 0);
+    fstTable.SetIntegerColumn(&intVec, 0);
+    fstTable.SetInt64Column(&int64Vec, 1);
+    fstTable.SetColumnNames(vector<std::string>{ "Int", "Int64" });
+
+    FstStore fstStore(filePath);
+    EXPECT_THROW(fstStore.fstAppend(fstTable, 0), std::runtime_error);
+  }
+}
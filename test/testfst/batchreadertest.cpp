@@ -0,0 +1,219 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstbatchreader.h>
+#include <interface/fstdefines.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class BatchReaderTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("batchreader.fst");
+  }
+
+  static std::string TextValue(int row)
+  {
+    return "s" + to_string(row % 2099);
+  }
+
+  // Write or append rows [from, from + nrOfRows)
+  void WriteRows(int from, int nrOfRows, int compression, bool append)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(4, nrOfRows);
+
+    IntVectorAdapter idVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    StringColumn strVec;
+    strVec.AllocateVec(nrOfRows);
+    FactorVectorAdapter factorVec(nrOfRows, 2, FstColumnAttribute::FACTOR_BASE);
+
+    vector<std::string>* levels = factorVec.DataPtr()->Levels()->StrVector()->StrVec();
+    (*levels)[0] = "a";
+    (*levels)[1] = "b";
+
+    for (int pos = 0; pos < nrOfRows; pos++)
+    {
+      const int row = from + pos;
+
+      idVec.Data()[pos] = row;
+      doubleVec.Data()[pos] = 0.5 * row;
+      (*strVec.StrVector()->StrVec())[pos] = TextValue(row);
+      factorVec.LevelData()[pos] = 1 + row % 2;
+    }
+
+    fstTable.SetIntegerColumn(&idVec, 0);
+    fstTable.SetDoubleColumn(&doubleVec, 1);
+    fstTable.SetStringColumn(&strVec, 2);
+    fstTable.SetFactorColumn(&factorVec, 3);
+    fstTable.SetColumnNames(vector<std::string>{ "Id", "Double", "Text", "Level" });
+
+    FstStore fstStore(filePath);
+
+    if (append)
+    {
+      fstStore.fstAppend(fstTable, compression);
+      return;
+    }
+
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  // Read all batches of the 'Text' and 'Id' columns and compare with the generated values
+  void CheckBatches(FstBatchReader &batchReader, const vector<unsigned long long> &expectedSizes)
+  {
+    ColumnFactory columnFactory;
+    std::vector<int> keyIndex;
+    unsigned long long row = 0;
+
+    for (unsigned long long expectedSize : expectedSizes)
+    {
+      FstTable tableRead;
+      StringArray selectedCols;
+
+      ASSERT_EQ(batchReader.NextRow(), row);
+      ASSERT_TRUE(batchReader.NextBatch(tableRead, &columnFactory, keyIndex, &selectedCols));
+      ASSERT_EQ(tableRead.NrOfRows(), expectedSize);
+      ASSERT_EQ(tableRead.NrOfColumns(), 2U);
+      EXPECT_STREQ(selectedCols.GetElement(0), "Text");
+
+      std::shared_ptr<DestructableObject> column;
+      FstColumnType type;
+      std::string colName, annotation;
+      short int scale;
+
+      tableRead.GetColumn(0, column, type, colName, scale, annotation);
+      vector<std::string>* strings = static_cast<StringVector*>(&*column)->StrVec();
+
+      tableRead.GetColumn(1, column, type, colName, scale, annotation);
+      int* idP = static_cast<IntVector*>(&*column)->Data();
+
+      for (unsigned long long pos = 0; pos < expectedSize; pos++, row++)
+      {
+        ASSERT_EQ(idP[pos], static_cast<int>(row));
+        EXPECT_EQ((*strings)[pos], TextValue(static_cast<int>(row)));
+      }
+    }
+
+    FstTable tableRead;
+    StringArray selectedCols;
+    EXPECT_FALSE(batchReader.NextBatch(tableRead, &columnFactory, keyIndex, &selectedCols));
+  }
+};
+
+
+TEST_F(BatchReaderTest, BatchesOverChunks)
+{
+  WriteRows(0, 50000, 40, false);
+  WriteRows(50000, 30000, 0, true);
+
+  ColumnFactory columnFactory;
+  vector<std::string> cols { "Text", "Id" };
+  StringArray columnSelection(cols);
+
+  // batch size is rounded up to a multiple of the alignment and batches end at data chunk boundaries
+  FstBatchReader batchReader(filePath, &columnFactory, &columnSelection, 20000);
+
+  EXPECT_EQ(batchReader.BatchRows(), 2ULL * BATCH_ROWS_ALIGNMENT);
+  EXPECT_EQ(batchReader.NrOfRows(), 80000ULL);
+
+  CheckBatches(batchReader, { 32768, 17232, 30000 });
+
+  batchReader.Reset();
+  CheckBatches(batchReader, { 32768, 17232, 30000 });
+}
+
+
+TEST_F(BatchReaderTest, SmallBatches)
+{
+  WriteRows(0, 100000, 70, false);
+
+  ColumnFactory columnFactory;
+  vector<std::string> cols { "Text", "Id" };
+  StringArray columnSelection(cols);
+
+  FstBatchReader batchReader(filePath, &columnFactory, &columnSelection, 1, true);
+
+  vector<unsigned long long> sizes(6, BATCH_ROWS_ALIGNMENT);
+  sizes.push_back(100000 - 6 * BATCH_ROWS_ALIGNMENT);
+
+  CheckBatches(batchReader, sizes);
+}
+
+
+TEST_F(BatchReaderTest, CompressedChunks)
+{
+  WriteRows(0, 50000, 60, false);
+  WriteRows(50000, 40000, 100, true);
+
+  ColumnFactory columnFactory;
+  vector<std::string> cols { "Double", "Id" };
+  StringArray columnSelection(cols);
+
+  // the column metadata of each data chunk is reused by the batches of that chunk
+  FstBatchReader batchReader(filePath, &columnFactory, &columnSelection, BATCH_ROWS_ALIGNMENT);
+  std::vector<int> keyIndex;
+  unsigned long long row = 0;
+
+  for (int pass = 0; pass < 2; pass++)
+  {
+    while (true)
+    {
+      FstTable tableRead;
+      StringArray selectedCols;
+
+      if (!batchReader.NextBatch(tableRead, &columnFactory, keyIndex, &selectedCols)) break;
+
+      std::shared_ptr<DestructableObject> column;
+      FstColumnType type;
+      std::string colName, annotation;
+      short int scale;
+
+      tableRead.GetColumn(0, column, type, colName, scale, annotation);
+      double* doubleP = static_cast<DoubleVector*>(&*column)->Data();
+
+      tableRead.GetColumn(1, column, type, colName, scale, annotation);
+      int* idP = static_cast<IntVector*>(&*column)->Data();
+
+      for (unsigned long long pos = 0; pos < tableRead.NrOfRows(); pos++, row++)
+      {
+        ASSERT_EQ(idP[pos], static_cast<int>(row));
+        ASSERT_EQ(doubleP[pos], 0.5 * row);
+      }
+    }
+
+    EXPECT_EQ(row, 90000ULL);
+
+    batchReader.Reset();
+    row = 0;
+  }
+}
+
+
+TEST_F(BatchReaderTest, IncorrectParameters)
+{
+  WriteRows(0, 1000, 0, false);
+
+  ColumnFactory columnFactory;
+  vector<std::string> cols { "Missing" };
+  StringArray columnSelection(cols);
+
+  EXPECT_THROW(FstBatchReader(filePath, &columnFactory, nullptr, 0), runtime_error);
+  EXPECT_THROW(FstBatchReader(filePath, &columnFactory, &columnSelection, 1000), runtime_error);
+}
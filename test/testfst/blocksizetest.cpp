@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class BlockSizeTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("blocksize.fst");
+  }
+
+  // Read a row range and a selection of rows and compare with the generated values
+  void CheckRows(int nrOfRows)
+  {
+    FstStore fstStore(filePath);
+
+    // row range that starts and ends within a block
+    GeneratedTable::CheckRows(fstStore, 1001, nrOfRows - 1000);
+
+    vector<int64_t> rows { 1, 2, 2 };
+    for (int64_t row = 3; row < nrOfRows; row += 1 + (row * 7) % 30011) rows.push_back(row);
+    rows.push_back(nrOfRows);
+
+    GeneratedTable::CheckSelectedRows(fstStore, rows);
+  }
+
+  // Number of elements per statistics block of a column in each data chunk (equal to the compression block size)
+  vector<unsigned long long> StatisticsBlockSizes(int colNr)
+  {
+    FstStore fstStore(filePath);
+    vector<ColumnStatistics> chunkStats;
+    fstStore.fstColumnStatistics(colNr, chunkStats);
+
+    vector<unsigned long long> blockSizes;
+    for (const ColumnStatistics &stats : chunkStats) blockSizes.push_back(stats.BlockSizeElems());
+
+    return blockSizes;
+  }
+};
+
+
+TEST_F(BlockSizeTest, WriteAndRead)
+{
+  for (unsigned int blockSize : { 65536U, static_cast<unsigned int>(MAX_BLOCK_SIZE) })
+  {
+    for (int compression : { 0, 30, 100 })
+    {
+      FstStore fstStore(filePath);
+      fstStore.SetBlockSize(blockSize);
+      GeneratedTable::WriteRows(fstStore, 0, 300000, compression, false);
+
+      CheckRows(300000);
+
+      // uncompressed columns use the default block size
+      EXPECT_EQ(StatisticsBlockSizes(0)[0], compression == 0 ? BLOCKSIZE_INT : blockSize / 4);
+      EXPECT_EQ(StatisticsBlockSizes(1)[0], compression == 0 ? BLOCKSIZE_REAL : blockSize / 8);
+      EXPECT_EQ(StatisticsBlockSizes(3)[0], blockSize / 4);
+      EXPECT_EQ(StatisticsBlockSizes(6)[0], blockSize / 4);
+
+      EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION_BLOCK_SIZE));
+    }
+  }
+}
+
+
+TEST_F(BlockSizeTest, ColumnBlockSize)
+{
+  FstStore fstStore(filePath);
+  fstStore.SetColumnBlockSize(1, 262144);
+  fstStore.SetColumnBlockSize(4, 131072);
+  GeneratedTable::WriteRows(fstStore, 0, 200000, 50, false);
+
+  CheckRows(200000);
+
+  EXPECT_EQ(StatisticsBlockSizes(0)[0], static_cast<unsigned long long>(BLOCKSIZE_INT));
+  EXPECT_EQ(StatisticsBlockSizes(1)[0], 262144ULL / 8);
+}
+
+
+TEST_F(BlockSizeTest, AppendWithOtherBlockSize)
+{
+  {
+    FstStore fstStore(filePath);
+    GeneratedTable::WriteRows(fstStore, 0, 100000, 60, false);
+  }
+
+  // files with default blocks remain readable by previous versions
+  EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION));
+
+  {
+    FstStore fstStore(filePath);
+    fstStore.SetBlockSize(524288);
+    GeneratedTable::WriteRows(fstStore, 100000, 150000, 60, true);
+  }
+
+  EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION_BLOCK_SIZE));
+
+  {
+    FstStore fstStore(filePath);
+    GeneratedTable::WriteRows(fstStore, 250000, 50000, 90, true);
+  }
+
+  CheckRows(300000);
+
+  vector<unsigned long long> blockSizes = StatisticsBlockSizes(2);
+  ASSERT_EQ(blockSizes.size(), 3U);
+  EXPECT_EQ(blockSizes[0], static_cast<unsigned long long>(BLOCKSIZE_INT64));
+  EXPECT_EQ(blockSizes[1], 524288ULL / 8);
+  EXPECT_EQ(blockSizes[2], static_cast<unsigned long long>(BLOCKSIZE_INT64));
+
+  EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION_BLOCK_SIZE));
+}
+
+
+TEST_F(BlockSizeTest, IncorrectBlockSize)
+{
+  FstStore fstStore(filePath);
+
+  EXPECT_THROW(fstStore.SetBlockSize(8192), runtime_error);
+  EXPECT_THROW(fstStore.SetBlockSize(100000), runtime_error);
+  EXPECT_THROW(fstStore.SetBlockSize(2 * MAX_BLOCK_SIZE), runtime_error);
+  EXPECT_THROW(fstStore.SetColumnBlockSize(0, 3 * BLOCKSIZE), runtime_error);
+  EXPECT_THROW(fstStore.SetColumnBlockSize(-1, BLOCKSIZE), runtime_error);
+
+  // the default block size can be set explicitly
+  fstStore.SetBlockSize(BLOCKSIZE);
+  GeneratedTable::WriteRows(fstStore, 0, 50000, 40, false);
+
+  CheckRows(50000);
+  EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION));
+}
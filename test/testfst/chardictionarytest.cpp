@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class CharDictionaryTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("chardictionary.fst");
+  }
+
+  // Short and repetitive strings that compress poorly in small blocks without a dictionary
+  static std::string StringValue(int row)
+  {
+    if (row % 97 == 5) return "NA";
+
+    const char* paths[] { "products", "customers/orders", "search", "account/settings" };
+    return "https://www.example.com/" + std::string(paths[row % 4]) + "?id=" + to_string((row * 7919) % 100003) +
+      "&ref=newsletter";
+  }
+
+  void WriteRows(int from, int nrOfRows, int compression, bool useDictionary, bool append)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(2, nrOfRows);
+
+    IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    StringColumn strVec;
+    strVec.AllocateVec(nrOfRows);
+
+    for (int pos = 0; pos < nrOfRows; pos++)
+    {
+      intVec.Data()[pos] = from + pos;
+      (*strVec.StrVector()->StrVec())[pos] = StringValue(from + pos);
+    }
+
+    fstTable.SetIntegerColumn(&intVec, 0);
+    fstTable.SetStringColumn(&strVec, 1);
+    fstTable.SetColumnNames(vector<std::string>{ "Id", "String" });
+
+    FstStore fstStore(filePath);
+    fstStore.SetCharacterDictionary(useDictionary);
+
+    if (append)
+    {
+      fstStore.fstAppend(fstTable, compression);
+      return;
+    }
+
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  static void CheckTable(FstTable &tableRead, const vector<int64_t> &rows)
+  {
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(rows.size()));
+
+    vector<std::string>* strings = ColumnVector<StringVector>(tableRead, 1)->StrVec();
+
+    for (size_t pos = 0; pos < rows.size(); pos++)
+    {
+      ASSERT_EQ((*strings)[pos], StringValue(static_cast<int>(rows[pos] - 1)));
+    }
+  }
+
+  // Read all rows, a row range and a selection of rows
+  void CheckRows(int nrOfRows)
+  {
+    FstStore fstStore(filePath);
+
+    for (int64_t startRow : { 1, 5000 })
+    {
+      FstTable tableRead;
+      ReadRows(fstStore, tableRead, startRow, -1);
+
+      vector<int64_t> rows;
+      for (int64_t row = startRow; row <= nrOfRows; row++) rows.push_back(row);
+
+      CheckTable(tableRead, rows);
+    }
+
+    vector<int64_t> rows { 1, 2047, 2048, 2048 };
+    for (int64_t row = 3000; row < nrOfRows; row += 1 + (row * 7) % 5003) rows.push_back(row);
+    rows.push_back(nrOfRows);
+
+    FstTable tableRead;
+    ReadSelectedRows(fstStore, tableRead, rows);
+
+    CheckTable(tableRead, rows);
+  }
+};
+
+
+TEST_F(CharDictionaryTest, WriteAndRead)
+{
+  for (int compression : { 20, 60, 100 })
+  {
+    WriteRows(0, 100000, compression, false, false);
+    const unsigned long long sizeWithoutDictionary = FileSize(filePath);
+
+    WriteRows(0, 100000, compression, true, false);
+    CheckRows(100000);
+
+    EXPECT_LT(FileSize(filePath), sizeWithoutDictionary);
+    EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION_CHAR_DICT));
+  }
+}
+
+
+TEST_F(CharDictionaryTest, SmallAndUncompressedColumns)
+{
+  // too few blocks to train a dictionary
+  WriteRows(0, 6000, 50, true, false);
+  CheckRows(6000);
+
+  // dictionaries are only used for compressed columns
+  WriteRows(0, 30000, 0, true, false);
+  CheckRows(30000);
+  EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION));
+}
+
+
+TEST_F(CharDictionaryTest, Append)
+{
+  WriteRows(0, 40000, 50, false, false);
+  EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION));
+
+  WriteRows(40000, 30000, 80, true, true);
+  EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION_CHAR_DICT));
+
+  WriteRows(70000, 20000, 30, false, true);
+  CheckRows(90000);
+}
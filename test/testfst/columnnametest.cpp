@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstreader.h>
+#include <interface/columnnameindex.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+
+TEST(ColumnNameTest, IndexLookup)
+{
+  StringColumn colNames;
+  colNames.AllocateVec(5);
+  *colNames.StrVector()->StrVec() = vector<std::string> { "a", "b", "", "a", "long column name" };
+
+  ColumnNameIndex index;
+  EXPECT_EQ(index.Find("a"), -1);
+
+  index.Build(&colNames, 5);
+
+  EXPECT_EQ(index.Find("a"), 0);  // first column of a duplicate name
+  EXPECT_EQ(index.Find("b"), 1);
+  EXPECT_EQ(index.Find(""), 2);
+  EXPECT_EQ(index.Find("long column name"), 4);
+  EXPECT_EQ(index.Find("c"), -1);
+  EXPECT_EQ(index.Find("long column"), -1);
+}
+
+
+TEST(ColumnNameTest, WideTableSelection)
+{
+  const std::string filePath = GetFilePath("columnname.fst");
+  const int nrOfCols = 20000;
+  const int nrOfRows = 3;
+
+  FstTable fstTable(nrOfRows);
+  fstTable.InitTable(nrOfCols, nrOfRows);
+
+  vector<std::unique_ptr<IntVectorAdapter>> columns;
+  vector<std::string> colNames;
+
+  for (int colNr = 0; colNr < nrOfCols; colNr++)
+  {
+    columns.emplace_back(new IntVectorAdapter(nrOfRows, FstColumnAttribute::NONE, 0));
+
+    for (int row = 0; row < nrOfRows; row++) columns[colNr]->Data()[row] = colNr * 10 + row;
+
+    fstTable.SetIntegerColumn(columns[colNr].get(), colNr);
+    colNames.push_back("col" + to_string(colNr));
+  }
+
+  fstTable.SetColumnNames(colNames);
+
+  FstStore fstStore(filePath);
+  fstStore.fstWrite(fstTable, 0);
+
+  vector<std::string> selection { "col19999", "col7", "col12345", "col7" };
+  StringArray columnSelection(selection);
+
+  ColumnFactory columnFactory;
+  FstReader reader(filePath, &columnFactory);
+
+  FstTable tableRead;
+  StringArray selectedCols;
+  std::vector<int> keyIndex;
+
+  reader.fstRead(tableRead, &columnSelection, 1, -1, &columnFactory, keyIndex, &selectedCols);
+
+  std::shared_ptr<DestructableObject> column;
+  FstColumnType type;
+  std::string colName, annotation;
+  short int scale;
+
+  const int expected[] { 19999, 7, 12345, 7 };
+
+  for (int colSel = 0; colSel < 4; colSel++)
+  {
+    tableRead.GetColumn(colSel, column, type, colName, scale, annotation);
+    EXPECT_EQ(static_cast<IntVector*>(&*column)->Data()[2], expected[colSel] * 10 + 2);
+  }
+
+  vector<std::string> missing { "col20000" };
+  StringArray missingSelection(missing);
+
+  EXPECT_THROW(reader.fstRead(tableRead, &missingSelection, 1, -1, &columnFactory, keyIndex, &selectedCols),
+    runtime_error);
+}
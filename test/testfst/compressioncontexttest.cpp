@@ -0,0 +1,139 @@
+#include "gtest/gtest.h"
+
+#include <compression/compression.h>
+#include <compression/compressioncontext.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+
+using namespace std;
+
+class CompressionContextTest : public ::testing::Test
+{
+protected:
+  // Compressible test block of 'size' bytes
+  static vector<char> TestBlock(unsigned int size, int seed)
+  {
+    vector<char> block(size);
+
+    for (unsigned int pos = 0; pos < size; pos++)
+    {
+      block[pos] = static_cast<char>((pos / 7 + seed) % 13);
+    }
+
+    return block;
+  }
+
+  // Compress and decompress a block with the reusable contexts of the calling thread
+  static bool RoundTrip(CompAlgorithm compress, DecompAlgorithm decompress, const vector<char> &block, int level)
+  {
+    vector<char> compressed(MAX_compressBound(block.size()));
+    vector<char> result(block.size());
+
+    const unsigned int compressedSize = compress(compressed.data(), static_cast<unsigned int>(compressed.size()),
+      block.data(), static_cast<unsigned int>(block.size()), level);
+
+    if (compressedSize == 0) return false;
+
+    if (decompress(result.data(), static_cast<unsigned int>(result.size()), compressed.data(), compressedSize) != 0)
+    {
+      return false;
+    }
+
+    return memcmp(block.data(), result.data(), block.size()) == 0;
+  }
+};
+
+
+TEST_F(CompressionContextTest, ReusedWithinThread)
+{
+  CompressionContext &context = CompressionContext::ForThread();
+
+  ZSTD_CCtx* zstdCompression = context.ZstdCompression();
+  ZSTD_DCtx* zstdDecompression = context.ZstdDecompression();
+  void* lz4State = context.Lz4State();
+
+  vector<char> block = TestBlock(16384, 0);
+  EXPECT_TRUE(RoundTrip(ZSTD_C, ZSTD_D, block, 50));
+  EXPECT_TRUE(RoundTrip(LZ4_C, LZ4_D, block, 50));
+
+  EXPECT_EQ(&CompressionContext::ForThread(), &context);
+  EXPECT_EQ(context.ZstdCompression(), zstdCompression);
+  EXPECT_EQ(context.ZstdDecompression(), zstdDecompression);
+  EXPECT_EQ(context.Lz4State(), lz4State);
+
+  // other threads have their own contexts
+  const CompressionContext* otherContext = nullptr;
+  std::thread other([&otherContext]() { otherContext = &CompressionContext::ForThread(); });
+  other.join();
+
+  EXPECT_NE(otherContext, &context);
+}
+
+
+TEST_F(CompressionContextTest, SameOutputAsOneShot)
+{
+  vector<char> block = TestBlock(16384, 3);
+  vector<char> expected(MAX_compressBound(block.size()));
+  vector<char> compressed(MAX_compressBound(block.size()));
+
+  for (int level : { 0, 30, 100 })
+  {
+    // a reused context must not change the compressed format
+    for (int repeat = 0; repeat < 2; repeat++)
+    {
+      const size_t expectedSize = ZSTD_compress(expected.data(), expected.size(), block.data(), block.size(),
+        (level * ZSTD_maxCLevel()) / 100);
+      const unsigned int size = ZSTD_C(compressed.data(), static_cast<unsigned int>(compressed.size()), block.data(),
+        static_cast<unsigned int>(block.size()), level);
+
+      ASSERT_EQ(size, expectedSize);
+      EXPECT_EQ(memcmp(expected.data(), compressed.data(), size), 0);
+
+      const int expectedLz4 = LZ4_compress_fast(block.data(), expected.data(), static_cast<int>(block.size()),
+        static_cast<int>(expected.size()), 101 - level);
+      const unsigned int sizeLz4 = LZ4_C(compressed.data(), static_cast<unsigned int>(compressed.size()), block.data(),
+        static_cast<unsigned int>(block.size()), level);
+
+      ASSERT_EQ(sizeLz4, static_cast<unsigned int>(expectedLz4));
+      EXPECT_EQ(memcmp(expected.data(), compressed.data(), sizeLz4), 0);
+    }
+  }
+}
+
+
+TEST_F(CompressionContextTest, ConcurrentThreads)
+{
+  const int nrOfThreads = 4;
+  vector<int> success(nrOfThreads, 0);
+  vector<std::thread> threads;
+
+  for (int thread = 0; thread < nrOfThreads; thread++)
+  {
+    threads.emplace_back([thread, &success]()
+    {
+      bool ok = true;
+
+      for (int block = 0; block < 50; block++)
+      {
+        vector<char> data = TestBlock(16384, thread * 50 + block);
+
+        ok = ok && RoundTrip(ZSTD_C, ZSTD_D, data, 20 + block);
+        ok = ok && RoundTrip(ZSTD_C_SHUF4, ZSTD_D_SHUF4, data, 20 + block);
+        ok = ok && RoundTrip(ZSTD_C_SHUF8, ZSTD_D_SHUF8, data, 20 + block);
+        ok = ok && RoundTrip(LZ4_C_SHUF4, LZ4_D_SHUF4, data, 20 + block);
+      }
+
+      success[thread] = ok ? 1 : 0;
+    });
+  }
+
+  for (std::thread &thread : threads) thread.join();
+
+  for (int thread = 0; thread < nrOfThreads; thread++)
+  {
+    EXPECT_EQ(success[thread], 1);
+  }
+}
@@ -0,0 +1,274 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <compression/compression.h>
+#include <compression/decimalcodec.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class DecimalCodecTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("decimalcodec.fst");
+  }
+
+  // NA value of R (a NaN with payload 1954)
+  static double NaValue()
+  {
+    const unsigned long long bits = 0x7FF00000000007A2ULL;
+    double value;
+    memcpy(&value, &bits, 8);
+
+    return value;
+  }
+
+  // Random walk of prices with 'decimals' decimals, every 'naInterval'-th value is NA
+  static vector<double> Prices(unsigned int size, int decimals, unsigned int naInterval, unsigned int seed)
+  {
+    std::mt19937 generator(seed);
+    const double scale = std::pow(10.0, decimals);
+    vector<double> values(size);
+    long long scaled = 1234567;
+
+    for (unsigned int pos = 0; pos < size; pos++)
+    {
+      scaled += static_cast<long long>(generator() % 41) - 20;
+      values[pos] = naInterval != 0 && pos % naInterval == 7 ? NaValue() : static_cast<double>(scaled) / scale;
+    }
+
+    return values;
+  }
+
+  static unsigned int RoundTrip(const vector<double> &values)
+  {
+    const unsigned int bound = DecimalSizeBound(static_cast<unsigned int>(8 * values.size()));
+    const unsigned int encodedSize = CodecRoundTrip(values, DECIMAL_DOUBLE_C, DECIMAL_DOUBLE_D, bound);
+
+    EXPECT_EQ(encodedSize, DecimalSize(values.data(), static_cast<unsigned int>(values.size()), DECIMAL_DETECT));
+
+    return encodedSize;
+  }
+
+  static int DetectedScale(const vector<double> &values)
+  {
+    const unsigned int srcSize = static_cast<unsigned int>(8 * values.size());
+    vector<char> encoded(DecimalSizeBound(srcSize));
+
+    if (DECIMAL_DOUBLE_C(encoded.data(), static_cast<unsigned int>(encoded.size()),
+      reinterpret_cast<const char*>(values.data()), srcSize, 0) == 0) return -1;
+
+    return encoded[0];
+  }
+
+  void WriteRows(const vector<double> &values, int compression, bool extendedCodecs, int decimals)
+  {
+    const int nrOfRows = static_cast<int>(values.size());
+
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(1, nrOfRows);
+
+    DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    memcpy(doubleVec.Data(), values.data(), 8 * values.size());
+
+    fstTable.SetDoubleColumn(&doubleVec, 0);
+    fstTable.SetColumnNames(vector<std::string>{ "Price" });
+
+    FstStore fstStore(filePath);
+    fstStore.SetExtendedCodecs(extendedCodecs);
+    if (decimals != DECIMAL_DETECT) fstStore.SetColumnDecimals(0, decimals);
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  void CheckRows(const vector<double> &values, int startRow)
+  {
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    ReadRows(fstStore, tableRead, startRow, -1);
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(values.size() - startRow + 1));
+
+    double* doubleP = ColumnVector<DoubleVector>(tableRead, 0)->Data();
+    ASSERT_EQ(memcmp(doubleP, &values[startRow - 1], 8 * (values.size() - startRow + 1)), 0);
+  }
+};
+
+
+TEST_F(DecimalCodecTest, RoundTrip)
+{
+  for (unsigned int size : { 1U, 2U, 255U, 256U, 257U, 2048U, 16387U })
+  {
+    for (int decimals = 0; decimals <= 6; decimals += 2)
+    {
+      RoundTrip(Prices(size, decimals, 0, size));
+      RoundTrip(Prices(size, decimals, 100, size));
+    }
+
+    RoundTrip(vector<double>(size, 3.25));
+    RoundTrip(vector<double>(size, NaValue()));
+  }
+}
+
+
+TEST_F(DecimalCodecTest, DetectedScale)
+{
+  EXPECT_EQ(DetectedScale(vector<double> { 1.0, -2.0, 1e15 }), 0);
+  EXPECT_EQ(DetectedScale(vector<double> { 0.1, 0.2, 0.3 }), 1);
+  EXPECT_EQ(DetectedScale(Prices(1000, 2, 50, 1)), 2);
+  EXPECT_EQ(DetectedScale(vector<double> { 1.5, 0.000001, 7.0 }), 6);
+  EXPECT_EQ(DetectedScale(vector<double> { 0.123456789 }), 9);
+
+  // constant prices with 2 decimals are stored as a header without packed values
+  EXPECT_EQ(RoundTrip(vector<double>(2048, 19.99)), static_cast<unsigned int>(DECIMAL_HEADER_SIZE + 16));
+}
+
+
+TEST_F(DecimalCodecTest, Rejected)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  EXPECT_EQ(DetectedScale(vector<double> { 1.0, 1.0 / 3.0 }), -1);
+  EXPECT_EQ(DetectedScale(vector<double> { 1.0, -0.0 }), -1);
+  EXPECT_EQ(DetectedScale(vector<double> { 1.0, std::numeric_limits<double>::infinity() }), -1);
+  EXPECT_EQ(DetectedScale(vector<double> { 1.0, 1e300 }), -1);
+  EXPECT_EQ(DetectedScale(vector<double> { 1.0, 0.0000000001 }), -1);
+
+  // a single NaN bit pattern per block
+  EXPECT_EQ(DetectedScale(vector<double> { NaValue(), 1.0, NaValue() }), 0);
+  EXPECT_EQ(DetectedScale(vector<double> { NaValue(), 1.0, nan }), -1);
+
+  // a fixed number of decimals is not raised
+  const vector<double> prices = Prices(100, 2, 0, 3);
+  vector<char> encoded(DecimalSizeBound(800));
+
+  EXPECT_EQ(DecimalEncode(encoded.data(), static_cast<unsigned int>(encoded.size()),
+    reinterpret_cast<const char*>(prices.data()), 800, 1), 0U);
+  EXPECT_GT(DecimalEncode(encoded.data(), static_cast<unsigned int>(encoded.size()),
+    reinterpret_cast<const char*>(prices.data()), 800, 4), 0U);
+  EXPECT_EQ(encoded[0], 4);
+
+  // corrupted header
+  encoded[0] = DECIMAL_MAX_SCALE + 1;
+  vector<double> restored(100);
+  EXPECT_NE(DECIMAL_DOUBLE_D(reinterpret_cast<char*>(restored.data()), 800, encoded.data(), 100), 0U);
+}
+
+
+TEST_F(DecimalCodecTest, PriceColumns)
+{
+  const vector<double> prices = Prices(250007, 2, 1000, 5);
+
+  // from compression level 50 all blocks are compressed
+  for (int compression : { 50, 80 })
+  {
+    WriteRows(prices, compression, false, DECIMAL_DETECT);
+    const unsigned long long defaultSize = FileSize(filePath);
+    EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION));
+
+    // detected decimals
+    WriteRows(prices, compression, true, DECIMAL_DETECT);
+    CheckRows(prices, 1);
+    CheckRows(prices, 123457);
+    EXPECT_LT(3 * FileSize(filePath), defaultSize);
+
+    // fixed decimals without the other extended codecs
+    WriteRows(prices, compression, false, 2);
+    CheckRows(prices, 1);
+    EXPECT_LT(3 * FileSize(filePath), defaultSize);
+    EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION_CODECS));
+  }
+
+  // values with more decimals than specified use the default codecs
+  const vector<double> finePrices = Prices(50000, 4, 0, 9);
+  WriteRows(finePrices, 60, false, 2);
+  CheckRows(finePrices, 1);
+}
+
+
+TEST_F(DecimalCodecTest, ColumnDecimalsRange)
+{
+  FstStore fstStore(filePath);
+
+  EXPECT_THROW(fstStore.SetColumnDecimals(0, -1), std::runtime_error);
+  EXPECT_THROW(fstStore.SetColumnDecimals(0, DECIMAL_MAX_SCALE + 1), std::runtime_error);
+  EXPECT_THROW(fstStore.SetColumnDecimals(-1, 2), std::runtime_error);
+  EXPECT_NO_THROW(fstStore.SetColumnDecimals(3, 2));
+}
+
+
+TEST_F(DecimalCodecTest, DISABLED_Benchmark)
+{
+  const unsigned int nrOfDoubles = 2048;  // single 16 KB block
+  const int nrOfRepeats = 1000;
+  const unsigned int srcSize = 8 * nrOfDoubles;
+
+  struct Codec
+  {
+    const char* name;
+    unsigned int (*compress)(char*, unsigned int, const char*, unsigned int, int);
+    unsigned int (*decompress)(char*, unsigned int, const char*, unsigned int);
+    int level;
+  };
+
+  const Codec codecs[] { { "DECIMAL_DOUBLE", DECIMAL_DOUBLE_C, DECIMAL_DOUBLE_D, 0 },
+    { "LZ4_SHUF8", LZ4_C_SHUF8, LZ4_D_SHUF8, 0 }, { "ZSTD_SHUF8 (20)", ZSTD_C_SHUF8, ZSTD_D_SHUF8, 20 },
+    { "ZSTD_SHUF8 (60)", ZSTD_C_SHUF8, ZSTD_D_SHUF8, 60 } };
+
+  for (int decimals : { 2, 6 })
+  {
+    const vector<double> values = Prices(nrOfDoubles, decimals, 0, 1);
+    const char* src = reinterpret_cast<const char*>(values.data());
+
+    for (const Codec &codec : codecs)
+    {
+      vector<char> compressed(2 * srcSize + 1024);
+      vector<char> restored(srcSize);
+      unsigned int compressedSize = 0;
+
+      auto start = std::chrono::steady_clock::now();
+
+      for (int repeat = 0; repeat < nrOfRepeats; repeat++)
+      {
+        compressedSize = codec.compress(compressed.data(), static_cast<unsigned int>(compressed.size()), src, srcSize,
+          codec.level);
+      }
+
+      const double compressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      start = std::chrono::steady_clock::now();
+
+      for (int repeat = 0; repeat < nrOfRepeats; repeat++)
+      {
+        codec.decompress(restored.data(), srcSize, compressed.data(), compressedSize);
+      }
+
+      const double decompressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      ASSERT_EQ(memcmp(src, restored.data(), srcSize), 0);
+
+      std::cout << decimals << " decimals, " << codec.name << ": ratio "
+        << static_cast<double>(srcSize) / compressedSize << ", compress "
+        << (static_cast<double>(srcSize) * nrOfRepeats) / (compressSeconds * 1e9) << " GB/s, decompress "
+        << (static_cast<double>(srcSize) * nrOfRepeats) / (decompressSeconds * 1e9) << " GB/s" << std::endl;
+    }
+  }
+}
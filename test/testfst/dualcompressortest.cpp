@@ -0,0 +1,185 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <compression/compressor.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class DualCompressorTest : public ::testing::Test
+{
+protected:
+  static const int nrOfBlocks = 64;
+  static const unsigned int blockSize = 16384;
+
+  vector<char> data;
+
+  virtual void SetUp()
+  {
+    // small random values, ZSTD's entropy coding compresses them much better than LZ4
+    std::mt19937 generator(11);
+    data.resize(static_cast<size_t>(nrOfBlocks) * blockSize);
+
+    for (char &value : data) value = static_cast<char>(generator() % 16);
+  }
+
+  // Compress all blocks in parallel, like the blockstreamer does, and return the sizes and algorithms
+  void CompressBlocks(DualCompressor &compressor, int nrOfThreads, vector<int> &sizes, vector<CompAlgo> &algorithms)
+  {
+    const int bufSize = compressor.CompressBufferSize(blockSize);
+    vector<char> compBuf(static_cast<size_t>(nrOfBlocks) * bufSize);
+
+    sizes.assign(nrOfBlocks, 0);
+    algorithms.assign(nrOfBlocks, CompAlgo::UNCOMPRESS);
+    compressor.PrepareThreadStates(nrOfThreads);
+
+#pragma omp parallel for schedule(static, 1) num_threads(nrOfThreads)
+    for (int block = 0; block < nrOfBlocks; block++)
+    {
+      CompAlgo algorithm;
+      sizes[block] = compressor.Compress(&compBuf[static_cast<size_t>(block) * bufSize], bufSize,
+        &data[static_cast<size_t>(block) * blockSize], blockSize, algorithm);
+      algorithms[block] = algorithm;
+    }
+
+    compressor.MergeThreadStates();
+
+    // all blocks decompress to the source data
+    vector<char> restored(blockSize);
+
+    for (int block = 0; block < nrOfBlocks; block++)
+    {
+      ASSERT_EQ(Decompressor::Decompress(static_cast<unsigned int>(algorithms[block]), restored.data(), blockSize,
+        &compBuf[static_cast<size_t>(block) * bufSize], sizes[block]), 0);
+      ASSERT_EQ(memcmp(restored.data(), &data[static_cast<size_t>(block) * blockSize], blockSize), 0);
+    }
+  }
+};
+
+
+TEST_F(DualCompressorTest, AdaptsToStrongerAlgorithm)
+{
+  DualCompressor compressor(CompAlgo::LZ4, CompAlgo::ZSTD, 0, 10, 1);
+  EXPECT_EQ(compressor.Algorithm1Ratio(), 50);
+
+  vector<int> sizes;
+  vector<CompAlgo> algorithms;
+  CompressBlocks(compressor, 1, sizes, algorithms);
+
+  // the weaker first algorithm is used for a minority of the blocks
+  int nrOfAlgo1 = 0;
+  for (CompAlgo algorithm : algorithms) nrOfAlgo1 += algorithm == CompAlgo::LZ4 ? 1 : 0;
+
+  EXPECT_GT(nrOfAlgo1, 0);
+  EXPECT_LT(nrOfAlgo1, nrOfBlocks / 4);
+  EXPECT_EQ(compressor.Algorithm1Ratio(), 5);
+}
+
+
+TEST_F(DualCompressorTest, DeterministicPerThreadState)
+{
+  for (int nrOfThreads : { 2, 4 })
+  {
+    vector<int> sizes, sizesRepeat;
+    vector<CompAlgo> algorithms, algorithmsRepeat;
+
+    DualCompressor compressor(CompAlgo::LZ4, CompAlgo::ZSTD, 0, 10, nrOfThreads);
+    CompressBlocks(compressor, nrOfThreads, sizes, algorithms);
+
+    DualCompressor compressorRepeat(CompAlgo::LZ4, CompAlgo::ZSTD, 0, 10, nrOfThreads);
+    CompressBlocks(compressorRepeat, nrOfThreads, sizesRepeat, algorithmsRepeat);
+
+    EXPECT_EQ(sizes, sizesRepeat);
+    EXPECT_EQ(algorithms, algorithmsRepeat);
+    EXPECT_EQ(compressor.Algorithm1Ratio(), compressorRepeat.Algorithm1Ratio());
+  }
+}
+
+
+TEST_F(DualCompressorTest, MergedStateIsReused)
+{
+  DualCompressor compressor(CompAlgo::LZ4, CompAlgo::ZSTD, 0, 10, 4);
+
+  vector<int> sizes;
+  vector<CompAlgo> algorithms;
+  CompressBlocks(compressor, 4, sizes, algorithms);
+
+  const int mergedRatio = compressor.Algorithm1Ratio();
+  EXPECT_LT(mergedRatio, 50);
+
+  // the next column starts from the merged statistics instead of an even split
+  CompressBlocks(compressor, 4, sizes, algorithms);
+  EXPECT_LE(compressor.Algorithm1Ratio(), mergedRatio);
+}
+
+
+TEST_F(DualCompressorTest, StatesGrowWithThreads)
+{
+  vector<int> sizes, sizesGrown;
+  vector<CompAlgo> algorithms, algorithmsGrown;
+
+  DualCompressor compressor(CompAlgo::LZ4, CompAlgo::ZSTD, 0, 10, 4);
+  CompressBlocks(compressor, 4, sizes, algorithms);
+
+  // a compressor created for a single thread gets a state for each thread of the parallel region
+  DualCompressor compressorGrown(CompAlgo::LZ4, CompAlgo::ZSTD, 0, 10, 1);
+  CompressBlocks(compressorGrown, 4, sizesGrown, algorithmsGrown);
+
+  EXPECT_EQ(sizes, sizesGrown);
+  EXPECT_EQ(algorithms, algorithmsGrown);
+  EXPECT_EQ(compressor.Algorithm1Ratio(), compressorGrown.Algorithm1Ratio());
+}
+
+
+TEST_F(DualCompressorTest, UnusedStatesAreNotMerged)
+{
+  vector<int> sizes;
+  vector<CompAlgo> algorithms;
+
+  DualCompressor compressor(CompAlgo::LZ4, CompAlgo::ZSTD, 0, 10, 1);
+  CompressBlocks(compressor, 1, sizes, algorithms);
+
+  // the idle states of three threads keep the initial ratio, which doesn't dilute the merged ratio
+  DualCompressor compressorIdle(CompAlgo::LZ4, CompAlgo::ZSTD, 0, 10, 4);
+  CompressBlocks(compressorIdle, 1, sizes, algorithms);
+
+  EXPECT_EQ(compressorIdle.Algorithm1Ratio(), compressor.Algorithm1Ratio());
+}
+
+
+TEST_F(DualCompressorTest, UnpreparedThreadsShareState)
+{
+  DualCompressor compressor(CompAlgo::LZ4, CompAlgo::ZSTD, 0, 10, 1);
+
+  const int bufSize = compressor.CompressBufferSize(blockSize);
+  vector<char> compBuf(static_cast<size_t>(nrOfBlocks) * bufSize);
+  vector<int> sizes(nrOfBlocks);
+  vector<CompAlgo> algorithms(nrOfBlocks);
+
+  // without PrepareThreadStates, threads other than the first use the locked shared state
+#pragma omp parallel for schedule(static, 1) num_threads(4)
+  for (int block = 0; block < nrOfBlocks; block++)
+  {
+    CompAlgo algorithm;
+    sizes[block] = compressor.Compress(&compBuf[static_cast<size_t>(block) * bufSize], bufSize,
+      &data[static_cast<size_t>(block) * blockSize], blockSize, algorithm);
+    algorithms[block] = algorithm;
+  }
+
+  compressor.MergeThreadStates();
+  EXPECT_LT(compressor.Algorithm1Ratio(), 50);
+
+  vector<char> restored(blockSize);
+
+  for (int block = 0; block < nrOfBlocks; block++)
+  {
+    ASSERT_EQ(Decompressor::Decompress(static_cast<unsigned int>(algorithms[block]), restored.data(), blockSize,
+      &compBuf[static_cast<size_t>(block) * bufSize], sizes[block]), 0);
+    ASSERT_EQ(memcmp(restored.data(), &data[static_cast<size_t>(block) * blockSize], blockSize), 0);
+  }
+}
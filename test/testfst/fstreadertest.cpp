@@ -0,0 +1,195 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstreader.h>
+#include <interface/fstdefines.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class FstReaderTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("fstreader.fst");
+  }
+
+  static std::string StringValue(int row)
+  {
+    return "s" + to_string(row % 1000);
+  }
+
+  // Write or append rows [from, from + nrOfRows)
+  void WriteRows(int from, int nrOfRows, int compression, bool append)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(3, nrOfRows);
+
+    IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    StringColumn strVec;
+    strVec.AllocateVec(nrOfRows);
+
+    for (int pos = 0; pos < nrOfRows; pos++)
+    {
+      const int row = from + pos;
+
+      intVec.Data()[pos] = row;
+      doubleVec.Data()[pos] = 0.5 * row;
+      (*strVec.StrVector()->StrVec())[pos] = StringValue(row);
+    }
+
+    fstTable.SetIntegerColumn(&intVec, 0);
+    fstTable.SetDoubleColumn(&doubleVec, 1);
+    fstTable.SetStringColumn(&strVec, 2);
+    fstTable.SetColumnNames(vector<std::string>{ "Id", "Double", "String" });
+
+    FstStore fstStore(filePath);
+
+    if (append)
+    {
+      fstStore.fstAppend(fstTable, compression);
+      return;
+    }
+
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  // Read rows [startRow, endRow] (one based) and count the rows with unexpected values
+  static int CountErrors(const FstReader &reader, int startRow, int endRow)
+  {
+    FstTable tableRead;
+    StringArray selectedCols;
+    ColumnFactory columnFactory;
+    std::vector<int> keyIndex;
+
+    reader.fstRead(tableRead, nullptr, startRow, endRow, &columnFactory, keyIndex, &selectedCols);
+
+    if (tableRead.NrOfRows() != static_cast<uint64_t>(endRow - startRow + 1)) return 1;
+
+    std::shared_ptr<DestructableObject> column;
+    FstColumnType type;
+    std::string colName, annotation;
+    short int scale;
+
+    tableRead.GetColumn(0, column, type, colName, scale, annotation);
+    int* intP = static_cast<IntVector*>(&*column)->Data();
+
+    tableRead.GetColumn(1, column, type, colName, scale, annotation);
+    double* doubleP = static_cast<DoubleVector*>(&*column)->Data();
+
+    tableRead.GetColumn(2, column, type, colName, scale, annotation);
+    vector<std::string>* strings = static_cast<StringVector*>(&*column)->StrVec();
+
+    int errors = 0;
+
+    for (int pos = 0; pos <= endRow - startRow; pos++)
+    {
+      const int row = startRow - 1 + pos;
+
+      if (intP[pos] != row || doubleP[pos] != 0.5 * row || (*strings)[pos] != StringValue(row)) errors++;
+    }
+
+    return errors;
+  }
+};
+
+
+TEST_F(FstReaderTest, Metadata)
+{
+  WriteRows(0, 20000, 50, false);
+  WriteRows(20000, 10000, 0, true);
+
+  ColumnFactory columnFactory;
+  FstReader reader(filePath, &columnFactory);
+
+  EXPECT_EQ(reader.NrOfRows(), 30000ULL);
+  EXPECT_EQ(reader.NrOfColumns(), 3);
+  EXPECT_STREQ(reader.ColumnNames()->GetElement(1), "Double");
+  EXPECT_EQ(reader.ColumnTypes()[2], 6);  // character column
+
+  // rows appended after opening are not visible to the reader
+  WriteRows(30000, 5000, 0, true);
+  EXPECT_EQ(reader.NrOfRows(), 30000ULL);
+  EXPECT_EQ(CountErrors(reader, 19990, 30000), 0);
+
+  EXPECT_THROW(CountErrors(reader, 30001, 30001), runtime_error);
+}
+
+
+TEST_F(FstReaderTest, RepeatedReads)
+{
+  WriteRows(0, 30000, 30, false);
+  WriteRows(30000, 30000, 80, true);
+
+  for (bool memoryMapped : { false, true })
+  {
+    ColumnFactory columnFactory;
+    FstReader reader(filePath, &columnFactory, memoryMapped);
+
+    for (int startRow = 1; startRow < 60000; startRow += 7919)
+    {
+      EXPECT_EQ(CountErrors(reader, startRow, std::min(startRow + 5000, 60000)), 0);
+    }
+
+    // row selection and predicates use the same cached metadata
+    FstTable tableRead;
+    StringArray selectedCols;
+    std::vector<int> keyIndex;
+
+    reader.fstReadRows(tableRead, nullptr, vector<int64_t> { 1, 29999, 30001, 60000 }, &columnFactory, keyIndex,
+      &selectedCols);
+    EXPECT_EQ(tableRead.NrOfRows(), 4ULL);
+
+    FstTable filteredRead;
+    reader.fstReadFiltered(filteredRead, nullptr, { FstPredicate::Range("Id", 29000LL, 31999LL) }, &columnFactory,
+      keyIndex, &selectedCols);
+    EXPECT_EQ(filteredRead.NrOfRows(), 3000ULL);
+  }
+}
+
+
+TEST_F(FstReaderTest, ConcurrentReads)
+{
+  WriteRows(0, 40000, 50, false);
+  WriteRows(40000, 20000, 0, true);
+
+  ColumnFactory columnFactory;
+  const FstReader reader(filePath, &columnFactory);
+
+  const int nrOfThreads = 4;
+  vector<int> errors(nrOfThreads, 0);
+  vector<std::thread> threads;
+
+  for (int thread = 0; thread < nrOfThreads; thread++)
+  {
+    threads.emplace_back([&reader, &errors, thread]()
+    {
+      for (int startRow = 1 + 1000 * thread; startRow < 60000; startRow += 9973)
+      {
+        errors[thread] += CountErrors(reader, startRow, std::min(startRow + 3000, 60000));
+      }
+    });
+  }
+
+  for (auto &thread : threads) thread.join();
+
+  for (int thread = 0; thread < nrOfThreads; thread++)
+  {
+    EXPECT_EQ(errors[thread], 0);
+  }
+}
@@ -1,12 +1,14 @@
 
 #include <string>
 #include <climits>
+#include <fstream>
 
 #include "gtest/gtest.h"
 #include "gtest/internal/gtest-filepath.h"
 
 #include <interface/fststore.h>
 #include <interface/icolumnfactory.h>
+#include <interface/openmphelper.h>
 
 #include <fsttable.h>
 #include <columnfactory.h>
@@ -83,6 +85,133 @@ TEST_F(FstReadTest, WrongFormat)
 }
 
 
+TEST_F(FstReadTest, ConcurrentPositionalReads)
+{
+  // uncompressed column that spans many read blocks
+  const int nrOfRows = 300000;
+
+  FstTable table(nrOfRows);
+  table.InitTable(1, nrOfRows);
+
+  IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+  for (int row = 0; row < nrOfRows; row++) intVec.Data()[row] = 3 * row;
+
+  table.SetIntegerColumn(&intVec, 0);
+  table.SetColumnNames(vector<std::string>{ "Int" });
+
+  std::string filePath = GetFilePath("positional.fst");
+  FstStore fstStore(filePath);
+  fstStore.fstWrite(table, 0);
+
+  const int prevThreads = ThreadsFst(4);
+
+  FstTable tableRead;
+  std::unique_ptr<StringColumn> col_names(new StringColumn());
+  fstStore.fstRead(tableRead, nullptr, 7, 299990, columnFactory, keyIndex, selectedCols, col_names.get());
+
+  std::shared_ptr<DestructableObject> column;
+  FstColumnType type;
+  std::string colName, annotation;
+  short int scale;
+
+  tableRead.GetColumn(0, column, type, colName, scale, annotation);
+  int* intP = static_cast<IntVector*>(&*column)->Data();
+
+  for (int pos = 0; pos < 299984; pos++)
+  {
+    ASSERT_EQ(intP[pos], 3 * (pos + 6));
+  }
+
+  // truncated column data is detected
+  std::string truncatedPath = GetFilePath("positional_truncated.fst");
+  {
+    ifstream source(filePath.c_str(), ios::binary);
+    std::string content((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+    ofstream truncated(truncatedPath.c_str(), ios::binary);
+    truncated.write(content.data(), content.size() / 2);
+  }
+
+  FstStore truncatedStore(truncatedPath);
+  FstTable truncatedTable;
+  std::unique_ptr<StringColumn> col_names2(new StringColumn());
+  EXPECT_THROW(truncatedStore.fstRead(truncatedTable, nullptr, 1, -1, columnFactory, keyIndex, selectedCols, col_names2.get()),
+    std::runtime_error);
+
+  ThreadsFst(prevThreads);
+}
+
+
+TEST_F(FstReadTest, MemoryMappedRead)
+{
+  const int nrOfRows = 10000;
+
+  FstTable table(nrOfRows);
+  table.InitTable(3, nrOfRows);
+
+  IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+  DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+  StringColumn strVec;
+  strVec.AllocateVec(nrOfRows);
+  vector<std::string>* strings = strVec.StrVector()->StrVec();
+
+  for (int row = 0; row < nrOfRows; row++)
+  {
+    intVec.Data()[row] = row - 500;
+    doubleVec.Data()[row] = 0.25 * row;
+    (*strings)[row] = to_string(row);
+  }
+
+  table.SetIntegerColumn(&intVec, 0);
+  table.SetDoubleColumn(&doubleVec, 1);
+  table.SetStringColumn(&strVec, 2);
+  table.SetColumnNames(vector<std::string>{ "Int", "Double", "String" });
+
+  std::string filePath = GetFilePath("mapped.fst");
+  FstStore fstStore(filePath);
+  fstStore.fstWrite(table, 0);
+
+  std::shared_ptr<DestructableObject> column;
+  FstColumnType type;
+  std::string colName, annotation;
+  short int scale;
+
+  {
+    FstStore mappedStore(filePath);
+    mappedStore.SetMemoryMapped(true);
+
+    FstTable tableRead;
+    std::unique_ptr<StringColumn> col_names(new StringColumn());
+    mappedStore.fstRead(tableRead, nullptr, 101, 9000, columnFactory, keyIndex, selectedCols, col_names.get());
+
+    tableRead.GetColumn(0, column, type, colName, scale, annotation);
+    int* intP = static_cast<IntVector*>(&*column)->Data();
+
+    tableRead.GetColumn(1, column, type, colName, scale, annotation);
+    double* doubleP = static_cast<DoubleVector*>(&*column)->Data();
+
+    tableRead.GetColumn(2, column, type, colName, scale, annotation);
+    vector<std::string>* strRead = static_cast<StringVector*>(&*column)->StrVec();
+
+    for (int pos = 0; pos < 8900; pos++)
+    {
+      ASSERT_EQ(intP[pos], pos - 400);
+      ASSERT_EQ(doubleP[pos], 0.25 * (pos + 100));
+      ASSERT_EQ((*strRead)[pos], to_string(pos + 100));
+    }
+
+    // modifications of the column data are never written to the file
+    intP[0] = 7;
+  }
+
+  FstTable tableRead;
+  std::unique_ptr<StringColumn> col_names(new StringColumn());
+  fstStore.fstRead(tableRead, nullptr, 101, 101, columnFactory, keyIndex, selectedCols, col_names.get());
+
+  tableRead.GetColumn(0, column, type, colName, scale, annotation);
+  EXPECT_EQ(static_cast<IntVector*>(&*column)->Data()[0], -400);
+}
+
+
 //TEST_F(FstReadTest, FromFileRead)
 //{
 //	// Define column name
@@ -70,3 +70,31 @@ TEST_F(FstWriteTest, MixedColumns)
 	ReadWriteTester::WriteReadSingleColumns(fstTable, filePath, 70);
 }
 
+
+
+TEST_F(FstWriteTest, PipelinedWrite)
+{
+	// column data exceeds the size of the write buffers that are queued for the writer thread
+	const int nrOfRows = 1000000;
+	FstTable fstTable(nrOfRows);
+	fstTable.InitTable(2, nrOfRows);
+
+	IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::INT_32_BASE, 0);
+	IntSeq(intVec.Data(), nrOfRows, 0);
+	fstTable.SetIntegerColumn(&intVec, 0);
+
+	DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::DOUBLE_64_BASE, 0);
+	for (int row = 0; row < nrOfRows; row++) doubleVec.Data()[row] = row * 0.25;
+	fstTable.SetDoubleColumn(&doubleVec, 1);
+
+	vector<std::string> colnames = { "Integer", "Double" };
+	StringArray colNames(colnames);
+	fstTable.SetColumnNames(colNames);
+
+	const int prevThreads = ThreadsFst(4);
+
+	ReadWriteTester::WriteReadFullTable(fstTable, filePath, 0);
+	ReadWriteTester::WriteReadFullTable(fstTable, filePath, 50);
+
+	ThreadsFst(prevThreads);
+}
@@ -0,0 +1,262 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstreader.h>
+#include <interface/fstdefines.h>
+#include <interface/fstpredicate.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class HorzChunksetTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("horzchunkset.fst");
+  }
+
+  // Table with rows [from, from + nrOfRows) of the named columns
+  struct TableColumns
+  {
+    FstTable fstTable;
+    vector<std::shared_ptr<void>> columns;
+
+    TableColumns(const vector<std::string> &colNames, int from, int nrOfRows) : fstTable(nrOfRows)
+    {
+      fstTable.InitTable(static_cast<uint32_t>(colNames.size()), nrOfRows);
+
+      for (size_t col = 0; col < colNames.size(); col++)
+      {
+        const std::string &colName = colNames[col];
+        const int colNr = static_cast<int>(col);
+
+        if (colName == "Id")
+        {
+          std::shared_ptr<IntVectorAdapter> vec(new IntVectorAdapter(nrOfRows, FstColumnAttribute::NONE, 0));
+          for (int pos = 0; pos < nrOfRows; pos++) vec->Data()[pos] = from + pos;
+          fstTable.SetIntegerColumn(vec.get(), colNr);
+          columns.push_back(vec);
+        }
+        else if (colName == "Value")
+        {
+          std::shared_ptr<DoubleVectorAdapter> vec(new DoubleVectorAdapter(nrOfRows, FstColumnAttribute::NONE, 0));
+          for (int pos = 0; pos < nrOfRows; pos++) vec->Data()[pos] = 0.25 * (from + pos);
+          fstTable.SetDoubleColumn(vec.get(), colNr);
+          columns.push_back(vec);
+        }
+        else if (colName == "Big")
+        {
+          std::shared_ptr<Int64VectorAdapter> vec(new Int64VectorAdapter(nrOfRows, FstColumnAttribute::INT_64_BASE, 0));
+          for (int pos = 0; pos < nrOfRows; pos++) vec->Data()[pos] = 10000000000LL * (from + pos);
+          fstTable.SetInt64Column(vec.get(), colNr);
+          columns.push_back(vec);
+        }
+        else if (colName == "Level")
+        {
+          std::shared_ptr<FactorVectorAdapter> vec(new FactorVectorAdapter(nrOfRows, 3, FstColumnAttribute::FACTOR_BASE));
+          *vec->DataPtr()->Levels()->StrVector()->StrVec() = vector<std::string> { "a", "b", "c" };
+          for (int pos = 0; pos < nrOfRows; pos++) vec->LevelData()[pos] = 1 + (from + pos) % 3;
+          fstTable.SetFactorColumn(vec.get(), colNr);
+          columns.push_back(vec);
+        }
+        else  // string columns
+        {
+          std::shared_ptr<StringColumn> vec(new StringColumn());
+          vec->AllocateVec(nrOfRows);
+          for (int pos = 0; pos < nrOfRows; pos++) (*vec->StrVector()->StrVec())[pos] = StringValue(colName, from + pos);
+          fstTable.SetStringColumn(vec.get(), colNr);
+          columns.push_back(vec);
+        }
+      }
+
+      fstTable.SetColumnNames(colNames);
+    }
+  };
+
+  static std::string StringValue(const std::string &colName, int row)
+  {
+    return colName + to_string(row % 1000);
+  }
+
+  void Write(const vector<std::string> &colNames, int from, int nrOfRows, bool append)
+  {
+    TableColumns table(colNames, from, nrOfRows);
+    FstStore fstStore(filePath);
+
+    if (append)
+    {
+      fstStore.fstAppend(table.fstTable, 40);
+      return;
+    }
+
+    fstStore.fstWrite(table.fstTable, 40);
+  }
+
+  void AddColumns(const vector<std::string> &colNames, int nrOfRows, int compression)
+  {
+    TableColumns table(colNames, 0, nrOfRows);
+    FstStore fstStore(filePath);
+    fstStore.fstAppendColumns(table.fstTable, compression);
+  }
+
+  // Compare the columns of a result table with the generated values of 'rows'
+  static void CheckTable(FstTable &tableRead, StringArray &selectedCols, const vector<std::string> &expectedCols,
+    const vector<int> &rows)
+  {
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(rows.size()));
+    ASSERT_EQ(tableRead.NrOfColumns(), static_cast<uint32_t>(expectedCols.size()));
+
+    for (size_t col = 0; col < expectedCols.size(); col++)
+    {
+      std::shared_ptr<DestructableObject> column;
+      FstColumnType type;
+      std::string colName, annotation;
+      short int scale;
+
+      tableRead.GetColumn(static_cast<uint32_t>(col), column, type, colName, scale, annotation);
+      colName = selectedCols.GetElement(col);
+      ASSERT_EQ(colName, expectedCols[col]);
+
+      for (size_t pos = 0; pos < rows.size(); pos++)
+      {
+        const int row = rows[pos];
+
+        if (colName == "Id") ASSERT_EQ(static_cast<IntVector*>(&*column)->Data()[pos], row);
+        else if (colName == "Value") ASSERT_EQ(static_cast<DoubleVector*>(&*column)->Data()[pos], 0.25 * row);
+        else if (colName == "Big") ASSERT_EQ(static_cast<LongVector*>(&*column)->Data()[pos], 10000000000LL * row);
+        else if (colName == "Level")
+        {
+          FactorVector* factorVec = static_cast<FactorVector*>(&*column);
+          ASSERT_EQ((*factorVec->Levels()->StrVector()->StrVec())[factorVec->Data()[pos] - 1], std::string(1, 'a' + row % 3));
+        }
+        else ASSERT_EQ((*static_cast<StringVector*>(&*column)->StrVec())[pos], StringValue(colName, row));
+      }
+    }
+  }
+
+  // Read rows [startRow, endRow] (one based) of the selected columns (all columns when empty)
+  void CheckRange(const vector<std::string> &selection, const vector<std::string> &allCols, int startRow, int endRow)
+  {
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    StringArray selectedCols;
+    ColumnFactory columnFactory;
+    std::vector<int> keyIndex;
+    std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+    vector<std::string> cols(selection);
+    StringArray columnSelection(cols);
+
+    fstStore.fstRead(tableRead, selection.empty() ? nullptr : &columnSelection, startRow, endRow, &columnFactory, keyIndex,
+      &selectedCols, col_names.get());
+
+    vector<int> rows;
+    for (int row = startRow - 1; row < endRow; row++) rows.push_back(row);
+
+    CheckTable(tableRead, selectedCols, selection.empty() ? allCols : selection, rows);
+  }
+};
+
+
+TEST_F(HorzChunksetTest, AddColumns)
+{
+  Write({ "Id", "Name" }, 0, 30000, false);
+  Write({ "Id", "Name" }, 30000, 20000, true);
+
+  AddColumns({ "Value", "Level", "Text" }, 50000, 0);
+
+  const vector<std::string> allCols { "Id", "Name", "Value", "Level", "Text" };
+
+  CheckRange({}, allCols, 1, 50000);
+
+  // columns of different chunksets over a data chunk boundary
+  CheckRange({ "Text", "Id", "Level" }, allCols, 29000, 31000);
+  CheckRange({ "Value" }, allCols, 40001, 50000);
+
+  // metadata covers all chunksets
+  FstStore fstStore(filePath);
+  ColumnFactory columnFactory;
+  std::unique_ptr<StringColumn> col_names(new StringColumn());
+  fstStore.fstMeta(&columnFactory, col_names.get());
+
+  ASSERT_EQ(fstStore.nrOfCols, 5);
+  EXPECT_EQ(*fstStore.p_nrOfRows, 50000ULL);
+  EXPECT_STREQ(col_names->GetElement(3), "Level");
+  EXPECT_EQ(fstStore.colTypes[2], 9);
+  EXPECT_EQ(fstStore.colTypes[3], 7);
+
+  // statistics of an added column
+  vector<ColumnStatistics> chunkStats;
+  fstStore.fstColumnStatistics(2, chunkStats);
+  ASSERT_EQ(chunkStats.size(), 2ULL);
+  EXPECT_EQ(chunkStats[1].Block(0).min.real, 0.25 * 30000);
+}
+
+
+TEST_F(HorzChunksetTest, AppendRowsAndColumns)
+{
+  Write({ "Id", "Name" }, 0, 10000, false);
+  AddColumns({ "Value" }, 10000, 50);
+
+  // rows are appended to all chunksets
+  Write({ "Id", "Name", "Value" }, 10000, 15000, true);
+  AddColumns({ "Big", "Text" }, 25000, 30);
+  Write({ "Id", "Name", "Value", "Big", "Text" }, 25000, 5000, true);
+
+  const vector<std::string> allCols { "Id", "Name", "Value", "Big", "Text" };
+
+  CheckRange({}, allCols, 1, 30000);
+  CheckRange({ "Big", "Value" }, allCols, 9000, 26000);
+
+  // row selection and predicates on added columns
+  ColumnFactory columnFactory;
+  FstReader reader(filePath, &columnFactory);
+
+  EXPECT_EQ(reader.NrOfColumns(), 5);
+  EXPECT_EQ(reader.NrOfRows(), 30000ULL);
+
+  FstTable selectionRead;
+  StringArray selectedCols;
+  std::vector<int> keyIndex;
+
+  reader.fstReadRows(selectionRead, nullptr, vector<int64_t> { 1, 10001, 10002, 29999 }, &columnFactory, keyIndex,
+    &selectedCols);
+  CheckTable(selectionRead, selectedCols, allCols, vector<int> { 0, 10000, 10001, 29998 });
+
+  FstTable filteredRead;
+  reader.fstReadFiltered(filteredRead, nullptr, { FstPredicate::Range("Big", 99990000000000LL, 250010000000000LL) },
+    &columnFactory, keyIndex, &selectedCols);
+
+  vector<int> rows;
+  for (int row = 9999; row <= 25001; row++) rows.push_back(row);
+  CheckTable(filteredRead, selectedCols, allCols, rows);
+}
+
+
+TEST_F(HorzChunksetTest, IncorrectColumns)
+{
+  Write({ "Id", "Name" }, 0, 1000, false);
+
+  TableColumns table({ "Value" }, 0, 999);
+  FstStore fstStore(filePath);
+  EXPECT_THROW(fstStore.fstAppendColumns(table.fstTable, 0), std::runtime_error);
+
+  // appended rows require all columns
+  AddColumns({ "Value" }, 1000, 0);
+  TableColumns rows({ "Id", "Name" }, 1000, 10);
+  EXPECT_THROW(fstStore.fstAppend(rows.fstTable, 0), std::runtime_error);
+}
@@ -0,0 +1,249 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <compression/bitpacking.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class IntegerCodecTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("integercodec.fst");
+  }
+
+  // All kernels supported by this CPU
+  static vector<ShuffleKernel> Kernels()
+  {
+    vector<ShuffleKernel> kernels;
+
+    for (ShuffleKernel kernel : { ShuffleKernel::SCALAR, ShuffleKernel::SSE2, ShuffleKernel::AVX2 })
+    {
+      if (GetPackingKernels(kernel) != nullptr) kernels.push_back(kernel);
+    }
+
+    return kernels;
+  }
+
+  // Element counts around the frame size
+  static vector<unsigned int> TestSizes()
+  {
+    return vector<unsigned int> { 1, 2, 255, 256, 257, 1000, 4096, 16387 };
+  }
+
+  // Sorted keys with gaps, constant values, random values over the full range and sorted values with NA's
+  static vector<ValuePattern> TestPatterns()
+  {
+    return vector<ValuePattern> { ValuePattern::SORTED, ValuePattern::CONSTANT, ValuePattern::RANDOM,
+      ValuePattern::SORTED_NA };
+  }
+
+  // Sorted integer keys and int64 timestamps
+  void WriteRows(int nrOfRows, int compression, bool extendedCodecs)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(2, nrOfRows);
+
+    IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    Int64VectorAdapter int64Vec(nrOfRows, FstColumnAttribute::INT_64_TIME_SECONDS, 0);
+
+    for (int pos = 0; pos < nrOfRows; pos++)
+    {
+      intVec.Data()[pos] = IntValue(pos);
+      int64Vec.Data()[pos] = Int64Value(pos);
+    }
+
+    fstTable.SetIntegerColumn(&intVec, 0);
+    fstTable.SetInt64Column(&int64Vec, 1);
+    fstTable.SetColumnNames(vector<std::string>{ "Key", "Time" });
+
+    FstStore fstStore(filePath);
+    fstStore.SetExtendedCodecs(extendedCodecs);
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  static int IntValue(int row)
+  {
+    return row % 5000 == 17 ? FST_NA_INT : 1000000 + 2 * row + (row * 7919) % 3;
+  }
+
+  static long long Int64Value(int row)
+  {
+    return 1600000000LL + 15 * static_cast<long long>(row) + (row * 31) % 7;
+  }
+
+  void CheckRows(int nrOfRows)
+  {
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    ReadRows(fstStore, tableRead, 1001, -1);
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(nrOfRows - 1000));
+
+    int* intP = ColumnVector<IntVector>(tableRead, 0)->Data();
+    long long* int64P = ColumnVector<LongVector>(tableRead, 1)->Data();
+
+    for (int row = 1000; row < nrOfRows; row++)
+    {
+      ASSERT_EQ(intP[row - 1000], IntValue(row));
+      ASSERT_EQ(int64P[row - 1000], Int64Value(row));
+    }
+  }
+};
+
+
+TEST_F(IntegerCodecTest, KernelsIdenticalToScalar)
+{
+  const PackingKernels* scalar = GetPackingKernels(ShuffleKernel::SCALAR);
+  std::mt19937_64 generator(17);
+
+  for (ShuffleKernel kernel : Kernels())
+  {
+    const PackingKernels* kernels = GetPackingKernels(kernel);
+
+    for (int width = 1; width <= 64; width++)
+    {
+      vector<unsigned long long> packed(4 * width);
+      for (unsigned long long &word : packed) word = generator();
+
+      vector<long long> expected(PACK_FRAME_SIZE), result(PACK_FRAME_SIZE);
+
+      scalar->unpackForInt64(packed.data(), expected.data(), width, -12345);
+      kernels->unpackForInt64(packed.data(), result.data(), width, -12345);
+      ASSERT_EQ(expected, result) << "kernel " << static_cast<int>(kernel) << ", width " << width;
+
+      const long long last = kernels->unpackDeltaInt64(packed.data(), result.data(), width, 1LL << 40);
+      ASSERT_EQ(scalar->unpackDeltaInt64(packed.data(), expected.data(), width, 1LL << 40), last);
+      ASSERT_EQ(expected, result) << "kernel " << static_cast<int>(kernel) << ", width " << width;
+
+      if (width > 32) continue;
+
+      // the same random bits as 32 bit words
+      const unsigned int* packedInt = reinterpret_cast<const unsigned int*>(packed.data());
+      vector<int> expectedInt(PACK_FRAME_SIZE), resultInt(PACK_FRAME_SIZE);
+
+      scalar->unpackForInt(packedInt, expectedInt.data(), width, 99);
+      kernels->unpackForInt(packedInt, resultInt.data(), width, 99);
+      ASSERT_EQ(expectedInt, resultInt) << "kernel " << static_cast<int>(kernel) << ", width " << width;
+
+      const int lastInt = kernels->unpackDeltaInt(packedInt, resultInt.data(), width, -3);
+      ASSERT_EQ(scalar->unpackDeltaInt(packedInt, expectedInt.data(), width, -3), lastInt);
+      ASSERT_EQ(expectedInt, resultInt) << "kernel " << static_cast<int>(kernel) << ", width " << width;
+    }
+  }
+}
+
+
+TEST_F(IntegerCodecTest, CodecsRoundTrip)
+{
+  for (unsigned int size : TestSizes())
+  {
+    for (ValuePattern pattern : TestPatterns())
+    {
+      unsigned int deltaSize, forSize;
+
+      const vector<int> values = PatternValues<int>(size, pattern, size);
+      const unsigned int bound = PackedSizeBound(4 * size, 4);
+      PackedSizesInt(values.data(), size, deltaSize, forSize);
+
+      EXPECT_EQ(CodecRoundTrip(values, DELTA_INT_C, DELTA_INT_D, bound), deltaSize);
+      EXPECT_EQ(CodecRoundTrip(values, FOR_INT_C, FOR_INT_D, bound), forSize);
+
+      const vector<long long> values64 = PatternValues<long long>(size, pattern, size);
+      const unsigned int bound64 = PackedSizeBound(8 * size, 8);
+      PackedSizesInt64(values64.data(), size, deltaSize, forSize);
+
+      EXPECT_EQ(CodecRoundTrip(values64, DELTA_INT64_C, DELTA_INT64_D, bound64), deltaSize);
+      EXPECT_EQ(CodecRoundTrip(values64, FOR_INT64_C, FOR_INT64_D, bound64), forSize);
+    }
+  }
+}
+
+
+TEST_F(IntegerCodecTest, PackedWidths)
+{
+  unsigned int deltaSize, forSize;
+
+  // constant values need no payload
+  const vector<int> constant = PatternValues<int>(1000, ValuePattern::CONSTANT, 0);
+  PackedSizesInt(constant.data(), 1000, deltaSize, forSize);
+  EXPECT_EQ(deltaSize, static_cast<unsigned int>(PACK_HEADER_INT));
+  EXPECT_EQ(forSize, static_cast<unsigned int>(PACK_HEADER_INT));
+
+  // increments of 15 - 21 fit in 6 bits after zig-zag encoding
+  vector<long long> timestamps(1024);
+  for (int pos = 0; pos < 1024; pos++) timestamps[pos] = Int64Value(pos);
+
+  PackedSizesInt64(timestamps.data(), 1024, deltaSize, forSize);
+  EXPECT_EQ(deltaSize, static_cast<unsigned int>(PACK_HEADER_INT64 + 4 * 32 * 6));
+  EXPECT_GT(forSize, deltaSize);
+}
+
+
+TEST_F(IntegerCodecTest, SortedColumns)
+{
+  for (int compression : { 30, 80 })
+  {
+    WriteRows(250000, compression, false);
+    const unsigned long long defaultSize = FileSize(filePath);
+    EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION));
+
+    WriteRows(250000, compression, true);
+    CheckRows(250000);
+
+    EXPECT_LT(FileSize(filePath), defaultSize);
+    EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION_CODECS));
+  }
+
+  // integer columns are stored uncompressed, but the file is still marked
+  WriteRows(10000, 0, true);
+  CheckRows(10000);
+  EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION_CODECS));
+}
+
+
+TEST_F(IntegerCodecTest, UncompressedLogicalColumn)
+{
+  const int nrOfRows = 100000;
+
+  FstTable fstTable(nrOfRows);
+  fstTable.InitTable(1, nrOfRows);
+
+  // long runs are run-length encoded, also at compression level 0
+  LogicalVectorAdapter logicalVec(nrOfRows);
+  for (int row = 0; row < nrOfRows; row++)
+  {
+    const int run = (row / 1000) % 3;
+    logicalVec.Data()[row] = run == 2 ? static_cast<int>(FST_NA_INT) : run;
+  }
+
+  fstTable.SetLogicalColumn(&logicalVec, 0);
+  fstTable.SetColumnNames(vector<std::string>{ "Flag" });
+
+  FstStore fstStore(filePath);
+  fstStore.SetExtendedCodecs(true);
+  fstStore.fstWrite(fstTable, 0);
+
+  EXPECT_EQ(TableVersion(filePath), static_cast<unsigned int>(FST_VERSION_CODECS));
+
+  FstTable tableRead;
+  ReadRows(fstStore, tableRead, 1, -1);
+  ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(nrOfRows));
+  ASSERT_EQ(memcmp(ColumnVector<IntVector>(tableRead, 0)->Data(), logicalVec.Data(), 4 * nrOfRows), 0);
+}
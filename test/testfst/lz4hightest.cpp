@@ -0,0 +1,306 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <compression/compression.h>
+#include <compression/compressioncontext.h>
+#include <compression/compressor.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class Lz4HighTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("lz4high.fst");
+  }
+
+  // Words from a small vocabulary, random bytes, zeros and small integer values
+  static vector<char> BlockData(unsigned int size, int pattern, unsigned int seed)
+  {
+    const char* words[] { "fst ", "column ", "block ", "compression ", "ratio ", "decode ", "throughput " };
+    std::mt19937 generator(seed);
+    vector<char> data;
+
+    while (data.size() < size)
+    {
+      switch (pattern)
+      {
+        case 0:
+        {
+          const char* word = words[generator() % 7];
+          data.insert(data.end(), word, word + strlen(word));
+          break;
+        }
+
+        case 1: data.push_back(static_cast<char>(generator())); break;
+        case 2: data.push_back(0); break;
+
+        default:
+        {
+          const int value = static_cast<int>(generator() % 1000);
+          data.insert(data.end(), reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value) + 4);
+          break;
+        }
+      }
+    }
+
+    data.resize(size);
+
+    return data;
+  }
+
+  // Compress with the high compression encoder and decompress as a regular LZ4 block
+  static unsigned int RoundTrip(const vector<char> &data, int compressionLevel)
+  {
+    const unsigned int srcSize = static_cast<unsigned int>(data.size());
+    const unsigned int capacity = static_cast<unsigned int>(LZ4_compressBound(static_cast<int>(srcSize)));
+
+    const unsigned int compSize = CodecRoundTrip(data, LZ4HC_C, LZ4_D, capacity, compressionLevel);
+
+    vector<char> compressed(capacity);
+    vector<char> restored(srcSize);
+    LZ4HC_C(compressed.data(), capacity, data.data(), srcSize, compressionLevel);
+
+    EXPECT_EQ(LZ4_decompress_safe(compressed.data(), restored.data(), static_cast<int>(compSize),
+      static_cast<int>(srcSize)), static_cast<int>(srcSize));
+
+    // decompressor of the LZ4 algorithm
+    memset(restored.data(), 0, srcSize);
+    EXPECT_EQ(Decompressor::Decompress(static_cast<unsigned int>(CompAlgo::LZ4), restored.data(), srcSize,
+      compressed.data(), compSize), 0);
+    EXPECT_EQ(memcmp(data.data(), restored.data(), srcSize), 0);
+
+    return compSize;
+  }
+
+  static int IntValue(int row)
+  {
+    return (row / 17) % 1000 + static_cast<int>((static_cast<unsigned int>(row) * 2654435761U) >> 28);
+  }
+
+  static long long Int64Value(int row)
+  {
+    return 1000000000000LL * (row / 5000) + IntValue(row);
+  }
+
+  static double DoubleValue(int row)
+  {
+    return IntValue(row) / 8.0;
+  }
+
+  void WriteRows(int nrOfRows, int compression, bool fastDecompression, bool adaptiveCompression)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(3, nrOfRows);
+
+    IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    Int64VectorAdapter int64Vec(nrOfRows, FstColumnAttribute::INT_64_BASE, 0);
+    DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      intVec.Data()[row] = IntValue(row);
+      int64Vec.Data()[row] = Int64Value(row);
+      doubleVec.Data()[row] = DoubleValue(row);
+    }
+
+    fstTable.SetIntegerColumn(&intVec, 0);
+    fstTable.SetInt64Column(&int64Vec, 1);
+    fstTable.SetDoubleColumn(&doubleVec, 2);
+    fstTable.SetColumnNames(vector<std::string>{ "Int", "Int64", "Double" });
+
+    FstStore fstStore(filePath);
+    fstStore.SetFastDecompression(fastDecompression);
+    fstStore.SetAdaptiveCompression(adaptiveCompression);
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  void CheckRows(int nrOfRows)
+  {
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    ReadRows(fstStore, tableRead, 1, -1);
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(nrOfRows));
+
+    // only existing algorithms are used
+    EXPECT_EQ(fstStore.tableVersionMax, static_cast<unsigned int>(FST_VERSION));
+
+    int* intP = ColumnVector<IntVector>(tableRead, 0)->Data();
+    long long* int64P = ColumnVector<LongVector>(tableRead, 1)->Data();
+    double* doubleP = ColumnVector<DoubleVector>(tableRead, 2)->Data();
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      ASSERT_EQ(intP[row], IntValue(row));
+      ASSERT_EQ(int64P[row], Int64Value(row));
+      ASSERT_EQ(doubleP[row], DoubleValue(row));
+    }
+  }
+};
+
+
+TEST_F(Lz4HighTest, CodecRoundTrip)
+{
+  for (unsigned int size : { 1U, 12U, 13U, 17U, 1000U, 16384U, 200003U })
+  {
+    for (int pattern = 0; pattern < 4; pattern++)
+    {
+      for (int compressionLevel : { 0, 50, 100 })
+      {
+        RoundTrip(BlockData(size, pattern, size + pattern), compressionLevel);
+      }
+    }
+  }
+}
+
+
+TEST_F(Lz4HighTest, HigherRatio)
+{
+  for (int pattern : { 0, 3 })
+  {
+    const vector<char> data = BlockData(16384, pattern, 5);
+    vector<char> compressed(LZ4_compressBound(16384));
+
+    const unsigned int lz4Size = LZ4_C(compressed.data(), static_cast<unsigned int>(compressed.size()), data.data(),
+      16384, 100);
+
+    // higher levels search more positions and use optimal parsing
+    const unsigned int size0 = RoundTrip(data, 0);
+    const unsigned int size100 = RoundTrip(data, 100);
+
+    EXPECT_LT(size0, lz4Size);
+    EXPECT_LE(size100, size0);
+  }
+
+  // levels 0 and 100 use the lowest and highest LZ4 HC level
+  const vector<char> data = BlockData(16384, 0, 5);
+  vector<char> compressed(LZ4_compressBound(16384));
+  vector<char> reference(LZ4_compressBound(16384));
+
+  for (int compressionLevel : { 0, 100 })
+  {
+    const unsigned int compSize = LZ4HC_C(compressed.data(), static_cast<unsigned int>(compressed.size()),
+      data.data(), 16384, compressionLevel);
+    const int referenceSize = LZ4_compress_HC(data.data(), reference.data(), 16384,
+      static_cast<int>(reference.size()), compressionLevel == 0 ? LZ4HC_CLEVEL_MIN : LZ4HC_CLEVEL_MAX);
+
+    ASSERT_EQ(compSize, static_cast<unsigned int>(referenceSize));
+    EXPECT_EQ(memcmp(compressed.data(), reference.data(), compSize), 0);
+  }
+}
+
+
+TEST_F(Lz4HighTest, ShuffledCompressor)
+{
+  const vector<char> data = BlockData(16384, 3, 7);
+  vector<char> restored(data.size());
+
+  for (CompAlgo algo : { CompAlgo::LZ4, CompAlgo::LZ4_SHUF4, CompAlgo::LZ4_SHUF8 })
+  {
+    Lz4HighCompressor compressor(algo, 80);
+    vector<char> compressed(compressor.CompressBufferSize(16384));
+
+    CompAlgo compAlgorithm;
+    const int compSize = compressor.Compress(compressed.data(), static_cast<unsigned int>(compressed.size()),
+      data.data(), 16384, compAlgorithm);
+
+    // blocks are stored with the algorithm of the fast encoder
+    ASSERT_EQ(compAlgorithm, algo);
+    ASSERT_GT(compSize, 0);
+    ASSERT_EQ(Decompressor::Decompress(static_cast<unsigned int>(compAlgorithm), restored.data(), 16384,
+      compressed.data(), compSize), 0);
+    ASSERT_EQ(memcmp(data.data(), restored.data(), 16384), 0);
+  }
+
+  EXPECT_THROW(Lz4HighCompressor(CompAlgo::ZSTD, 80), std::runtime_error);
+}
+
+
+TEST_F(Lz4HighTest, FastDecompressionColumns)
+{
+  WriteRows(250007, 50, false, false);
+  const unsigned long long lz4Size = FileSize(filePath);
+
+  for (bool adaptiveCompression : { false, true })
+  {
+    WriteRows(250007, 100, true, adaptiveCompression);
+    CheckRows(250007);
+
+    EXPECT_LT(FileSize(filePath), lz4Size);
+  }
+}
+
+
+TEST_F(Lz4HighTest, DISABLED_Benchmark)
+{
+  const unsigned int srcSize = 16384;  // single block
+  const int nrOfRepeats = 1000;
+
+  struct Codec
+  {
+    const char* name;
+    unsigned int (*compress)(char*, unsigned int, const char*, unsigned int, int);
+    unsigned int (*decompress)(char*, unsigned int, const char*, unsigned int);
+    int level;
+  };
+
+  const Codec codecs[] { { "LZ4", LZ4_C, LZ4_D, 100 }, { "LZ4HC (50)", LZ4HC_C, LZ4_D, 50 },
+    { "LZ4HC (100)", LZ4HC_C, LZ4_D, 100 }, { "ZSTD (100)", ZSTD_C, ZSTD_D, 100 } };
+
+  // words and small integer values
+  for (int pattern : { 0, 3 })
+  {
+    const vector<char> data = BlockData(srcSize, pattern, 1);
+
+    for (const Codec &codec : codecs)
+    {
+      vector<char> compressed(2 * srcSize + 1024);
+      vector<char> restored(srcSize);
+      unsigned int compressedSize = 0;
+
+      auto start = std::chrono::steady_clock::now();
+
+      for (int repeat = 0; repeat < nrOfRepeats; repeat++)
+      {
+        compressedSize = codec.compress(compressed.data(), static_cast<unsigned int>(compressed.size()), data.data(),
+          srcSize, codec.level);
+      }
+
+      const double compressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      start = std::chrono::steady_clock::now();
+
+      for (int repeat = 0; repeat < nrOfRepeats; repeat++)
+      {
+        codec.decompress(restored.data(), srcSize, compressed.data(), compressedSize);
+      }
+
+      const double decompressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      ASSERT_EQ(memcmp(data.data(), restored.data(), srcSize), 0);
+
+      std::cout << "pattern " << pattern << ", " << codec.name << ": ratio "
+        << static_cast<double>(srcSize) / compressedSize << ", compress "
+        << (static_cast<double>(srcSize) * nrOfRepeats) / (compressSeconds * 1e9) << " GB/s, decompress "
+        << (static_cast<double>(srcSize) * nrOfRepeats) / (decompressSeconds * 1e9) << " GB/s" << std::endl;
+    }
+  }
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <interface/fstmemoryimage.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class MemoryImageTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("memoryimage.fst");
+  }
+};
+
+
+TEST_F(MemoryImageTest, WriteAndRead)
+{
+  std::shared_ptr<FstMemoryImage> image = std::make_shared<FstMemoryImage>();
+  FstStore fstStore(image);
+
+  GeneratedTable::WriteRows(fstStore, 0, 30000, 50, false);
+  GeneratedTable::WriteRows(fstStore, 30000, 20000, 0, true);
+
+  EXPECT_GT(image->Size(), 0ULL);
+
+  GeneratedTable::CheckRows(fstStore, 1, 50000);
+  GeneratedTable::CheckRows(fstStore, 29000, 31000);
+
+  // selected rows
+  GeneratedTable::CheckSelectedRows(fstStore, vector<int64_t> { 1, 30000, 30001, 50000 });
+
+  // metadata
+  FstStore metaStore(image);
+  ColumnFactory columnFactory;
+  std::unique_ptr<StringColumn> meta_names(new StringColumn());
+  metaStore.fstMeta(&columnFactory, meta_names.get());
+
+  EXPECT_EQ(*metaStore.p_nrOfRows, 50000ULL);
+  EXPECT_EQ(metaStore.nrOfCols, 7);
+}
+
+
+TEST_F(MemoryImageTest, SameAsFile)
+{
+  std::shared_ptr<FstMemoryImage> image = std::make_shared<FstMemoryImage>();
+  FstStore imageStore(image);
+  FstStore fileStore(filePath);
+
+  GeneratedTable::WriteRows(imageStore, 0, 20000, 30, false);
+  GeneratedTable::WriteRows(fileStore, 0, 20000, 30, false);
+
+  std::ifstream file(filePath, std::ios::binary);
+  vector<char> fileData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  file.close();
+
+  ASSERT_EQ(fileData.size(), image->Size());
+  EXPECT_TRUE(std::equal(fileData.begin(), fileData.end(), image->Data()));
+
+  // a file loaded into an image can be read and extended
+  std::shared_ptr<FstMemoryImage> loaded = std::make_shared<FstMemoryImage>(std::move(fileData));
+  FstStore loadedStore(loaded);
+
+  GeneratedTable::WriteRows(loadedStore, 20000, 10000, 70, true);
+  GeneratedTable::CheckRows(loadedStore, 1, 30000);
+}
+
+
+TEST_F(MemoryImageTest, EmptyImage)
+{
+  FstStore fstStore(std::make_shared<FstMemoryImage>());
+
+  ColumnFactory columnFactory;
+  std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+  EXPECT_THROW(fstStore.fstMeta(&columnFactory, col_names.get()), runtime_error);
+}
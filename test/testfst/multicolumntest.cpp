@@ -116,3 +116,65 @@ TEST_F(MultiColumnTest, PerColumnCompressed)
 
   ReadWriteTester::WriteReadSingleColumns(table, GetFilePath("char_comp_10000_70.fst"), 70);
 }
+
+
+TEST_F(MultiColumnTest, WideTableParallelRead)
+{
+  const int nrOfCols = 60;
+  const int nrOfRows = 5000;
+
+  FstTable table(nrOfRows);
+  table.InitTable(nrOfCols, nrOfRows);
+
+  vector<std::string> colNames;
+  std::vector<std::unique_ptr<IntVectorAdapter>> intVecs;
+  std::vector<std::unique_ptr<DoubleVectorAdapter>> doubleVecs;
+
+  for (int colNr = 0; colNr < nrOfCols; colNr++)
+  {
+    colNames.push_back("col" + to_string(colNr));
+
+    if (colNr % 2 == 0)
+    {
+      intVecs.emplace_back(new IntVectorAdapter(nrOfRows, FstColumnAttribute::NONE, 0));
+      IntSeq(intVecs.back()->Data(), nrOfRows, colNr);
+      table.SetIntegerColumn(intVecs.back().get(), colNr);
+      continue;
+    }
+
+    doubleVecs.emplace_back(new DoubleVectorAdapter(nrOfRows, FstColumnAttribute::NONE, 0));
+    for (int row = 0; row < nrOfRows; row++) doubleVecs.back()->Data()[row] = colNr + 0.25 * row;
+    table.SetDoubleColumn(doubleVecs.back().get(), colNr);
+  }
+
+  table.SetColumnNames(colNames);
+
+  FstStore fstStore(GetFilePath("wide_table.fst"));
+  fstStore.fstWrite(table, 50);
+
+  ColumnFactory columnFactory;
+  std::vector<int> keyIndex;
+
+  // read with multiple threads and compare with the original columns
+  const int prevThreads = ThreadsFst(4);
+
+  FstTable tableRead;
+  StringArray selectedCols;
+  std::unique_ptr<StringColumn> col_names(new StringColumn());
+  fstStore.fstRead(tableRead, nullptr, 11, 4990, &columnFactory, keyIndex, &selectedCols, col_names.get());
+
+  ThreadsFst(prevThreads);
+
+  for (int colNr = 0; colNr < nrOfCols; colNr++)
+  {
+    std::shared_ptr<DestructableObject> columnRead, columnOrig;
+    FstColumnType type;
+    std::string colName, annotation;
+    short int scale;
+
+    tableRead.GetColumn(colNr, columnRead, type, colName, scale, annotation);
+    table.GetColumn(colNr, columnOrig, type, colName, scale, annotation);
+
+    EXPECT_TRUE(ReadWriteTester::CompareColVecs(columnRead, columnOrig, type, 10, 4980));
+  }
+}
@@ -0,0 +1,233 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <interface/fstpredicate.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class PredicateTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("predicate.fst");
+  }
+
+  static long long TimeValue(int row)
+  {
+    return 1000LL * row;
+  }
+
+  static double DoubleValue(int row)
+  {
+    if (row % 50 == 3) return std::nan("");
+    return 0.25 * ((row * 31) % 997) - 100.0;
+  }
+
+  // Write or append rows [from, from + nrOfRows), the 'Id' column contains the row number
+  void WriteRows(int from, int nrOfRows, int compression, bool append)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(7, nrOfRows);
+
+    IntVectorAdapter idVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    Int64VectorAdapter timeVec(nrOfRows, FstColumnAttribute::INT_64_BASE, 0);
+    IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    LogicalVectorAdapter logicalVec(nrOfRows);
+    StringColumn strVec;
+    strVec.AllocateVec(nrOfRows);
+    FactorVectorAdapter factorVec(nrOfRows, 3, FstColumnAttribute::FACTOR_BASE);
+
+    vector<std::string>* levels = factorVec.DataPtr()->Levels()->StrVector()->StrVec();
+    (*levels)[0] = "a";
+    (*levels)[1] = "b";
+    (*levels)[2] = "c";
+
+    for (int pos = 0; pos < nrOfRows; pos++)
+    {
+      const int row = from + pos;
+
+      idVec.Data()[pos] = row;
+      timeVec.Data()[pos] = TimeValue(row);
+      intVec.Data()[pos] = GeneratedTable::IntValue(row);
+      doubleVec.Data()[pos] = DoubleValue(row);
+      logicalVec.Data()[pos] = GeneratedTable::LogicalValue(row);
+      (*strVec.StrVector()->StrVec())[pos] = "s" + to_string(row);
+      factorVec.LevelData()[pos] = 1 + row % 3;
+    }
+
+    fstTable.SetIntegerColumn(&idVec, 0);
+    fstTable.SetInt64Column(&timeVec, 1);
+    fstTable.SetIntegerColumn(&intVec, 2);
+    fstTable.SetDoubleColumn(&doubleVec, 3);
+    fstTable.SetLogicalColumn(&logicalVec, 4);
+    fstTable.SetStringColumn(&strVec, 5);
+    fstTable.SetFactorColumn(&factorVec, 6);
+    fstTable.SetColumnNames(vector<std::string>{ "Id", "Time", "Int", "Double", "Logical", "String", "Factor" });
+
+    FstStore fstStore(filePath);
+
+    if (append)
+    {
+      fstStore.fstAppend(fstTable, compression);
+      return;
+    }
+
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  // Read the filtered table and compare with the rows selected by 'isMatch'
+  void CheckFiltered(const vector<FstPredicate> &predicates, int nrOfRows, const std::function<bool(int)> &isMatch)
+  {
+    vector<int> expected;
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      if (isMatch(row)) expected.push_back(row);
+    }
+
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    StringArray selectedCols;
+    ColumnFactory columnFactory;
+    std::vector<int> keyIndex;
+    std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+    vector<std::string> cols { "Id", "String", "Factor", "Time" };
+    StringArray columnSelection(cols);
+
+    fstStore.fstReadFiltered(tableRead, &columnSelection, predicates, &columnFactory, keyIndex, &selectedCols,
+      col_names.get());
+
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(expected.size()));
+
+    std::shared_ptr<DestructableObject> column;
+    FstColumnType type;
+    std::string colName, annotation;
+    short int scale;
+
+    tableRead.GetColumn(0, column, type, colName, scale, annotation);
+    int* idP = static_cast<IntVector*>(&*column)->Data();
+
+    tableRead.GetColumn(1, column, type, colName, scale, annotation);
+    vector<std::string>* strings = static_cast<StringVector*>(&*column)->StrVec();
+
+    tableRead.GetColumn(2, column, type, colName, scale, annotation);
+    FactorVector* factorVec = static_cast<FactorVector*>(&*column);
+    vector<std::string>* levels = factorVec->Levels()->StrVector()->StrVec();
+
+    tableRead.GetColumn(3, column, type, colName, scale, annotation);
+    long long* timeP = static_cast<LongVector*>(&*column)->Data();
+
+    const std::string levelNames[] { "a", "b", "c" };
+
+    for (size_t pos = 0; pos < expected.size(); pos++)
+    {
+      const int row = expected[pos];
+
+      ASSERT_EQ(idP[pos], row);
+      EXPECT_EQ((*strings)[pos], "s" + to_string(row));
+      EXPECT_EQ((*levels)[factorVec->Data()[pos] - 1], levelNames[row % 3]);
+      EXPECT_EQ(timeP[pos], TimeValue(row));
+    }
+  }
+};
+
+
+TEST_F(PredicateTest, RangeOnSortedColumn)
+{
+  WriteRows(0, 100000, 50, false);
+
+  CheckFiltered({ FstPredicate::Range("Time", 5000000LL, 12000000LL) }, 100000,
+    [](int row) { return row >= 5000 && row <= 12000; });
+
+  // bounds between values
+  CheckFiltered({ FstPredicate::Range("Time", 4999999.5, 5010000.5) }, 100000,
+    [](int row) { return row >= 5000 && row <= 5010; });
+
+  // no matching rows
+  CheckFiltered({ FstPredicate::Range("Time", -10LL, -1LL) }, 100000, [](int) { return false; });
+}
+
+
+TEST_F(PredicateTest, EqualAndIn)
+{
+  WriteRows(0, 50000, 0, false);
+
+  CheckFiltered({ FstPredicate::Equal("Int", 17LL) }, 50000,
+    [](int row) { return GeneratedTable::IntValue(row) == 17; });
+
+  CheckFiltered({ FstPredicate::In("Int", vector<long long> { -5000, 3, 4000, 9999 }) }, 50000, [](int row)
+  {
+    const int value = GeneratedTable::IntValue(row);
+    return value == -5000 || value == 3 || value == 4000;
+  });
+
+  CheckFiltered({ FstPredicate::In("Double", vector<double> { -100.0, 0.25, 10.5, std::nan("") }) }, 50000, [](int row)
+  {
+    const double value = DoubleValue(row);
+    return value == -100.0 || value == 0.25 || value == 10.5;
+  });
+
+  // NA values never match
+  CheckFiltered({ FstPredicate::Equal("Logical", 1LL) }, 50000,
+    [](int row) { return GeneratedTable::LogicalValue(row) == 1; });
+}
+
+
+TEST_F(PredicateTest, CombinedPredicatesOverChunks)
+{
+  WriteRows(0, 40000, 30, false);
+  WriteRows(40000, 30000, 70, true);
+
+  vector<FstPredicate> predicates
+  {
+    FstPredicate::Range("Time", 20000000LL, 60000000LL),
+    FstPredicate::Range("Int", -1000LL, 1000LL),
+    FstPredicate::Range("Double", -50.0, 50.0)
+  };
+
+  CheckFiltered(predicates, 70000, [](int row)
+  {
+    const double value = DoubleValue(row);
+    const int intValue = GeneratedTable::IntValue(row);
+    return row >= 20000 && row <= 60000 && intValue != static_cast<int>(FST_NA_INT) && intValue >= -1000 &&
+      intValue <= 1000 && value >= -50.0 && value <= 50.0;
+  });
+}
+
+
+TEST_F(PredicateTest, IncorrectPredicates)
+{
+  WriteRows(0, 1000, 0, false);
+
+  FstStore fstStore(filePath);
+  FstTable tableRead;
+  StringArray selectedCols;
+  ColumnFactory columnFactory;
+  std::vector<int> keyIndex;
+  std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+  EXPECT_THROW(fstStore.fstReadFiltered(tableRead, nullptr, { FstPredicate::Equal("String", 1LL) }, &columnFactory,
+    keyIndex, &selectedCols, col_names.get()), runtime_error);
+
+  EXPECT_THROW(fstStore.fstReadFiltered(tableRead, nullptr, { FstPredicate::Equal("Missing", 1LL) }, &columnFactory,
+    keyIndex, &selectedCols, col_names.get()), runtime_error);
+}
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class RowSelectionTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("rowselection.fst");
+  }
+
+  // Write or append rows [from, from + nrOfRows) of the generated table
+  void WriteRows(int from, int nrOfRows, int compression, bool append)
+  {
+    FstStore fstStore(filePath);
+    GeneratedTable::WriteRows(fstStore, from, nrOfRows, compression, append);
+  }
+
+  // Read the (one based) rows and compare with the generated values
+  void CheckRows(const vector<int64_t> &rows)
+  {
+    FstStore fstStore(filePath);
+    GeneratedTable::CheckSelectedRows(fstStore, rows);
+  }
+
+  // Sorted sample of rows with duplicates, block boundaries and the first and last row
+  static vector<int64_t> SampleRows(int nrOfRows)
+  {
+    vector<int64_t> rows { 1, 1, 2 };
+
+    for (int64_t row = 3; row < nrOfRows; row += 1 + (row * 7) % 3001)
+    {
+      rows.push_back(row);
+      if (row % 4 == 0) rows.push_back(row);
+    }
+
+    rows.push_back(nrOfRows);
+
+    return rows;
+  }
+};
+
+
+TEST_F(RowSelectionTest, SingleChunk)
+{
+  for (int compression : { 0, 30, 100 })
+  {
+    WriteRows(0, 100000, compression, false);
+    CheckRows(SampleRows(100000));
+
+    // rows within a single block
+    CheckRows(vector<int64_t> { 4097, 4100, 4100, 5000 });
+  }
+}
+
+
+TEST_F(RowSelectionTest, MultipleChunks)
+{
+  WriteRows(0, 30000, 50, false);
+  WriteRows(30000, 20000, 0, true);
+  WriteRows(50000, 30000, 80, true);
+
+  CheckRows(SampleRows(80000));
+
+  // last row of a chunk and first row of the next
+  CheckRows(vector<int64_t> { 30000, 30001, 50000, 50001 });
+
+  // only rows from the last chunk
+  CheckRows(vector<int64_t> { 60000, 70000 });
+}
+
+
+TEST_F(RowSelectionTest, IncorrectSelection)
+{
+  WriteRows(0, 1000, 0, false);
+
+  CheckRows(vector<int64_t> {});
+
+  FstStore fstStore(filePath);
+  FstTable tableRead;
+  StringArray selectedCols;
+  ColumnFactory columnFactory;
+  std::vector<int> keyIndex;
+  std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+  EXPECT_THROW(fstStore.fstReadRows(tableRead, nullptr, vector<int64_t> { 5, 3 }, &columnFactory, keyIndex,
+    &selectedCols, col_names.get()), runtime_error);
+
+  EXPECT_THROW(fstStore.fstReadRows(tableRead, nullptr, vector<int64_t> { 0 }, &columnFactory, keyIndex, &selectedCols,
+    col_names.get()), runtime_error);
+
+  EXPECT_THROW(fstStore.fstReadRows(tableRead, nullptr, vector<int64_t> { 1001 }, &columnFactory, keyIndex,
+    &selectedCols, col_names.get()), runtime_error);
+}
@@ -0,0 +1,245 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <interface/fstpredicate.h>
+#include <compression/runlength.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class RunLengthTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("runlength.fst");
+  }
+
+  // Long runs, a single run, runs of length one and random runs
+  static vector<ValuePattern> TestPatterns()
+  {
+    return vector<ValuePattern> { ValuePattern::LONG_RUNS, ValuePattern::CONSTANT, ValuePattern::SEQUENCE,
+      ValuePattern::RUNS };
+  }
+
+  static int StatusValue(int row)
+  {
+    if (row >= 20000 && row < 21000) return FST_NA_INT;
+    return (row / 5000) % 7;
+  }
+
+  static int FlagValue(int row)
+  {
+    if (row >= 50000 && row < 50500) return FST_NA_INT;
+    return (row / 3000) % 2;
+  }
+
+  static int LevelValue(int row)
+  {
+    return 1 + (row / 10000) % 3;
+  }
+
+  static long long EpochValue(int row)
+  {
+    return 1600000000000LL + 3600000LL * (row / 7000);
+  }
+
+  // Columns with long runs of equal values and a row number column
+  void WriteRows(int nrOfRows, int compression, bool extendedCodecs)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(5, nrOfRows);
+
+    IntVectorAdapter idVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    IntVectorAdapter statusVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    LogicalVectorAdapter flagVec(nrOfRows);
+    FactorVectorAdapter levelVec(nrOfRows, 3, FstColumnAttribute::FACTOR_BASE);
+    Int64VectorAdapter epochVec(nrOfRows, FstColumnAttribute::INT_64_BASE, 0);
+
+    vector<std::string>* levels = levelVec.DataPtr()->Levels()->StrVector()->StrVec();
+    (*levels)[0] = "low";
+    (*levels)[1] = "mid";
+    (*levels)[2] = "high";
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      idVec.Data()[row] = row;
+      statusVec.Data()[row] = StatusValue(row);
+      flagVec.Data()[row] = FlagValue(row);
+      levelVec.LevelData()[row] = LevelValue(row);
+      epochVec.Data()[row] = EpochValue(row);
+    }
+
+    fstTable.SetIntegerColumn(&idVec, 0);
+    fstTable.SetIntegerColumn(&statusVec, 1);
+    fstTable.SetLogicalColumn(&flagVec, 2);
+    fstTable.SetFactorColumn(&levelVec, 3);
+    fstTable.SetInt64Column(&epochVec, 4);
+    fstTable.SetColumnNames(vector<std::string>{ "Id", "Status", "Flag", "Level", "Epoch" });
+
+    FstStore fstStore(filePath);
+    fstStore.SetExtendedCodecs(extendedCodecs);
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  void CheckRows(int nrOfRows)
+  {
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    ReadRows(fstStore, tableRead, 1, -1);
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(nrOfRows));
+
+    int* statusP = ColumnVector<IntVector>(tableRead, 1)->Data();
+    int* flagP = ColumnVector<IntVector>(tableRead, 2)->Data();
+    int* levelP = ColumnVector<FactorVector>(tableRead, 3)->Data();
+    long long* epochP = ColumnVector<LongVector>(tableRead, 4)->Data();
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      ASSERT_EQ(statusP[row], StatusValue(row));
+      ASSERT_EQ(flagP[row], FlagValue(row));
+      ASSERT_EQ(levelP[row], LevelValue(row));
+      ASSERT_EQ(epochP[row], EpochValue(row));
+    }
+  }
+
+  // Count and read the filtered rows and compare with the rows selected by 'isMatch'
+  void CheckFiltered(const vector<FstPredicate> &predicates, int nrOfRows, const std::function<bool(int)> &isMatch)
+  {
+    vector<int> expected;
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      if (isMatch(row)) expected.push_back(row);
+    }
+
+    FstStore fstStore(filePath);
+    std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+    EXPECT_EQ(fstStore.fstCountFiltered(predicates, col_names.get()), static_cast<long long>(expected.size()));
+
+    FstTable tableRead;
+    StringArray selectedCols;
+    ColumnFactory columnFactory;
+    std::vector<int> keyIndex;
+
+    vector<std::string> cols { "Id" };
+    StringArray columnSelection(cols);
+
+    fstStore.fstReadFiltered(tableRead, &columnSelection, predicates, &columnFactory, keyIndex, &selectedCols,
+      col_names.get());
+
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(expected.size()));
+
+    int* idP = ColumnVector<IntVector>(tableRead, 0)->Data();
+
+    for (size_t pos = 0; pos < expected.size(); pos++)
+    {
+      ASSERT_EQ(idP[pos], expected[pos]);
+    }
+  }
+};
+
+
+TEST_F(RunLengthTest, CodecsRoundTrip)
+{
+  for (unsigned int size : { 1U, 2U, 1000U, 4096U, 16387U })
+  {
+    for (ValuePattern pattern : TestPatterns())
+    {
+      // the encoded size is known in advance
+      const vector<int> values = PatternValues<int>(size, pattern, size);
+      const unsigned int encodedSize = RunLengthSizeInt(values.data(), size);
+      EXPECT_EQ(CodecRoundTrip(values, RLE_INT_C, RLE_INT_D, encodedSize), encodedSize);
+
+      const vector<long long> values64 = PatternValues<long long>(size, pattern, size);
+      const unsigned int encodedSize64 = RunLengthSizeInt64(values64.data(), size);
+      EXPECT_EQ(CodecRoundTrip(values64, RLE_INT64_C, RLE_INT64_D, encodedSize64), encodedSize64);
+    }
+  }
+}
+
+
+TEST_F(RunLengthTest, Runs)
+{
+  const int na = static_cast<int>(FST_NA_INT);
+  const vector<int> values { 5, 5, 5, na, na, 7 };
+  vector<char> encoded(RunLengthSizeInt(values.data(), 6));
+
+  EXPECT_EQ(encoded.size(), static_cast<size_t>(RLE_HEADER_SIZE + 3 * 8));
+  RLE_INT_C(encoded.data(), static_cast<unsigned int>(encoded.size()), reinterpret_cast<const char*>(values.data()),
+    24, 0);
+
+  vector<unsigned int> runLengths;
+  vector<long long> runValues;
+
+  ASSERT_EQ(RunLengthRuns(encoded.data(), static_cast<unsigned int>(encoded.size()), 4, 6, runLengths, runValues), 0U);
+  EXPECT_EQ(runLengths, (vector<unsigned int> { 3, 2, 1 }));
+  EXPECT_EQ(runValues, (vector<long long> { 5, na, 7 }));
+
+  // the run lengths have to add up to the block size
+  EXPECT_NE(RunLengthRuns(encoded.data(), static_cast<unsigned int>(encoded.size()), 4, 7, runLengths, runValues), 0U);
+}
+
+
+TEST_F(RunLengthTest, RunColumns)
+{
+  for (int compression : { 30, 80 })
+  {
+    WriteRows(250007, compression, false);
+    const unsigned long long defaultSize = FileSize(filePath);
+
+    WriteRows(250007, compression, true);
+    CheckRows(250007);
+
+    EXPECT_LT(FileSize(filePath), defaultSize);
+  }
+}
+
+
+TEST_F(RunLengthTest, FilterOnRuns)
+{
+  for (bool extendedCodecs : { false, true })
+  {
+    WriteRows(250007, 50, extendedCodecs);
+
+    CheckFiltered({ FstPredicate::Equal("Status", 3LL) }, 250007, [](int row) { return StatusValue(row) == 3; });
+
+    CheckFiltered({ FstPredicate::In("Status", vector<long long> { 0, 6 }) }, 250007, [](int row)
+    {
+      const int value = StatusValue(row);
+      return value == 0 || value == 6;
+    });
+
+    // NA values never match
+    CheckFiltered({ FstPredicate::Range("Status", -10LL, 10LL) }, 250007,
+      [](int row) { return StatusValue(row) != static_cast<int>(FST_NA_INT); });
+
+    CheckFiltered({ FstPredicate::Equal("Flag", 1LL) }, 250007, [](int row) { return FlagValue(row) == 1; });
+
+    CheckFiltered({ FstPredicate::Range("Epoch", EpochValue(30000), EpochValue(100000)) }, 250007,
+      [](int row) { return EpochValue(row) >= EpochValue(30000) && EpochValue(row) <= EpochValue(100000); });
+
+    // candidate rows that start and end within run-length encoded blocks
+    CheckFiltered({ FstPredicate::Range("Id", 12345LL, 98765LL), FstPredicate::Equal("Flag", 0LL),
+      FstPredicate::In("Status", vector<long long> { 2, 4, 5 }) }, 250007, [](int row)
+    {
+      const int status = StatusValue(row);
+      return row >= 12345 && row <= 98765 && FlagValue(row) == 0 && (status == 2 || status == 4 || status == 5);
+    });
+  }
+}
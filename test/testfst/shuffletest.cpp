@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+
+#include <compression/compression.h>
+#include <compression/shufflekernels.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+
+using namespace std;
+
+class ShuffleTest : public ::testing::Test
+{
+protected:
+  // All kernels supported by this CPU
+  static vector<ShuffleKernel> Kernels()
+  {
+    vector<ShuffleKernel> kernels;
+
+    for (ShuffleKernel kernel : { ShuffleKernel::SCALAR, ShuffleKernel::SSE2, ShuffleKernel::AVX2 })
+    {
+      if (GetShuffleKernels(kernel) != nullptr) kernels.push_back(kernel);
+    }
+
+    return kernels;
+  }
+
+  static vector<char> RandomBytes(size_t size, unsigned int seed)
+  {
+    std::mt19937 generator(seed);
+    vector<char> bytes(size);
+
+    for (size_t pos = 0; pos < size; pos++) bytes[pos] = static_cast<char>(generator() & 255);
+
+    return bytes;
+  }
+
+  // Element counts around the vector widths and the size of a compression block
+  static vector<int> TestSizes()
+  {
+    return vector<int> { 0, 1, 7, 8, 9, 15, 16, 17, 24, 31, 32, 33, 48, 63, 64, 65, 96, 127, 128, 129, 1000, 2048,
+      4096 };
+  }
+};
+
+
+TEST_F(ShuffleTest, RealIdenticalToScalar)
+{
+  for (ShuffleKernel kernel : Kernels())
+  {
+    const ShuffleKernels* kernels = GetShuffleKernels(kernel);
+
+    for (int nrOfDoubles : TestSizes())
+    {
+      vector<char> input = RandomBytes(8 * nrOfDoubles + 8, nrOfDoubles);
+      vector<char> expected(input.size(), 0), shuffled(input.size(), 0), restored(input.size(), 0);
+      double* inputP = reinterpret_cast<double*>(input.data());
+
+      ShuffleRealScalar(inputP, reinterpret_cast<double*>(expected.data()), nrOfDoubles);
+      kernels->shuffleReal(inputP, reinterpret_cast<double*>(shuffled.data()), nrOfDoubles);
+
+      ASSERT_EQ(memcmp(expected.data(), shuffled.data(), shuffled.size()), 0) << "kernel " << static_cast<int>(kernel)
+        << ", " << nrOfDoubles << " doubles";
+
+      kernels->deshuffleReal(reinterpret_cast<double*>(shuffled.data()), reinterpret_cast<double*>(restored.data()),
+        nrOfDoubles);
+
+      ASSERT_EQ(memcmp(input.data(), restored.data(), 8 * nrOfDoubles), 0) << "kernel " << static_cast<int>(kernel)
+        << ", " << nrOfDoubles << " doubles";
+    }
+  }
+}
+
+
+TEST_F(ShuffleTest, IntIdenticalToScalar)
+{
+  for (ShuffleKernel kernel : Kernels())
+  {
+    const ShuffleKernels* kernels = GetShuffleKernels(kernel);
+
+    for (int nrOfInts : TestSizes())
+    {
+      vector<char> input = RandomBytes(4 * nrOfInts + 8, nrOfInts + 1);
+      vector<char> expected(input.size(), 0), shuffled(input.size(), 0), restored(input.size(), 0);
+      int* inputP = reinterpret_cast<int*>(input.data());
+
+      ShuffleInt2Scalar(inputP, reinterpret_cast<int*>(expected.data()), nrOfInts);
+      kernels->shuffleInt2(inputP, reinterpret_cast<int*>(shuffled.data()), nrOfInts);
+
+      ASSERT_EQ(memcmp(expected.data(), shuffled.data(), shuffled.size()), 0) << "kernel " << static_cast<int>(kernel)
+        << ", " << nrOfInts << " integers";
+
+      kernels->deshuffleInt2(reinterpret_cast<int*>(shuffled.data()), reinterpret_cast<int*>(restored.data()),
+        nrOfInts);
+
+      ASSERT_EQ(memcmp(input.data(), restored.data(), 4 * nrOfInts), 0) << "kernel " << static_cast<int>(kernel)
+        << ", " << nrOfInts << " integers";
+    }
+  }
+}
+
+
+TEST_F(ShuffleTest, ActiveKernel)
+{
+  const ShuffleKernel active = ActiveShuffleKernel();
+
+  ASSERT_NE(GetShuffleKernels(active), nullptr);
+  EXPECT_EQ(&ActiveShuffleKernels(), GetShuffleKernels(active));
+
+  for (ShuffleKernel kernel : Kernels())
+  {
+    EXPECT_LE(static_cast<int>(kernel), static_cast<int>(active));
+  }
+}
+
+
+// Throughput of the shuffle kernels on compression blocks, run with --gtest_also_run_disabled_tests
+TEST_F(ShuffleTest, DISABLED_Benchmark)
+{
+  const int nrOfDoubles = 2048;  // single 16 KB block
+  const int nrOfRepeats = 100000;
+
+  vector<char> input = RandomBytes(8 * nrOfDoubles, 1);
+  vector<char> output(input.size());
+
+  for (ShuffleKernel kernel : Kernels())
+  {
+    const ShuffleKernels* kernels = GetShuffleKernels(kernel);
+
+    for (int type = 0; type < 4; type++)
+    {
+      auto start = std::chrono::steady_clock::now();
+
+      for (int repeat = 0; repeat < nrOfRepeats; repeat++)
+      {
+        double* inP = reinterpret_cast<double*>(repeat % 2 == 0 ? input.data() : output.data());
+        double* outP = reinterpret_cast<double*>(repeat % 2 == 0 ? output.data() : input.data());
+
+        int* inIntP = reinterpret_cast<int*>(inP);
+        int* outIntP = reinterpret_cast<int*>(outP);
+
+        if (type == 0) kernels->shuffleReal(inP, outP, nrOfDoubles);
+        else if (type == 1) kernels->deshuffleReal(inP, outP, nrOfDoubles);
+        else if (type == 2) kernels->shuffleInt2(inIntP, outIntP, 2 * nrOfDoubles);
+        else kernels->deshuffleInt2(inIntP, outIntP, 2 * nrOfDoubles);
+      }
+
+      const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      const char* names[] { "ShuffleReal", "DeshuffleReal", "ShuffleInt2", "DeshuffleInt2" };
+
+      std::cout << names[type] << " kernel " << static_cast<int>(kernel) << ": "
+        << (static_cast<double>(input.size()) * nrOfRepeats) / (seconds * 1e9) << " GB/s" << std::endl;
+    }
+  }
+}
@@ -0,0 +1,214 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <statistics/columnstatistics.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class StatisticsTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("statistics.fst");
+  }
+
+  static int IntValue(int row)
+  {
+    // first integer block contains only NA's
+    if (row < 4096) return FST_NA_INT;
+    return GeneratedTable::IntValue(row);
+  }
+
+  static double DoubleValue(int row)
+  {
+    if (row % 50 == 3) return std::nan("");
+    return 0.25 * ((row * 31) % 997) - 100.0;
+  }
+
+  static long long Int64Value(int row)
+  {
+    if (row % 333 == 0) return numeric_limits<long long>::min();
+    return 3000000000LL * (row % 17) - row;
+  }
+
+  void WriteTable(int nrOfRows, int compression, bool append)
+  {
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(5, nrOfRows);
+
+    IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    Int64VectorAdapter int64Vec(nrOfRows, FstColumnAttribute::INT_64_BASE, 0);
+    LogicalVectorAdapter logicalVec(nrOfRows);
+    StringColumn strVec;
+    strVec.AllocateVec(nrOfRows);
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      intVec.Data()[row] = IntValue(row);
+      doubleVec.Data()[row] = DoubleValue(row);
+      int64Vec.Data()[row] = Int64Value(row);
+      logicalVec.Data()[row] = GeneratedTable::LogicalValue(row);
+      (*strVec.StrVector()->StrVec())[row] = "s" + to_string(row);
+    }
+
+    fstTable.SetIntegerColumn(&intVec, 0);
+    fstTable.SetDoubleColumn(&doubleVec, 1);
+    fstTable.SetInt64Column(&int64Vec, 2);
+    fstTable.SetLogicalColumn(&logicalVec, 3);
+    fstTable.SetStringColumn(&strVec, 4);
+    fstTable.SetColumnNames(vector<std::string>{ "Int", "Double", "Int64", "Logical", "String" });
+
+    FstStore fstStore(filePath);
+
+    if (append)
+    {
+      fstStore.fstAppend(fstTable, compression);
+      return;
+    }
+
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  // Compare block statistics with the statistics calculated from the generated values
+  template<typename T>
+  void CheckIntegerStatistics(const ColumnStatistics &stats, int nrOfRows, unsigned int blockSize, T (*value)(int), T naValue)
+  {
+    ASSERT_EQ(stats.BlockSizeElems(), blockSize);
+    ASSERT_EQ(stats.NrOfBlocks(), static_cast<unsigned long long>((nrOfRows + blockSize - 1) / blockSize));
+
+    for (unsigned long long block = 0; block < stats.NrOfBlocks(); block++)
+    {
+      long long minValue = numeric_limits<long long>::max();
+      long long maxValue = numeric_limits<long long>::min();
+      unsigned long long naCount = 0;
+
+      for (int row = static_cast<int>(block * blockSize); row < min(nrOfRows, static_cast<int>((block + 1) * blockSize)); row++)
+      {
+        const T val = value(row);
+
+        if (val == naValue)
+        {
+          naCount++;
+          continue;
+        }
+
+        minValue = min(minValue, static_cast<long long>(val));
+        maxValue = max(maxValue, static_cast<long long>(val));
+      }
+
+      EXPECT_EQ(stats.Block(block).naCount, naCount);
+      EXPECT_EQ(stats.Block(block).min.int64, minValue);
+      EXPECT_EQ(stats.Block(block).max.int64, maxValue);
+    }
+  }
+
+  void CheckStatistics(int nrOfRows, unsigned long long nrOfChunks)
+  {
+    FstStore fstStore(filePath);
+    vector<ColumnStatistics> chunkStats;
+
+    fstStore.fstColumnStatistics(0, chunkStats);
+    ASSERT_EQ(chunkStats.size(), nrOfChunks);
+    EXPECT_EQ(chunkStats[0].Type(), StatisticsType::INT_32);
+    CheckIntegerStatistics(chunkStats[0], nrOfRows, BLOCKSIZE_INT, IntValue, static_cast<int>(FST_NA_INT));
+
+    // first block contains only NA's
+    EXPECT_GT(chunkStats[0].Block(0).min.int64, chunkStats[0].Block(0).max.int64);
+
+    fstStore.fstColumnStatistics(2, chunkStats);
+    EXPECT_EQ(chunkStats[0].Type(), StatisticsType::INT_64);
+    CheckIntegerStatistics(chunkStats[0], nrOfRows, BLOCKSIZE_INT64, Int64Value, numeric_limits<long long>::min());
+
+    fstStore.fstColumnStatistics(3, chunkStats);
+    EXPECT_EQ(chunkStats[0].Type(), StatisticsType::INT_32);
+    CheckIntegerStatistics(chunkStats[0], nrOfRows, 4096, GeneratedTable::LogicalValue, static_cast<int>(FST_NA_INT));
+
+    // doubles
+    fstStore.fstColumnStatistics(1, chunkStats);
+    const ColumnStatistics &doubleStats = chunkStats[0];
+    EXPECT_EQ(doubleStats.Type(), StatisticsType::DOUBLE_64);
+    ASSERT_EQ(doubleStats.NrOfBlocks(), static_cast<unsigned long long>((nrOfRows + BLOCKSIZE_REAL - 1) / BLOCKSIZE_REAL));
+
+    for (unsigned long long block = 0; block < doubleStats.NrOfBlocks(); block++)
+    {
+      double minValue = numeric_limits<double>::infinity();
+      double maxValue = -numeric_limits<double>::infinity();
+      unsigned long long naCount = 0;
+
+      for (int row = static_cast<int>(block * BLOCKSIZE_REAL); row < min(nrOfRows, static_cast<int>((block + 1) * BLOCKSIZE_REAL)); row++)
+      {
+        const double val = DoubleValue(row);
+
+        if (std::isnan(val))
+        {
+          naCount++;
+          continue;
+        }
+
+        minValue = min(minValue, val);
+        maxValue = max(maxValue, val);
+      }
+
+      EXPECT_EQ(doubleStats.Block(block).naCount, naCount);
+      EXPECT_EQ(doubleStats.Block(block).min.real, minValue);
+      EXPECT_EQ(doubleStats.Block(block).max.real, maxValue);
+    }
+
+    // no statistics for character columns
+    fstStore.fstColumnStatistics(4, chunkStats);
+    EXPECT_EQ(chunkStats[0].NrOfBlocks(), 0ULL);
+  }
+};
+
+
+TEST_F(StatisticsTest, Uncompressed)
+{
+  WriteTable(10000, 0, false);
+  CheckStatistics(10000, 1);
+}
+
+
+TEST_F(StatisticsTest, Compressed)
+{
+  WriteTable(100000, 30, false);
+  CheckStatistics(100000, 1);
+
+  WriteTable(100000, 80, false);
+  CheckStatistics(100000, 1);
+}
+
+
+TEST_F(StatisticsTest, AppendedChunks)
+{
+  WriteTable(10000, 50, false);
+  WriteTable(10000, 50, true);
+
+  // each data chunk has its own statistics
+  CheckStatistics(10000, 2);
+
+  FstStore fstStore(filePath);
+  vector<ColumnStatistics> chunkStats;
+  fstStore.fstColumnStatistics(1, chunkStats);
+
+  ASSERT_EQ(chunkStats.size(), 2ULL);
+  EXPECT_EQ(chunkStats[1].NrOfBlocks(), chunkStats[0].NrOfBlocks());
+  EXPECT_EQ(chunkStats[1].Block(1).min.real, chunkStats[0].Block(1).min.real);
+}
@@ -0,0 +1,208 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fststreamer.h>
+#include <interface/fstdefines.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class StreamerTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("streamer.fst");
+  }
+
+  static std::string TextValue(int row)
+  {
+    return "text" + to_string(row % 1013);
+  }
+
+  static std::string LevelValue(int row)
+  {
+    return "level" + to_string((row / 3) % 7);
+  }
+
+  // Batch with rows [from, from + nrOfRows), the factor levels of each batch only contain the values used
+  struct Batch
+  {
+    FstTable fstTable;
+    IntVectorAdapter idVec;
+    DoubleVectorAdapter doubleVec;
+    StringColumn strVec;
+    std::unique_ptr<FactorVectorAdapter> factorVec;
+
+    Batch(int from, int nrOfRows) : fstTable(nrOfRows), idVec(nrOfRows, FstColumnAttribute::NONE, 0),
+      doubleVec(nrOfRows, FstColumnAttribute::NONE, 0)
+    {
+      fstTable.InitTable(4, nrOfRows);
+      strVec.AllocateVec(nrOfRows);
+
+      vector<std::string> levels;
+      map<std::string, int> levelIndex;
+      vector<int> levelData(nrOfRows);
+
+      for (int pos = 0; pos < nrOfRows; pos++)
+      {
+        const int row = from + pos;
+        const std::string level = LevelValue(row);
+
+        if (levelIndex.find(level) == levelIndex.end())
+        {
+          levels.push_back(level);
+          levelIndex[level] = static_cast<int>(levels.size());
+        }
+
+        idVec.Data()[pos] = row;
+        doubleVec.Data()[pos] = 0.5 * row;
+        (*strVec.StrVector()->StrVec())[pos] = TextValue(row);
+        levelData[pos] = levelIndex[level];
+      }
+
+      factorVec = std::unique_ptr<FactorVectorAdapter>(new FactorVectorAdapter(nrOfRows, levels.size(),
+        FstColumnAttribute::FACTOR_BASE));
+      *factorVec->DataPtr()->Levels()->StrVector()->StrVec() = levels;
+      for (int pos = 0; pos < nrOfRows; pos++) factorVec->LevelData()[pos] = levelData[pos];
+
+      fstTable.SetIntegerColumn(&idVec, 0);
+      fstTable.SetDoubleColumn(&doubleVec, 1);
+      fstTable.SetStringColumn(&strVec, 2);
+      fstTable.SetFactorColumn(factorVec.get(), 3);
+      fstTable.SetColumnNames(vector<std::string>{ "Id", "Double", "Text", "Level" });
+    }
+  };
+
+  // Read the complete file and compare with the generated values
+  void CheckFile(int nrOfRows)
+  {
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    StringArray selectedCols;
+    ColumnFactory columnFactory;
+    std::vector<int> keyIndex;
+    std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+    fstStore.fstRead(tableRead, nullptr, 1, -1, &columnFactory, keyIndex, &selectedCols, col_names.get());
+
+    ASSERT_EQ(*fstStore.p_nrOfRows, static_cast<unsigned long long>(nrOfRows));
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(nrOfRows));
+
+    std::shared_ptr<DestructableObject> column;
+    FstColumnType type;
+    std::string colName, annotation;
+    short int scale;
+
+    tableRead.GetColumn(0, column, type, colName, scale, annotation);
+    int* idP = static_cast<IntVector*>(&*column)->Data();
+
+    tableRead.GetColumn(1, column, type, colName, scale, annotation);
+    double* doubleP = static_cast<DoubleVector*>(&*column)->Data();
+
+    tableRead.GetColumn(2, column, type, colName, scale, annotation);
+    vector<std::string>* strings = static_cast<StringVector*>(&*column)->StrVec();
+
+    tableRead.GetColumn(3, column, type, colName, scale, annotation);
+    FactorVector* factorVec = static_cast<FactorVector*>(&*column);
+    vector<std::string>* levels = factorVec->Levels()->StrVector()->StrVec();
+
+    for (int row = 0; row < nrOfRows; row++)
+    {
+      ASSERT_EQ(idP[row], row);
+      EXPECT_EQ(doubleP[row], 0.5 * row);
+      EXPECT_EQ((*strings)[row], TextValue(row));
+      EXPECT_EQ((*levels)[factorVec->Data()[row] - 1], LevelValue(row));
+    }
+  }
+};
+
+
+TEST_F(StreamerTest, StreamBatches)
+{
+  {
+    FstStreamer streamer(filePath, 50);
+
+    // more batches than the slots of a single chunk index
+    for (int batchNr = 0; batchNr < 11; batchNr++)
+    {
+      Batch batch(batchNr * 7000, 7000);
+      streamer.WriteBatch(batch.fstTable);
+    }
+
+    EXPECT_EQ(streamer.NrOfRows(), 77000ULL);
+    streamer.Close();
+  }
+
+  CheckFile(77000);
+}
+
+
+TEST_F(StreamerTest, AppendToExistingFile)
+{
+  {
+    Batch batch(0, 5000);
+    FstStore fstStore(filePath);
+    fstStore.fstWrite(batch.fstTable, 0);
+  }
+
+  {
+    FstStreamer streamer(filePath, 30, true);
+    EXPECT_EQ(streamer.NrOfRows(), 5000ULL);
+
+    for (int batchNr = 0; batchNr < 3; batchNr++)
+    {
+      Batch batch(5000 + batchNr * 10000, 10000);
+      streamer.WriteBatch(batch.fstTable);
+    }
+
+    // the destructor closes the file
+  }
+
+  CheckFile(35000);
+}
+
+
+TEST_F(StreamerTest, IncorrectBatches)
+{
+  FstStreamer emptyStreamer(filePath, 0);
+  EXPECT_THROW(emptyStreamer.Close(), runtime_error);
+
+  FstStreamer streamer(filePath, 0);
+
+  Batch batch(0, 1000);
+  streamer.WriteBatch(batch.fstTable);
+
+  // batch with different column types is rejected, the file remains usable
+  FstTable otherTable(10);
+  otherTable.InitTable(4, 10);
+  DoubleVectorAdapter doubleVec(10, FstColumnAttribute::NONE, 0);
+  otherTable.SetDoubleColumn(&doubleVec, 0);
+  otherTable.SetDoubleColumn(&doubleVec, 1);
+  otherTable.SetDoubleColumn(&doubleVec, 2);
+  otherTable.SetDoubleColumn(&doubleVec, 3);
+
+  EXPECT_THROW(streamer.WriteBatch(otherTable), runtime_error);
+
+  Batch nextBatch(1000, 1000);
+  streamer.WriteBatch(nextBatch.fstTable);
+  streamer.Close();
+
+  EXPECT_THROW(streamer.WriteBatch(nextBatch.fstTable), runtime_error);
+
+  CheckFile(2000);
+}
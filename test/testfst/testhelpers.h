@@ -6,7 +6,20 @@
 #include "gtest/gtest.h"
 #include "gtest/internal/gtest-filepath.h"
 
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <compression/compression.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
 #include <string>
+#include <vector>
 
 
 using namespace testing::internal;
@@ -57,4 +70,289 @@ inline std::string GetFilePath(std::string fileName)
 	return filePath.string();
 }
 
-#endif // TEST_HELPERS_H
\ No newline at end of file
+inline unsigned long long FileSize(const std::string &filePath)
+{
+	ifstream file(filePath, ios::binary | ios::ate);
+	return static_cast<unsigned long long>(file.tellg());
+}
+
+// Highest version of the features used in a fst file
+inline unsigned int TableVersion(const std::string &filePath)
+{
+	FstStore fstStore(filePath);
+	ColumnFactory columnFactory;
+	std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+	fstStore.fstMeta(&columnFactory, col_names.get());
+
+	return fstStore.tableVersionMax;
+}
+
+// Read rows [from, to] (one based, -1 for the last row) of all columns
+inline void ReadRows(FstStore &fstStore, FstTable &tableRead, int64_t from, int64_t to)
+{
+	StringArray selectedCols;
+	ColumnFactory columnFactory;
+	std::vector<int> keyIndex;
+	std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+	fstStore.fstRead(tableRead, nullptr, from, to, &columnFactory, keyIndex, &selectedCols, col_names.get());
+}
+
+// Read a sorted selection of (one based) rows of all columns
+inline void ReadSelectedRows(FstStore &fstStore, FstTable &tableRead, const vector<int64_t> &rows)
+{
+	StringArray selectedCols;
+	ColumnFactory columnFactory;
+	std::vector<int> keyIndex;
+	std::unique_ptr<StringColumn> col_names(new StringColumn());
+
+	fstStore.fstReadRows(tableRead, nullptr, rows, &columnFactory, keyIndex, &selectedCols, col_names.get());
+}
+
+// Column of a table that was read, as the vector type of the column (IntVector, DoubleVector, StringVector, ...)
+template<typename T>
+T* ColumnVector(FstTable &tableRead, int colNr)
+{
+	std::shared_ptr<DestructableObject> column;
+	FstColumnType type;
+	std::string colName, annotation;
+	short int scale;
+
+	tableRead.GetColumn(colNr, column, type, colName, scale, annotation);
+
+	return static_cast<T*>(&*column);  // the column is owned by the table
+}
+
+// Value patterns of the codec tests
+enum class ValuePattern
+{
+	SORTED,        // increasing values with small random gaps
+	SORTED_NA,     // increasing values with NA's (smallest value)
+	CONSTANT,      // a single value
+	RANDOM,        // random bits
+	SMALL_RANDOM,  // random values in [0, 65535]
+	SEQUENCE,      // row numbers, runs of length one
+	LONG_RUNS,     // runs of 1000 equal values
+	RUNS           // runs of random length and random values
+};
+
+// Block of integer values with a pattern, the same size and seed give the same values
+template<typename T>
+vector<T> PatternValues(unsigned int size, ValuePattern pattern, unsigned int seed)
+{
+	std::mt19937_64 generator(seed);
+	vector<T> values(size);
+	T value = 0;
+
+	for (unsigned int pos = 0; pos < size; pos++)
+	{
+		switch (pattern)
+		{
+			case ValuePattern::SORTED:
+				values[pos] = static_cast<T>(3 * static_cast<long long>(pos) - 5000) + static_cast<T>(generator() % 3);
+				break;
+
+			case ValuePattern::SORTED_NA:
+				values[pos] = pos % 100 == 3 ? std::numeric_limits<T>::min() : static_cast<T>(pos);
+				break;
+
+			case ValuePattern::CONSTANT: values[pos] = 42; break;
+			case ValuePattern::RANDOM: values[pos] = static_cast<T>(generator()); break;
+			case ValuePattern::SMALL_RANDOM: values[pos] = static_cast<T>(generator() % 65536); break;
+			case ValuePattern::SEQUENCE: values[pos] = static_cast<T>(pos); break;
+			case ValuePattern::LONG_RUNS: values[pos] = static_cast<T>(pos / 1000) - 3; break;
+
+
+			case ValuePattern::RUNS:
+				if (generator() % 20 == 0) value = static_cast<T>(generator());
+				values[pos] = value;
+				break;
+		}
+	}
+
+	return values;
+}
+
+// Compress 'values' with a codec in a buffer of 'capacity' bytes, decompress and compare. A block that is truncated by
+// a single byte can't be decompressed and the codec fails when the capacity is a single byte too small.
+// Returns the compressed size.
+template<typename T>
+unsigned int CodecRoundTrip(const vector<T> &values, CompAlgorithm compress, DecompAlgorithm decompress,
+	unsigned int capacity, int compressionLevel = 0)
+{
+	const unsigned int srcSize = static_cast<unsigned int>(values.size() * sizeof(T));
+	const char* src = reinterpret_cast<const char*>(values.data());
+	vector<char> compressed(capacity);
+	vector<T> restored(values.size());
+
+	const unsigned int compSize = compress(compressed.data(), capacity, src, srcSize, compressionLevel);
+
+	EXPECT_GT(compSize, 0U);
+	if (compSize == 0) return 0;
+
+	EXPECT_EQ(decompress(reinterpret_cast<char*>(restored.data()), srcSize, compressed.data(), compSize), 0U);
+	EXPECT_EQ(memcmp(values.data(), restored.data(), srcSize), 0);
+
+	// corrupted size
+	EXPECT_NE(decompress(reinterpret_cast<char*>(restored.data()), srcSize, compressed.data(), compSize - 1), 0U);
+
+	// insufficient capacity
+	EXPECT_EQ(compress(compressed.data(), compSize - 1, src, srcSize, compressionLevel), 0U);
+
+	return compSize;
+}
+
+// Table with integer, double, int64, logical, byte, character and factor columns. Each value is a function of the
+// (zero based) row number, so any range or selection of rows can be written, appended and checked.
+class GeneratedTable
+{
+public:
+
+	static int IntValue(int row)
+	{
+		if (row % 100 == 7) return static_cast<int>(FST_NA_INT);
+		return static_cast<int>((static_cast<long long>(row) * 7919) % 10007) - 5000;  // no overflow for large rows
+	}
+
+	static double DoubleValue(int row)
+	{
+		return 0.5 * row;
+	}
+
+	static long long Int64Value(int row)
+	{
+		return 3000000000LL * (row % 17) - row;
+	}
+
+	static int LogicalValue(int row)
+	{
+		if (row % 9 == 0) return static_cast<int>(FST_NA_INT);
+		return row % 2;
+	}
+
+	static char ByteValue(int row)
+	{
+		return static_cast<char>(row % 101);
+	}
+
+	static std::string StringValue(int row)
+	{
+		if (row % 37 == 5) return "NA";
+		return "s" + to_string((static_cast<long long>(row) * 13) % 1000);
+	}
+
+	// level 'a' for even and 'b' for odd rows
+	static int FactorValue(int row)
+	{
+		if (row % 5 == 0) return static_cast<int>(FST_NA_INT);
+		return 1 + row % 2;
+	}
+
+	// Write or append rows [from, from + nrOfRows)
+	static void WriteRows(FstStore &fstStore, int from, int nrOfRows, int compression, bool append)
+	{
+		FstTable fstTable(nrOfRows);
+		fstTable.InitTable(7, nrOfRows);
+
+		IntVectorAdapter intVec(nrOfRows, FstColumnAttribute::NONE, 0);
+		DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+		Int64VectorAdapter int64Vec(nrOfRows, FstColumnAttribute::INT_64_BASE, 0);
+		LogicalVectorAdapter logicalVec(nrOfRows);
+		ByteVectorAdapter byteVec(nrOfRows);
+		StringColumn strVec;
+		strVec.AllocateVec(nrOfRows);
+		FactorVectorAdapter factorVec(nrOfRows, 2, FstColumnAttribute::FACTOR_BASE);
+
+		vector<std::string>* levels = factorVec.DataPtr()->Levels()->StrVector()->StrVec();
+		(*levels)[0] = "a";
+		(*levels)[1] = "b";
+
+		for (int pos = 0; pos < nrOfRows; pos++)
+		{
+			const int row = from + pos;
+
+			intVec.Data()[pos] = IntValue(row);
+			doubleVec.Data()[pos] = DoubleValue(row);
+			int64Vec.Data()[pos] = Int64Value(row);
+			logicalVec.Data()[pos] = LogicalValue(row);
+			byteVec.Data()[pos] = ByteValue(row);
+			(*strVec.StrVector()->StrVec())[pos] = StringValue(row);
+			factorVec.LevelData()[pos] = FactorValue(row);
+		}
+
+		fstTable.SetIntegerColumn(&intVec, 0);
+		fstTable.SetDoubleColumn(&doubleVec, 1);
+		fstTable.SetInt64Column(&int64Vec, 2);
+		fstTable.SetLogicalColumn(&logicalVec, 3);
+		fstTable.SetByteColumn(&byteVec, 4);
+		fstTable.SetStringColumn(&strVec, 5);
+		fstTable.SetFactorColumn(&factorVec, 6);
+		fstTable.SetColumnNames(vector<std::string>{ "Int", "Double", "Int64", "Logical", "Byte", "String", "Factor" });
+
+		if (append)
+		{
+			fstStore.fstAppend(fstTable, compression);
+			return;
+		}
+
+		fstStore.fstWrite(fstTable, compression);
+	}
+
+	// Compare a table that was read with all columns with the generated values of the (one based) rows
+	static void CheckTable(FstTable &tableRead, const vector<int64_t> &rows)
+	{
+		ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(rows.size()));
+
+		int* intP = ColumnVector<IntVector>(tableRead, 0)->Data();
+		double* doubleP = ColumnVector<DoubleVector>(tableRead, 1)->Data();
+		long long* int64P = ColumnVector<LongVector>(tableRead, 2)->Data();
+		int* logicalP = ColumnVector<IntVector>(tableRead, 3)->Data();
+		char* byteP = ColumnVector<ByteVector>(tableRead, 4)->Data();
+		vector<std::string>* strings = ColumnVector<StringVector>(tableRead, 5)->StrVec();
+		FactorVector* factorVec = ColumnVector<FactorVector>(tableRead, 6);
+		vector<std::string>* levels = factorVec->Levels()->StrVector()->StrVec();
+
+		for (size_t pos = 0; pos < rows.size(); pos++)
+		{
+			const int row = static_cast<int>(rows[pos] - 1);
+
+			ASSERT_EQ(intP[pos], IntValue(row));
+			EXPECT_EQ(doubleP[pos], DoubleValue(row));
+			EXPECT_EQ(int64P[pos], Int64Value(row));
+			EXPECT_EQ(logicalP[pos], LogicalValue(row));
+			EXPECT_EQ(byteP[pos], ByteValue(row));
+			EXPECT_EQ((*strings)[pos], StringValue(row));
+
+			const int factorValue = factorVec->Data()[pos];
+			ASSERT_EQ(factorValue, FactorValue(row));
+			if (factorValue != static_cast<int>(FST_NA_INT))
+			{
+				EXPECT_EQ((*levels)[factorValue - 1], row % 2 == 0 ? "a" : "b");
+			}
+		}
+	}
+
+	// Read rows [from, to] (one based) and compare with the generated values
+	static void CheckRows(FstStore &fstStore, int from, int to)
+	{
+		FstTable tableRead;
+		ReadRows(fstStore, tableRead, from, to);
+
+		vector<int64_t> rows;
+		for (int64_t row = from; row <= to; row++) rows.push_back(row);
+
+		CheckTable(tableRead, rows);
+	}
+
+	// Read a sorted selection of (one based) rows and compare with the generated values
+	static void CheckSelectedRows(FstStore &fstStore, const vector<int64_t> &rows)
+	{
+		FstTable tableRead;
+		ReadSelectedRows(fstStore, tableRead, rows);
+
+		CheckTable(tableRead, rows);
+	}
+};
+
+#endif // TEST_HELPERS_H
@@ -0,0 +1,232 @@
+#include "gtest/gtest.h"
+#include "gtest/internal/gtest-filepath.h"
+
+#include <interface/fststore.h>
+#include <interface/fstdefines.h>
+#include <compression/compression.h>
+#include <compression/xorcodec.h>
+
+#include <fsttable.h>
+#include <columnfactory.h>
+
+#include "testhelpers.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using namespace testing::internal;
+using namespace std;
+
+class XorCodecTest : public ::testing::Test
+{
+protected:
+  std::string filePath;
+
+  virtual void SetUp()
+  {
+    filePath = GetFilePath("xorcodec.fst");
+  }
+
+  // Random walk with steps of 'step' (rounded to a multiple of 'step' when 'quantized' is set)
+  static vector<double> RandomWalk(unsigned int size, double step, bool quantized, unsigned int seed)
+  {
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> distribution(0.0, 1.0);
+    vector<double> values(size);
+    double value = 100.0;
+
+    for (unsigned int pos = 0; pos < size; pos++)
+    {
+      value += quantized ? step * std::round(distribution(generator)) : step * distribution(generator);
+      values[pos] = value;
+    }
+
+    return values;
+  }
+
+  static vector<double> SpecialValues(unsigned int size)
+  {
+    const double specials[] { 0.0, -0.0, std::numeric_limits<double>::infinity(),
+      -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::max(), 1.0, 1.0, 1.0 };
+
+    vector<double> values(size);
+    for (unsigned int pos = 0; pos < size; pos++) values[pos] = specials[(pos * 7) % 10];
+
+    return values;
+  }
+
+  static unsigned int RoundTrip(const vector<double> &values)
+  {
+    const unsigned int srcSize = static_cast<unsigned int>(8 * values.size());
+    return CodecRoundTrip(values, XOR_DOUBLE_C, XOR_DOUBLE_D, XorSizeBound(srcSize));
+  }
+
+  void WriteRows(const vector<double> &values, int compression, bool extendedCodecs)
+  {
+    const int nrOfRows = static_cast<int>(values.size());
+
+    FstTable fstTable(nrOfRows);
+    fstTable.InitTable(1, nrOfRows);
+
+    DoubleVectorAdapter doubleVec(nrOfRows, FstColumnAttribute::NONE, 0);
+    memcpy(doubleVec.Data(), values.data(), 8 * values.size());
+
+    fstTable.SetDoubleColumn(&doubleVec, 0);
+    fstTable.SetColumnNames(vector<std::string>{ "Price" });
+
+    FstStore fstStore(filePath);
+    fstStore.SetExtendedCodecs(extendedCodecs);
+    fstStore.fstWrite(fstTable, compression);
+  }
+
+  void CheckRows(const vector<double> &values, int startRow)
+  {
+    FstStore fstStore(filePath);
+    FstTable tableRead;
+    ReadRows(fstStore, tableRead, startRow, -1);
+    ASSERT_EQ(tableRead.NrOfRows(), static_cast<uint64_t>(values.size() - startRow + 1));
+
+    double* doubleP = ColumnVector<DoubleVector>(tableRead, 0)->Data();
+    ASSERT_EQ(memcmp(doubleP, &values[startRow - 1], 8 * (values.size() - startRow + 1)), 0);
+  }
+};
+
+
+TEST_F(XorCodecTest, RoundTrip)
+{
+  for (unsigned int size : { 1U, 2U, 3U, 100U, 2048U, 10001U })
+  {
+    RoundTrip(RandomWalk(size, 0.01, false, size));
+    RoundTrip(RandomWalk(size, 0.25, true, size));
+    RoundTrip(SpecialValues(size));
+    RoundTrip(vector<double>(size, 3.5));
+
+    // random bits, including the maximum encoding size
+    std::mt19937_64 generator(size);
+    vector<double> random(size);
+    for (double &value : random)
+    {
+      const unsigned long long bits = generator();
+      memcpy(&value, &bits, 8);
+    }
+
+    RoundTrip(random);
+  }
+}
+
+
+TEST_F(XorCodecTest, EncodedSize)
+{
+  // 3.5 has 14 significant bits and 50 trailing zeros (11 bits of flag, leading zero code and length), repeated
+  // values take 2 bits
+  EXPECT_EQ(RoundTrip(vector<double>(2048, 3.5)), (11 + 14 + 2047 * 2 + 7) / 8U);
+
+  // a walk over quarters shares all but a few bits with the previous value
+  EXPECT_LT(RoundTrip(RandomWalk(2048, 0.25, true, 1)), 2048U * 3);
+}
+
+
+TEST_F(XorCodecTest, Capacity)
+{
+  const vector<double> values = RandomWalk(2048, 0.01, false, 3);
+  vector<char> encoded(XorSizeBound(8 * 2048));
+
+  const unsigned int encodedSize = XOR_DOUBLE_C(encoded.data(), static_cast<unsigned int>(encoded.size()),
+    reinterpret_cast<const char*>(values.data()), 8 * 2048, 0);
+
+  // the encoding is abandoned when it exceeds the capacity
+  EXPECT_EQ(XOR_DOUBLE_C(encoded.data(), encodedSize - 1, reinterpret_cast<const char*>(values.data()), 8 * 2048, 0),
+    0U);
+
+  // truncated data
+  vector<double> restored(2048);
+  EXPECT_NE(XOR_DOUBLE_D(reinterpret_cast<char*>(restored.data()), 8 * 2048, encoded.data(), encodedSize / 2), 0U);
+}
+
+
+TEST_F(XorCodecTest, DoubleColumns)
+{
+  const vector<double> values = RandomWalk(200000, 0.25, true, 5);
+
+  for (int compression : { 20, 80 })
+  {
+    WriteRows(values, compression, false);
+    const unsigned long long defaultSize = FileSize(filePath);
+
+    WriteRows(values, compression, true);
+    CheckRows(values, 1);
+    CheckRows(values, 99999);
+
+    EXPECT_LT(FileSize(filePath), defaultSize);
+  }
+
+  // full precision steps
+  const vector<double> noisy = RandomWalk(50000, 0.01, false, 7);
+  WriteRows(noisy, 60, true);
+  CheckRows(noisy, 1);
+}
+
+
+TEST_F(XorCodecTest, DISABLED_Benchmark)
+{
+  const unsigned int nrOfDoubles = 2048;  // single 16 KB block
+  const int nrOfRepeats = 1000;
+  const unsigned int srcSize = 8 * nrOfDoubles;
+
+  struct Codec
+  {
+    const char* name;
+    unsigned int (*compress)(char*, unsigned int, const char*, unsigned int, int);
+    unsigned int (*decompress)(char*, unsigned int, const char*, unsigned int);
+    int level;
+  };
+
+  const Codec codecs[] { { "XOR_DOUBLE", XOR_DOUBLE_C, XOR_DOUBLE_D, 0 }, { "LZ4_SHUF8", LZ4_C_SHUF8, LZ4_D_SHUF8, 0 },
+    { "ZSTD_SHUF8 (20)", ZSTD_C_SHUF8, ZSTD_D_SHUF8, 20 }, { "ZSTD_SHUF8 (60)", ZSTD_C_SHUF8, ZSTD_D_SHUF8, 60 } };
+
+  for (int series = 0; series < 2; series++)
+  {
+    const vector<double> values = series == 0 ? RandomWalk(nrOfDoubles, 0.01, false, 1) :
+      RandomWalk(nrOfDoubles, 0.01, true, 1);
+    const char* src = reinterpret_cast<const char*>(values.data());
+
+    for (const Codec &codec : codecs)
+    {
+      vector<char> compressed(2 * srcSize + 1024);
+      vector<char> restored(srcSize);
+      unsigned int compressedSize = 0;
+
+      auto start = std::chrono::steady_clock::now();
+
+      for (int repeat = 0; repeat < nrOfRepeats; repeat++)
+      {
+        compressedSize = codec.compress(compressed.data(), static_cast<unsigned int>(compressed.size()), src, srcSize,
+          codec.level);
+      }
+
+      const double compressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      start = std::chrono::steady_clock::now();
+
+      for (int repeat = 0; repeat < nrOfRepeats; repeat++)
+      {
+        codec.decompress(restored.data(), srcSize, compressed.data(), compressedSize);
+      }
+
+      const double decompressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      ASSERT_EQ(memcmp(src, restored.data(), srcSize), 0);
+
+      std::cout << (series == 0 ? "random walk, " : "quantized random walk, ") << codec.name << ": ratio "
+        << static_cast<double>(srcSize) / compressedSize << ", compress "
+        << (static_cast<double>(srcSize) * nrOfRepeats) / (compressSeconds * 1e9) << " GB/s, decompress "
+        << (static_cast<double>(srcSize) * nrOfRepeats) / (decompressSeconds * 1e9) << " GB/s" << std::endl;
+    }
+  }
+}